@@ -0,0 +1,243 @@
+#pragma once
+
+#include "point.hpp"
+#include "simd.hpp"
+#include "transform.hpp"
+#include "vec.hpp"
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+namespace linalg {
+
+// The top three rows of a Transform4, with the ( 0, 0, 0, 1 ) bottom row implied. Rows are 16-byte aligned Vec4s,
+// 48 bytes in total against 64 for Transform4.
+class Affine3x4
+{
+  alignas( 16 ) std::array<Vec4, 3> m_rows{};
+
+public:
+  constexpr Affine3x4() = default;
+
+  constexpr Affine3x4( float t00,
+    float                    t01,
+    float                    t02,
+    float                    t03,
+    float                    t10,
+    float                    t11,
+    float                    t12,
+    float                    t13,
+    float                    t20,
+    float                    t21,
+    float                    t22,
+    float                    t23 )
+    : m_rows{ Vec4{ t00, t01, t02, t03 }, Vec4{ t10, t11, t12, t13 }, Vec4{ t20, t21, t22, t23 } }
+  {}
+
+  constexpr Affine3x4( const Vec3& v00, const Vec3& v01, const Vec3& v02, const Point3& p03 )
+    : Affine3x4( v00.x(),
+        v01.x(),
+        v02.x(),
+        p03.x(),
+        v00.y(),
+        v01.y(),
+        v02.y(),
+        p03.y(),
+        v00.z(),
+        v01.z(),
+        v02.z(),
+        p03.z() )
+  {}
+
+  // Drops the bottom row, which for a Transform4 is always ( 0, 0, 0, 1 ).
+  explicit constexpr Affine3x4( const Transform4& t )
+    : Affine3x4( t( 0, 0 ),
+        t( 0, 1 ),
+        t( 0, 2 ),
+        t( 0, 3 ),
+        t( 1, 0 ),
+        t( 1, 1 ),
+        t( 1, 2 ),
+        t( 1, 3 ),
+        t( 2, 0 ),
+        t( 2, 1 ),
+        t( 2, 2 ),
+        t( 2, 3 ) )
+  {}
+
+  [[nodiscard]] static constexpr Affine3x4 identity()
+  {
+    return Affine3x4{ 1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F };
+  }
+
+  constexpr float& operator()( size_t i, size_t j )
+  {
+    assert( i < 3 && j < 4 );
+    return m_rows[i][j];
+  }
+
+  [[nodiscard]] constexpr const float& operator()( size_t i, size_t j ) const
+  {
+    assert( i < 3 && j < 4 );
+    return m_rows[i][j];
+  }
+
+  constexpr Vec4& row( size_t i )
+  {
+    assert( i < 3 );
+    return m_rows[i];
+  }
+
+  [[nodiscard]] constexpr const Vec4& row( size_t i ) const
+  {
+    assert( i < 3 );
+    return m_rows[i];
+  }
+
+  [[nodiscard]] constexpr Vec3 get_column3( size_t j ) const
+  {
+    return Vec3{ ( *this )( 0, j ), ( *this )( 1, j ), ( *this )( 2, j ) };
+  }
+
+  [[nodiscard]] constexpr Point3 get_translation() const { return Point3{ get_column3( 3 ) }; }
+
+  constexpr void set_translation( const Point3& point )
+  {
+    ( *this )( 0, 3 ) = point.x();
+    ( *this )( 1, 3 ) = point.y();
+    ( *this )( 2, 3 ) = point.z();
+  }
+
+  [[nodiscard]] constexpr Transform4 to_transform4() const
+  {
+    const Affine3x4& a = *this;
+    return Transform4{ a( 0, 0 ),
+      a( 0, 1 ),
+      a( 0, 2 ),
+      a( 0, 3 ),
+      a( 1, 0 ),
+      a( 1, 1 ),
+      a( 1, 2 ),
+      a( 1, 3 ),
+      a( 2, 0 ),
+      a( 2, 1 ),
+      a( 2, 2 ),
+      a( 2, 3 ) };
+  }
+
+  [[nodiscard]] friend constexpr bool operator==( const Affine3x4& left, const Affine3x4& right )
+  {
+    return left.m_rows[0] == right.m_rows[0] && left.m_rows[1] == right.m_rows[1]
+           && left.m_rows[2] == right.m_rows[2];
+  }
+};
+
+// Row i of the product is left's row i weighted against right's rows and the implied ( 0, 0, 0, 1 ): 36 multiplies
+// and 27 adds instead of the 64 and 48 of a full 4x4 product.
+[[nodiscard]] constexpr Affine3x4 operator*( const Affine3x4& left, const Affine3x4& right )
+{
+#ifdef LINALG_SIMD_F32X4
+  if !consteval
+  {
+    const simd::Columns4 rows{ { simd::load( right.row( 0 ).data() ),
+      simd::load( right.row( 1 ).data() ),
+      simd::load( right.row( 2 ).data() ),
+      simd::load( Vec4{ 0.0F, 0.0F, 0.0F, 1.0F }.data() ) } };
+    Affine3x4 result;
+    for ( size_t i = 0; i != 3; ++i )
+    {
+      simd::store( result.row( i ).data(), simd::combine_columns( rows, simd::load( left.row( i ).data() ) ) );
+    }
+    return result;
+  }
+#endif
+  Affine3x4 result;
+  for ( size_t i = 0; i != 3; ++i )
+  {
+    for ( size_t j = 0; j != 4; ++j )
+    {
+      const float sum = madd<DefaultFma>( left( i, 1 ), right( 1, j ), left( i, 0 ) * right( 0, j ) );
+      result( i, j )  = madd<DefaultFma>( left( i, 2 ), right( 2, j ), sum );
+    }
+    result( i, 3 ) += left( i, 3 );
+  }
+  return result;
+}
+
+[[nodiscard]] constexpr Vec3 operator*( const Affine3x4& a, const Vec3& vec )
+{
+  return Vec3{
+    a( 0, 0 ) * vec.x() + a( 0, 1 ) * vec.y() + a( 0, 2 ) * vec.z(),
+    a( 1, 0 ) * vec.x() + a( 1, 1 ) * vec.y() + a( 1, 2 ) * vec.z(),
+    a( 2, 0 ) * vec.x() + a( 2, 1 ) * vec.y() + a( 2, 2 ) * vec.z(),
+  };
+}
+
+[[nodiscard]] constexpr Point3 operator*( const Affine3x4& a, const Point3& point )
+{
+#ifdef LINALG_SIMD_F32X4
+  if !consteval
+  {
+    const simd::f32x4 p = simd::load( Vec4{ point, 1.0F }.data() );
+    return Point3{ simd::dot( simd::load( a.row( 0 ).data() ), p ),
+      simd::dot( simd::load( a.row( 1 ).data() ), p ),
+      simd::dot( simd::load( a.row( 2 ).data() ), p ) };
+  }
+#endif
+  return Point3{
+    a( 0, 0 ) * point.x() + a( 0, 1 ) * point.y() + a( 0, 2 ) * point.z() + a( 0, 3 ),
+    a( 1, 0 ) * point.x() + a( 1, 1 ) * point.y() + a( 1, 2 ) * point.z() + a( 1, 3 ),
+    a( 2, 0 ) * point.x() + a( 2, 1 ) * point.y() + a( 2, 2 ) * point.z() + a( 2, 3 ),
+  };
+}
+
+[[nodiscard]] constexpr Vec3 transform_normal( const Vec3& normal, const Affine3x4& a )
+{
+  return Vec3{
+    normal.x() * a( 0, 0 ) + normal.y() * a( 1, 0 ) + normal.z() * a( 2, 0 ),
+    normal.x() * a( 0, 1 ) + normal.y() * a( 1, 1 ) + normal.z() * a( 2, 1 ),
+    normal.x() * a( 0, 2 ) + normal.y() * a( 1, 2 ) + normal.z() * a( 2, 2 ),
+  };
+}
+
+[[nodiscard]] constexpr Vec3 operator*( const Vec3& normal_vec, const Affine3x4& a )
+{
+  return transform_normal( normal_vec, a );
+}
+
+// Same construction as inverse( const Transform4& ).
+[[nodiscard]] constexpr Affine3x4 inverse( const Affine3x4& mat )
+{
+  const Vec3 a = mat.get_column3( 0 );
+  const Vec3 b = mat.get_column3( 1 );
+  const Vec3 c = mat.get_column3( 2 );
+  const Vec3 d = mat.get_column3( 3 );
+
+  Vec3 s = cross( a, b );
+  Vec3 t = cross( c, d );
+
+  const float inv_det = 1.0F / dot( s, c );
+  s *= inv_det;
+  t *= inv_det;
+
+  const Vec3 v  = c * inv_det;
+  const Vec3 r0 = cross( b, v );
+  const Vec3 r1 = cross( v, a );
+
+  return Affine3x4{
+    r0.x(),
+    r0.y(),
+    r0.z(),
+    -dot( b, t ),
+    r1.x(),
+    r1.y(),
+    r1.z(),
+    dot( a, t ),
+    s.x(),
+    s.y(),
+    s.z(),
+    -dot( d, s ),
+  };
+}
+
+} // namespace linalg
@@ -0,0 +1,2450 @@
+#pragma once
+
+#include "affine.hpp"
+#include "dispatch.hpp"
+#include "half.hpp"
+#include "mat4.hpp"
+#include "normal_encoding.hpp"
+#include "parallel.hpp"
+#include "point.hpp"
+#include "quaternion.hpp"
+#include "transform.hpp"
+#include "vec.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace linalg {
+
+static_assert( sizeof( Vec3 ) == 3 * sizeof( float ) && sizeof( Point3 ) == sizeof( Vec3 ) );
+static_assert( sizeof( Vec4 ) == 4 * sizeof( float ) && sizeof( Mat4 ) == 16 * sizeof( float ) );
+static_assert( sizeof( Transform4 ) == sizeof( Mat4 ) && sizeof( Quaternion ) == sizeof( Vec4 ) );
+static_assert( sizeof( HVec3 ) == 3 * sizeof( Half ) && sizeof( HVec4 ) == 4 * sizeof( Half ) );
+static_assert( sizeof( BF16Vec3 ) == 3 * sizeof( BFloat16 ) && sizeof( BF16Vec4 ) == 4 * sizeof( BFloat16 ) );
+
+namespace detail {
+
+// Top three rows of a Transform4, row-major. transform3 maps each xyz triple to rows * ( x, y, z, 1 ); points,
+// vectors and normals differ only in how the rows are filled.
+using Rows3x4 = std::array<float, 12>;
+
+[[nodiscard]] constexpr Rows3x4 point_rows( const Transform4& t )
+{
+  return Rows3x4{ t( 0, 0 ),
+    t( 0, 1 ),
+    t( 0, 2 ),
+    t( 0, 3 ),
+    t( 1, 0 ),
+    t( 1, 1 ),
+    t( 1, 2 ),
+    t( 1, 3 ),
+    t( 2, 0 ),
+    t( 2, 1 ),
+    t( 2, 2 ),
+    t( 2, 3 ) };
+}
+
+[[nodiscard]] constexpr Rows3x4 vector_rows( const Transform4& t )
+{
+  Rows3x4 rows = point_rows( t );
+  rows[3]      = 0.0F;
+  rows[7]      = 0.0F;
+  rows[11]     = 0.0F;
+  return rows;
+}
+
+// transform_normal multiplies the row vector by t, i.e. applies the transposed 3x3 block.
+[[nodiscard]] constexpr Rows3x4 normal_rows( const Transform4& t )
+{
+  return Rows3x4{ t( 0, 0 ),
+    t( 1, 0 ),
+    t( 2, 0 ),
+    0.0F,
+    t( 0, 1 ),
+    t( 1, 1 ),
+    t( 2, 1 ),
+    0.0F,
+    t( 0, 2 ),
+    t( 1, 2 ),
+    t( 2, 2 ),
+    0.0F };
+}
+
+// The rotation matrix of a unit quaternion with zero translation: rotating by one quaternion is a 3x3 transform whose
+// nine products are shared by every vector.
+[[nodiscard]] inline Rows3x4 rotation_rows( Quaternion q )
+{
+  const Mat3 r = q.get_rotation_matrix();
+  return Rows3x4{ r( 0, 0 ), r( 0, 1 ), r( 0, 2 ), 0.0F, r( 1, 0 ), r( 1, 1 ), r( 1, 2 ), 0.0F, r( 2, 0 ), r( 2, 1 ),
+    r( 2, 2 ), 0.0F };
+}
+
+// Number of xyz triples to write before dst + 3 * head is Alignment-byte aligned, as the streaming stores require.
+template<size_t Alignment>
+[[nodiscard]] inline size_t stream_head( const float* dst, size_t count )
+{
+  size_t head = 0;
+  while ( head != count && reinterpret_cast<std::uintptr_t>( dst + 3 * head ) % Alignment != 0 )
+  {
+    ++head;
+  }
+  return head;
+}
+
+struct BatchKernels
+{
+  void ( *multiply_mat4 )( const Mat4* left, const Mat4* right, Mat4* out, size_t count );
+  void ( *multiply_mat4_vec4 )( const Mat4& mat, const Vec4* in, Vec4* out, size_t count );
+  void ( *multiply_mat4_right )( const Mat4* left, const Mat4& right, Mat4* out, size_t count );
+  void ( *transform3 )( const Rows3x4& rows, const float* in, float* out, size_t count, bool stream );
+  void ( *dot3 )( const Vec3* left, const Vec3* right, float* out, size_t count );
+  void ( *dot4 )( const Vec4* left, const Vec4* right, float* out, size_t count );
+  void ( *cross3 )( const Vec3* left, const Vec3* right, Vec3* out, size_t count );
+  void ( *rotate3 )( const Quaternion* quats, const Vec3* in, Vec3* out, size_t count );
+  void ( *normalize3 )( const Vec3* in, Vec3* out, size_t count );
+  void ( *normalize4 )( const Vec4* in, Vec4* out, size_t count );
+  void ( *normalize3_refined )( const Vec3* in, Vec3* out, size_t count );
+  void ( *normalize4_refined )( const Vec4* in, Vec4* out, size_t count );
+  void ( *normalize3_estimate )( const Vec3* in, Vec3* out, size_t count );
+  void ( *normalize4_estimate )( const Vec4* in, Vec4* out, size_t count );
+  void ( *half_to_float )( const std::uint16_t* in, float* out, size_t count );
+  void ( *float_to_half )( const float* in, std::uint16_t* out, size_t count );
+  void ( *bfloat16_to_float )( const std::uint16_t* in, float* out, size_t count );
+  void ( *float_to_bfloat16 )( const float* in, std::uint16_t* out, size_t count );
+  void ( *encode_oct32 )( const Vec3* in, Oct32* out, size_t count );
+  void ( *decode_oct32 )( const Oct32* in, Vec3* out, size_t count );
+  void ( *encode_oct16 )( const Vec3* in, Oct16* out, size_t count );
+  void ( *decode_oct16 )( const Oct16* in, Vec3* out, size_t count );
+  void ( *encode_snorm10x3 )( const Vec3* in, Snorm10x3* out, size_t count );
+  void ( *decode_snorm10x3 )( const Snorm10x3* in, Vec3* out, size_t count );
+};
+
+namespace scalar {
+
+inline void multiply_mat4( const Mat4* left, const Mat4* right, Mat4* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = left[i] * right[i];
+  }
+}
+
+inline void multiply_mat4_vec4( const Mat4& mat, const Vec4* in, Vec4* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = mat * in[i];
+  }
+}
+
+inline void multiply_mat4_right( const Mat4* left, const Mat4& right, Mat4* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = left[i] * right;
+  }
+}
+
+inline void transform3( const Rows3x4& m, const float* in, float* out, size_t count, bool /*stream*/ )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float x = in[3 * i];
+    const float y = in[3 * i + 1];
+    const float z = in[3 * i + 2];
+    out[3 * i]     = ( m[0] * x + m[1] * y ) + ( m[2] * z + m[3] );
+    out[3 * i + 1] = ( m[4] * x + m[5] * y ) + ( m[6] * z + m[7] );
+    out[3 * i + 2] = ( m[8] * x + m[9] * y ) + ( m[10] * z + m[11] );
+  }
+}
+
+inline void dot3( const Vec3* left, const Vec3* right, float* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = dot( left[i], right[i] );
+  }
+}
+
+// ( x x' + z z' ) + ( y y' + w w' ), the pairing the SIMD kernels' horizontal adds produce. dot() may instead use a
+// dot-product instruction whose order depends on the target.
+inline float dot4( const Vec4& a, const Vec4& b )
+{
+  return ( a.x() * b.x() + a.z() * b.z() ) + ( a.y() * b.y() + a.w() * b.w() );
+}
+
+inline void dot4( const Vec4* left, const Vec4* right, float* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = dot4( left[i], right[i] );
+  }
+}
+
+inline void cross3( const Vec3* left, const Vec3* right, Vec3* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = cross( left[i], right[i] );
+  }
+}
+
+// out = v + 2 r x ( r x v + w v ) for the unit quaternion ( r, w ). Equal to transform( v, q ) up to rounding; the
+// SIMD kernels evaluate the same expression, so tails agree with full registers.
+inline void rotate3( const Quaternion* quats, const Vec3* in, Vec3* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const Vec3  r = quats[i].get_vector();
+    const float w = quats[i].w();
+    const Vec3  v = in[i];
+    const Vec3  c{ w * v.x() + ( r.y() * v.z() - r.z() * v.y() ),
+      w * v.y() + ( r.z() * v.x() - r.x() * v.z() ),
+      w * v.z() + ( r.x() * v.y() - r.y() * v.x() ) };
+    out[i] = Vec3{ v.x() + 2.0F * ( r.y() * c.z() - r.z() * c.y() ),
+      v.y() + 2.0F * ( r.z() * c.x() - r.x() * c.z() ),
+      v.z() + 2.0F * ( r.x() * c.y() - r.y() * c.x() ) };
+  }
+}
+
+template<RsqrtPolicy Policy = Exact>
+inline void normalize3( const Vec3* in, Vec3* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = normalized<Policy>( in[i] );
+  }
+}
+
+template<RsqrtPolicy Policy = Exact>
+inline void normalize4( const Vec4* in, Vec4* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      const Vec4& v   = in[i];
+      const float len = std::sqrt( dot4( v, v ) );
+      out[i]          = Vec4{ v.x() / len, v.y() / len, v.z() / len, v.w() / len };
+    } else
+    {
+      out[i] = normalized<Policy>( in[i] );
+    }
+  }
+}
+
+// The 16-bit conversions work on flat scalar arrays; a Vec3 or Vec4 array is 3 or 4 times as many scalars.
+inline void half_to_float( const std::uint16_t* in, float* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = half_bits_to_float( in[i] );
+  }
+}
+
+inline void float_to_half( const float* in, std::uint16_t* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = float_to_half_bits( in[i] );
+  }
+}
+
+inline void bfloat16_to_float( const std::uint16_t* in, float* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = bfloat16_bits_to_float( in[i] );
+  }
+}
+
+inline void float_to_bfloat16( const float* in, std::uint16_t* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = float_to_bfloat16_bits( in[i] );
+  }
+}
+
+template<typename Encoded>
+inline void encode_normals( const Vec3* in, Encoded* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    if constexpr ( std::same_as<Encoded, Oct32> )
+    {
+      out[i] = linalg::encode_oct32( in[i] );
+    } else if constexpr ( std::same_as<Encoded, Oct16> )
+    {
+      out[i] = linalg::encode_oct16( in[i] );
+    } else
+    {
+      out[i] = linalg::encode_snorm10x3( in[i] );
+    }
+  }
+}
+
+template<typename Encoded>
+inline void decode_normals( const Encoded* in, Vec3* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    out[i] = decode( in[i] );
+  }
+}
+
+} // namespace scalar
+
+#ifdef LINALG_DISPATCH_X86
+
+// The SSE4 and AVX2 kernels share one in-lane shuffle sequence: three registers holding four consecutive xyz
+// triples per 128-bit lane are split into x, y and z registers, and merged back the same way.
+namespace sse4 {
+
+LINALG_TARGET_SSE4 inline void deinterleave3( __m128 a, __m128 b, __m128 c, __m128& x, __m128& y, __m128& z )
+{
+  x = _mm_shuffle_ps( a, _mm_shuffle_ps( b, c, _MM_SHUFFLE( 0, 1, 0, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+  y = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 0, 0, 0, 1 ) ),
+    _mm_shuffle_ps( b, c, _MM_SHUFFLE( 0, 2, 0, 3 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+  z = _mm_shuffle_ps( _mm_shuffle_ps( a, b, _MM_SHUFFLE( 0, 1, 0, 2 ) ),
+    _mm_shuffle_ps( c, c, _MM_SHUFFLE( 0, 3, 0, 0 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+}
+
+LINALG_TARGET_SSE4 inline void interleave3( __m128 x, __m128 y, __m128 z, __m128& a, __m128& b, __m128& c )
+{
+  a = _mm_shuffle_ps( _mm_shuffle_ps( x, y, _MM_SHUFFLE( 0, 0, 0, 0 ) ),
+    _mm_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+  b = _mm_shuffle_ps( _mm_shuffle_ps( y, z, _MM_SHUFFLE( 1, 1, 1, 1 ) ),
+    _mm_shuffle_ps( x, y, _MM_SHUFFLE( 2, 2, 2, 2 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+  c = _mm_shuffle_ps( _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 3, 2, 2 ) ),
+    _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 3, 3, 3 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+}
+
+LINALG_TARGET_SSE4 inline void load3( const float* ptr, __m128& x, __m128& y, __m128& z )
+{
+  deinterleave3( _mm_loadu_ps( ptr ), _mm_loadu_ps( ptr + 4 ), _mm_loadu_ps( ptr + 8 ), x, y, z );
+}
+
+// Stream = true bypasses the cache with non-temporal stores; ptr must then be 16-byte aligned.
+template<bool Stream = false>
+LINALG_TARGET_SSE4 inline void store3( float* ptr, __m128 x, __m128 y, __m128 z )
+{
+  __m128 a;
+  __m128 b;
+  __m128 c;
+  interleave3( x, y, z, a, b, c );
+  if constexpr ( Stream )
+  {
+    _mm_stream_ps( ptr, a );
+    _mm_stream_ps( ptr + 4, b );
+    _mm_stream_ps( ptr + 8, c );
+  } else
+  {
+    _mm_storeu_ps( ptr, a );
+    _mm_storeu_ps( ptr + 4, b );
+    _mm_storeu_ps( ptr + 8, c );
+  }
+}
+
+LINALG_TARGET_SSE4 inline __m128 hsum4( __m128 v )
+{
+  v = _mm_add_ps( v, _mm_shuffle_ps( v, v, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+  return _mm_add_ps( v, _mm_shuffle_ps( v, v, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+}
+
+LINALG_TARGET_SSE4 inline void multiply_mat4( const Mat4* left, const Mat4* right, Mat4* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float* a = left[i][0].data();
+    const float* b = right[i][0].data();
+
+    const __m128 a0 = _mm_loadu_ps( a );
+    const __m128 a1 = _mm_loadu_ps( a + 4 );
+    const __m128 a2 = _mm_loadu_ps( a + 8 );
+    const __m128 a3 = _mm_loadu_ps( a + 12 );
+
+    float* o = out[i][0].data();
+    for ( size_t j = 0; j != 4; ++j )
+    {
+      const __m128 bj = _mm_loadu_ps( b + 4 * j );
+      __m128       c  = _mm_mul_ps( a0, _mm_shuffle_ps( bj, bj, 0x00 ) );
+      c               = _mm_add_ps( c, _mm_mul_ps( a1, _mm_shuffle_ps( bj, bj, 0x55 ) ) );
+      c               = _mm_add_ps( c, _mm_mul_ps( a2, _mm_shuffle_ps( bj, bj, 0xAA ) ) );
+      _mm_storeu_ps( o + 4 * j, _mm_add_ps( c, _mm_mul_ps( a3, _mm_shuffle_ps( bj, bj, 0xFF ) ) ) );
+    }
+  }
+}
+
+LINALG_TARGET_SSE4 inline void multiply_mat4_vec4( const Mat4& mat, const Vec4* in, Vec4* out, size_t count )
+{
+  const __m128 c0 = _mm_loadu_ps( mat[0].data() );
+  const __m128 c1 = _mm_loadu_ps( mat[1].data() );
+  const __m128 c2 = _mm_loadu_ps( mat[2].data() );
+  const __m128 c3 = _mm_loadu_ps( mat[3].data() );
+
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const __m128 v = _mm_loadu_ps( src + 4 * i );
+    __m128       r = _mm_mul_ps( c0, _mm_shuffle_ps( v, v, 0x00 ) );
+    r              = _mm_add_ps( r, _mm_mul_ps( c1, _mm_shuffle_ps( v, v, 0x55 ) ) );
+    r              = _mm_add_ps( r, _mm_mul_ps( c2, _mm_shuffle_ps( v, v, 0xAA ) ) );
+    _mm_storeu_ps( dst + 4 * i, _mm_add_ps( r, _mm_mul_ps( c3, _mm_shuffle_ps( v, v, 0xFF ) ) ) );
+  }
+}
+
+// Column j of left[i] * right is the combination of left[i]'s columns weighted by column j of right, so the 16
+// weights are splatted once for the whole batch.
+LINALG_TARGET_SSE4 inline void multiply_mat4_right( const Mat4* left, const Mat4& right, Mat4* out, size_t count )
+{
+  __m128 w[16];
+  for ( size_t j = 0; j != 4; ++j )
+  {
+    for ( size_t k = 0; k != 4; ++k )
+    {
+      w[4 * j + k] = _mm_set1_ps( right[j][k] );
+    }
+  }
+
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float* a  = left[i][0].data();
+    const __m128 a0 = _mm_loadu_ps( a );
+    const __m128 a1 = _mm_loadu_ps( a + 4 );
+    const __m128 a2 = _mm_loadu_ps( a + 8 );
+    const __m128 a3 = _mm_loadu_ps( a + 12 );
+
+    float* o = out[i][0].data();
+    for ( size_t j = 0; j != 4; ++j )
+    {
+      __m128 c = _mm_mul_ps( a0, w[4 * j] );
+      c        = _mm_add_ps( c, _mm_mul_ps( a1, w[4 * j + 1] ) );
+      c        = _mm_add_ps( c, _mm_mul_ps( a2, w[4 * j + 2] ) );
+      _mm_storeu_ps( o + 4 * j, _mm_add_ps( c, _mm_mul_ps( a3, w[4 * j + 3] ) ) );
+    }
+  }
+}
+
+struct BroadcastRows
+{
+  __m128 m[12];
+};
+
+LINALG_TARGET_SSE4 inline BroadcastRows broadcast_rows( const Rows3x4& rows )
+{
+  BroadcastRows result;
+  for ( size_t k = 0; k != 12; ++k )
+  {
+    result.m[k] = _mm_set1_ps( rows[k] );
+  }
+  return result;
+}
+
+// Four xyz triples.
+template<bool Stream>
+LINALG_TARGET_SSE4 inline void transform3_block( const BroadcastRows& r, const float* src, float* dst )
+{
+  __m128 x;
+  __m128 y;
+  __m128 z;
+  load3( src, x, y, z );
+
+  const auto&  m  = r.m;
+  const __m128 rx = _mm_add_ps(
+    _mm_add_ps( _mm_mul_ps( m[0], x ), _mm_mul_ps( m[1], y ) ), _mm_add_ps( _mm_mul_ps( m[2], z ), m[3] ) );
+  const __m128 ry = _mm_add_ps(
+    _mm_add_ps( _mm_mul_ps( m[4], x ), _mm_mul_ps( m[5], y ) ), _mm_add_ps( _mm_mul_ps( m[6], z ), m[7] ) );
+  const __m128 rz = _mm_add_ps(
+    _mm_add_ps( _mm_mul_ps( m[8], x ), _mm_mul_ps( m[9], y ) ), _mm_add_ps( _mm_mul_ps( m[10], z ), m[11] ) );
+
+  store3<Stream>( dst, rx, ry, rz );
+}
+
+LINALG_TARGET_SSE4 inline void transform3( const Rows3x4& m, const float* in, float* out, size_t count, bool stream )
+{
+  const BroadcastRows rows = broadcast_rows( m );
+
+  size_t i = 0;
+  if ( stream )
+  {
+    i = stream_head<16>( out, count );
+    scalar::transform3( m, in, out, i, false );
+    for ( ; i + 4 <= count; i += 4 )
+    {
+      transform3_block<true>( rows, in + 3 * i, out + 3 * i );
+    }
+    _mm_sfence();
+  }
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    transform3_block<false>( rows, in + 3 * i, out + 3 * i );
+  }
+  scalar::transform3( m, in + 3 * i, out + 3 * i, count - i, false );
+}
+
+LINALG_TARGET_SSE4 inline void dot3( const Vec3* left, const Vec3* right, float* out, size_t count )
+{
+  const auto* a = reinterpret_cast<const float*>( left );
+  const auto* b = reinterpret_cast<const float*>( right );
+
+  size_t i = 0;
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    __m128 ax;
+    __m128 ay;
+    __m128 az;
+    __m128 bx;
+    __m128 by;
+    __m128 bz;
+    load3( a + 3 * i, ax, ay, az );
+    load3( b + 3 * i, bx, by, bz );
+    _mm_storeu_ps(
+      out + i, _mm_add_ps( _mm_add_ps( _mm_mul_ps( ax, bx ), _mm_mul_ps( ay, by ) ), _mm_mul_ps( az, bz ) ) );
+  }
+  scalar::dot3( left + i, right + i, out + i, count - i );
+}
+
+LINALG_TARGET_SSE4 inline void dot4( const Vec4* left, const Vec4* right, float* out, size_t count )
+{
+  const auto* a = reinterpret_cast<const float*>( left );
+  const auto* b = reinterpret_cast<const float*>( right );
+
+  size_t i = 0;
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    __m128 p0 = _mm_mul_ps( _mm_loadu_ps( a + 4 * i ), _mm_loadu_ps( b + 4 * i ) );
+    __m128 p1 = _mm_mul_ps( _mm_loadu_ps( a + 4 * i + 4 ), _mm_loadu_ps( b + 4 * i + 4 ) );
+    __m128 p2 = _mm_mul_ps( _mm_loadu_ps( a + 4 * i + 8 ), _mm_loadu_ps( b + 4 * i + 8 ) );
+    __m128 p3 = _mm_mul_ps( _mm_loadu_ps( a + 4 * i + 12 ), _mm_loadu_ps( b + 4 * i + 12 ) );
+    _MM_TRANSPOSE4_PS( p0, p1, p2, p3 );
+    _mm_storeu_ps( out + i, _mm_add_ps( _mm_add_ps( p0, p2 ), _mm_add_ps( p1, p3 ) ) );
+  }
+  scalar::dot4( left + i, right + i, out + i, count - i );
+}
+
+LINALG_TARGET_SSE4 inline void cross3( const Vec3* left, const Vec3* right, Vec3* out, size_t count )
+{
+  const auto* a   = reinterpret_cast<const float*>( left );
+  const auto* b   = reinterpret_cast<const float*>( right );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    __m128 ax;
+    __m128 ay;
+    __m128 az;
+    __m128 bx;
+    __m128 by;
+    __m128 bz;
+    load3( a + 3 * i, ax, ay, az );
+    load3( b + 3 * i, bx, by, bz );
+    store3( dst + 3 * i,
+      _mm_sub_ps( _mm_mul_ps( ay, bz ), _mm_mul_ps( az, by ) ),
+      _mm_sub_ps( _mm_mul_ps( az, bx ), _mm_mul_ps( ax, bz ) ),
+      _mm_sub_ps( _mm_mul_ps( ax, by ), _mm_mul_ps( ay, bx ) ) );
+  }
+  scalar::cross3( left + i, right + i, out + i, count - i );
+}
+
+// Rotates the vectors ( x, y, z ) by the quaternions ( qx, qy, qz, qw ) as scalar::rotate3 does.
+LINALG_TARGET_SSE4 inline void rotate(
+  __m128 qx, __m128 qy, __m128 qz, __m128 qw, __m128& x, __m128& y, __m128& z )
+{
+  const __m128 cx  = _mm_add_ps( _mm_mul_ps( qw, x ), _mm_sub_ps( _mm_mul_ps( qy, z ), _mm_mul_ps( qz, y ) ) );
+  const __m128 cy  = _mm_add_ps( _mm_mul_ps( qw, y ), _mm_sub_ps( _mm_mul_ps( qz, x ), _mm_mul_ps( qx, z ) ) );
+  const __m128 cz  = _mm_add_ps( _mm_mul_ps( qw, z ), _mm_sub_ps( _mm_mul_ps( qx, y ), _mm_mul_ps( qy, x ) ) );
+  const __m128 two = _mm_set1_ps( 2.0F );
+  x = _mm_add_ps( x, _mm_mul_ps( two, _mm_sub_ps( _mm_mul_ps( qy, cz ), _mm_mul_ps( qz, cy ) ) ) );
+  y = _mm_add_ps( y, _mm_mul_ps( two, _mm_sub_ps( _mm_mul_ps( qz, cx ), _mm_mul_ps( qx, cz ) ) ) );
+  z = _mm_add_ps( z, _mm_mul_ps( two, _mm_sub_ps( _mm_mul_ps( qx, cy ), _mm_mul_ps( qy, cx ) ) ) );
+}
+
+LINALG_TARGET_SSE4 inline void rotate3( const Quaternion* quats, const Vec3* in, Vec3* out, size_t count )
+{
+  const auto* q   = reinterpret_cast<const float*>( quats );
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    __m128 qx = _mm_loadu_ps( q + 4 * i );
+    __m128 qy = _mm_loadu_ps( q + 4 * i + 4 );
+    __m128 qz = _mm_loadu_ps( q + 4 * i + 8 );
+    __m128 qw = _mm_loadu_ps( q + 4 * i + 12 );
+    _MM_TRANSPOSE4_PS( qx, qy, qz, qw );
+    __m128 x;
+    __m128 y;
+    __m128 z;
+    load3( src + 3 * i, x, y, z );
+    rotate( qx, qy, qz, qw, x, y, z );
+    store3( dst + 3 * i, x, y, z );
+  }
+  scalar::rotate3( quats + i, in + i, out + i, count - i );
+}
+
+// 1 / sqrt( sq ) for the Refined and Estimate policies; Exact kernels divide by the square root instead.
+template<RsqrtPolicy Policy>
+LINALG_TARGET_SSE4 inline __m128 rsqrt( __m128 sq )
+{
+  const __m128 estimate = _mm_rsqrt_ps( sq );
+  if constexpr ( std::same_as<Policy, Estimate> )
+  {
+    return estimate;
+  }
+  const __m128 half_sq_ee = _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 0.5F ), sq ), _mm_mul_ps( estimate, estimate ) );
+  return _mm_mul_ps( estimate, _mm_sub_ps( _mm_set1_ps( 1.5F ), half_sq_ee ) );
+}
+
+template<RsqrtPolicy Policy = Exact>
+LINALG_TARGET_SSE4 inline void normalize3( const Vec3* in, Vec3* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    __m128 x;
+    __m128 y;
+    __m128 z;
+    load3( src + 3 * i, x, y, z );
+    const __m128 sq = _mm_add_ps( _mm_add_ps( _mm_mul_ps( x, x ), _mm_mul_ps( y, y ) ), _mm_mul_ps( z, z ) );
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      const __m128 len = _mm_sqrt_ps( sq );
+      store3( dst + 3 * i, _mm_div_ps( x, len ), _mm_div_ps( y, len ), _mm_div_ps( z, len ) );
+    } else
+    {
+      const __m128 inv = rsqrt<Policy>( sq );
+      store3( dst + 3 * i, _mm_mul_ps( x, inv ), _mm_mul_ps( y, inv ), _mm_mul_ps( z, inv ) );
+    }
+  }
+  scalar::normalize3<Policy>( in + i, out + i, count - i );
+}
+
+template<RsqrtPolicy Policy = Exact>
+LINALG_TARGET_SSE4 inline void normalize4( const Vec4* in, Vec4* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const __m128 v  = _mm_loadu_ps( src + 4 * i );
+    const __m128 sq = hsum4( _mm_mul_ps( v, v ) );
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      _mm_storeu_ps( dst + 4 * i, _mm_div_ps( v, _mm_sqrt_ps( sq ) ) );
+    } else
+    {
+      _mm_storeu_ps( dst + 4 * i, _mm_mul_ps( v, rsqrt<Policy>( sq ) ) );
+    }
+  }
+}
+
+// SSE4.1 has no half conversion instructions (F16C comes with the AVX2 tier), so this tier uses the scalar ones for
+// half and integer arithmetic for bfloat16.
+LINALG_TARGET_SSE4 inline void bfloat16_to_float( const std::uint16_t* in, float* out, size_t count )
+{
+  size_t i = 0;
+  for ( ; i + 4 <= count; i += 4 )
+  {
+    const __m128i bits = _mm_cvtepu16_epi32( _mm_loadl_epi64( reinterpret_cast<const __m128i*>( in + i ) ) );
+    _mm_storeu_ps( out + i, _mm_castsi128_ps( _mm_slli_epi32( bits, 16 ) ) );
+  }
+  scalar::bfloat16_to_float( in + i, out + i, count - i );
+}
+
+// Round to nearest even by adding 0x7fff plus the lowest kept bit, with NaNs truncated and kept quiet instead.
+LINALG_TARGET_SSE4 inline __m128i round_to_bfloat16( __m128 v )
+{
+  const __m128i bits    = _mm_castps_si128( v );
+  const __m128i lsb     = _mm_and_si128( _mm_srli_epi32( bits, 16 ), _mm_set1_epi32( 1 ) );
+  const __m128i rounded = _mm_add_epi32( bits, _mm_add_epi32( lsb, _mm_set1_epi32( 0x7fff ) ) );
+  const __m128i quiet   = _mm_or_si128( bits, _mm_set1_epi32( 0x40'0000 ) );
+  const __m128i nan     = _mm_castps_si128( _mm_cmpunord_ps( v, v ) );
+  return _mm_srli_epi32( _mm_blendv_epi8( rounded, quiet, nan ), 16 );
+}
+
+LINALG_TARGET_SSE4 inline void float_to_bfloat16( const float* in, std::uint16_t* out, size_t count )
+{
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    const __m128i lo = round_to_bfloat16( _mm_loadu_ps( in + i ) );
+    const __m128i hi = round_to_bfloat16( _mm_loadu_ps( in + i + 4 ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out + i ), _mm_packus_epi32( lo, hi ) );
+  }
+  scalar::float_to_bfloat16( in + i, out + i, count - i );
+}
+
+} // namespace sse4
+
+namespace avx2 {
+
+// a * b + c and a * b - c, fused unless LINALG_NO_FMA is defined. Without FMA the kernels of every ISA round each
+// step in the order of the scalar kernels and return the same bits, apart from the rsqrt-based normalize modes.
+LINALG_TARGET_AVX2 inline __m256 madd( __m256 a, __m256 b, __m256 c )
+{
+#ifdef LINALG_NO_FMA
+  return _mm256_add_ps( _mm256_mul_ps( a, b ), c );
+#else
+  return _mm256_fmadd_ps( a, b, c );
+#endif
+}
+
+LINALG_TARGET_AVX2 inline __m256 msub( __m256 a, __m256 b, __m256 c )
+{
+#ifdef LINALG_NO_FMA
+  return _mm256_sub_ps( _mm256_mul_ps( a, b ), c );
+#else
+  return _mm256_fmsub_ps( a, b, c );
+#endif
+}
+
+LINALG_TARGET_AVX2 inline __m256 load_lanes( const float* lo, const float* hi )
+{
+  return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( lo ) ), _mm_loadu_ps( hi ), 1 );
+}
+
+// Eight xyz triples: the low 128-bit lane carries triples 0-3, the high lane triples 4-7.
+LINALG_TARGET_AVX2 inline void load3( const float* ptr, __m256& x, __m256& y, __m256& z )
+{
+  const __m256 a = load_lanes( ptr, ptr + 12 );
+  const __m256 b = load_lanes( ptr + 4, ptr + 16 );
+  const __m256 c = load_lanes( ptr + 8, ptr + 20 );
+
+  x = _mm256_shuffle_ps( a, _mm256_shuffle_ps( b, c, _MM_SHUFFLE( 0, 1, 0, 2 ) ), _MM_SHUFFLE( 2, 0, 3, 0 ) );
+  y = _mm256_shuffle_ps( _mm256_shuffle_ps( a, b, _MM_SHUFFLE( 0, 0, 0, 1 ) ),
+    _mm256_shuffle_ps( b, c, _MM_SHUFFLE( 0, 2, 0, 3 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+  z = _mm256_shuffle_ps( _mm256_shuffle_ps( a, b, _MM_SHUFFLE( 0, 1, 0, 2 ) ),
+    _mm256_shuffle_ps( c, c, _MM_SHUFFLE( 0, 3, 0, 0 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+}
+
+// Stream = true bypasses the cache with non-temporal stores; ptr must then be 16-byte aligned.
+template<bool Stream = false>
+LINALG_TARGET_AVX2 inline void store3( float* ptr, __m256 x, __m256 y, __m256 z )
+{
+  const __m256 a = _mm256_shuffle_ps( _mm256_shuffle_ps( x, y, _MM_SHUFFLE( 0, 0, 0, 0 ) ),
+    _mm256_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+  const __m256 b = _mm256_shuffle_ps( _mm256_shuffle_ps( y, z, _MM_SHUFFLE( 1, 1, 1, 1 ) ),
+    _mm256_shuffle_ps( x, y, _MM_SHUFFLE( 2, 2, 2, 2 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+  const __m256 c = _mm256_shuffle_ps( _mm256_shuffle_ps( z, x, _MM_SHUFFLE( 3, 3, 2, 2 ) ),
+    _mm256_shuffle_ps( y, z, _MM_SHUFFLE( 3, 3, 3, 3 ) ),
+    _MM_SHUFFLE( 2, 0, 2, 0 ) );
+
+  if constexpr ( Stream )
+  {
+    _mm_stream_ps( ptr, _mm256_castps256_ps128( a ) );
+    _mm_stream_ps( ptr + 4, _mm256_castps256_ps128( b ) );
+    _mm_stream_ps( ptr + 8, _mm256_castps256_ps128( c ) );
+    _mm_stream_ps( ptr + 12, _mm256_extractf128_ps( a, 1 ) );
+    _mm_stream_ps( ptr + 16, _mm256_extractf128_ps( b, 1 ) );
+    _mm_stream_ps( ptr + 20, _mm256_extractf128_ps( c, 1 ) );
+  } else
+  {
+    _mm_storeu_ps( ptr, _mm256_castps256_ps128( a ) );
+    _mm_storeu_ps( ptr + 4, _mm256_castps256_ps128( b ) );
+    _mm_storeu_ps( ptr + 8, _mm256_castps256_ps128( c ) );
+    _mm_storeu_ps( ptr + 12, _mm256_extractf128_ps( a, 1 ) );
+    _mm_storeu_ps( ptr + 16, _mm256_extractf128_ps( b, 1 ) );
+    _mm_storeu_ps( ptr + 20, _mm256_extractf128_ps( c, 1 ) );
+  }
+}
+
+// In-lane 4x4 transpose: lane L of r0..r3 holds four Vec4, afterwards r0..r3 hold their x, y, z and w.
+LINALG_TARGET_AVX2 inline void transpose_lanes( __m256& r0, __m256& r1, __m256& r2, __m256& r3 )
+{
+  const __m256 t0 = _mm256_unpacklo_ps( r0, r1 );
+  const __m256 t1 = _mm256_unpacklo_ps( r2, r3 );
+  const __m256 t2 = _mm256_unpackhi_ps( r0, r1 );
+  const __m256 t3 = _mm256_unpackhi_ps( r2, r3 );
+
+  r0 = _mm256_shuffle_ps( t0, t1, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+  r1 = _mm256_shuffle_ps( t0, t1, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+  r2 = _mm256_shuffle_ps( t2, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+  r3 = _mm256_shuffle_ps( t2, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+}
+
+LINALG_TARGET_AVX2 inline void multiply_mat4( const Mat4* left, const Mat4* right, Mat4* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float* a = left[i][0].data();
+    const float* b = right[i][0].data();
+
+    const __m256 a0 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a ) );
+    const __m256 a1 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a + 4 ) );
+    const __m256 a2 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a + 8 ) );
+    const __m256 a3 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a + 12 ) );
+    const __m256 b01 = _mm256_loadu_ps( b );
+    const __m256 b23 = _mm256_loadu_ps( b + 8 );
+
+    __m256 c01 = _mm256_mul_ps( a0, _mm256_permute_ps( b01, 0x00 ) );
+    __m256 c23 = _mm256_mul_ps( a0, _mm256_permute_ps( b23, 0x00 ) );
+    c01        = madd( a1, _mm256_permute_ps( b01, 0x55 ), c01 );
+    c23        = madd( a1, _mm256_permute_ps( b23, 0x55 ), c23 );
+    c01        = madd( a2, _mm256_permute_ps( b01, 0xAA ), c01 );
+    c23        = madd( a2, _mm256_permute_ps( b23, 0xAA ), c23 );
+    c01        = madd( a3, _mm256_permute_ps( b01, 0xFF ), c01 );
+    c23        = madd( a3, _mm256_permute_ps( b23, 0xFF ), c23 );
+
+    float* o = out[i][0].data();
+    _mm256_storeu_ps( o, c01 );
+    _mm256_storeu_ps( o + 8, c23 );
+  }
+}
+
+LINALG_TARGET_AVX2 inline void multiply_mat4_vec4( const Mat4& mat, const Vec4* in, Vec4* out, size_t count )
+{
+  const __m256 c0 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( mat[0].data() ) );
+  const __m256 c1 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( mat[1].data() ) );
+  const __m256 c2 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( mat[2].data() ) );
+  const __m256 c3 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( mat[3].data() ) );
+
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 2 <= count; i += 2 )
+  {
+    const __m256 v = _mm256_loadu_ps( src + 4 * i );
+    __m256       r = _mm256_mul_ps( c0, _mm256_permute_ps( v, 0x00 ) );
+    r              = madd( c1, _mm256_permute_ps( v, 0x55 ), r );
+    r              = madd( c2, _mm256_permute_ps( v, 0xAA ), r );
+    _mm256_storeu_ps( dst + 4 * i, madd( c3, _mm256_permute_ps( v, 0xFF ), r ) );
+  }
+  sse4::multiply_mat4_vec4( mat, in + i, out + i, count - i );
+}
+
+// Two result columns per register: weight register k of pair p holds right( k, 2p ) in the low lane and
+// right( k, 2p + 1 ) in the high lane.
+LINALG_TARGET_AVX2 inline void multiply_mat4_right( const Mat4* left, const Mat4& right, Mat4* out, size_t count )
+{
+  __m256 w01[4];
+  __m256 w23[4];
+  for ( size_t k = 0; k != 4; ++k )
+  {
+    w01[k] = _mm256_setr_m128( _mm_set1_ps( right[0][k] ), _mm_set1_ps( right[1][k] ) );
+    w23[k] = _mm256_setr_m128( _mm_set1_ps( right[2][k] ), _mm_set1_ps( right[3][k] ) );
+  }
+
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float* a  = left[i][0].data();
+    const __m256 a0 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a ) );
+    const __m256 a1 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a + 4 ) );
+    const __m256 a2 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a + 8 ) );
+    const __m256 a3 = _mm256_broadcast_ps( reinterpret_cast<const __m128*>( a + 12 ) );
+
+    __m256 c01 = _mm256_mul_ps( a0, w01[0] );
+    __m256 c23 = _mm256_mul_ps( a0, w23[0] );
+    c01        = madd( a1, w01[1], c01 );
+    c23        = madd( a1, w23[1], c23 );
+    c01        = madd( a2, w01[2], c01 );
+    c23        = madd( a2, w23[2], c23 );
+    c01        = madd( a3, w01[3], c01 );
+    c23        = madd( a3, w23[3], c23 );
+
+    float* o = out[i][0].data();
+    _mm256_storeu_ps( o, c01 );
+    _mm256_storeu_ps( o + 8, c23 );
+  }
+}
+
+struct BroadcastRows
+{
+  __m256 m[12];
+};
+
+LINALG_TARGET_AVX2 inline BroadcastRows broadcast_rows( const Rows3x4& rows )
+{
+  BroadcastRows result;
+  for ( size_t k = 0; k != 12; ++k )
+  {
+    result.m[k] = _mm256_set1_ps( rows[k] );
+  }
+  return result;
+}
+
+// Eight xyz triples.
+template<bool Stream>
+LINALG_TARGET_AVX2 inline void transform3_block( const BroadcastRows& r, const float* src, float* dst )
+{
+  __m256 x;
+  __m256 y;
+  __m256 z;
+  load3( src, x, y, z );
+
+  const auto&  m  = r.m;
+  const __m256 rx = _mm256_add_ps( madd( m[0], x, _mm256_mul_ps( m[1], y ) ), madd( m[2], z, m[3] ) );
+  const __m256 ry = _mm256_add_ps( madd( m[4], x, _mm256_mul_ps( m[5], y ) ), madd( m[6], z, m[7] ) );
+  const __m256 rz = _mm256_add_ps( madd( m[8], x, _mm256_mul_ps( m[9], y ) ), madd( m[10], z, m[11] ) );
+
+  store3<Stream>( dst, rx, ry, rz );
+}
+
+LINALG_TARGET_AVX2 inline void transform3( const Rows3x4& m, const float* in, float* out, size_t count, bool stream )
+{
+  const BroadcastRows rows = broadcast_rows( m );
+
+  size_t i = 0;
+  if ( stream )
+  {
+    i = stream_head<16>( out, count );
+    scalar::transform3( m, in, out, i, false );
+    for ( ; i + 8 <= count; i += 8 )
+    {
+      transform3_block<true>( rows, in + 3 * i, out + 3 * i );
+    }
+    _mm_sfence();
+  }
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    transform3_block<false>( rows, in + 3 * i, out + 3 * i );
+  }
+  sse4::transform3( m, in + 3 * i, out + 3 * i, count - i, false );
+}
+
+LINALG_TARGET_AVX2 inline void dot3( const Vec3* left, const Vec3* right, float* out, size_t count )
+{
+  const auto* a = reinterpret_cast<const float*>( left );
+  const auto* b = reinterpret_cast<const float*>( right );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 ax;
+    __m256 ay;
+    __m256 az;
+    __m256 bx;
+    __m256 by;
+    __m256 bz;
+    load3( a + 3 * i, ax, ay, az );
+    load3( b + 3 * i, bx, by, bz );
+    _mm256_storeu_ps( out + i, madd( az, bz, madd( ay, by, _mm256_mul_ps( ax, bx ) ) ) );
+  }
+  sse4::dot3( left + i, right + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void dot4( const Vec4* left, const Vec4* right, float* out, size_t count )
+{
+  const auto* a = reinterpret_cast<const float*>( left );
+  const auto* b = reinterpret_cast<const float*>( right );
+
+  // After the in-lane transpose the dot products come out as [0 2 4 6 | 1 3 5 7].
+  const __m256i order = _mm256_setr_epi32( 0, 4, 1, 5, 2, 6, 3, 7 );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 p0 = _mm256_mul_ps( _mm256_loadu_ps( a + 4 * i ), _mm256_loadu_ps( b + 4 * i ) );
+    __m256 p1 = _mm256_mul_ps( _mm256_loadu_ps( a + 4 * i + 8 ), _mm256_loadu_ps( b + 4 * i + 8 ) );
+    __m256 p2 = _mm256_mul_ps( _mm256_loadu_ps( a + 4 * i + 16 ), _mm256_loadu_ps( b + 4 * i + 16 ) );
+    __m256 p3 = _mm256_mul_ps( _mm256_loadu_ps( a + 4 * i + 24 ), _mm256_loadu_ps( b + 4 * i + 24 ) );
+    transpose_lanes( p0, p1, p2, p3 );
+    const __m256 sum = _mm256_add_ps( _mm256_add_ps( p0, p2 ), _mm256_add_ps( p1, p3 ) );
+    _mm256_storeu_ps( out + i, _mm256_permutevar8x32_ps( sum, order ) );
+  }
+  sse4::dot4( left + i, right + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void cross3( const Vec3* left, const Vec3* right, Vec3* out, size_t count )
+{
+  const auto* a   = reinterpret_cast<const float*>( left );
+  const auto* b   = reinterpret_cast<const float*>( right );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 ax;
+    __m256 ay;
+    __m256 az;
+    __m256 bx;
+    __m256 by;
+    __m256 bz;
+    load3( a + 3 * i, ax, ay, az );
+    load3( b + 3 * i, bx, by, bz );
+    store3( dst + 3 * i,
+      msub( ay, bz, _mm256_mul_ps( az, by ) ),
+      msub( az, bx, _mm256_mul_ps( ax, bz ) ),
+      msub( ax, by, _mm256_mul_ps( ay, bx ) ) );
+  }
+  sse4::cross3( left + i, right + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void rotate(
+  __m256 qx, __m256 qy, __m256 qz, __m256 qw, __m256& x, __m256& y, __m256& z )
+{
+  const __m256 cx  = madd( qw, x, msub( qy, z, _mm256_mul_ps( qz, y ) ) );
+  const __m256 cy  = madd( qw, y, msub( qz, x, _mm256_mul_ps( qx, z ) ) );
+  const __m256 cz  = madd( qw, z, msub( qx, y, _mm256_mul_ps( qy, x ) ) );
+  const __m256 two = _mm256_set1_ps( 2.0F );
+  x = madd( two, msub( qy, cz, _mm256_mul_ps( qz, cy ) ), x );
+  y = madd( two, msub( qz, cx, _mm256_mul_ps( qx, cz ) ), y );
+  z = madd( two, msub( qx, cy, _mm256_mul_ps( qy, cx ) ), z );
+}
+
+LINALG_TARGET_AVX2 inline void rotate3( const Quaternion* quats, const Vec3* in, Vec3* out, size_t count )
+{
+  const auto* q   = reinterpret_cast<const float*>( quats );
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    // Quaternions 0-3 go to the low lanes and 4-7 to the high ones, the order of load3.
+    const float* pq = q + 4 * i;
+    __m256       qx = load_lanes( pq, pq + 16 );
+    __m256       qy = load_lanes( pq + 4, pq + 20 );
+    __m256       qz = load_lanes( pq + 8, pq + 24 );
+    __m256       qw = load_lanes( pq + 12, pq + 28 );
+    transpose_lanes( qx, qy, qz, qw );
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    load3( src + 3 * i, x, y, z );
+    rotate( qx, qy, qz, qw, x, y, z );
+    store3( dst + 3 * i, x, y, z );
+  }
+  sse4::rotate3( quats + i, in + i, out + i, count - i );
+}
+
+template<RsqrtPolicy Policy>
+LINALG_TARGET_AVX2 inline __m256 rsqrt( __m256 sq )
+{
+  const __m256 estimate = _mm256_rsqrt_ps( sq );
+  if constexpr ( std::same_as<Policy, Estimate> )
+  {
+    return estimate;
+  }
+  const __m256 half_sq = _mm256_mul_ps( _mm256_set1_ps( 0.5F ), sq );
+  return _mm256_mul_ps( estimate,
+    _mm256_sub_ps( _mm256_set1_ps( 1.5F ), _mm256_mul_ps( half_sq, _mm256_mul_ps( estimate, estimate ) ) ) );
+}
+
+template<RsqrtPolicy Policy = Exact>
+LINALG_TARGET_AVX2 inline void normalize3( const Vec3* in, Vec3* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    load3( src + 3 * i, x, y, z );
+    const __m256 sq = madd( z, z, madd( y, y, _mm256_mul_ps( x, x ) ) );
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      const __m256 len = _mm256_sqrt_ps( sq );
+      store3( dst + 3 * i, _mm256_div_ps( x, len ), _mm256_div_ps( y, len ), _mm256_div_ps( z, len ) );
+    } else
+    {
+      const __m256 inv = rsqrt<Policy>( sq );
+      store3( dst + 3 * i, _mm256_mul_ps( x, inv ), _mm256_mul_ps( y, inv ), _mm256_mul_ps( z, inv ) );
+    }
+  }
+  sse4::normalize3<Policy>( in + i, out + i, count - i );
+}
+
+template<RsqrtPolicy Policy = Exact>
+LINALG_TARGET_AVX2 inline void normalize4( const Vec4* in, Vec4* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 2 <= count; i += 2 )
+  {
+    const __m256 v  = _mm256_loadu_ps( src + 4 * i );
+    __m256       sq = _mm256_mul_ps( v, v );
+    sq              = _mm256_add_ps( sq, _mm256_permute_ps( sq, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+    sq              = _mm256_add_ps( sq, _mm256_permute_ps( sq, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      _mm256_storeu_ps( dst + 4 * i, _mm256_div_ps( v, _mm256_sqrt_ps( sq ) ) );
+    } else
+    {
+      _mm256_storeu_ps( dst + 4 * i, _mm256_mul_ps( v, rsqrt<Policy>( sq ) ) );
+    }
+  }
+  sse4::normalize4<Policy>( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void half_to_float( const std::uint16_t* in, float* out, size_t count )
+{
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    _mm256_storeu_ps( out + i, _mm256_cvtph_ps( _mm_loadu_si128( reinterpret_cast<const __m128i*>( in + i ) ) ) );
+  }
+  scalar::half_to_float( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void float_to_half( const float* in, std::uint16_t* out, size_t count )
+{
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    const __m128i half = _mm256_cvtps_ph( _mm256_loadu_ps( in + i ), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out + i ), half );
+  }
+  scalar::float_to_half( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void bfloat16_to_float( const std::uint16_t* in, float* out, size_t count )
+{
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    const __m256i bits = _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( in + i ) ) );
+    _mm256_storeu_ps( out + i, _mm256_castsi256_ps( _mm256_slli_epi32( bits, 16 ) ) );
+  }
+  sse4::bfloat16_to_float( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline __m256i round_to_bfloat16( __m256 v )
+{
+  const __m256i bits    = _mm256_castps_si256( v );
+  const __m256i lsb     = _mm256_and_si256( _mm256_srli_epi32( bits, 16 ), _mm256_set1_epi32( 1 ) );
+  const __m256i rounded = _mm256_add_epi32( bits, _mm256_add_epi32( lsb, _mm256_set1_epi32( 0x7fff ) ) );
+  const __m256i quiet   = _mm256_or_si256( bits, _mm256_set1_epi32( 0x40'0000 ) );
+  const __m256i nan     = _mm256_castps_si256( _mm256_cmp_ps( v, v, _CMP_UNORD_Q ) );
+  return _mm256_srli_epi32( _mm256_blendv_epi8( rounded, quiet, nan ), 16 );
+}
+
+LINALG_TARGET_AVX2 inline void float_to_bfloat16( const float* in, std::uint16_t* out, size_t count )
+{
+  size_t i = 0;
+  for ( ; i + 16 <= count; i += 16 )
+  {
+    const __m256i lo = round_to_bfloat16( _mm256_loadu_ps( in + i ) );
+    const __m256i hi = round_to_bfloat16( _mm256_loadu_ps( in + i + 8 ) );
+    // packus works within 128-bit lanes; the permute restores element order.
+    const __m256i packed = _mm256_permute4x64_epi64( _mm256_packus_epi32( lo, hi ), _MM_SHUFFLE( 3, 1, 2, 0 ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), packed );
+  }
+  sse4::float_to_bfloat16( in + i, out + i, count - i );
+}
+
+// Normal encodings, following normal_encoding.hpp step by step so that the encoded bits match the scalar ones.
+LINALG_TARGET_AVX2 inline __m256 abs_ps( __m256 v )
+{
+  return _mm256_andnot_ps( _mm256_set1_ps( -0.0F ), v );
+}
+
+// copysign( magnitude, sign ) for a non-negative magnitude.
+LINALG_TARGET_AVX2 inline __m256 with_sign_of( __m256 magnitude, __m256 sign )
+{
+  return _mm256_or_ps( magnitude, _mm256_and_ps( sign, _mm256_set1_ps( -0.0F ) ) );
+}
+
+template<int Bits>
+LINALG_TARGET_AVX2 inline __m256i quantize_snorm( __m256 v )
+{
+  const __m256 scale = _mm256_set1_ps( static_cast<float>( ( 1 << ( Bits - 1 ) ) - 1 ) );
+  return _mm256_and_si256( _mm256_cvtps_epi32( _mm256_mul_ps( v, scale ) ), _mm256_set1_epi32( ( 1 << Bits ) - 1 ) );
+}
+
+template<int Bits, int Shift>
+LINALG_TARGET_AVX2 inline __m256 dequantize_snorm( __m256i bits )
+{
+  const __m256  scale = _mm256_set1_ps( static_cast<float>( ( 1 << ( Bits - 1 ) ) - 1 ) );
+  const __m256i value = _mm256_srai_epi32( _mm256_slli_epi32( bits, 32 - Bits - Shift ), 32 - Bits );
+  return _mm256_max_ps( _mm256_div_ps( _mm256_cvtepi32_ps( value ), scale ), _mm256_set1_ps( -1.0F ) );
+}
+
+template<int Bits>
+LINALG_TARGET_AVX2 inline __m256i encode_octahedral( __m256 x, __m256 y, __m256 z )
+{
+  const __m256 one   = _mm256_set1_ps( 1.0F );
+  const __m256 l1    = _mm256_add_ps( _mm256_add_ps( abs_ps( x ), abs_ps( y ) ), abs_ps( z ) );
+  const __m256 u     = _mm256_div_ps( x, l1 );
+  const __m256 v     = _mm256_div_ps( y, l1 );
+  const __m256 lower = _mm256_cmp_ps( z, _mm256_setzero_ps(), _CMP_LT_OQ );
+  const __m256 fu    = _mm256_blendv_ps( u, with_sign_of( _mm256_sub_ps( one, abs_ps( v ) ), u ), lower );
+  const __m256 fv    = _mm256_blendv_ps( v, with_sign_of( _mm256_sub_ps( one, abs_ps( u ) ), v ), lower );
+  return _mm256_or_si256( quantize_snorm<Bits>( fu ), _mm256_slli_epi32( quantize_snorm<Bits>( fv ), Bits ) );
+}
+
+LINALG_TARGET_AVX2 inline void normalize_lanes( __m256& x, __m256& y, __m256& z )
+{
+  const __m256 len = _mm256_sqrt_ps( madd( z, z, madd( y, y, _mm256_mul_ps( x, x ) ) ) );
+  x                = _mm256_div_ps( x, len );
+  y                = _mm256_div_ps( y, len );
+  z                = _mm256_div_ps( z, len );
+}
+
+template<int Bits>
+LINALG_TARGET_AVX2 inline void decode_octahedral( __m256i bits, __m256& x, __m256& y, __m256& z )
+{
+  x              = dequantize_snorm<Bits, 0>( bits );
+  y              = dequantize_snorm<Bits, Bits>( bits );
+  z              = _mm256_sub_ps( _mm256_sub_ps( _mm256_set1_ps( 1.0F ), abs_ps( x ) ), abs_ps( y ) );
+  const __m256 t = _mm256_max_ps( _mm256_xor_ps( z, _mm256_set1_ps( -0.0F ) ), _mm256_setzero_ps() );
+  x              = _mm256_sub_ps( x, with_sign_of( t, x ) );
+  y              = _mm256_sub_ps( y, with_sign_of( t, y ) );
+  normalize_lanes( x, y, z );
+}
+
+LINALG_TARGET_AVX2 inline void encode_oct32( const Vec3* in, Oct32* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    load3( src + 3 * i, x, y, z );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), encode_octahedral<16>( x, y, z ) );
+  }
+  scalar::encode_normals( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void decode_oct32( const Oct32* in, Vec3* out, size_t count )
+{
+  auto* dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    decode_octahedral<16>( _mm256_loadu_si256( reinterpret_cast<const __m256i*>( in + i ) ), x, y, z );
+    store3( dst + 3 * i, x, y, z );
+  }
+  scalar::decode_normals( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void encode_oct16( const Vec3* in, Oct16* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    load3( src + 3 * i, x, y, z );
+    const __m256i bits   = encode_octahedral<8>( x, y, z );
+    const __m128i packed = _mm_packus_epi32( _mm256_castsi256_si128( bits ), _mm256_extracti128_si256( bits, 1 ) );
+    _mm_storeu_si128( reinterpret_cast<__m128i*>( out + i ), packed );
+  }
+  scalar::encode_normals( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void decode_oct16( const Oct16* in, Vec3* out, size_t count )
+{
+  auto* dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    const __m256i bits = _mm256_cvtepu16_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>( in + i ) ) );
+    decode_octahedral<8>( bits, x, y, z );
+    store3( dst + 3 * i, x, y, z );
+  }
+  scalar::decode_normals( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void encode_snorm10x3( const Vec3* in, Snorm10x3* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    __m256 x;
+    __m256 y;
+    __m256 z;
+    load3( src + 3 * i, x, y, z );
+    const __m256i bits = _mm256_or_si256( _mm256_or_si256( quantize_snorm<10>( x ),
+                                            _mm256_slli_epi32( quantize_snorm<10>( y ), 10 ) ),
+      _mm256_slli_epi32( quantize_snorm<10>( z ), 20 ) );
+    _mm256_storeu_si256( reinterpret_cast<__m256i*>( out + i ), bits );
+  }
+  scalar::encode_normals( in + i, out + i, count - i );
+}
+
+LINALG_TARGET_AVX2 inline void decode_snorm10x3( const Snorm10x3* in, Vec3* out, size_t count )
+{
+  auto* dst = reinterpret_cast<float*>( out );
+
+  size_t i = 0;
+  for ( ; i + 8 <= count; i += 8 )
+  {
+    const __m256i bits = _mm256_loadu_si256( reinterpret_cast<const __m256i*>( in + i ) );
+    __m256        x    = dequantize_snorm<10, 0>( bits );
+    __m256        y    = dequantize_snorm<10, 10>( bits );
+    __m256        z    = dequantize_snorm<10, 20>( bits );
+    normalize_lanes( x, y, z );
+    store3( dst + 3 * i, x, y, z );
+  }
+  scalar::decode_normals( in + i, out + i, count - i );
+}
+
+} // namespace avx2
+
+namespace avx512 {
+
+LINALG_TARGET_AVX512 inline __m512 madd( __m512 a, __m512 b, __m512 c )
+{
+#ifdef LINALG_NO_FMA
+  return _mm512_add_ps( _mm512_mul_ps( a, b ), c );
+#else
+  return _mm512_fmadd_ps( a, b, c );
+#endif
+}
+
+LINALG_TARGET_AVX512 inline __m512 msub( __m512 a, __m512 b, __m512 c )
+{
+#ifdef LINALG_NO_FMA
+  return _mm512_sub_ps( _mm512_mul_ps( a, b ), c );
+#else
+  return _mm512_fmsub_ps( a, b, c );
+#endif
+}
+
+// Permutation tables that split 16 xyz triples (48 floats in three registers) into x, y and z registers. Each
+// component needs two two-source permutes: the first draws from v0:v1, the second patches in lanes from v2.
+struct Deinterleave3
+{
+  std::array<int, 16> lo;
+  std::array<int, 16> hi;
+};
+
+constexpr Deinterleave3 make_deinterleave3( int component )
+{
+  Deinterleave3 table{};
+  for ( int i = 0; i != 16; ++i )
+  {
+    const int p                        = 3 * i + component;
+    table.lo[static_cast<size_t>( i )] = p < 32 ? p : 0;
+    table.hi[static_cast<size_t>( i )] = p < 32 ? i : 16 + p - 32;
+  }
+  return table;
+}
+
+// The inverse: output register `block` first takes x and y lanes, then z lanes.
+constexpr Deinterleave3 make_interleave3( int block )
+{
+  Deinterleave3 table{};
+  for ( int q = 0; q != 16; ++q )
+  {
+    const int p                        = 16 * block + q;
+    const int i                        = p / 3;
+    const int c                        = p % 3;
+    table.lo[static_cast<size_t>( q )] = c == 0 ? i : c == 1 ? 16 + i : 0;
+    table.hi[static_cast<size_t>( q )] = c == 2 ? 16 + i : q;
+  }
+  return table;
+}
+
+inline constexpr std::array<Deinterleave3, 3> deinterleave3_tables{ make_deinterleave3( 0 ),
+  make_deinterleave3( 1 ),
+  make_deinterleave3( 2 ) };
+
+inline constexpr std::array<Deinterleave3, 3> interleave3_tables{ make_interleave3( 0 ),
+  make_interleave3( 1 ),
+  make_interleave3( 2 ) };
+
+// Load/store masks covering the first `count` elements of a block of 16, where each element spans `Width` floats
+// and the block therefore spans `Width` registers. Full blocks get all-ones masks, so the main loop and the tail
+// share one code path.
+template<size_t Width>
+struct BlockMask
+{
+  std::array<__mmask16, Width> reg;
+  __mmask16                    lanes;
+};
+
+template<size_t Width>
+[[nodiscard]] inline BlockMask<Width> block_mask( size_t count )
+{
+  static_assert( Width <= 4 );
+  const size_t        floats = Width * count;
+  const std::uint64_t bits   = floats >= 64 ? ~std::uint64_t{ 0 } : ( std::uint64_t{ 1 } << floats ) - 1;
+
+  BlockMask<Width> mask{};
+  for ( size_t r = 0; r != Width; ++r )
+  {
+    mask.reg[r] = static_cast<__mmask16>( bits >> ( 16 * r ) );
+  }
+  mask.lanes = static_cast<__mmask16>( count >= 16 ? 0xFFFF : ( 1U << count ) - 1 );
+  return mask;
+}
+
+LINALG_TARGET_AVX512 inline __m512 permute2( __m512 a, const std::array<int, 16>& index, __m512 b )
+{
+  return _mm512_permutex2var_ps( a, _mm512_loadu_si512( index.data() ), b );
+}
+
+LINALG_TARGET_AVX512 inline void load3( const float* ptr, const BlockMask<3>& mask, __m512& x, __m512& y, __m512& z )
+{
+  const __m512 v0 = _mm512_maskz_loadu_ps( mask.reg[0], ptr );
+  const __m512 v1 = _mm512_maskz_loadu_ps( mask.reg[1], ptr + 16 );
+  const __m512 v2 = _mm512_maskz_loadu_ps( mask.reg[2], ptr + 32 );
+
+  x = permute2( permute2( v0, deinterleave3_tables[0].lo, v1 ), deinterleave3_tables[0].hi, v2 );
+  y = permute2( permute2( v0, deinterleave3_tables[1].lo, v1 ), deinterleave3_tables[1].hi, v2 );
+  z = permute2( permute2( v0, deinterleave3_tables[2].lo, v1 ), deinterleave3_tables[2].hi, v2 );
+}
+
+LINALG_TARGET_AVX512 inline void store3( float* ptr, const BlockMask<3>& mask, __m512 x, __m512 y, __m512 z )
+{
+  const __m512 v0 = permute2( permute2( x, interleave3_tables[0].lo, y ), interleave3_tables[0].hi, z );
+  const __m512 v1 = permute2( permute2( x, interleave3_tables[1].lo, y ), interleave3_tables[1].hi, z );
+  const __m512 v2 = permute2( permute2( x, interleave3_tables[2].lo, y ), interleave3_tables[2].hi, z );
+
+  _mm512_mask_storeu_ps( ptr, mask.reg[0], v0 );
+  _mm512_mask_storeu_ps( ptr + 16, mask.reg[1], v1 );
+  _mm512_mask_storeu_ps( ptr + 32, mask.reg[2], v2 );
+}
+
+LINALG_TARGET_AVX512 inline void transpose_lanes( __m512& r0, __m512& r1, __m512& r2, __m512& r3 )
+{
+  const __m512 t0 = _mm512_unpacklo_ps( r0, r1 );
+  const __m512 t1 = _mm512_unpacklo_ps( r2, r3 );
+  const __m512 t2 = _mm512_unpackhi_ps( r0, r1 );
+  const __m512 t3 = _mm512_unpackhi_ps( r2, r3 );
+
+  r0 = _mm512_shuffle_ps( t0, t1, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+  r1 = _mm512_shuffle_ps( t0, t1, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+  r2 = _mm512_shuffle_ps( t2, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+  r3 = _mm512_shuffle_ps( t2, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+}
+
+// Four Vec4 per register: each 128-bit lane is multiplied by the 4x4 matrix whose columns are c0..c3.
+LINALG_TARGET_AVX512 inline __m512 combine_columns( __m512 c0, __m512 c1, __m512 c2, __m512 c3, __m512 v )
+{
+  __m512 r = _mm512_mul_ps( c0, _mm512_permute_ps( v, 0x00 ) );
+  r        = madd( c1, _mm512_permute_ps( v, 0x55 ), r );
+  r        = madd( c2, _mm512_permute_ps( v, 0xAA ), r );
+  return madd( c3, _mm512_permute_ps( v, 0xFF ), r );
+}
+
+LINALG_TARGET_AVX512 inline void multiply_mat4( const Mat4* left, const Mat4* right, Mat4* out, size_t count )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float* a = left[i][0].data();
+
+    const __m512 a0 = _mm512_broadcast_f32x4( _mm_loadu_ps( a ) );
+    const __m512 a1 = _mm512_broadcast_f32x4( _mm_loadu_ps( a + 4 ) );
+    const __m512 a2 = _mm512_broadcast_f32x4( _mm_loadu_ps( a + 8 ) );
+    const __m512 a3 = _mm512_broadcast_f32x4( _mm_loadu_ps( a + 12 ) );
+    _mm512_storeu_ps( out[i][0].data(), combine_columns( a0, a1, a2, a3, _mm512_loadu_ps( right[i][0].data() ) ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void multiply_mat4_vec4( const Mat4& mat, const Vec4* in, Vec4* out, size_t count )
+{
+  const __m512 c0 = _mm512_broadcast_f32x4( _mm_loadu_ps( mat[0].data() ) );
+  const __m512 c1 = _mm512_broadcast_f32x4( _mm_loadu_ps( mat[1].data() ) );
+  const __m512 c2 = _mm512_broadcast_f32x4( _mm_loadu_ps( mat[2].data() ) );
+  const __m512 c3 = _mm512_broadcast_f32x4( _mm_loadu_ps( mat[3].data() ) );
+
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i < count; i += 4 )
+  {
+    const __mmask16 mask = block_mask<1>( 4 * ( count - i ) ).reg[0];
+    const __m512    v    = _mm512_maskz_loadu_ps( mask, src + 4 * i );
+    _mm512_mask_storeu_ps( dst + 4 * i, mask, combine_columns( c0, c1, c2, c3, v ) );
+  }
+}
+
+// The whole result in one register: 128-bit lane j of weight register k holds right( k, j ).
+LINALG_TARGET_AVX512 inline void multiply_mat4_right( const Mat4* left, const Mat4& right, Mat4* out, size_t count )
+{
+  __m512 w[4];
+  for ( size_t k = 0; k != 4; ++k )
+  {
+    std::array<float, 16> lanes{};
+    for ( size_t j = 0; j != 16; ++j )
+    {
+      lanes[j] = right[j / 4][k];
+    }
+    w[k] = _mm512_loadu_ps( lanes.data() );
+  }
+
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float* a  = left[i][0].data();
+    const __m512 a0 = _mm512_broadcast_f32x4( _mm_loadu_ps( a ) );
+    const __m512 a1 = _mm512_broadcast_f32x4( _mm_loadu_ps( a + 4 ) );
+    const __m512 a2 = _mm512_broadcast_f32x4( _mm_loadu_ps( a + 8 ) );
+    const __m512 a3 = _mm512_broadcast_f32x4( _mm_loadu_ps( a + 12 ) );
+
+    __m512 c = _mm512_mul_ps( a0, w[0] );
+    c        = madd( a1, w[1], c );
+    c        = madd( a2, w[2], c );
+    _mm512_storeu_ps( out[i][0].data(), madd( a3, w[3], c ) );
+  }
+}
+
+struct BroadcastRows
+{
+  __m512 m[12];
+};
+
+LINALG_TARGET_AVX512 inline BroadcastRows broadcast_rows( const Rows3x4& rows )
+{
+  BroadcastRows result;
+  for ( size_t k = 0; k != 12; ++k )
+  {
+    result.m[k] = _mm512_set1_ps( rows[k] );
+  }
+  return result;
+}
+
+// Up to 16 xyz triples. Streaming blocks must be full and 64-byte aligned; other blocks use masked stores.
+template<bool Stream>
+LINALG_TARGET_AVX512 inline void transform3_block( const BroadcastRows& r, const float* src, float* dst, size_t count )
+{
+  const auto mask = block_mask<3>( count );
+  __m512     x;
+  __m512     y;
+  __m512     z;
+  load3( src, mask, x, y, z );
+
+  const auto&  m  = r.m;
+  const __m512 rx = _mm512_add_ps( madd( m[0], x, _mm512_mul_ps( m[1], y ) ), madd( m[2], z, m[3] ) );
+  const __m512 ry = _mm512_add_ps( madd( m[4], x, _mm512_mul_ps( m[5], y ) ), madd( m[6], z, m[7] ) );
+  const __m512 rz = _mm512_add_ps( madd( m[8], x, _mm512_mul_ps( m[9], y ) ), madd( m[10], z, m[11] ) );
+
+  if constexpr ( Stream )
+  {
+    _mm512_stream_ps( dst, permute2( permute2( rx, interleave3_tables[0].lo, ry ), interleave3_tables[0].hi, rz ) );
+    _mm512_stream_ps(
+      dst + 16, permute2( permute2( rx, interleave3_tables[1].lo, ry ), interleave3_tables[1].hi, rz ) );
+    _mm512_stream_ps(
+      dst + 32, permute2( permute2( rx, interleave3_tables[2].lo, ry ), interleave3_tables[2].hi, rz ) );
+  } else
+  {
+    store3( dst, mask, rx, ry, rz );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void transform3( const Rows3x4& m, const float* in, float* out, size_t count, bool stream )
+{
+  const BroadcastRows rows = broadcast_rows( m );
+
+  size_t i = 0;
+  if ( stream )
+  {
+    i = stream_head<64>( out, count );
+    if ( i != 0 )
+    {
+      transform3_block<false>( rows, in, out, i );
+    }
+    for ( ; i + 16 <= count; i += 16 )
+    {
+      transform3_block<true>( rows, in + 3 * i, out + 3 * i, 16 );
+    }
+    _mm_sfence();
+  }
+  for ( ; i < count; i += 16 )
+  {
+    transform3_block<false>( rows, in + 3 * i, out + 3 * i, std::min<size_t>( 16, count - i ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void dot3( const Vec3* left, const Vec3* right, float* out, size_t count )
+{
+  const auto* a = reinterpret_cast<const float*>( left );
+  const auto* b = reinterpret_cast<const float*>( right );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     ax;
+    __m512     ay;
+    __m512     az;
+    __m512     bx;
+    __m512     by;
+    __m512     bz;
+    load3( a + 3 * i, mask, ax, ay, az );
+    load3( b + 3 * i, mask, bx, by, bz );
+    _mm512_mask_storeu_ps(
+      out + i, mask.lanes, madd( az, bz, madd( ay, by, _mm512_mul_ps( ax, bx ) ) ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void dot4( const Vec4* left, const Vec4* right, float* out, size_t count )
+{
+  const auto* a = reinterpret_cast<const float*>( left );
+  const auto* b = reinterpret_cast<const float*>( right );
+
+  // After the in-lane transpose the dot products come out as [0 4 8 12 | 1 5 9 13 | ...].
+  const __m512i order = _mm512_setr_epi32( 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15 );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto   mask = block_mask<4>( count - i );
+    const float* pa   = a + 4 * i;
+    const float* pb   = b + 4 * i;
+
+    __m512 p0 = _mm512_mul_ps( _mm512_maskz_loadu_ps( mask.reg[0], pa ), _mm512_maskz_loadu_ps( mask.reg[0], pb ) );
+    __m512 p1 =
+      _mm512_mul_ps( _mm512_maskz_loadu_ps( mask.reg[1], pa + 16 ), _mm512_maskz_loadu_ps( mask.reg[1], pb + 16 ) );
+    __m512 p2 =
+      _mm512_mul_ps( _mm512_maskz_loadu_ps( mask.reg[2], pa + 32 ), _mm512_maskz_loadu_ps( mask.reg[2], pb + 32 ) );
+    __m512 p3 =
+      _mm512_mul_ps( _mm512_maskz_loadu_ps( mask.reg[3], pa + 48 ), _mm512_maskz_loadu_ps( mask.reg[3], pb + 48 ) );
+    transpose_lanes( p0, p1, p2, p3 );
+    const __m512 sum = _mm512_add_ps( _mm512_add_ps( p0, p2 ), _mm512_add_ps( p1, p3 ) );
+    _mm512_mask_storeu_ps( out + i, mask.lanes, _mm512_permutexvar_ps( order, sum ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void cross3( const Vec3* left, const Vec3* right, Vec3* out, size_t count )
+{
+  const auto* a   = reinterpret_cast<const float*>( left );
+  const auto* b   = reinterpret_cast<const float*>( right );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     ax;
+    __m512     ay;
+    __m512     az;
+    __m512     bx;
+    __m512     by;
+    __m512     bz;
+    load3( a + 3 * i, mask, ax, ay, az );
+    load3( b + 3 * i, mask, bx, by, bz );
+    store3( dst + 3 * i,
+      mask,
+      msub( ay, bz, _mm512_mul_ps( az, by ) ),
+      msub( az, bx, _mm512_mul_ps( ax, bz ) ),
+      msub( ax, by, _mm512_mul_ps( ay, bx ) ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void rotate(
+  __m512 qx, __m512 qy, __m512 qz, __m512 qw, __m512& x, __m512& y, __m512& z )
+{
+  const __m512 cx  = madd( qw, x, msub( qy, z, _mm512_mul_ps( qz, y ) ) );
+  const __m512 cy  = madd( qw, y, msub( qz, x, _mm512_mul_ps( qx, z ) ) );
+  const __m512 cz  = madd( qw, z, msub( qx, y, _mm512_mul_ps( qy, x ) ) );
+  const __m512 two = _mm512_set1_ps( 2.0F );
+  x = madd( two, msub( qy, cz, _mm512_mul_ps( qz, cy ) ), x );
+  y = madd( two, msub( qz, cx, _mm512_mul_ps( qx, cz ) ), y );
+  z = madd( two, msub( qx, cy, _mm512_mul_ps( qy, cx ) ), z );
+}
+
+LINALG_TARGET_AVX512 inline void rotate3( const Quaternion* quats, const Vec3* in, Vec3* out, size_t count )
+{
+  const auto* q   = reinterpret_cast<const float*>( quats );
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  // The in-lane transpose leaves the quaternions in the order [0 4 8 12 | 1 5 9 13 | ...]; this restores 0-15.
+  const __m512i order = _mm512_setr_epi32( 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15 );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    // Masked-off quaternions load as zero, which leaves their (also masked-off) vectors unchanged.
+    const auto   quat_mask = block_mask<4>( count - i );
+    const auto   mask      = block_mask<3>( count - i );
+    const float* pq        = q + 4 * i;
+    __m512       qx        = _mm512_maskz_loadu_ps( quat_mask.reg[0], pq );
+    __m512       qy        = _mm512_maskz_loadu_ps( quat_mask.reg[1], pq + 16 );
+    __m512       qz        = _mm512_maskz_loadu_ps( quat_mask.reg[2], pq + 32 );
+    __m512       qw        = _mm512_maskz_loadu_ps( quat_mask.reg[3], pq + 48 );
+    transpose_lanes( qx, qy, qz, qw );
+    __m512 x;
+    __m512 y;
+    __m512 z;
+    load3( src + 3 * i, mask, x, y, z );
+    rotate( _mm512_permutexvar_ps( order, qx ),
+      _mm512_permutexvar_ps( order, qy ),
+      _mm512_permutexvar_ps( order, qz ),
+      _mm512_permutexvar_ps( order, qw ),
+      x,
+      y,
+      z );
+    store3( dst + 3 * i, mask, x, y, z );
+  }
+}
+
+// AVX-512 estimates to 14 bits rather than 12.
+template<RsqrtPolicy Policy>
+LINALG_TARGET_AVX512 inline __m512 rsqrt( __m512 sq )
+{
+  const __m512 estimate = _mm512_rsqrt14_ps( sq );
+  if constexpr ( std::same_as<Policy, Estimate> )
+  {
+    return estimate;
+  }
+  const __m512 half_sq = _mm512_mul_ps( _mm512_set1_ps( 0.5F ), sq );
+  return _mm512_mul_ps( estimate,
+    _mm512_sub_ps( _mm512_set1_ps( 1.5F ), _mm512_mul_ps( half_sq, _mm512_mul_ps( estimate, estimate ) ) ) );
+}
+
+template<RsqrtPolicy Policy = Exact>
+LINALG_TARGET_AVX512 inline void normalize3( const Vec3* in, Vec3* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     x;
+    __m512     y;
+    __m512     z;
+    load3( src + 3 * i, mask, x, y, z );
+    const __m512 sq = madd( z, z, madd( y, y, _mm512_mul_ps( x, x ) ) );
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      const __m512 len = _mm512_sqrt_ps( sq );
+      store3( dst + 3 * i, mask, _mm512_div_ps( x, len ), _mm512_div_ps( y, len ), _mm512_div_ps( z, len ) );
+    } else
+    {
+      const __m512 inv = rsqrt<Policy>( sq );
+      store3( dst + 3 * i, mask, _mm512_mul_ps( x, inv ), _mm512_mul_ps( y, inv ), _mm512_mul_ps( z, inv ) );
+    }
+  }
+}
+
+template<RsqrtPolicy Policy = Exact>
+LINALG_TARGET_AVX512 inline void normalize4( const Vec4* in, Vec4* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+  auto*       dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i < count; i += 4 )
+  {
+    const __mmask16 mask = block_mask<1>( 4 * ( count - i ) ).reg[0];
+    const __m512    v    = _mm512_maskz_loadu_ps( mask, src + 4 * i );
+    __m512          sq   = _mm512_mul_ps( v, v );
+    sq                   = _mm512_add_ps( sq, _mm512_permute_ps( sq, _MM_SHUFFLE( 1, 0, 3, 2 ) ) );
+    sq                   = _mm512_add_ps( sq, _mm512_permute_ps( sq, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      _mm512_mask_storeu_ps( dst + 4 * i, mask, _mm512_div_ps( v, _mm512_sqrt_ps( sq ) ) );
+    } else
+    {
+      _mm512_mask_storeu_ps( dst + 4 * i, mask, _mm512_mul_ps( v, rsqrt<Policy>( sq ) ) );
+    }
+  }
+}
+
+LINALG_TARGET_AVX512 inline void half_to_float( const std::uint16_t* in, float* out, size_t count )
+{
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const __mmask16 mask = block_mask<1>( count - i ).lanes;
+    const __m256i   half = _mm256_maskz_loadu_epi16( mask, in + i );
+    _mm512_mask_storeu_ps( out + i, mask, _mm512_cvtph_ps( half ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void float_to_half( const float* in, std::uint16_t* out, size_t count )
+{
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const __mmask16 mask = block_mask<1>( count - i ).lanes;
+    const __m512    v    = _mm512_maskz_loadu_ps( mask, in + i );
+    _mm256_mask_storeu_epi16( out + i, mask, _mm512_cvtps_ph( v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void bfloat16_to_float( const std::uint16_t* in, float* out, size_t count )
+{
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const __mmask16 mask = block_mask<1>( count - i ).lanes;
+    const __m512i   bits = _mm512_cvtepu16_epi32( _mm256_maskz_loadu_epi16( mask, in + i ) );
+    _mm512_mask_storeu_ps( out + i, mask, _mm512_castsi512_ps( _mm512_slli_epi32( bits, 16 ) ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void float_to_bfloat16( const float* in, std::uint16_t* out, size_t count )
+{
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const __mmask16 mask    = block_mask<1>( count - i ).lanes;
+    const __m512    v       = _mm512_maskz_loadu_ps( mask, in + i );
+    const __m512i   bits    = _mm512_castps_si512( v );
+    const __m512i   lsb     = _mm512_and_si512( _mm512_srli_epi32( bits, 16 ), _mm512_set1_epi32( 1 ) );
+    const __m512i   rounded = _mm512_add_epi32( bits, _mm512_add_epi32( lsb, _mm512_set1_epi32( 0x7fff ) ) );
+    const __m512i   quiet   = _mm512_or_si512( bits, _mm512_set1_epi32( 0x40'0000 ) );
+    const __m512i   result  = _mm512_mask_blend_epi32( _mm512_cmp_ps_mask( v, v, _CMP_UNORD_Q ), rounded, quiet );
+    _mm256_mask_storeu_epi16( out + i, mask, _mm512_cvtepi32_epi16( _mm512_srli_epi32( result, 16 ) ) );
+  }
+}
+
+// Normal encodings; see the AVX2 versions.
+LINALG_TARGET_AVX512 inline __m512 with_sign_of( __m512 magnitude, __m512 sign )
+{
+  return _mm512_or_ps( magnitude, _mm512_and_ps( sign, _mm512_set1_ps( -0.0F ) ) );
+}
+
+template<int Bits>
+LINALG_TARGET_AVX512 inline __m512i quantize_snorm( __m512 v )
+{
+  const __m512 scale = _mm512_set1_ps( static_cast<float>( ( 1 << ( Bits - 1 ) ) - 1 ) );
+  return _mm512_and_si512( _mm512_cvtps_epi32( _mm512_mul_ps( v, scale ) ), _mm512_set1_epi32( ( 1 << Bits ) - 1 ) );
+}
+
+template<int Bits, int Shift>
+LINALG_TARGET_AVX512 inline __m512 dequantize_snorm( __m512i bits )
+{
+  const __m512  scale = _mm512_set1_ps( static_cast<float>( ( 1 << ( Bits - 1 ) ) - 1 ) );
+  const __m512i value = _mm512_srai_epi32( _mm512_slli_epi32( bits, 32 - Bits - Shift ), 32 - Bits );
+  return _mm512_max_ps( _mm512_div_ps( _mm512_cvtepi32_ps( value ), scale ), _mm512_set1_ps( -1.0F ) );
+}
+
+template<int Bits>
+LINALG_TARGET_AVX512 inline __m512i encode_octahedral( __m512 x, __m512 y, __m512 z )
+{
+  const __m512    one   = _mm512_set1_ps( 1.0F );
+  const __m512    l1    = _mm512_add_ps( _mm512_add_ps( _mm512_abs_ps( x ), _mm512_abs_ps( y ) ), _mm512_abs_ps( z ) );
+  const __m512    u     = _mm512_div_ps( x, l1 );
+  const __m512    v     = _mm512_div_ps( y, l1 );
+  const __m512    fu    = with_sign_of( _mm512_sub_ps( one, _mm512_abs_ps( v ) ), u );
+  const __m512    fv    = with_sign_of( _mm512_sub_ps( one, _mm512_abs_ps( u ) ), v );
+  const __mmask16 lower = _mm512_cmp_ps_mask( z, _mm512_setzero_ps(), _CMP_LT_OQ );
+  return _mm512_or_si512( quantize_snorm<Bits>( _mm512_mask_blend_ps( lower, u, fu ) ),
+    _mm512_slli_epi32( quantize_snorm<Bits>( _mm512_mask_blend_ps( lower, v, fv ) ), Bits ) );
+}
+
+LINALG_TARGET_AVX512 inline void normalize_lanes( __m512& x, __m512& y, __m512& z )
+{
+  const __m512 len = _mm512_sqrt_ps( madd( z, z, madd( y, y, _mm512_mul_ps( x, x ) ) ) );
+  x                = _mm512_div_ps( x, len );
+  y                = _mm512_div_ps( y, len );
+  z                = _mm512_div_ps( z, len );
+}
+
+template<int Bits>
+LINALG_TARGET_AVX512 inline void decode_octahedral( __m512i bits, __m512& x, __m512& y, __m512& z )
+{
+  x              = dequantize_snorm<Bits, 0>( bits );
+  y              = dequantize_snorm<Bits, Bits>( bits );
+  z              = _mm512_sub_ps( _mm512_sub_ps( _mm512_set1_ps( 1.0F ), _mm512_abs_ps( x ) ), _mm512_abs_ps( y ) );
+  const __m512 t = _mm512_max_ps( _mm512_xor_ps( z, _mm512_set1_ps( -0.0F ) ), _mm512_setzero_ps() );
+  x              = _mm512_sub_ps( x, with_sign_of( t, x ) );
+  y              = _mm512_sub_ps( y, with_sign_of( t, y ) );
+  normalize_lanes( x, y, z );
+}
+
+LINALG_TARGET_AVX512 inline void encode_oct32( const Vec3* in, Oct32* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     x;
+    __m512     y;
+    __m512     z;
+    load3( src + 3 * i, mask, x, y, z );
+    _mm512_mask_storeu_epi32( out + i, mask.lanes, encode_octahedral<16>( x, y, z ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void decode_oct32( const Oct32* in, Vec3* out, size_t count )
+{
+  auto* dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     x;
+    __m512     y;
+    __m512     z;
+    decode_octahedral<16>( _mm512_maskz_loadu_epi32( mask.lanes, in + i ), x, y, z );
+    store3( dst + 3 * i, mask, x, y, z );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void encode_oct16( const Vec3* in, Oct16* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     x;
+    __m512     y;
+    __m512     z;
+    load3( src + 3 * i, mask, x, y, z );
+    _mm256_mask_storeu_epi16( out + i, mask.lanes, _mm512_cvtepi32_epi16( encode_octahedral<8>( x, y, z ) ) );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void decode_oct16( const Oct16* in, Vec3* out, size_t count )
+{
+  auto* dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     x;
+    __m512     y;
+    __m512     z;
+    decode_octahedral<8>( _mm512_cvtepu16_epi32( _mm256_maskz_loadu_epi16( mask.lanes, in + i ) ), x, y, z );
+    store3( dst + 3 * i, mask, x, y, z );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void encode_snorm10x3( const Vec3* in, Snorm10x3* out, size_t count )
+{
+  const auto* src = reinterpret_cast<const float*>( in );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto mask = block_mask<3>( count - i );
+    __m512     x;
+    __m512     y;
+    __m512     z;
+    load3( src + 3 * i, mask, x, y, z );
+    const __m512i bits = _mm512_or_si512( _mm512_or_si512( quantize_snorm<10>( x ),
+                                            _mm512_slli_epi32( quantize_snorm<10>( y ), 10 ) ),
+      _mm512_slli_epi32( quantize_snorm<10>( z ), 20 ) );
+    _mm512_mask_storeu_epi32( out + i, mask.lanes, bits );
+  }
+}
+
+LINALG_TARGET_AVX512 inline void decode_snorm10x3( const Snorm10x3* in, Vec3* out, size_t count )
+{
+  auto* dst = reinterpret_cast<float*>( out );
+
+  for ( size_t i = 0; i < count; i += 16 )
+  {
+    const auto    mask = block_mask<3>( count - i );
+    const __m512i bits = _mm512_maskz_loadu_epi32( mask.lanes, in + i );
+    __m512        x    = dequantize_snorm<10, 0>( bits );
+    __m512        y    = dequantize_snorm<10, 10>( bits );
+    __m512        z    = dequantize_snorm<10, 20>( bits );
+    normalize_lanes( x, y, z );
+    store3( dst + 3 * i, mask, x, y, z );
+  }
+}
+
+} // namespace avx512
+
+#endif
+
+inline constexpr std::array<BatchKernels, isa_count> batch_kernel_table{
+  BatchKernels{ scalar::multiply_mat4,
+    scalar::multiply_mat4_vec4,
+    scalar::multiply_mat4_right,
+    scalar::transform3,
+    scalar::dot3,
+    scalar::dot4,
+    scalar::cross3,
+    scalar::rotate3,
+    scalar::normalize3,
+    scalar::normalize4,
+    scalar::normalize3<Refined>,
+    scalar::normalize4<Refined>,
+    scalar::normalize3<Estimate>,
+    scalar::normalize4<Estimate>,
+    scalar::half_to_float,
+    scalar::float_to_half,
+    scalar::bfloat16_to_float,
+    scalar::float_to_bfloat16,
+    scalar::encode_normals<Oct32>,
+    scalar::decode_normals<Oct32>,
+    scalar::encode_normals<Oct16>,
+    scalar::decode_normals<Oct16>,
+    scalar::encode_normals<Snorm10x3>,
+    scalar::decode_normals<Snorm10x3> },
+#ifdef LINALG_DISPATCH_X86
+  BatchKernels{ sse4::multiply_mat4,
+    sse4::multiply_mat4_vec4,
+    sse4::multiply_mat4_right,
+    sse4::transform3,
+    sse4::dot3,
+    sse4::dot4,
+    sse4::cross3,
+    sse4::rotate3,
+    sse4::normalize3,
+    sse4::normalize4,
+    sse4::normalize3<Refined>,
+    sse4::normalize4<Refined>,
+    sse4::normalize3<Estimate>,
+    sse4::normalize4<Estimate>,
+    scalar::half_to_float,
+    scalar::float_to_half,
+    sse4::bfloat16_to_float,
+    sse4::float_to_bfloat16,
+    scalar::encode_normals<Oct32>,
+    scalar::decode_normals<Oct32>,
+    scalar::encode_normals<Oct16>,
+    scalar::decode_normals<Oct16>,
+    scalar::encode_normals<Snorm10x3>,
+    scalar::decode_normals<Snorm10x3> },
+  BatchKernels{ avx2::multiply_mat4,
+    avx2::multiply_mat4_vec4,
+    avx2::multiply_mat4_right,
+    avx2::transform3,
+    avx2::dot3,
+    avx2::dot4,
+    avx2::cross3,
+    avx2::rotate3,
+    avx2::normalize3,
+    avx2::normalize4,
+    avx2::normalize3<Refined>,
+    avx2::normalize4<Refined>,
+    avx2::normalize3<Estimate>,
+    avx2::normalize4<Estimate>,
+    avx2::half_to_float,
+    avx2::float_to_half,
+    avx2::bfloat16_to_float,
+    avx2::float_to_bfloat16,
+    avx2::encode_oct32,
+    avx2::decode_oct32,
+    avx2::encode_oct16,
+    avx2::decode_oct16,
+    avx2::encode_snorm10x3,
+    avx2::decode_snorm10x3 },
+  BatchKernels{ avx512::multiply_mat4,
+    avx512::multiply_mat4_vec4,
+    avx512::multiply_mat4_right,
+    avx512::transform3,
+    avx512::dot3,
+    avx512::dot4,
+    avx512::cross3,
+    avx512::rotate3,
+    avx512::normalize3,
+    avx512::normalize4,
+    avx512::normalize3<Refined>,
+    avx512::normalize4<Refined>,
+    avx512::normalize3<Estimate>,
+    avx512::normalize4<Estimate>,
+    avx512::half_to_float,
+    avx512::float_to_half,
+    avx512::bfloat16_to_float,
+    avx512::float_to_bfloat16,
+    avx512::encode_oct32,
+    avx512::decode_oct32,
+    avx512::encode_oct16,
+    avx512::decode_oct16,
+    avx512::encode_snorm10x3,
+    avx512::decode_snorm10x3 },
+#else
+  BatchKernels{ scalar::multiply_mat4,
+    scalar::multiply_mat4_vec4,
+    scalar::multiply_mat4_right,
+    scalar::transform3,
+    scalar::dot3,
+    scalar::dot4,
+    scalar::cross3,
+    scalar::rotate3,
+    scalar::normalize3,
+    scalar::normalize4,
+    scalar::normalize3<Refined>,
+    scalar::normalize4<Refined>,
+    scalar::normalize3<Estimate>,
+    scalar::normalize4<Estimate>,
+    scalar::half_to_float,
+    scalar::float_to_half,
+    scalar::bfloat16_to_float,
+    scalar::float_to_bfloat16,
+    scalar::encode_normals<Oct32>,
+    scalar::decode_normals<Oct32>,
+    scalar::encode_normals<Oct16>,
+    scalar::decode_normals<Oct16>,
+    scalar::encode_normals<Snorm10x3>,
+    scalar::decode_normals<Snorm10x3> },
+  BatchKernels{ scalar::multiply_mat4,
+    scalar::multiply_mat4_vec4,
+    scalar::multiply_mat4_right,
+    scalar::transform3,
+    scalar::dot3,
+    scalar::dot4,
+    scalar::cross3,
+    scalar::rotate3,
+    scalar::normalize3,
+    scalar::normalize4,
+    scalar::normalize3<Refined>,
+    scalar::normalize4<Refined>,
+    scalar::normalize3<Estimate>,
+    scalar::normalize4<Estimate>,
+    scalar::half_to_float,
+    scalar::float_to_half,
+    scalar::bfloat16_to_float,
+    scalar::float_to_bfloat16,
+    scalar::encode_normals<Oct32>,
+    scalar::decode_normals<Oct32>,
+    scalar::encode_normals<Oct16>,
+    scalar::decode_normals<Oct16>,
+    scalar::encode_normals<Snorm10x3>,
+    scalar::decode_normals<Snorm10x3> },
+  BatchKernels{ scalar::multiply_mat4,
+    scalar::multiply_mat4_vec4,
+    scalar::multiply_mat4_right,
+    scalar::transform3,
+    scalar::dot3,
+    scalar::dot4,
+    scalar::cross3,
+    scalar::rotate3,
+    scalar::normalize3,
+    scalar::normalize4,
+    scalar::normalize3<Refined>,
+    scalar::normalize4<Refined>,
+    scalar::normalize3<Estimate>,
+    scalar::normalize4<Estimate>,
+    scalar::half_to_float,
+    scalar::float_to_half,
+    scalar::bfloat16_to_float,
+    scalar::float_to_bfloat16,
+    scalar::encode_normals<Oct32>,
+    scalar::decode_normals<Oct32>,
+    scalar::encode_normals<Oct16>,
+    scalar::decode_normals<Oct16>,
+    scalar::encode_normals<Snorm10x3>,
+    scalar::decode_normals<Snorm10x3> },
+#endif
+};
+
+[[nodiscard]] inline const BatchKernels& batch_kernels() { return select_kernels( batch_kernel_table ); }
+
+template<typename Storage, size_t N>
+void convert_from_storage( void ( *kernel )( const std::uint16_t*, float*, size_t ),
+  std::span<const Vec<Storage, N>> in,
+  std::span<Vec<float, N>>         out )
+{
+  assert( in.size() == out.size() );
+  kernel( reinterpret_cast<const std::uint16_t*>( in.data() ), reinterpret_cast<float*>( out.data() ), out.size() * N );
+}
+
+template<typename Storage, size_t N>
+void convert_to_storage( void ( *kernel )( const float*, std::uint16_t*, size_t ),
+  std::span<const Vec<float, N>> in,
+  std::span<Vec<Storage, N>>     out )
+{
+  assert( in.size() == out.size() );
+  kernel( reinterpret_cast<const float*>( in.data() ), reinterpret_cast<std::uint16_t*>( out.data() ), out.size() * N );
+}
+
+} // namespace detail
+
+// out[i] = left[i] * right[i]. The output may alias either input.
+inline void multiply(
+  std::span<const Mat4> left, std::span<const Mat4> right, std::span<Mat4> out, Threads threads = {} )
+{
+  assert( left.size() == out.size() && right.size() == out.size() );
+  const auto& kernels = detail::batch_kernels();
+  detail::parallel_for( out.size(), threads, [&]( size_t begin, size_t end ) {
+    kernels.multiply_mat4( left.data() + begin, right.data() + begin, out.data() + begin, end - begin );
+  } );
+}
+
+// out[i] = left * right[i], e.g. one parent applied to many local matrices. The output may alias right.
+inline void multiply( const Mat4& left, std::span<const Mat4> right, std::span<Mat4> out, Threads threads = {} )
+{
+  assert( right.size() == out.size() );
+  // Each column of right[i] is an independent Vec4, so this is the Mat4 * Vec4 kernel over four times as many.
+  const auto& kernels = detail::batch_kernels();
+  const auto* in      = reinterpret_cast<const Vec4*>( right.data() );
+  auto*       dst     = reinterpret_cast<Vec4*>( out.data() );
+  detail::parallel_for( out.size(), threads, [&]( size_t begin, size_t end ) {
+    kernels.multiply_mat4_vec4( left, in + 4 * begin, dst + 4 * begin, 4 * ( end - begin ) );
+  } );
+}
+
+// out[i] = left[i] * right. The output may alias left.
+inline void multiply( std::span<const Mat4> left, const Mat4& right, std::span<Mat4> out, Threads threads = {} )
+{
+  assert( left.size() == out.size() );
+  const auto& kernels = detail::batch_kernels();
+  detail::parallel_for( out.size(), threads, [&]( size_t begin, size_t end ) {
+    kernels.multiply_mat4_right( left.data() + begin, right, out.data() + begin, end - begin );
+  } );
+}
+
+// Transform4 overloads. The product of two affine matrices keeps the ( 0, 0, 0, 1 ) bottom row exactly.
+inline void multiply( std::span<const Transform4> left,
+  std::span<const Transform4>                     right,
+  std::span<Transform4>                           out,
+  Threads                                         threads = {} )
+{
+  multiply( std::span<const Mat4>{ static_cast<const Mat4*>( left.data() ), left.size() },
+    std::span<const Mat4>{ static_cast<const Mat4*>( right.data() ), right.size() },
+    std::span<Mat4>{ static_cast<Mat4*>( out.data() ), out.size() },
+    threads );
+}
+
+inline void multiply(
+  const Transform4& left, std::span<const Transform4> right, std::span<Transform4> out, Threads threads = {} )
+{
+  multiply( static_cast<const Mat4&>( left ),
+    std::span<const Mat4>{ static_cast<const Mat4*>( right.data() ), right.size() },
+    std::span<Mat4>{ static_cast<Mat4*>( out.data() ), out.size() },
+    threads );
+}
+
+inline void multiply(
+  std::span<const Transform4> left, const Transform4& right, std::span<Transform4> out, Threads threads = {} )
+{
+  multiply( std::span<const Mat4>{ static_cast<const Mat4*>( left.data() ), left.size() },
+    static_cast<const Mat4&>( right ),
+    std::span<Mat4>{ static_cast<Mat4*>( out.data() ), out.size() },
+    threads );
+}
+
+// out[i] = mat * in[i]. The output may alias the input.
+inline void multiply( const Mat4& mat, std::span<const Vec4> in, std::span<Vec4> out )
+{
+  assert( in.size() == out.size() );
+  detail::batch_kernels().multiply_mat4_vec4( mat, in.data(), out.data(), out.size() );
+}
+
+// Outputs of at least this many bytes that do not alias their input are written with non-temporal stores, keeping
+// a multi-megabyte result from evicting the working set. Below it the output is likely to be read again soon.
+inline constexpr size_t streaming_store_threshold = size_t{ 8 } << 20;
+
+namespace detail {
+
+inline void transform3( const Rows3x4& rows, std::span<const Vec3> in, std::span<Vec3> out )
+{
+  assert( in.size() == out.size() );
+  const auto* src    = reinterpret_cast<const float*>( in.data() );
+  auto*       dst    = reinterpret_cast<float*>( out.data() );
+  const bool  stream = out.size_bytes() >= streaming_store_threshold && src != dst;
+  batch_kernels().transform3( rows, src, dst, out.size(), stream );
+}
+
+} // namespace detail
+
+// out[i] = t * in[i]. The output may alias the input.
+inline void transform_points( const Transform4& t, std::span<const Point3> in, std::span<Point3> out )
+{
+  assert( in.size() == out.size() );
+  detail::transform3( detail::point_rows( t ),
+    { static_cast<const Vec3*>( in.data() ), in.size() },
+    { static_cast<Vec3*>( out.data() ), out.size() } );
+}
+
+// out[i] = t * in[i], ignoring the translation. The output may alias the input.
+inline void transform_vectors( const Transform4& t, std::span<const Vec3> in, std::span<Vec3> out )
+{
+  detail::transform3( detail::vector_rows( t ), in, out );
+}
+
+// out[i] = transform_normal( in[i], t ); pass the inverse transform, as for transform_normal. The output may alias
+// the input.
+inline void transform_normals( const Transform4& t, std::span<const Vec3> in, std::span<Vec3> out )
+{
+  detail::transform3( detail::normal_rows( t ), in, out );
+}
+
+inline void transform_points( const Affine3x4& a, std::span<const Point3> in, std::span<Point3> out )
+{
+  transform_points( a.to_transform4(), in, out );
+}
+
+inline void transform_vectors( const Affine3x4& a, std::span<const Vec3> in, std::span<Vec3> out )
+{
+  transform_vectors( a.to_transform4(), in, out );
+}
+
+inline void transform_normals( const Affine3x4& a, std::span<const Vec3> in, std::span<Vec3> out )
+{
+  transform_normals( a.to_transform4(), in, out );
+}
+
+// out[i] = transform( in[i], q ) for a unit quaternion q. The rotation matrix is built once and applied as by
+// transform_vectors, so this costs the same per vector. The output may alias the input.
+inline void transform_vectors( const Quaternion& q, std::span<const Vec3> in, std::span<Vec3> out )
+{
+  detail::transform3( detail::rotation_rows( q ), in, out );
+}
+
+inline void transform_points( const Quaternion& q, std::span<const Point3> in, std::span<Point3> out )
+{
+  assert( in.size() == out.size() );
+  detail::transform3( detail::rotation_rows( q ),
+    { static_cast<const Vec3*>( in.data() ), in.size() },
+    { static_cast<Vec3*>( out.data() ), out.size() } );
+}
+
+// out[i] = transform( in[i], quats[i] ) for unit quaternions, a register of rotations at a time. The output may alias
+// the input.
+inline void transform_vectors( std::span<const Quaternion> quats, std::span<const Vec3> in, std::span<Vec3> out )
+{
+  assert( quats.size() == out.size() && in.size() == out.size() );
+  detail::batch_kernels().rotate3( quats.data(), in.data(), out.data(), out.size() );
+}
+
+inline void transform_points( std::span<const Quaternion> quats, std::span<const Point3> in, std::span<Point3> out )
+{
+  assert( quats.size() == out.size() && in.size() == out.size() );
+  detail::batch_kernels().rotate3(
+    quats.data(), static_cast<const Vec3*>( in.data() ), static_cast<Vec3*>( out.data() ), out.size() );
+}
+
+inline void dot( std::span<const Vec3> left, std::span<const Vec3> right, std::span<float> out )
+{
+  assert( left.size() == out.size() && right.size() == out.size() );
+  detail::batch_kernels().dot3( left.data(), right.data(), out.data(), out.size() );
+}
+
+inline void dot( std::span<const Vec4> left, std::span<const Vec4> right, std::span<float> out )
+{
+  assert( left.size() == out.size() && right.size() == out.size() );
+  detail::batch_kernels().dot4( left.data(), right.data(), out.data(), out.size() );
+}
+
+// out[i] = cross( left[i], right[i] ). The output may alias either input.
+inline void cross( std::span<const Vec3> left, std::span<const Vec3> right, std::span<Vec3> out )
+{
+  assert( left.size() == out.size() && right.size() == out.size() );
+  detail::batch_kernels().cross3( left.data(), right.data(), out.data(), out.size() );
+}
+
+// out[i] = normalized<Policy>( in[i] ). The output may alias the input.
+template<RsqrtPolicy Policy = Exact>
+void normalize( std::span<const Vec3> in, std::span<Vec3> out )
+{
+  assert( in.size() == out.size() );
+  const auto& kernels = detail::batch_kernels();
+  if constexpr ( std::same_as<Policy, Refined> )
+  {
+    kernels.normalize3_refined( in.data(), out.data(), out.size() );
+  } else if constexpr ( std::same_as<Policy, Estimate> )
+  {
+    kernels.normalize3_estimate( in.data(), out.data(), out.size() );
+  } else
+  {
+    kernels.normalize3( in.data(), out.data(), out.size() );
+  }
+}
+
+template<RsqrtPolicy Policy = Exact>
+void normalize( std::span<const Vec4> in, std::span<Vec4> out )
+{
+  assert( in.size() == out.size() );
+  const auto& kernels = detail::batch_kernels();
+  if constexpr ( std::same_as<Policy, Refined> )
+  {
+    kernels.normalize4_refined( in.data(), out.data(), out.size() );
+  } else if constexpr ( std::same_as<Policy, Estimate> )
+  {
+    kernels.normalize4_estimate( in.data(), out.data(), out.size() );
+  } else
+  {
+    kernels.normalize4( in.data(), out.data(), out.size() );
+  }
+}
+
+// Batched normal encodings from normal_encoding.hpp. Encoding produces the same bits as encode_oct32 and friends on
+// every ISA; decoding agrees with decode to within rounding.
+inline void encode_oct32( std::span<const Vec3> in, std::span<Oct32> out )
+{
+  assert( in.size() == out.size() );
+  detail::batch_kernels().encode_oct32( in.data(), out.data(), out.size() );
+}
+
+inline void encode_oct16( std::span<const Vec3> in, std::span<Oct16> out )
+{
+  assert( in.size() == out.size() );
+  detail::batch_kernels().encode_oct16( in.data(), out.data(), out.size() );
+}
+
+inline void encode_snorm10x3( std::span<const Vec3> in, std::span<Snorm10x3> out )
+{
+  assert( in.size() == out.size() );
+  detail::batch_kernels().encode_snorm10x3( in.data(), out.data(), out.size() );
+}
+
+inline void decode( std::span<const Oct32> in, std::span<Vec3> out )
+{
+  assert( in.size() == out.size() );
+  detail::batch_kernels().decode_oct32( in.data(), out.data(), out.size() );
+}
+
+inline void decode( std::span<const Oct16> in, std::span<Vec3> out )
+{
+  assert( in.size() == out.size() );
+  detail::batch_kernels().decode_oct16( in.data(), out.data(), out.size() );
+}
+
+inline void decode( std::span<const Snorm10x3> in, std::span<Vec3> out )
+{
+  assert( in.size() == out.size() );
+  detail::batch_kernels().decode_snorm10x3( in.data(), out.data(), out.size() );
+}
+
+// Bulk conversion between float vectors and packed 16-bit storage vectors, rounding to nearest even. The kernels see
+// the arrays as flat scalars.
+inline void convert( std::span<const HVec3> in, std::span<Vec3> out )
+{
+  detail::convert_from_storage( detail::batch_kernels().half_to_float, in, out );
+}
+
+inline void convert( std::span<const HVec4> in, std::span<Vec4> out )
+{
+  detail::convert_from_storage( detail::batch_kernels().half_to_float, in, out );
+}
+
+inline void convert( std::span<const Vec3> in, std::span<HVec3> out )
+{
+  detail::convert_to_storage( detail::batch_kernels().float_to_half, in, out );
+}
+
+inline void convert( std::span<const Vec4> in, std::span<HVec4> out )
+{
+  detail::convert_to_storage( detail::batch_kernels().float_to_half, in, out );
+}
+
+inline void convert( std::span<const BF16Vec3> in, std::span<Vec3> out )
+{
+  detail::convert_from_storage( detail::batch_kernels().bfloat16_to_float, in, out );
+}
+
+inline void convert( std::span<const BF16Vec4> in, std::span<Vec4> out )
+{
+  detail::convert_from_storage( detail::batch_kernels().bfloat16_to_float, in, out );
+}
+
+inline void convert( std::span<const Vec3> in, std::span<BF16Vec3> out )
+{
+  detail::convert_to_storage( detail::batch_kernels().float_to_bfloat16, in, out );
+}
+
+inline void convert( std::span<const Vec4> in, std::span<BF16Vec4> out )
+{
+  detail::convert_to_storage( detail::batch_kernels().float_to_bfloat16, in, out );
+}
+
+} // namespace linalg
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <string_view>
+
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __GNUC__ ) || defined( __clang__ ) )
+#include <immintrin.h>
+#define LINALG_DISPATCH_X86
+// The AVX targets include fma; kernels still fuse only through their madd helpers, which LINALG_NO_FMA turns into a
+// separate multiply and add. Keep -ffp-contract=off with it so the compiler does not fuse those pairs again.
+#define LINALG_TARGET_SSE4   __attribute__( ( target( "sse4.1" ) ) )
+#define LINALG_TARGET_AVX2   __attribute__( ( target( "avx2,fma,f16c" ) ) )
+#define LINALG_TARGET_AVX512 __attribute__( ( target( "avx512f,avx512vl,avx512dq,avx512bw,avx2,fma" ) ) )
+#endif
+
+namespace linalg {
+
+// Instruction set used by the batch kernels. Ordered from narrowest to widest.
+enum class Isa : std::uint8_t {
+  scalar,
+  sse4,
+  avx2,
+  avx512,
+};
+
+inline constexpr size_t isa_count = 4;
+
+[[nodiscard]] constexpr std::string_view to_string( Isa isa )
+{
+  switch ( isa )
+  {
+  case Isa::scalar:
+    return "scalar";
+  case Isa::sse4:
+    return "sse4";
+  case Isa::avx2:
+    return "avx2";
+  case Isa::avx512:
+    return "avx512";
+  }
+  return "unknown";
+}
+
+[[nodiscard]] constexpr Isa isa_from_string( std::string_view name, Isa fallback )
+{
+  for ( size_t i = 0; i != isa_count; ++i )
+  {
+    const auto isa = static_cast<Isa>( i );
+    if ( name == to_string( isa ) )
+    {
+      return isa;
+    }
+  }
+  return fallback;
+}
+
+// Widest instruction set supported by both the CPU and the operating system.
+[[nodiscard]] inline Isa detect_isa()
+{
+#ifdef LINALG_DISPATCH_X86
+  __builtin_cpu_init();
+  if ( __builtin_cpu_supports( "avx512f" ) && __builtin_cpu_supports( "avx512vl" )
+       && __builtin_cpu_supports( "avx512dq" ) && __builtin_cpu_supports( "avx512bw" ) )
+  {
+    return Isa::avx512;
+  }
+  if ( __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) && __builtin_cpu_supports( "f16c" ) )
+  {
+    return Isa::avx2;
+  }
+  if ( __builtin_cpu_supports( "sse4.1" ) )
+  {
+    return Isa::sse4;
+  }
+#endif
+  return Isa::scalar;
+}
+
+[[nodiscard]] inline Isa supported_isa()
+{
+  static const Isa isa = detect_isa();
+  return isa;
+}
+
+namespace detail {
+
+// The LINALG_ISA environment variable caps the detected instruction set, e.g. LINALG_ISA=sse4.
+[[nodiscard]] inline Isa initial_isa()
+{
+  const Isa   supported = supported_isa();
+  const char* requested = std::getenv( "LINALG_ISA" ); // NOLINT(concurrency-mt-unsafe)
+  if ( requested == nullptr )
+  {
+    return supported;
+  }
+  return std::min( isa_from_string( requested, supported ), supported );
+}
+
+inline std::atomic<Isa>& isa_state()
+{
+  static std::atomic<Isa> state{ initial_isa() };
+  return state;
+}
+
+} // namespace detail
+
+[[nodiscard]] inline Isa active_isa() { return detail::isa_state().load( std::memory_order_relaxed ); }
+
+// Overrides the kernel selection. Requests wider than supported_isa() are clamped; returns the ISA now in use.
+inline Isa set_isa( Isa isa )
+{
+  const Isa effective = std::min( isa, supported_isa() );
+  detail::isa_state().store( effective, std::memory_order_relaxed );
+  return effective;
+}
+
+template<typename Kernels>
+[[nodiscard]] inline const Kernels& select_kernels( const std::array<Kernels, isa_count>& table )
+{
+  return table[static_cast<size_t>( active_isa() )];
+}
+
+} // namespace linalg
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "point.hpp"
+#include "quaternion.hpp"
+#include "transform.hpp"
+
+namespace linalg {
+
+// A rigid motion as real + dual * e with e^2 = 0: the real part is the unit rotation quaternion r and the dual part
+// is t * r / 2 for the translation t, applied after the rotation. Eight floats against the twelve of a Transform4,
+// and blends of them stay rigid, which is what dual quaternion skinning relies on.
+template<typename T>
+class DualQuaternionT
+{
+public:
+  constexpr DualQuaternionT() = default;
+  constexpr DualQuaternionT( const QuaternionT<T>& real, const QuaternionT<T>& dual ) : m_real( real ), m_dual( dual )
+  {}
+  constexpr DualQuaternionT( const QuaternionT<T>& rotation, const Vec<T, 3>& translation )
+    : m_real( rotation ), m_dual( QuaternionT<T>{ QuaternionT<T>{ translation, T{ 0 } } * rotation * T{ 0.5 } } )
+  {}
+
+  constexpr QuaternionT<T>&                     real() { return m_real; }
+  constexpr QuaternionT<T>&                     dual() { return m_dual; }
+  [[nodiscard]] constexpr const QuaternionT<T>& real() const { return m_real; }
+  [[nodiscard]] constexpr const QuaternionT<T>& dual() const { return m_dual; }
+
+  [[nodiscard]] constexpr QuaternionT<T> get_rotation() const { return m_real; }
+
+  [[nodiscard]] constexpr Vec<T, 3> get_translation() const
+  {
+    return ( m_dual * conjugate( m_real ) ).get_vector() * T{ 2 };
+  }
+
+  [[nodiscard]] constexpr Transform4T<T> to_transform4() const
+  {
+    const Mat3T<T> r = QuaternionT<T>{ m_real }.get_rotation_matrix();
+    return Transform4T<T>{ r[0], r[1], r[2], Point3T<T>{ get_translation() } };
+  }
+
+private:
+  QuaternionT<T> m_real{ T{ 0 }, T{ 0 }, T{ 0 }, T{ 1 } };
+  QuaternionT<T> m_dual{};
+};
+
+using DualQuaternion  = DualQuaternionT<float>;
+using DDualQuaternion = DualQuaternionT<double>;
+
+// The rotation and translation of a rigid transform; any scale or shear in the upper 3x3 block is not represented.
+template<typename T>
+[[nodiscard]] constexpr DualQuaternionT<T> dual_quat_from_transform( const Transform4T<T>& t )
+{
+  QuaternionT<T> rotation;
+  rotation.set_rotation_from_mat4( t );
+  return DualQuaternionT<T>{ rotation, Vec<T, 3>{ t.get_translation() } };
+}
+
+// left * right applies right first, as for matrices.
+template<typename T>
+[[nodiscard]] constexpr DualQuaternionT<T> operator*( const DualQuaternionT<T>& left, const DualQuaternionT<T>& right )
+{
+  return DualQuaternionT<T>{ left.real() * right.real(),
+    QuaternionT<T>{ left.real() * right.dual() + left.dual() * right.real() } };
+}
+
+template<typename T>
+[[nodiscard]] constexpr DualQuaternionT<T> operator+( const DualQuaternionT<T>& left, const DualQuaternionT<T>& right )
+{
+  return DualQuaternionT<T>{ QuaternionT<T>{ left.real() + right.real() },
+    QuaternionT<T>{ left.dual() + right.dual() } };
+}
+
+template<typename T>
+[[nodiscard]] constexpr DualQuaternionT<T> operator*( std::type_identity_t<T> s, const DualQuaternionT<T>& dq )
+{
+  return DualQuaternionT<T>{ QuaternionT<T>{ dq.real() * s }, QuaternionT<T>{ dq.dual() * s } };
+}
+
+// The inverse of a unit dual quaternion.
+template<typename T>
+[[nodiscard]] constexpr DualQuaternionT<T> inverse( const DualQuaternionT<T>& dq )
+{
+  return DualQuaternionT<T>{ conjugate( dq.real() ), conjugate( dq.dual() ) };
+}
+
+// Scales both parts so that the real part has unit length, as after blending.
+template<typename T>
+[[nodiscard]] constexpr DualQuaternionT<T> normalized( const DualQuaternionT<T>& dq )
+{
+  return ( T{ 1 } / magnitude( static_cast<const Vec<T, 4>&>( dq.real() ) ) ) * dq;
+}
+
+// Rotates and translates a point by a unit dual quaternion.
+template<typename T>
+[[nodiscard]] constexpr Point3T<T> transform( const Point3T<T>& point, const DualQuaternionT<T>& dq )
+{
+  return Point3T<T>{ transform( static_cast<const Vec<T, 3>&>( point ), dq.real() ) + dq.get_translation() };
+}
+
+// Directions and normals only rotate.
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> transform( const Vec<T, 3>& vec, const DualQuaternionT<T>& dq )
+{
+  return transform( vec, dq.real() );
+}
+
+} // namespace linalg
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "math.hpp"
+#include <cmath>
+#include <concepts>
+
+// Fused multiply-add is the default whenever the target has it in hardware. Define LINALG_NO_FMA (CMake:
+// -DLINALG_USE_FMA=OFF, which also passes -ffp-contract=off) for results that match across FMA and non-FMA machines.
+#if !defined( LINALG_NO_FMA ) && ( defined( __FMA__ ) || defined( __ARM_FEATURE_FMA ) )
+#define LINALG_FMA
+#endif
+
+namespace linalg {
+
+// Multiply-add policies for dot products and matrix kernels. Fused rounds a * b + c once, through the FMA instruction
+// or std::fma where the hardware has none; Separate rounds the product and then the sum.
+struct Fused
+{};
+
+struct Separate
+{};
+
+template<typename P>
+concept FmaPolicy = std::same_as<P, Fused> || std::same_as<P, Separate>;
+
+#ifdef LINALG_FMA
+using DefaultFma = Fused;
+#else
+using DefaultFma = Separate;
+#endif
+
+template<FmaPolicy Policy, typename T>
+[[nodiscard]] constexpr T madd( T a, T b, T c )
+{
+  if constexpr ( std::same_as<Policy, Fused> && std::floating_point<T> )
+  {
+    if consteval
+    {
+      // Rounded once, as std::fma does at runtime. The float product is exact in double, and a double sum rounded to
+      // odd rounds correctly to float. For double, a * b = product + error exactly, and the three-term sum is rounded
+      // through a round-to-odd tail; exact unless |a| or |b| reaches 2^995 or the product's error turns subnormal.
+      if constexpr ( std::same_as<T, float> )
+      {
+        const double product = static_cast<double>( a ) * static_cast<double>( b );
+        return static_cast<float>( detail::add_round_to_odd( product, static_cast<double>( c ) ) );
+      } else if constexpr ( std::same_as<T, double> )
+      {
+        const double product = a * b;
+        // x - x is NaN for infinities and NaNs, whose sums need no correction.
+        if ( product == 0.0 || c == 0.0 || product - product != 0.0 || c - c != 0.0 )
+        {
+          return product + c;
+        }
+        const double product_error = detail::product_error( a, b, product );
+        const double low           = c + product_error;
+        const double sum           = product + low;
+        if ( sum - sum != 0.0 )
+        {
+          return sum;
+        }
+        const double tail = detail::add_round_to_odd(
+          detail::sum_error( c, product_error, low ), detail::sum_error( product, low, sum ) );
+        return sum + tail;
+      }
+    } else
+    {
+      return std::fma( a, b, c );
+    }
+  }
+  return a * b + c;
+}
+
+} // namespace linalg
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "vec.hpp"
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined( __BMI2__ )
+#include <immintrin.h>
+#endif
+
+namespace linalg {
+
+// The cell of a uniform grid containing point: floor( point / cell_size ) per component.
+template<size_t N>
+[[nodiscard]] inline Vec<int, N> to_cell( const Vec<float, N>& point, float cell_size )
+{
+  assert( cell_size > 0.0F );
+  Vec<int, N> cell{};
+  for ( size_t i = 0; i != N; ++i )
+  {
+    cell[i] = static_cast<int>( std::floor( point[i] / cell_size ) );
+  }
+  return cell;
+}
+
+namespace detail {
+
+constexpr std::uint64_t morton_mask = 0x1249'2492'4924'9249ULL;
+
+// Spreads the low 21 bits of value so that bit i lands on bit 3i.
+[[nodiscard]] constexpr std::uint64_t spread_bits3( std::uint32_t value )
+{
+  std::uint64_t x = value & 0x1f'ffffU;
+  x               = ( x | ( x << 32 ) ) & 0x001f'0000'0000'ffffULL;
+  x               = ( x | ( x << 16 ) ) & 0x001f'0000'ff00'00ffULL;
+  x               = ( x | ( x << 8 ) ) & 0x100f'00f0'0f00'f00fULL;
+  x               = ( x | ( x << 4 ) ) & 0x10c3'0c30'c30c'30c3ULL;
+  x               = ( x | ( x << 2 ) ) & morton_mask;
+  return x;
+}
+
+[[nodiscard]] constexpr std::uint32_t compact_bits3( std::uint64_t x )
+{
+  x &= morton_mask;
+  x = ( x | ( x >> 2 ) ) & 0x10c3'0c30'c30c'30c3ULL;
+  x = ( x | ( x >> 4 ) ) & 0x100f'00f0'0f00'f00fULL;
+  x = ( x | ( x >> 8 ) ) & 0x001f'0000'ff00'00ffULL;
+  x = ( x | ( x >> 16 ) ) & 0x001f'0000'0000'ffffULL;
+  x = ( x | ( x >> 32 ) ) & 0x1f'ffffULL;
+  return static_cast<std::uint32_t>( x );
+}
+
+// Sign-extends the 21-bit value back to int.
+[[nodiscard]] constexpr int from_bits21( std::uint32_t value )
+{
+  return static_cast<int>( value << 11 ) >> 11;
+}
+
+} // namespace detail
+
+// Interleaves the low 21 bits of each component into a 63-bit Morton (Z-order) code, x in bit 0. Cells in
+// [-2^20, 2^20) round-trip through morton_decode; negative components wrap, so add a bias first when the codes must
+// sort in spatial order.
+[[nodiscard]] constexpr std::uint64_t morton_encode( const IVec3& cell )
+{
+#if defined( __BMI2__ )
+  if !consteval
+  {
+    return _pdep_u64( static_cast<std::uint32_t>( cell.x() ), detail::morton_mask )
+           | _pdep_u64( static_cast<std::uint32_t>( cell.y() ), detail::morton_mask << 1 )
+           | _pdep_u64( static_cast<std::uint32_t>( cell.z() ), detail::morton_mask << 2 );
+  }
+#endif
+  return detail::spread_bits3( static_cast<std::uint32_t>( cell.x() ) )
+         | ( detail::spread_bits3( static_cast<std::uint32_t>( cell.y() ) ) << 1 )
+         | ( detail::spread_bits3( static_cast<std::uint32_t>( cell.z() ) ) << 2 );
+}
+
+[[nodiscard]] constexpr IVec3 morton_decode( std::uint64_t code )
+{
+  return IVec3{ detail::from_bits21( detail::compact_bits3( code ) ),
+    detail::from_bits21( detail::compact_bits3( code >> 1 ) ),
+    detail::from_bits21( detail::compact_bits3( code >> 2 ) ) };
+}
+
+} // namespace linalg
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+
+namespace linalg {
+
+namespace detail {
+
+// Round to nearest even, as F16C does. Values from 65520 up become infinity, values below the smallest subnormal
+// become zero and NaNs become the quiet NaN 0x7e00.
+[[nodiscard]] constexpr std::uint16_t float_to_half_bits( float value )
+{
+  constexpr std::uint32_t f32_infinity = 255U << 23;
+  constexpr std::uint32_t f16_overflow = ( 127U + 16U ) << 23;
+  constexpr std::uint32_t f16_min_norm = 113U << 23;
+  constexpr std::uint32_t denorm_magic = ( ( 127U - 15U ) + ( 23U - 10U ) + 1U ) << 23;
+
+  std::uint32_t       bits = std::bit_cast<std::uint32_t>( value );
+  const std::uint32_t sign = bits & 0x8000'0000U;
+  bits ^= sign;
+
+  std::uint32_t half = 0;
+  if ( bits >= f16_overflow )
+  {
+    half = bits > f32_infinity ? 0x7e00U : 0x7c00U;
+  } else if ( bits < f16_min_norm )
+  {
+    // Adding the magic value aligns the subnormal mantissa at the bottom of the float; the float addition rounds.
+    const float aligned = std::bit_cast<float>( bits ) + std::bit_cast<float>( denorm_magic );
+    half                = std::bit_cast<std::uint32_t>( aligned ) - denorm_magic;
+  } else
+  {
+    const std::uint32_t mantissa_odd = ( bits >> 13 ) & 1U;
+    bits += ( ( 15U - 127U ) << 23 ) + 0xfffU + mantissa_odd;
+    half = bits >> 13;
+  }
+  return static_cast<std::uint16_t>( half | ( sign >> 16 ) );
+}
+
+// Exact; every half value is representable as a float.
+[[nodiscard]] constexpr float half_bits_to_float( std::uint16_t half )
+{
+  constexpr std::uint32_t shifted_exponent = 0x7c00U << 13;
+  constexpr std::uint32_t magic            = 113U << 23;
+
+  std::uint32_t       bits     = ( half & 0x7fffU ) << 13;
+  const std::uint32_t exponent = bits & shifted_exponent;
+  bits += ( 127U - 15U ) << 23;
+
+  if ( exponent == shifted_exponent )
+  {
+    bits += ( 128U - 16U ) << 23;
+  } else if ( exponent == 0 )
+  {
+    bits += 1U << 23;
+    bits = std::bit_cast<std::uint32_t>( std::bit_cast<float>( bits ) - std::bit_cast<float>( magic ) );
+  }
+  return std::bit_cast<float>( bits | ( ( half & 0x8000U ) << 16 ) );
+}
+
+// The upper half of the float, rounded to nearest even; NaNs are kept quiet so rounding cannot turn them into
+// infinity.
+[[nodiscard]] constexpr std::uint16_t float_to_bfloat16_bits( float value )
+{
+  const std::uint32_t bits = std::bit_cast<std::uint32_t>( value );
+  if ( ( bits & 0x7fff'ffffU ) > 0x7f80'0000U )
+  {
+    return static_cast<std::uint16_t>( ( bits >> 16 ) | 0x40U );
+  }
+  return static_cast<std::uint16_t>( ( bits + 0x7fffU + ( ( bits >> 16 ) & 1U ) ) >> 16 );
+}
+
+[[nodiscard]] constexpr float bfloat16_bits_to_float( std::uint16_t bfloat )
+{
+  return std::bit_cast<float>( static_cast<std::uint32_t>( bfloat ) << 16 );
+}
+
+} // namespace detail
+
+// 16-bit floating point storage types. They only convert to and from float; arithmetic is done on the float values.
+// Equality compares bit patterns, so +0 and -0 differ and a NaN equals itself.
+//
+// IEEE 754 binary16: 5 exponent and 10 mantissa bits, finite up to 65504.
+class Half
+{
+  std::uint16_t m_bits = 0;
+
+public:
+  constexpr Half() = default;
+
+  explicit constexpr Half( float value ) : m_bits( detail::float_to_half_bits( value ) ) {}
+
+  [[nodiscard]] static constexpr Half from_bits( std::uint16_t bits )
+  {
+    Half half;
+    half.m_bits = bits;
+    return half;
+  }
+
+  [[nodiscard]] constexpr std::uint16_t bits() const { return m_bits; }
+
+  explicit constexpr operator float() const { return detail::half_bits_to_float( m_bits ); }
+
+  [[nodiscard]] friend constexpr bool operator==( Half left, Half right ) = default;
+};
+
+// bfloat16: the float exponent range with 7 mantissa bits.
+class BFloat16
+{
+  std::uint16_t m_bits = 0;
+
+public:
+  constexpr BFloat16() = default;
+
+  explicit constexpr BFloat16( float value ) : m_bits( detail::float_to_bfloat16_bits( value ) ) {}
+
+  [[nodiscard]] static constexpr BFloat16 from_bits( std::uint16_t bits )
+  {
+    BFloat16 bfloat;
+    bfloat.m_bits = bits;
+    return bfloat;
+  }
+
+  [[nodiscard]] constexpr std::uint16_t bits() const { return m_bits; }
+
+  explicit constexpr operator float() const { return detail::bfloat16_bits_to_float( m_bits ); }
+
+  [[nodiscard]] friend constexpr bool operator==( BFloat16 left, BFloat16 right ) = default;
+};
+
+template<typename T>
+concept StorageFloat = std::same_as<T, Half> || std::same_as<T, BFloat16>;
+
+} // namespace linalg
@@ -1,10 +1,12 @@
 #pragma once
 
+#include "simd.hpp"
 #include "vec.hpp"
 #include <array>
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <type_traits>
 
 namespace linalg {
 
@@ -29,7 +31,7 @@ public:
     Mat result{};
     for ( size_t i = 0; i != Row; ++i )
     {
-      result( i, i ) = 1.0F;
+      result( i, i ) = T{ 1 };
     }
     return result;
   }
@@ -113,7 +115,7 @@ public:
     requires std::same_as<T, U>
   constexpr Mat& operator/=( U div )
   {
-    assert( div != 0.0F );
+    assert( div != U{ 0 } );
     for ( size_t i = 0; i != Row; ++i )
     {
       for ( size_t j = 0; j != Col; ++j )
@@ -125,6 +127,28 @@ public:
   }
 };
 
+#ifdef LINALG_SIMD_F32X4
+namespace simd {
+
+template<typename T, size_t N>
+  requires is_f32x4<T, N>
+[[nodiscard]] inline Columns4 load_columns( const Mat<T, N, N>& mat )
+{
+  return Columns4{ { load( mat[0].data() ), load( mat[1].data() ), load( mat[2].data() ), load( mat[3].data() ) } };
+}
+
+#ifdef LINALG_SIMD_F64X4
+template<typename T, size_t N>
+  requires is_f64x4<T, N>
+[[nodiscard]] inline Columns4d load_columns( const Mat<T, N, N>& mat )
+{
+  return Columns4d{ { load( mat[0].data() ), load( mat[1].data() ), load( mat[2].data() ), load( mat[3].data() ) } };
+}
+#endif
+
+} // namespace simd
+#endif
+
 template<typename T, size_t N>
 [[nodiscard]] constexpr Mat<T, N, N> operator+( const Mat<T, N, N>& left, const Mat<T, N, N>& right )
 {
@@ -141,39 +165,89 @@ template<typename T, size_t N>
   return mat;
 }
 
-template<typename T, size_t N>
-[[nodiscard]] constexpr Mat<T, N, N> operator*( const Mat<T, N, N>& left, const Mat<T, N, N>& right )
+// Products with an explicit multiply-add policy; the operators use DefaultFma.
+template<FmaPolicy Policy, typename T, size_t N>
+[[nodiscard]] constexpr Mat<T, N, N> multiply( const Mat<T, N, N>& left, const Mat<T, N, N>& right )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_packed4<T, N> )
+  {
+    if !consteval
+    {
+      // All columns are computed before the result exists, which lets the compiler drop its zero fill; for doubles
+      // that fill is a 128-byte memset costing more than the product itself.
+      const auto cols    = simd::load_columns( left );
+      auto       product = cols;
+      for ( size_t j = 0; j != N; ++j )
+      {
+        product.col[j] = simd::combine_columns<Policy>( cols, right[j].data() );
+      }
+      Mat<T, N, N> mat;
+      for ( size_t j = 0; j != N; ++j )
+      {
+        simd::store( mat[j].data(), product.col[j] );
+      }
+      return mat;
+    }
+  }
+#endif
   Mat<T, N, N> mat{};
   for ( size_t i = 0; i != N; ++i )
   {
     for ( size_t j = 0; j != N; ++j )
     {
-      for ( size_t k = 0; k != N; ++k )
+      T sum = left( i, 0 ) * right( 0, j );
+      for ( size_t k = 1; k != N; ++k )
       {
-        mat( i, j ) += left( i, k ) * right( k, j );
+        sum = madd<Policy>( left( i, k ), right( k, j ), sum );
       }
+      mat( i, j ) = sum;
     }
   }
   return mat;
 }
 
-template<typename T, size_t N>
-[[nodiscard]] constexpr Vec<T, N> operator*( const Mat<T, N, N>& mat, const Vec<T, N>& vec )
+template<FmaPolicy Policy, typename T, size_t N>
+[[nodiscard]] constexpr Vec<T, N> multiply( const Mat<T, N, N>& mat, const Vec<T, N>& vec )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_packed4<T, N> )
+  {
+    if !consteval
+    {
+      Vec<T, N> result;
+      simd::store( result.data(), simd::combine_columns<Policy>( simd::load_columns( mat ), vec.data() ) );
+      return result;
+    }
+  }
+#endif
   Vec<T, N> result{};
   for ( size_t i = 0; i != N; ++i )
   {
-    for ( size_t j = 0; j != N; ++j )
+    T sum = mat( i, 0 ) * vec[0];
+    for ( size_t j = 1; j != N; ++j )
     {
-      result[i] += mat( i, j ) * vec[j];
+      sum = madd<Policy>( mat( i, j ), vec[j], sum );
     }
+    result[i] = sum;
   }
   return result;
 }
 
 template<typename T, size_t N>
-[[nodiscard]] constexpr Mat<T, N, N> operator*( const Mat<T, N, N>& a, float mul )
+[[nodiscard]] constexpr Mat<T, N, N> operator*( const Mat<T, N, N>& left, const Mat<T, N, N>& right )
+{
+  return multiply<DefaultFma>( left, right );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] constexpr Vec<T, N> operator*( const Mat<T, N, N>& mat, const Vec<T, N>& vec )
+{
+  return multiply<DefaultFma>( mat, vec );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] constexpr Mat<T, N, N> operator*( const Mat<T, N, N>& a, std::type_identity_t<T> mul )
 {
   auto mat = a;
   mat *= mul;
@@ -181,7 +255,7 @@ template<typename T, size_t N>
 }
 
 template<typename T, size_t N>
-[[nodiscard]] constexpr Mat<T, N, N> operator/( const Mat<T, N, N>& a, float div )
+[[nodiscard]] constexpr Mat<T, N, N> operator/( const Mat<T, N, N>& a, std::type_identity_t<T> div )
 {
   auto mat = a;
   mat /= div;
@@ -191,6 +265,22 @@ template<typename T, size_t N>
 template<typename T, size_t N>
 [[nodiscard]] constexpr Mat<T, N, N> transpose( const Mat<T, N, N>& mat )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_packed4<T, N> )
+  {
+    if !consteval
+    {
+      auto         cols = simd::load_columns( mat );
+      Mat<T, N, N> result;
+      simd::transpose( cols );
+      for ( size_t j = 0; j != N; ++j )
+      {
+        simd::store( result[j].data(), cols.col[j] );
+      }
+      return result;
+    }
+  }
+#endif
   Mat<T, N, N> result{};
   for ( size_t i = 0; i < N; ++i )
   {
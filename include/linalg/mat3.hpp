@@ -1,16 +1,19 @@
 #pragma once
 #include "mat.hpp"
+#include "math.hpp"
+#include <type_traits>
 
 namespace linalg {
 
-class Mat3 : public Mat<float, 3, 3>
+template<typename T>
+class Mat3T : public Mat<T, 3, 3>
 {
 public:
-  Mat3() = default;
+  Mat3T() = default;
 
-  template<typename T>
-    requires( std::same_as<T, float> )
-  constexpr Mat3( T n00, T n01, T n02, T n10, T n11, T n12, T n20, T n21, T n22 )
+  template<typename U>
+    requires( std::same_as<U, T> )
+  constexpr Mat3T( U n00, U n01, U n02, U n10, U n11, U n12, U n20, U n21, U n22 )
   {
     ( *this )( 0, 0 ) = n00;
     ( *this )( 1, 0 ) = n10;
@@ -23,24 +26,29 @@ public:
     ( *this )( 2, 2 ) = n22;
   }
 
-  constexpr Mat3( const Vec3& v00, const Vec3& v01, const Vec3& v02 )
+  constexpr Mat3T( const Vec<T, 3>& v00, const Vec<T, 3>& v01, const Vec<T, 3>& v02 )
   {
     ( *this )[0] = v00;
     ( *this )[1] = v01;
     ( *this )[2] = v02;
   }
 
-  constexpr Mat3( const Mat& other ) : Mat( other ) {}
+  constexpr Mat3T( const Mat<T, 3, 3>& other ) : Mat<T, 3, 3>( other ) {}
 };
 
-[[nodiscard]] constexpr float determinant( const Mat3& mat )
+using Mat3  = Mat3T<float>;
+using DMat3 = Mat3T<double>;
+
+template<typename T>
+[[nodiscard]] constexpr T determinant( const Mat<T, 3, 3>& mat )
 {
   return mat( 0, 0 ) * ( mat( 1, 1 ) * mat( 2, 2 ) - mat( 2, 1 ) * mat( 1, 2 ) )
          - mat( 0, 1 ) * ( mat( 1, 0 ) * mat( 2, 2 ) - mat( 1, 2 ) * mat( 2, 0 ) )
          + mat( 0, 2 ) * ( mat( 1, 0 ) * mat( 2, 1 ) - mat( 1, 1 ) * mat( 2, 0 ) );
 }
 
-[[nodiscard]] constexpr Mat3 inverse( const Mat3& mat )
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> inverse( const Mat<T, 3, 3>& mat )
 {
   const auto& a = mat[0];
   const auto& b = mat[1];
@@ -52,7 +60,7 @@ public:
 
   const auto scalar_cross = dot( a_cross_b, c );
 
-  return Mat3{ b_cross_c.x(),
+  return Mat3T<T>{ b_cross_c.x(),
     b_cross_c.y(),
     b_cross_c.z(),
     c_cross_a.x(),
@@ -64,35 +72,70 @@ public:
          / scalar_cross;
 }
 
-[[nodiscard]] inline Mat3 make_rotation_x( float t )
+// A Mat3 known to be orthonormal with determinant 1, so its inverse is its transpose and products of rotations stay
+// rotations. Returned by the make_rotation factories; wrapping any other matrix is the caller's promise that it is one.
+template<typename T>
+class Rotation3T : public Mat3T<T>
 {
-  auto c = std::cos( t );
-  auto s = std::sin( t );
+public:
+  constexpr Rotation3T() : Mat3T<T>( Mat3T<T>::identity() ) {}
+
+  explicit constexpr Rotation3T( const Mat3T<T>& mat ) : Mat3T<T>( mat ) {}
+
+  // inverse() and the product below rely on the matrix staying a rotation, so elements are read-only and the
+  // inherited mutators are deleted; modify a Mat3 copy instead. Arithmetic such as rot * 2.0F returns a Mat3.
+  [[nodiscard]] constexpr const T& operator()( size_t i, size_t j ) const { return Mat3T<T>::operator()( i, j ); }
+  [[nodiscard]] constexpr const Vec<T, 3>& operator[]( size_t i ) const { return Mat3T<T>::operator[]( i ); }
+
+  Rotation3T& operator+=( const Mat<T, 3, 3>& other ) = delete;
+  Rotation3T& operator-=( const Mat<T, 3, 3>& other ) = delete;
+  template<typename U>
+  Rotation3T& operator*=( U mul ) = delete;
+  template<typename U>
+  Rotation3T& operator/=( U div ) = delete;
+};
+
+using Rotation3  = Rotation3T<float>;
+using DRotation3 = Rotation3T<double>;
 
-  return Mat3{ 1.0F, 0.0F, 0.0F, 0.0F, c, -s, 0.0F, s, c };
+template<typename T>
+[[nodiscard]] constexpr Rotation3T<T> inverse( const Rotation3T<T>& rot )
+{
+  return Rotation3T<T>{ transpose( rot ) };
 }
 
-[[nodiscard]] inline Mat3 make_rotation_y( float t )
+template<typename T>
+[[nodiscard]] constexpr Rotation3T<T> operator*( const Rotation3T<T>& left, const Rotation3T<T>& right )
 {
-  auto c = std::cos( t );
-  auto s = std::sin( t );
+  return Rotation3T<T>{ static_cast<const Mat<T, 3, 3>&>( left ) * static_cast<const Mat<T, 3, 3>&>( right ) };
+}
 
-  return Mat3{ c, 0.0F, s, 0.0F, 1.0F, 0.0F, -s, 0.0F, c };
+namespace detail {
+
+// The rotation matrices from the cosine and sine of the angle, shared with the batched factories in
+// rotation_batch.hpp.
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> rotation_x( T c, T s )
+{
+  return Mat3T<T>{ T{ 1 }, T{ 0 }, T{ 0 }, T{ 0 }, c, -s, T{ 0 }, s, c };
 }
 
-[[nodiscard]] inline Mat3 make_rotation_z( float t )
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> rotation_y( T c, T s )
 {
-  auto c = std::cos( t );
-  auto s = std::sin( t );
+  return Mat3T<T>{ c, T{ 0 }, s, T{ 0 }, T{ 1 }, T{ 0 }, -s, T{ 0 }, c };
+}
 
-  return Mat3{ c, -s, 0.0F, s, c, 0.0F, 0.0F, 0.0F, 1.0F };
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> rotation_z( T c, T s )
+{
+  return Mat3T<T>{ c, -s, T{ 0 }, s, c, T{ 0 }, T{ 0 }, T{ 0 }, T{ 1 } };
 }
 
-[[nodiscard]] inline Mat3 make_rotation( float t, const Vec3& a )
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> rotation_about( T c, T s, const Vec<T, 3>& a )
 {
-  auto c           = std::cos( t );
-  auto s           = std::sin( t );
-  auto one_minus_c = 1.0F - c;
+  auto one_minus_c = T{ 1 } - c;
 
   auto x = a.x() * one_minus_c;
   auto y = a.y() * one_minus_c;
@@ -102,7 +145,7 @@ public:
   auto axaz = x * a.z();
   auto ayaz = y * a.z();
 
-  return Mat3{ c + x * a.x(),
+  return Mat3T<T>{ c + x * a.x(),
     axay - s * a.z(),
     axaz + s * a.y(),
     axay + s * a.z(),
@@ -113,29 +156,66 @@ public:
     c + z * a.z() };
 }
 
-[[nodiscard]] constexpr Mat3 make_reflection( const Vec3& a )
+} // namespace detail
+
+// The angle-only factories default to float; make_rotation_x<double>( t ) builds a DRotation3. All of them are
+// constexpr through the trigonometric functions in math.hpp.
+template<typename T = float>
+[[nodiscard]] constexpr Rotation3T<T> make_rotation_x( std::type_identity_t<T> t )
+{
+  return Rotation3T<T>{ detail::rotation_x( cos( t ), sin( t ) ) };
+}
+
+template<typename T = float>
+[[nodiscard]] constexpr Rotation3T<T> make_rotation_y( std::type_identity_t<T> t )
+{
+  return Rotation3T<T>{ detail::rotation_y( cos( t ), sin( t ) ) };
+}
+
+template<typename T = float>
+[[nodiscard]] constexpr Rotation3T<T> make_rotation_z( std::type_identity_t<T> t )
+{
+  return Rotation3T<T>{ detail::rotation_z( cos( t ), sin( t ) ) };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Rotation3T<T> make_rotation( std::type_identity_t<T> t, const Vec<T, 3>& a )
 {
-  auto x = -2.0F * a.x();
-  auto y = -2.0F * a.y();
-  auto z = -2.0F * a.z();
+  return Rotation3T<T>{ detail::rotation_about( cos( t ), sin( t ), a ) };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> make_reflection( const Vec<T, 3>& a )
+{
+  auto x = T{ -2 } * a.x();
+  auto y = T{ -2 } * a.y();
+  auto z = T{ -2 } * a.z();
 
   auto axay = x * a.y();
   auto axaz = x * a.z();
   auto ayaz = y * a.z();
 
-  return Mat3{ 1.0F + x * a.x(), axay, axaz, axay, 1.0F + y * a.y(), ayaz, axaz, ayaz, 1.0F + z * a.z() };
+  return Mat3T<T>{ T{ 1 } + x * a.x(), axay, axaz, axay, T{ 1 } + y * a.y(), ayaz, axaz, ayaz, T{ 1 } + z * a.z() };
 }
 
-[[nodiscard]] constexpr Mat3 make_involution( const Vec3& a ) { return -make_reflection( a ); }
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> make_involution( const Vec<T, 3>& a )
+{
+  return -make_reflection( a );
+}
 
-[[nodiscard]] constexpr Mat3 make_scale( float sx, float sy, float sz )
+template<typename T = float>
+[[nodiscard]] constexpr Mat3T<T> make_scale( std::type_identity_t<T> sx,
+  std::type_identity_t<T>                                             sy,
+  std::type_identity_t<T>                                             sz )
 {
-  return Mat3{ sx, 0.0F, 0.0F, 0.0F, sy, 0.0F, 0.0F, 0.0F, sz };
+  return Mat3T<T>{ sx, T{ 0 }, T{ 0 }, T{ 0 }, sy, T{ 0 }, T{ 0 }, T{ 0 }, sz };
 }
 
-[[nodiscard]] constexpr Mat3 make_scale( float s, const Vec3& a )
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> make_scale( std::type_identity_t<T> s, const Vec<T, 3>& a )
 {
-  s -= 1.0F;
+  s -= T{ 1 };
   auto x = s * a.x();
   auto y = s * a.y();
   auto z = s * a.z();
@@ -144,25 +224,28 @@ public:
   auto axaz = x * a.z();
   auto ayaz = y * a.z();
 
-  return Mat3{ x * a.x() + 1.0F, axay, axaz, axay, y * a.y() + 1.0F, ayaz, axaz, ayaz, z * a.z() + 1.0F };
+  return Mat3T<T>{ x * a.x() + T{ 1 }, axay, axaz, axay, y * a.y() + T{ 1 }, ayaz, axaz, ayaz, z * a.z() + T{ 1 } };
 }
 
-[[nodiscard]] inline Mat3 make_skew( float t, const Vec3& skew_direction, const Vec3& projected )
+template<typename T>
+[[nodiscard]] constexpr Mat3T<T> make_skew( std::type_identity_t<T> t,
+  const Vec<T, 3>&                                                skew_direction,
+  const Vec<T, 3>&                                                projected )
 {
-  t      = std::tan( t );
+  t      = tan( t );
   auto x = skew_direction.x() * t;
   auto y = skew_direction.y() * t;
   auto z = skew_direction.z() * t;
 
-  return Mat3{ x * projected.x() + 1.0F,
+  return Mat3T<T>{ x * projected.x() + T{ 1 },
     x * projected.y(),
     x * projected.z(),
     y * projected.x(),
-    y * projected.y() + 1.0F,
+    y * projected.y() + T{ 1 },
     y * projected.z(),
     z * projected.x(),
     z * projected.y(),
-    z * projected.z() + 1.0F };
+    z * projected.z() + T{ 1 } };
 }
 
 } // namespace linalg
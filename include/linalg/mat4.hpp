@@ -4,15 +4,16 @@
 
 namespace linalg {
 
-class Mat4 : public Mat<float, 4, 4>
+template<typename T>
+class Mat4T : public Mat<T, 4, 4>
 {
 public:
-  Mat4() = default;
+  Mat4T() = default;
 
-  template<typename T>
-    requires( std::same_as<T, float> )
-  constexpr Mat4(
-    T t00, T t01, T t02, T t03, T t10, T t11, T t12, T t13, T t20, T t21, T t22, T t23, T t30, T t31, T t32, T t33 )
+  template<typename U>
+    requires( std::same_as<U, T> )
+  constexpr Mat4T(
+    U t00, U t01, U t02, U t03, U t10, U t11, U t12, U t13, U t20, U t21, U t22, U t23, U t30, U t31, U t32, U t33 )
   {
     ( *this )( 0, 0 ) = t00;
     ( *this )( 1, 0 ) = t10;
@@ -32,7 +33,7 @@ public:
     ( *this )( 3, 3 ) = t33;
   }
 
-  constexpr Mat4( const Vec4& v00, const Vec4& v01, const Vec4& v02, const Vec4& v03 )
+  constexpr Mat4T( const Vec<T, 4>& v00, const Vec<T, 4>& v01, const Vec<T, 4>& v02, const Vec<T, 4>& v03 )
   {
     ( *this )[0] = v00;
     ( *this )[1] = v01;
@@ -40,27 +41,72 @@ public:
     ( *this )[3] = v03;
   }
 
-  constexpr Mat4( const Mat& other ) : Mat( other ) {}
+  constexpr Mat4T( const Mat<T, 4, 4>& other ) : Mat<T, 4, 4>( other ) {}
 };
 
-[[nodiscard]] constexpr Mat4 inverse( const Mat4& mat )
+using Mat4  = Mat4T<float>;
+using DMat4 = Mat4T<double>;
+
+template<typename T>
+[[nodiscard]] constexpr Mat4T<T> inverse( const Mat<T, 4, 4>& mat )
 {
-  const Vec3 a = mat[0].to_sub_vec<3>();
-  const Vec3 b = mat[1].to_sub_vec<3>();
-  const Vec3 c = mat[2].to_sub_vec<3>();
-  const Vec3 d = mat[3].to_sub_vec<3>();
+#ifdef LINALG_SIMD_F64X4
+  // Same construction with each column in one register; the cross products leave lane 3, which holds the bottom row,
+  // at zero, and the inverse's rows are transposed back into columns at the end.
+  if constexpr ( simd::is_f64x4<T, 4> )
+  {
+    if !consteval
+    {
+      const simd::Columns4d m = simd::load_columns( mat );
+      const simd::f64x4     x = simd::broadcast<3>( m.col[0] );
+      const simd::f64x4     y = simd::broadcast<3>( m.col[1] );
+      const simd::f64x4     z = simd::broadcast<3>( m.col[2] );
+      const simd::f64x4     w = simd::broadcast<3>( m.col[3] );
+
+      simd::f64x4 s = simd::cross3( m.col[0], m.col[1] );
+      simd::f64x4 t = simd::cross3( m.col[2], m.col[3] );
+      simd::f64x4 u = simd::sub( simd::mul( m.col[0], y ), simd::mul( m.col[1], x ) );
+      simd::f64x4 v = simd::sub( simd::mul( m.col[2], w ), simd::mul( m.col[3], z ) );
+
+      const simd::f64x4 inv_det = simd::splat( 1.0 / ( simd::dot3( s, v ) + simd::dot3( t, u ) ) );
+      s                         = simd::mul( s, inv_det );
+      t                         = simd::mul( t, inv_det );
+      u                         = simd::mul( u, inv_det );
+      v                         = simd::mul( v, inv_det );
+
+      simd::Columns4d rows{ {
+        simd::with_w( simd::add( simd::cross3( m.col[1], v ), simd::mul( t, y ) ), -simd::dot3( m.col[1], t ) ),
+        simd::with_w( simd::sub( simd::cross3( v, m.col[0] ), simd::mul( t, x ) ), simd::dot3( m.col[0], t ) ),
+        simd::with_w( simd::add( simd::cross3( m.col[3], u ), simd::mul( s, w ) ), -simd::dot3( m.col[3], s ) ),
+        simd::with_w( simd::sub( simd::cross3( u, m.col[2] ), simd::mul( s, z ) ), simd::dot3( m.col[2], s ) ),
+      } };
+      simd::transpose( rows );
+
+      Mat4T<T> result;
+      for ( size_t j = 0; j != 4; ++j )
+      {
+        simd::store( result[j].data(), rows.col[j] );
+      }
+      return result;
+    }
+  }
+#endif
+  const Vec<T, 3> a = mat[0].template to_sub_vec<3>();
+  const Vec<T, 3> b = mat[1].template to_sub_vec<3>();
+  const Vec<T, 3> c = mat[2].template to_sub_vec<3>();
+  const Vec<T, 3> d = mat[3].template to_sub_vec<3>();
 
-  const float x = mat( 3, 0 );
-  const float y = mat( 3, 1 );
-  const float z = mat( 3, 2 );
-  const float w = mat( 3, 3 );
+  const T x = mat( 3, 0 );
+  const T y = mat( 3, 1 );
+  const T z = mat( 3, 2 );
+  const T w = mat( 3, 3 );
 
   auto s = cross( a, b );
   auto t = cross( c, d );
   auto u = a * y - b * x;
   auto v = c * w - d * z;
 
-  const auto inv_det = 1.0F / ( dot( s, v ) + dot( t, u ) );
+  const auto inv_det = T{ 1 } / ( dot( s, v ) + dot( t, u ) );
   s *= inv_det;
   t *= inv_det;
   u *= inv_det;
@@ -71,7 +117,7 @@ public:
   const auto r2 = cross( d, u ) + s * w;
   const auto r3 = cross( u, c ) - s * z;
 
-  return Mat4{ r0.x(),
+  return Mat4T<T>{ r0.x(),
     r0.y(),
     r0.z(),
     -dot( b, t ),
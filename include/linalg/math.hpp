@@ -0,0 +1,264 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace linalg {
+
+namespace detail {
+
+// Constant-evaluable sqrt, sin, cos and tan, computed in double. sqrt is correctly rounded; sin and cos are within
+// 0.8 ulp and tan within 2.2 ulp of the exact double result for |x| < 1e6 (beyond that the argument reduction loses
+// bits). Float results round the double ones, which makes them correctly rounded in all but rare cases.
+
+[[nodiscard]] constexpr double power_of_two( int exponent )
+{
+  return std::bit_cast<double>( static_cast<std::uint64_t>( exponent + 1023 ) << 52 );
+}
+
+// Dekker's split of a into hi + lo, each with at most 26 significant bits. Exact for |a| < 2^995.
+constexpr void split( double a, double& hi, double& lo )
+{
+  const double c = 134217729.0 * a;
+  hi             = c - ( c - a );
+  lo             = a - hi;
+}
+
+// The rounding error of product = a * b, exact while the error stays in the normal range.
+[[nodiscard]] constexpr double product_error( double a, double b, double product )
+{
+  double a_hi = 0.0;
+  double a_lo = 0.0;
+  double b_hi = 0.0;
+  double b_lo = 0.0;
+  split( a, a_hi, a_lo );
+  split( b, b_hi, b_lo );
+  return ( ( ( a_hi * b_hi - product ) + a_hi * b_lo ) + a_lo * b_hi ) + a_lo * b_lo;
+}
+
+// The rounding error of sum = a + b, exact (Knuth's TwoSum).
+[[nodiscard]] constexpr double sum_error( double a, double b, double sum )
+{
+  const double b_part = sum - a;
+  return ( a - ( sum - b_part ) ) + ( b - b_part );
+}
+
+// a + b rounded to odd: truncated, with the last bit set when the sum is inexact. Rounding that once more to a format
+// with at least two bits fewer gives the correctly rounded sum (Boldo and Melquiond).
+[[nodiscard]] constexpr double add_round_to_odd( double a, double b )
+{
+  const double sum   = a + b;
+  const double error = sum_error( a, b, sum );
+  auto         bits  = std::bit_cast<std::uint64_t>( sum );
+  // The exact sum lies between sum and its neighbour in the direction of the error; pick the odd one of the two. An
+  // infinite sum leaves a NaN error, which compares false both ways.
+  if ( ( error < 0.0 || error > 0.0 ) && ( bits & 1U ) == 0 )
+  {
+    bits = ( error < 0.0 ) == ( sum < 0.0 ) ? bits + 1 : bits - 1;
+  }
+  return std::bit_cast<double>( bits );
+}
+
+[[nodiscard]] constexpr double constexpr_sqrt( double x )
+{
+  if ( x < 0.0 || x != x )
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if ( x == 0.0 || x == std::numeric_limits<double>::infinity() )
+  {
+    return x;
+  }
+
+  // x = f * 2^e with f in [0.5, 2) and e even; subnormals are scaled into the normal range first.
+  int scale = 0;
+  if ( x < std::numeric_limits<double>::min() )
+  {
+    x *= 0x1p54;
+    scale = -27;
+  }
+  const auto bits     = std::bit_cast<std::uint64_t>( x );
+  int        exponent = static_cast<int>( bits >> 52 ) - 1022;
+  double     f        = std::bit_cast<double>( ( bits & 0x000f'ffff'ffff'ffffULL ) | 0x3fe0'0000'0000'0000ULL );
+  if ( exponent % 2 != 0 )
+  {
+    f *= 2.0;
+    exponent -= 1;
+  }
+
+  double y = 0.41731 + 0.59016 * f;
+  for ( int i = 0; i != 5; ++i )
+  {
+    y = 0.5 * ( y + f / y );
+  }
+  // One more step on the exact residual rounds y correctly.
+  const double square = y * y;
+  y += ( ( f - square ) - product_error( y, y, square ) ) / ( 2.0 * y );
+  return y * power_of_two( exponent / 2 + scale );
+}
+
+template<size_t K>
+[[nodiscard]] constexpr double horner( double z, const double ( &coefficients )[K] )
+{
+  double result = coefficients[0];
+  for ( size_t k = 1; k != K; ++k )
+  {
+    result = result * z + coefficients[k];
+  }
+  return result;
+}
+
+// sin( r + tail ) and cos( r + tail ) for |r| <= pi / 4, where tail is below an ulp of r (fdlibm's kernels).
+[[nodiscard]] constexpr double sin_kernel( double r, double tail )
+{
+  constexpr double coefficients[] = { 1.58969099521155010221e-10,
+    -2.50507602534068634195e-08,
+    2.75573137070700676789e-06,
+    -1.98412698298579493134e-04,
+    8.33333333332248946124e-03 };
+  const double     z              = r * r;
+  const double     v              = z * r;
+  const double     p              = horner( z, coefficients );
+  return r - ( ( z * ( 0.5 * tail - v * p ) - tail ) + v * 1.66666666666666324348e-01 );
+}
+
+[[nodiscard]] constexpr double cos_kernel( double r, double tail )
+{
+  constexpr double coefficients[] = { -1.13596475577881948265e-11,
+    2.08757232129817482790e-09,
+    -2.75573143513906633035e-07,
+    2.48015872894767294178e-05,
+    -1.38888888888741095749e-03,
+    4.16666666666666019037e-02 };
+  const double     z              = r * r;
+  const double     half_z         = 0.5 * z;
+  const double     w              = 1.0 - half_z;
+  return w + ( ( ( 1.0 - w ) - half_z ) + ( z * z * horner( z, coefficients ) - r * tail ) );
+}
+
+// Splits x into quadrant * pi / 2 + r + tail with |r| <= pi / 4. pi / 2 is split into four parts; the first two have
+// 33 bits, so their products with the quadrant are exact for |x| < 1e6.
+[[nodiscard]] constexpr double split_half_pi( double x, int& quadrant, double& tail )
+{
+  const double rounding = 0x1.8p52;
+  const double k        = ( x * 6.36619772367581382433e-01 + rounding ) - rounding;
+  quadrant              = static_cast<int>( static_cast<std::int64_t>( k ) & 3 );
+  const double head     = x - k * 1.57079632673412561417e+00;
+  const double w        = k * 6.07710050630396597660e-11;
+  const double r        = head - w;
+  tail                  = ( ( head - r ) - w ) - ( k * 2.02226624871116645580e-21 + k * 8.47842766036889956997e-32 );
+  const double sum      = r + tail;
+  tail -= sum - r;
+  return sum;
+}
+
+// sin( x + quadrant_offset * pi / 2 ).
+[[nodiscard]] constexpr double constexpr_sin( double x, int quadrant_offset )
+{
+  // Infinities and NaNs.
+  if ( !( x >= -std::numeric_limits<double>::max() && x <= std::numeric_limits<double>::max() ) )
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if ( x == 0.0 && quadrant_offset == 0 )
+  {
+    return x;
+  }
+  int          quadrant = 0;
+  double       tail     = 0.0;
+  const double r        = split_half_pi( x, quadrant, tail );
+  switch ( ( quadrant + quadrant_offset ) & 3 )
+  {
+  case 0:
+    return sin_kernel( r, tail );
+  case 1:
+    return cos_kernel( r, tail );
+  case 2:
+    return -sin_kernel( r, tail );
+  default:
+    return -cos_kernel( r, tail );
+  }
+}
+
+[[nodiscard]] constexpr double constexpr_tan( double x )
+{
+  // Infinities and NaNs.
+  if ( !( x >= -std::numeric_limits<double>::max() && x <= std::numeric_limits<double>::max() ) )
+  {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if ( x == 0.0 )
+  {
+    return x;
+  }
+  int          quadrant = 0;
+  double       tail     = 0.0;
+  const double r        = split_half_pi( x, quadrant, tail );
+  const double s        = sin_kernel( r, tail );
+  const double c        = cos_kernel( r, tail );
+  return ( quadrant & 1 ) == 0 ? s / c : -c / s;
+}
+
+} // namespace detail
+
+// std::sqrt, std::sin, std::cos and std::tan at run time, and the implementations above during constant evaluation,
+// so that factories built on them can be constexpr.
+template<std::floating_point T>
+[[nodiscard]] constexpr T sqrt( T x )
+{
+  if consteval
+  {
+    return static_cast<T>( detail::constexpr_sqrt( static_cast<double>( x ) ) );
+  } else
+  {
+    return std::sqrt( x );
+  }
+}
+
+template<std::integral T>
+[[nodiscard]] constexpr double sqrt( T x )
+{
+  return sqrt( static_cast<double>( x ) );
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T sin( T x )
+{
+  if consteval
+  {
+    return static_cast<T>( detail::constexpr_sin( static_cast<double>( x ), 0 ) );
+  } else
+  {
+    return std::sin( x );
+  }
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T cos( T x )
+{
+  if consteval
+  {
+    return static_cast<T>( detail::constexpr_sin( static_cast<double>( x ), 1 ) );
+  } else
+  {
+    return std::cos( x );
+  }
+}
+
+template<std::floating_point T>
+[[nodiscard]] constexpr T tan( T x )
+{
+  if consteval
+  {
+    return static_cast<T>( detail::constexpr_tan( static_cast<double>( x ) ) );
+  } else
+  {
+    return std::tan( x );
+  }
+}
+
+} // namespace linalg
@@ -0,0 +1,124 @@
+#pragma once
+
+#include "vec.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace linalg {
+
+// Compact encodings of unit Vec3 normals. Decoding always returns a unit vector. The angular error bounds are the
+// worst case measured over a dense sampling of the sphere.
+//
+// Oct32 and Oct16 project the normal onto an octahedron and unfold it into a square, stored as two snorm values
+// (x in the low half). Snorm10x3 stores x, y and z as 10-bit snorm values in bits 0-9, 10-19 and 20-29.
+//
+//   Oct32      4 bytes   max error 0.004 degrees
+//   Oct16      2 bytes   max error 1.0 degrees
+//   Snorm10x3  4 bytes   max error 0.1 degrees
+struct Oct32
+{
+  std::uint32_t bits = 0;
+
+  [[nodiscard]] friend constexpr bool operator==( Oct32 left, Oct32 right ) = default;
+};
+
+struct Oct16
+{
+  std::uint16_t bits = 0;
+
+  [[nodiscard]] friend constexpr bool operator==( Oct16 left, Oct16 right ) = default;
+};
+
+struct Snorm10x3
+{
+  std::uint32_t bits = 0;
+
+  [[nodiscard]] friend constexpr bool operator==( Snorm10x3 left, Snorm10x3 right ) = default;
+};
+
+namespace detail {
+
+// The batch kernels in batch.hpp repeat these steps operation for operation, so both produce the same bits.
+template<int Bits>
+[[nodiscard]] inline std::uint32_t quantize_snorm( float value )
+{
+  constexpr float         scale = static_cast<float>( ( 1 << ( Bits - 1 ) ) - 1 );
+  constexpr std::uint32_t mask  = ( 1U << Bits ) - 1;
+  return static_cast<std::uint32_t>( static_cast<std::int32_t>( std::nearbyint( value * scale ) ) ) & mask;
+}
+
+template<int Bits>
+[[nodiscard]] inline float dequantize_snorm( std::uint32_t bits, int shift )
+{
+  constexpr float scale = static_cast<float>( ( 1 << ( Bits - 1 ) ) - 1 );
+  const auto      value = static_cast<std::int32_t>( bits << ( 32 - Bits - shift ) ) >> ( 32 - Bits );
+  return std::max( static_cast<float>( value ) / scale, -1.0F );
+}
+
+template<int Bits>
+[[nodiscard]] inline std::uint32_t encode_octahedral( const Vec3& normal )
+{
+  const float l1 = ( std::abs( normal.x() ) + std::abs( normal.y() ) ) + std::abs( normal.z() );
+  float       u  = normal.x() / l1;
+  float       v  = normal.y() / l1;
+  if ( normal.z() < 0.0F )
+  {
+    // Fold the lower hemisphere over the diagonals.
+    const float folded_u = std::copysign( 1.0F - std::abs( v ), u );
+    v                    = std::copysign( 1.0F - std::abs( u ), v );
+    u                    = folded_u;
+  }
+  return quantize_snorm<Bits>( u ) | ( quantize_snorm<Bits>( v ) << Bits );
+}
+
+template<int Bits>
+[[nodiscard]] inline Vec3 decode_octahedral( std::uint32_t bits )
+{
+  float       u = dequantize_snorm<Bits>( bits, 0 );
+  float       v = dequantize_snorm<Bits>( bits, Bits );
+  const float z = ( 1.0F - std::abs( u ) ) - std::abs( v );
+  const float t = std::max( -z, 0.0F );
+  u -= std::copysign( t, u );
+  v -= std::copysign( t, v );
+  return normalized( Vec3{ u, v, z } );
+}
+
+} // namespace detail
+
+// The input must be non-zero; it does not have to be normalized for the octahedral encodings.
+[[nodiscard]] inline Oct32 encode_oct32( const Vec3& normal )
+{
+  return Oct32{ detail::encode_octahedral<16>( normal ) };
+}
+
+[[nodiscard]] inline Oct16 encode_oct16( const Vec3& normal )
+{
+  return Oct16{ static_cast<std::uint16_t>( detail::encode_octahedral<8>( normal ) ) };
+}
+
+// The input must be a unit vector.
+[[nodiscard]] inline Snorm10x3 encode_snorm10x3( const Vec3& normal )
+{
+  return Snorm10x3{ detail::quantize_snorm<10>( normal.x() ) | ( detail::quantize_snorm<10>( normal.y() ) << 10 )
+                    | ( detail::quantize_snorm<10>( normal.z() ) << 20 ) };
+}
+
+[[nodiscard]] inline Vec3 decode( Oct32 encoded )
+{
+  return detail::decode_octahedral<16>( encoded.bits );
+}
+
+[[nodiscard]] inline Vec3 decode( Oct16 encoded )
+{
+  return detail::decode_octahedral<8>( encoded.bits );
+}
+
+[[nodiscard]] inline Vec3 decode( Snorm10x3 encoded )
+{
+  return normalized( Vec3{ detail::dequantize_snorm<10>( encoded.bits, 0 ),
+    detail::dequantize_snorm<10>( encoded.bits, 10 ),
+    detail::dequantize_snorm<10>( encoded.bits, 20 ) } );
+}
+
+} // namespace linalg
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace linalg {
+
+// Number of threads a batch call may split its range across, including the calling thread. Zero uses
+// std::thread::hardware_concurrency().
+struct Threads
+{
+  size_t count = 1;
+};
+
+namespace detail {
+
+// Below this many elements per thread, starting a thread costs more than it saves.
+inline constexpr size_t min_items_per_thread = 4096;
+
+[[nodiscard]] inline size_t worker_count( size_t count, Threads threads )
+{
+  const size_t requested = threads.count != 0 ? threads.count : std::max( 1U, std::thread::hardware_concurrency() );
+  return std::clamp( count / min_items_per_thread, size_t{ 1 }, requested );
+}
+
+// Calls fn( begin, end ) on disjoint chunks covering [0, count). The first chunk runs on the calling thread, the rest
+// on worker threads that are joined before returning.
+template<typename Fn>
+void parallel_for( size_t count, Threads threads, const Fn& fn )
+{
+  const size_t workers = worker_count( count, threads );
+  if ( workers == 1 )
+  {
+    fn( size_t{ 0 }, count );
+    return;
+  }
+
+  const size_t              chunk = ( count + workers - 1 ) / workers;
+  std::vector<std::jthread> pool;
+  pool.reserve( workers - 1 );
+  for ( size_t begin = chunk; begin < count; begin += chunk )
+  {
+    pool.emplace_back( fn, begin, std::min( begin + chunk, count ) );
+  }
+  fn( size_t{ 0 }, chunk );
+}
+
+} // namespace detail
+
+} // namespace linalg
@@ -4,37 +4,55 @@
 #include "point.hpp"
 #include "transform.hpp"
 #include "vec.hpp"
+#include <concepts>
+#include <limits>
 #include <optional>
 
 namespace linalg {
 
-class Plane : public Vec4
+template<typename T>
+class PlaneT : public Vec<T, 4>
 {
 public:
-  using Vec4::Vec4;
+  using Vec<T, 4>::Vec;
 
-  [[nodiscard]] constexpr Vec3 get_normal() const { return to_sub_vec<3>(); }
+  [[nodiscard]] constexpr Vec<T, 3> get_normal() const { return this->template to_sub_vec<3>(); }
 
-  void normalize_in_place()
+  // Scales the plane so that its normal has unit length; see rsqrt.hpp for the policies.
+  template<RsqrtPolicy Policy = Exact>
+  constexpr void normalize_in_place()
   {
-    float mag = magnitude( get_normal() );
-    *this /= mag;
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      T mag = magnitude( get_normal() );
+      *this /= mag;
+    } else
+    {
+      *this *= rsqrt<Policy>( magnitude_squared( get_normal() ) );
+    }
   }
 };
 
-[[nodiscard]] constexpr float dot( const Plane& plane, const Point3& point )
+using Plane  = PlaneT<float>;
+using DPlane = PlaneT<double>;
+
+// Constrained so that dot<Policy>( a, b ) on plain vectors never tries to instantiate PlaneT<Policy>.
+template<std::floating_point T>
+[[nodiscard]] constexpr T dot( const PlaneT<T>& plane, const Point3T<T>& point )
 {
   return plane.x() * point.x() + plane.y() * point.y() + plane.z() * point.z() + plane.w();
 }
 
-[[nodiscard]] constexpr float dot( const Plane& plane, const Vec3& point )
+template<std::floating_point T>
+[[nodiscard]] constexpr T dot( const PlaneT<T>& plane, const Vec<T, 3>& point )
 {
   return plane.x() * point.x() + plane.y() * point.y() + plane.z() * point.z();
 }
 
-[[nodiscard]] constexpr Plane operator*( const Plane& plane, const Transform4& transform )
+template<typename T>
+[[nodiscard]] constexpr PlaneT<T> operator*( const PlaneT<T>& plane, const Transform4T<T>& transform )
 {
-  return Plane{
+  return PlaneT<T>{
     plane.x() * transform( 0, 0 ) + plane.y() * transform( 1, 0 ) + plane.z() * transform( 2, 0 ),
     plane.x() * transform( 0, 1 ) + plane.y() * transform( 1, 1 ) + plane.z() * transform( 2, 1 ),
     plane.x() * transform( 0, 2 ) + plane.y() * transform( 1, 2 ) + plane.z() * transform( 2, 2 ),
@@ -42,68 +60,75 @@ public:
   };
 }
 
-[[nodiscard]] constexpr Transform4 make_reflection( const Plane& plane )
+template<typename T>
+[[nodiscard]] constexpr Transform4T<T> make_reflection( const PlaneT<T>& plane )
 {
-  float nx_sq = -2.0F * plane.x() * plane.x();
-  float ny_sq = -2.0F * plane.y() * plane.y();
-  float nz_sq = -2.0F * plane.z() * plane.z();
-  float nx_ny = -2.0F * plane.x() * plane.y();
-  float nx_nz = -2.0F * plane.x() * plane.z();
-  float ny_nz = -2.0F * plane.y() * plane.z();
-  float nx_d  = -2.0F * plane.x() * plane.w();
-  float ny_d  = -2.0F * plane.y() * plane.w();
-  float nz_d  = -2.0F * plane.z() * plane.w();
-
-  return Transform4{
-    1.0F + nx_sq,
+  T nx_sq = T{ -2 } * plane.x() * plane.x();
+  T ny_sq = T{ -2 } * plane.y() * plane.y();
+  T nz_sq = T{ -2 } * plane.z() * plane.z();
+  T nx_ny = T{ -2 } * plane.x() * plane.y();
+  T nx_nz = T{ -2 } * plane.x() * plane.z();
+  T ny_nz = T{ -2 } * plane.y() * plane.z();
+  T nx_d  = T{ -2 } * plane.x() * plane.w();
+  T ny_d  = T{ -2 } * plane.y() * plane.w();
+  T nz_d  = T{ -2 } * plane.z() * plane.w();
+
+  return Transform4T<T>{
+    T{ 1 } + nx_sq,
     nx_ny,
     nx_nz,
     nx_d,
     nx_ny,
-    1.0F + ny_sq,
+    T{ 1 } + ny_sq,
     ny_nz,
     ny_d,
     nx_nz,
     ny_nz,
-    1.0F + nz_sq,
+    T{ 1 } + nz_sq,
     nz_d,
   };
 }
 
-[[nodiscard]] inline std::optional<Point3> get_intersection( const Plane& plane, const Line& line )
+template<typename T>
+[[nodiscard]] inline std::optional<Point3T<T>> get_intersection( const PlaneT<T>& plane, const LineT<T>& line )
 {
-  float fp = dot( plane, line.point() );
-  float fv = dot( plane, line.vector() );
-  return std::fabs( fv ) > float_min ? std::optional{ line.point() - ( fp / fv ) * line.vector() } : std::nullopt;
+  T fp = dot( plane, line.point() );
+  T fv = dot( plane, line.vector() );
+  return std::fabs( fv ) > std::numeric_limits<T>::min() ? std::optional{ line.point() - ( fp / fv ) * line.vector() }
+                                                         : std::nullopt;
 }
 
-[[nodiscard]] inline std::optional<Point3> get_intersection( const Plane& a, const Plane& b, const Plane& c )
+template<typename T>
+[[nodiscard]] inline std::optional<Point3T<T>> get_intersection( const PlaneT<T>& a,
+  const PlaneT<T>&                                                              b,
+  const PlaneT<T>&                                                              c )
 {
-  const Vec3& na = a.get_normal();
-  const Vec3& nb = b.get_normal();
-  const Vec3& nc = c.get_normal();
+  const Vec<T, 3>& na = a.get_normal();
+  const Vec<T, 3>& nb = b.get_normal();
+  const Vec<T, 3>& nc = c.get_normal();
 
-  Vec3  cross_na_nb           = cross( na, nb );
-  float scalar_triple_product = dot( cross_na_nb, nc );
+  Vec<T, 3> cross_na_nb           = cross( na, nb );
+  T         scalar_triple_product = dot( cross_na_nb, nc );
 
-  return std::fabs( scalar_triple_product ) > float_min
-           ? std::optional{ ( a.w() * cross( nc, nb ) + b.w() * cross( na, nc ) - c.w() * cross_na_nb )
-                            / scalar_triple_product }
+  return std::fabs( scalar_triple_product ) > std::numeric_limits<T>::min()
+           ? std::optional{ Point3T<T>{ ( a.w() * cross( nc, nb ) + b.w() * cross( na, nc ) - c.w() * cross_na_nb )
+                                        / scalar_triple_product } }
            : std::nullopt;
 }
 
-[[nodiscard]] inline std::optional<Line> get_intersection( const Plane& a, const Plane& b )
+template<typename T>
+[[nodiscard]] inline std::optional<LineT<T>> get_intersection( const PlaneT<T>& a, const PlaneT<T>& b )
 {
-  const Vec3& na = a.get_normal();
-  const Vec3& nb = b.get_normal();
+  const Vec<T, 3>& na = a.get_normal();
+  const Vec<T, 3>& nb = b.get_normal();
 
-  const Vec3& vec                   = cross( na, nb );
-  float       scalar_triple_product = dot( vec, vec );
-  if ( std::fabs( scalar_triple_product ) > float_min )
+  const Vec<T, 3>& vec                   = cross( na, nb );
+  T                scalar_triple_product = dot( vec, vec );
+  if ( std::fabs( scalar_triple_product ) > std::numeric_limits<T>::min() )
   {
-    Point3 point{ ( a.w() * cross( vec, nb ) + b.w() * cross( na, vec ) ) / scalar_triple_product };
+    Point3T<T> point{ ( a.w() * cross( vec, nb ) + b.w() * cross( na, vec ) ) / scalar_triple_product };
     return std::optional{
-      Line{ point, vec }
+      LineT<T>{ point, vec }
     };
   }
   return std::nullopt;
@@ -4,27 +4,34 @@
 
 namespace linalg {
 
-class Point3 : public Vec3
+template<typename T>
+class Point3T : public Vec<T, 3>
 {
 public:
-  constexpr Point3() = default;
-  constexpr Point3( float x, float y, float z ) : Vec3( x, y, z ) {}
-  constexpr Point3( const Vec3& vec ) : Vec3( vec ) {};
+  constexpr Point3T() = default;
+  constexpr Point3T( T x, T y, T z ) : Vec<T, 3>( x, y, z ) {}
+  constexpr Point3T( const Vec<T, 3>& vec ) : Vec<T, 3>( vec ) {};
 };
 
-[[nodiscard]] constexpr Point3 operator+( const Point3& point, const Vec3& vec )
+template<typename T>
+[[nodiscard]] constexpr Point3T<T> operator+( const Point3T<T>& point, const Vec<T, 3>& vec )
 {
-  return Point3{ point.x() + vec.x(), point.y() + vec.y(), point.z() + vec.z() };
+  return Point3T<T>{ point.x() + vec.x(), point.y() + vec.y(), point.z() + vec.z() };
 }
 
-[[nodiscard]] constexpr Point3 operator-( const Point3& point, const Vec3& vec )
+template<typename T>
+[[nodiscard]] constexpr Point3T<T> operator-( const Point3T<T>& point, const Vec<T, 3>& vec )
 {
-  return Point3{ point.x() - vec.x(), point.y() - vec.y(), point.z() - vec.z() };
+  return Point3T<T>{ point.x() - vec.x(), point.y() - vec.y(), point.z() - vec.z() };
 }
 
-[[nodiscard]] constexpr Vec3 operator-( const Point3& a, const Point3& b )
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> operator-( const Point3T<T>& a, const Point3T<T>& b )
 {
-  return Vec3{ a.x() - b.x(), a.y() - b.y(), a.z() - b.z() };
+  return Vec<T, 3>{ a.x() - b.x(), a.y() - b.y(), a.z() - b.z() };
 }
 
+using Point3  = Point3T<float>;
+using DPoint3 = Point3T<double>;
+
 } // namespace linalg
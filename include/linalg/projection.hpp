@@ -1,12 +1,13 @@
 #pragma once
 
 #include "mat4.hpp"
+#include "math.hpp"
 #include <cassert>
 #include <cmath>
 
 namespace linalg {
 
-[[nodiscard]] inline Mat4 look_at( const Vec3& eye, const Vec3& center, const Vec3& up )
+[[nodiscard]] constexpr Mat4 look_at( const Vec3& eye, const Vec3& center, const Vec3& up )
 {
   const Vec3 f = normalized( center - eye );
   const Vec3 s = normalized( cross( f, up ) );
@@ -32,12 +33,12 @@ namespace linalg {
   };
 }
 
-[[nodiscard]] inline Mat4 perspective( float fovy, float aspect, float near_p, float far_p )
+[[nodiscard]] constexpr Mat4 perspective( float fovy, float aspect, float near_p, float far_p )
 {
   assert( std::abs( aspect ) > epsilon );
   assert( far_p > near_p );
 
-  const float tan_half_fov = std::tan( fovy / 2.0F );
+  const float tan_half_fov = tan( fovy / 2.0F );
 
   Mat4 result{};
   result( 0, 0 ) = 1.0F / ( aspect * tan_half_fov );
@@ -49,7 +50,7 @@ namespace linalg {
   return result;
 }
 
-[[nodiscard]] inline Mat4 ortho( float left, float right, float bottom, float top, float near_p, float far_p )
+[[nodiscard]] constexpr Mat4 ortho( float left, float right, float bottom, float top, float near_p, float far_p )
 {
   Mat4 result{};
   result( 0, 0 ) = 2.0F / ( right - left );
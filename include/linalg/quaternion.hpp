@@ -3,106 +3,115 @@
 #include "mat3.hpp"
 #include "mat4.hpp"
 #include "vec.hpp"
+#include "vec_expr.hpp"
+#include <limits>
+#include <numbers>
+#include <type_traits>
 
 namespace linalg {
 
-class Quaternion : public Vec4
+template<typename T>
+class QuaternionT : public Vec<T, 4>
 {
 public:
-  using Vec4::Vec;
+  using Vec<T, 4>::Vec;
+  using Vec<T, 4>::x;
+  using Vec<T, 4>::y;
+  using Vec<T, 4>::z;
+  using Vec<T, 4>::w;
 
-  constexpr Quaternion( const Vec4& v ) : Vec4( v ) {}
+  constexpr QuaternionT( const Vec<T, 4>& v ) : Vec<T, 4>( v ) {}
 
-  [[nodiscard]] constexpr Vec3 get_vector() const { return to_sub_vec<3>(); }
+  [[nodiscard]] constexpr Vec<T, 3> get_vector() const { return this->template to_sub_vec<3>(); }
 
-  [[nodiscard]] constexpr Mat3 get_rotation_matrix()
+  [[nodiscard]] constexpr Mat3T<T> get_rotation_matrix()
   {
-    float x2 = x() * x();
-    float y2 = y() * y();
-    float z2 = z() * z();
-    float xy = x() * y();
-    float xz = x() * z();
-    float yz = y() * z();
-    float wx = w() * x();
-    float wy = w() * y();
-    float wz = w() * z();
-
-    return Mat3{ 1.0F - 2.0F * y2 - 2.0F * z2,
-      2.0F * ( xy - wz ),
-      2.0F * ( xz + wy ),
-      2.0F * ( xy + wz ),
-      1.0F - 2.0F * x2 - 2.0F * z2,
-      2.0F * ( yz - wx ),
-      2.0F * ( xz - wy ),
-      2.0F * ( yz + wx ),
-      1.0F - 2.0F * x2 - 2.0F * y2 };
+    T x2 = x() * x();
+    T y2 = y() * y();
+    T z2 = z() * z();
+    T xy = x() * y();
+    T xz = x() * z();
+    T yz = y() * z();
+    T wx = w() * x();
+    T wy = w() * y();
+    T wz = w() * z();
+
+    return Mat3T<T>{ T{ 1 } - T{ 2 } * y2 - T{ 2 } * z2,
+      T{ 2 } * ( xy - wz ),
+      T{ 2 } * ( xz + wy ),
+      T{ 2 } * ( xy + wz ),
+      T{ 1 } - T{ 2 } * x2 - T{ 2 } * z2,
+      T{ 2 } * ( yz - wx ),
+      T{ 2 } * ( xz - wy ),
+      T{ 2 } * ( yz + wx ),
+      T{ 1 } - T{ 2 } * x2 - T{ 2 } * y2 };
   }
 
-  [[nodiscard]] constexpr Mat4 to_mat4()
+  [[nodiscard]] constexpr Mat4T<T> to_mat4()
   {
-    float x2 = x() * x();
-    float y2 = y() * y();
-    float z2 = z() * z();
-    float xy = x() * y();
-    float xz = x() * z();
-    float yz = y() * z();
-    float wx = w() * x();
-    float wy = w() * y();
-    float wz = w() * z();
-
-    return Mat4{ 1.0F - 2.0F * y2 - 2.0F * z2,
-      2.0F * ( xy - wz ),
-      2.0F * ( xz + wy ),
-      0.0F,
-      2.0F * ( xy + wz ),
-      1.0F - 2.0F * x2 - 2.0F * z2,
-      2.0F * ( yz - wx ),
-      0.0F,
-      2.0F * ( xz - wy ),
-      2.0F * ( yz + wx ),
-      1.0F - 2.0F * x2 - 2.0F * y2,
-      0.0F,
-      0.0F,
-      0.0F,
-      0.0F,
-      1.0F };
+    T x2 = x() * x();
+    T y2 = y() * y();
+    T z2 = z() * z();
+    T xy = x() * y();
+    T xz = x() * z();
+    T yz = y() * z();
+    T wx = w() * x();
+    T wy = w() * y();
+    T wz = w() * z();
+
+    return Mat4T<T>{ T{ 1 } - T{ 2 } * y2 - T{ 2 } * z2,
+      T{ 2 } * ( xy - wz ),
+      T{ 2 } * ( xz + wy ),
+      T{ 0 },
+      T{ 2 } * ( xy + wz ),
+      T{ 1 } - T{ 2 } * x2 - T{ 2 } * z2,
+      T{ 2 } * ( yz - wx ),
+      T{ 0 },
+      T{ 2 } * ( xz - wy ),
+      T{ 2 } * ( yz + wx ),
+      T{ 1 } - T{ 2 } * x2 - T{ 2 } * y2,
+      T{ 0 },
+      T{ 0 },
+      T{ 0 },
+      T{ 0 },
+      T{ 1 } };
   }
 
-  void set_rotation_from_matrix( const Mat3& rotation_mat )
+  constexpr void set_rotation_from_matrix( const Mat<T, 3, 3>& rotation_mat )
   {
-    float m00 = rotation_mat( 0, 0 );
-    float m11 = rotation_mat( 1, 1 );
-    float m22 = rotation_mat( 2, 2 );
-    float sum = m00 + m11 + m22;
+    T m00 = rotation_mat( 0, 0 );
+    T m11 = rotation_mat( 1, 1 );
+    T m22 = rotation_mat( 2, 2 );
+    T sum = m00 + m11 + m22;
 
-    if ( sum > 0.0F )
+    if ( sum > T{ 0 } )
     {
-      w()     = std::sqrt( sum + 1.0F ) * 0.5F;
-      float f = 0.25F / w();
+      w() = sqrt( sum + T{ 1 } ) * T{ 0.5 };
+      T f = T{ 0.25 } / w();
 
       x() = ( rotation_mat( 2, 1 ) - rotation_mat( 1, 2 ) ) * f;
       y() = ( rotation_mat( 0, 2 ) - rotation_mat( 2, 0 ) ) * f;
       z() = ( rotation_mat( 1, 0 ) - rotation_mat( 0, 1 ) ) * f;
     } else if ( ( m00 > m11 ) && ( m00 > m22 ) )
     {
-      x()     = std::sqrt( m00 - m11 - m22 + 1.0F ) * 0.5F;
-      float f = 0.25F / x();
+      x() = sqrt( m00 - m11 - m22 + T{ 1 } ) * T{ 0.5 };
+      T f = T{ 0.25 } / x();
 
       y() = ( rotation_mat( 1, 0 ) + rotation_mat( 0, 1 ) ) * f;
       z() = ( rotation_mat( 0, 2 ) + rotation_mat( 2, 0 ) ) * f;
       w() = ( rotation_mat( 2, 1 ) - rotation_mat( 1, 2 ) ) * f;
     } else if ( m11 > m22 )
     {
-      y()     = std::sqrt( m11 - m00 - m22 + 1.0F ) * 0.5F;
-      float f = 0.25F / y();
+      y() = sqrt( m11 - m00 - m22 + T{ 1 } ) * T{ 0.5 };
+      T f = T{ 0.25 } / y();
 
       x() = ( rotation_mat( 1, 0 ) + rotation_mat( 0, 1 ) ) * f;
       z() = ( rotation_mat( 2, 1 ) + rotation_mat( 1, 2 ) ) * f;
       w() = ( rotation_mat( 0, 2 ) - rotation_mat( 2, 0 ) ) * f;
     } else
     {
-      z()     = std::sqrt( m22 - m00 - m11 + 1.0F ) * 0.5F;
-      float f = 0.25F / z();
+      z() = sqrt( m22 - m00 - m11 + T{ 1 } ) * T{ 0.5 };
+      T f = T{ 0.25 } / z();
 
       x() = ( rotation_mat( 0, 2 ) + rotation_mat( 2, 0 ) ) * f;
       y() = ( rotation_mat( 2, 1 ) + rotation_mat( 1, 2 ) ) * f;
@@ -110,16 +119,17 @@ public:
     }
   }
 
-  void set_rotation_from_mat4( const Mat4& m )
+  constexpr void set_rotation_from_mat4( const Mat<T, 4, 4>& m )
   {
-    Mat3 rot{ m( 0, 0 ), m( 0, 1 ), m( 0, 2 ), m( 1, 0 ), m( 1, 1 ), m( 1, 2 ), m( 2, 0 ), m( 2, 1 ), m( 2, 2 ) };
+    Mat3T<T> rot{ m( 0, 0 ), m( 0, 1 ), m( 0, 2 ), m( 1, 0 ), m( 1, 1 ), m( 1, 2 ), m( 2, 0 ), m( 2, 1 ), m( 2, 2 ) };
     set_rotation_from_matrix( rot );
   }
 };
 
-[[nodiscard]] constexpr Quaternion operator*( const Quaternion& q00, const Quaternion& q01 )
+template<typename T>
+[[nodiscard]] constexpr QuaternionT<T> operator*( const QuaternionT<T>& q00, const QuaternionT<T>& q01 )
 {
-  return Quaternion{
+  return QuaternionT<T>{
     q00.x() * q01.w() + q00.y() * q01.z() - q00.z() * q01.y() + q00.w() * q01.x(),
     q00.y() * q01.w() + q00.z() * q01.x() + q00.w() * q01.y() - q00.x() * q01.z(),
     q00.z() * q01.w() + q00.w() * q01.z() + q00.x() * q01.y() - q00.y() * q01.x(),
@@ -127,48 +137,59 @@ public:
   };
 }
 
-[[nodiscard]] constexpr Vec3 transform( const Vec3& vec, const Quaternion& quat )
+// The inverse of a unit quaternion.
+template<typename T>
+[[nodiscard]] constexpr QuaternionT<T> conjugate( const QuaternionT<T>& q )
 {
-  const Vec3& b         = quat.get_vector();
-  const float c         = quat.w();
-  const float b_squared = magnitude_squared( b );
+  return QuaternionT<T>{ -q.x(), -q.y(), -q.z(), q.w() };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> transform( const Vec<T, 3>& vec, const QuaternionT<T>& quat )
+{
+  const Vec<T, 3>& b         = quat.get_vector();
+  const T          c         = quat.w();
+  const T          b_squared = magnitude_squared( b );
 
-  return ( c * c - b_squared ) * vec + 2.0F * dot( vec, b ) * b + 2.0F * c * cross( b, vec );
+  return ( c * c - b_squared ) * lazy( vec ) + T{ 2 } * dot( vec, b ) * lazy( b )
+         + T{ 2 } * c * lazy( cross( b, vec ) );
 }
 
-[[nodiscard]] inline Vec3 euler_angles( const Quaternion& q )
+template<typename T>
+[[nodiscard]] inline Vec<T, 3> euler_angles( const QuaternionT<T>& q )
 {
-  float sinr_cosp = 2.0F * ( q.w() * q.x() + q.y() * q.z() );
-  float cosr_cosp = 1.0F - 2.0F * ( q.x() * q.x() + q.y() * q.y() );
-  float pitch     = std::atan2( sinr_cosp, cosr_cosp );
+  T sinr_cosp = T{ 2 } * ( q.w() * q.x() + q.y() * q.z() );
+  T cosr_cosp = T{ 1 } - T{ 2 } * ( q.x() * q.x() + q.y() * q.y() );
+  T pitch     = std::atan2( sinr_cosp, cosr_cosp );
 
-  float sinp = 2.0F * ( q.w() * q.y() - q.z() * q.x() );
-  float yaw;
-  if ( std::abs( sinp ) >= 1.0F )
+  T sinp = T{ 2 } * ( q.w() * q.y() - q.z() * q.x() );
+  T yaw;
+  if ( std::abs( sinp ) >= T{ 1 } )
   {
-    yaw = std::copysign( pi / 2.0F, sinp );
+    yaw = std::copysign( std::numbers::pi_v<T> / T{ 2 }, sinp );
   } else
   {
     yaw = std::asin( sinp );
   }
 
-  float siny_cosp = 2.0F * ( q.w() * q.z() + q.x() * q.y() );
-  float cosy_cosp = 1.0F - 2.0F * ( q.y() * q.y() + q.z() * q.z() );
-  float roll      = std::atan2( siny_cosp, cosy_cosp );
+  T siny_cosp = T{ 2 } * ( q.w() * q.z() + q.x() * q.y() );
+  T cosy_cosp = T{ 1 } - T{ 2 } * ( q.y() * q.y() + q.z() * q.z() );
+  T roll      = std::atan2( siny_cosp, cosy_cosp );
 
-  return Vec3{ pitch, yaw, roll };
+  return Vec<T, 3>{ pitch, yaw, roll };
 }
 
-[[nodiscard]] inline Quaternion quat_from_euler( const Vec3& euler )
+template<typename T>
+[[nodiscard]] constexpr QuaternionT<T> quat_from_euler( const Vec<T, 3>& euler )
 {
-  float cx = std::cos( euler.x() * 0.5F );
-  float sx = std::sin( euler.x() * 0.5F );
-  float cy = std::cos( euler.y() * 0.5F );
-  float sy = std::sin( euler.y() * 0.5F );
-  float cz = std::cos( euler.z() * 0.5F );
-  float sz = std::sin( euler.z() * 0.5F );
-
-  return Quaternion{
+  T cx = cos( euler.x() * T{ 0.5 } );
+  T sx = sin( euler.x() * T{ 0.5 } );
+  T cy = cos( euler.y() * T{ 0.5 } );
+  T sy = sin( euler.y() * T{ 0.5 } );
+  T cz = cos( euler.z() * T{ 0.5 } );
+  T sz = sin( euler.z() * T{ 0.5 } );
+
+  return QuaternionT<T>{
     sx * cy * cz - cx * sy * sz,
     cx * sy * cz + sx * cy * sz,
     cx * cy * sz - sx * sy * cz,
@@ -176,20 +197,21 @@ public:
   };
 }
 
-[[nodiscard]] inline Quaternion slerp( const Quaternion& a, const Quaternion& b, float t )
+template<typename T>
+[[nodiscard]] inline QuaternionT<T> slerp( const QuaternionT<T>& a, const QuaternionT<T>& b, std::type_identity_t<T> t )
 {
-  float cos_theta = dot( static_cast<const Vec4&>( a ), static_cast<const Vec4&>( b ) );
+  T cos_theta = dot( static_cast<const Vec<T, 4>&>( a ), static_cast<const Vec<T, 4>&>( b ) );
 
-  Quaternion b_adj = b;
-  if ( cos_theta < 0.0F )
+  QuaternionT<T> b_adj = b;
+  if ( cos_theta < T{ 0 } )
   {
     cos_theta = -cos_theta;
-    b_adj     = Quaternion{ -b.x(), -b.y(), -b.z(), -b.w() };
+    b_adj     = QuaternionT<T>{ -b.x(), -b.y(), -b.z(), -b.w() };
   }
 
-  if ( cos_theta > 1.0F - epsilon )
+  if ( cos_theta > T{ 1 } - std::numeric_limits<T>::epsilon() )
   {
-    return Quaternion{
+    return QuaternionT<T>{
       a.x() + t * ( b_adj.x() - a.x() ),
       a.y() + t * ( b_adj.y() - a.y() ),
       a.z() + t * ( b_adj.z() - a.z() ),
@@ -197,12 +219,12 @@ public:
     };
   }
 
-  float theta     = std::acos( cos_theta );
-  float sin_theta = std::sin( theta );
-  float wa        = std::sin( ( 1.0F - t ) * theta ) / sin_theta;
-  float wb        = std::sin( t * theta ) / sin_theta;
+  T theta     = std::acos( cos_theta );
+  T sin_theta = std::sin( theta );
+  T wa        = std::sin( ( T{ 1 } - t ) * theta ) / sin_theta;
+  T wb        = std::sin( t * theta ) / sin_theta;
 
-  return Quaternion{
+  return QuaternionT<T>{
     wa * a.x() + wb * b_adj.x(),
     wa * a.y() + wb * b_adj.y(),
     wa * a.z() + wb * b_adj.z(),
@@ -210,6 +232,8 @@ public:
   };
 }
 
-using Quat = Quaternion;
+using Quaternion  = QuaternionT<float>;
+using DQuaternion = QuaternionT<double>;
+using Quat        = Quaternion;
 
 } // namespace linalg
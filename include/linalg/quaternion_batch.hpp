@@ -0,0 +1,875 @@
+#pragma once
+
+#include "quaternion.hpp"
+#include "transform.hpp"
+#include "vec_batch.hpp"
+#include "vmath.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace linalg {
+
+// Structure-of-arrays quaternions: x, y, z and w each in their own lane of a Vec4Batch.
+class QuaternionBatch : public Vec4Batch
+{
+public:
+  QuaternionBatch() = default;
+  explicit QuaternionBatch( size_t size ) : Vec4Batch( size ) {}
+  explicit QuaternionBatch( std::span<const Quaternion> quats ) : Vec4Batch( quats.size() )
+  {
+    for ( size_t i = 0; i != quats.size(); ++i )
+    {
+      set( i, quats[i] );
+    }
+  }
+
+  [[nodiscard]] Quaternion operator[]( size_t i ) const { return Quaternion{ Vec4Batch::operator[]( i ) }; }
+
+  using Vec4Batch::copy_to;
+  void copy_to( std::span<Quaternion> out ) const
+  {
+    assert( out.size() == size() );
+    for ( size_t i = 0; i != size(); ++i )
+    {
+      out[i] = ( *this )[i];
+    }
+  }
+};
+
+// The order in which the batched Euler conversions apply the rotations about the fixed x, y and z axes; XYZ rotates
+// about x first and z last, the convention of quat_from_euler and euler_angles. The angles stay ( x, y, z ) in every
+// order. Applying them in a given order about the fixed axes equals the reverse order about the rotating axes, so ZYX
+// here is intrinsic XYZ.
+enum class EulerOrder : std::uint8_t {
+  XYZ,
+  XZY,
+  YXZ,
+  YZX,
+  ZXY,
+  ZYX,
+};
+
+namespace detail {
+
+template<MathPrecision P>
+struct SlerpMode
+{};
+
+struct NlerpMode
+{};
+
+struct CorrectedNlerpMode
+{};
+
+// Blends one register of quaternions, a[c] and b[c] holding component c. b is negated where dot( a, b ) < 0 by
+// flipping sign bits, so both halves of the double cover take the same path.
+template<typename Mode, typename L>
+void blend_lanes( const typename L::pack ( &a )[4],
+  typename L::pack ( &b )[4],
+  typename L::pack t,
+  typename L::pack ( &out )[4] )
+{
+  const auto one = L::splat( 1.0F );
+  auto       d   = L::mul( a[0], b[0] );
+  for ( size_t c = 1; c != 4; ++c )
+  {
+    d = L::fmadd( a[c], b[c], d );
+  }
+  const auto sign = L::bit_and( d, L::splat( -0.0F ) );
+  for ( size_t c = 0; c != 4; ++c )
+  {
+    b[c] = L::bit_xor( b[c], sign );
+  }
+  d = L::min( L::abs( d ), one );
+
+  if constexpr ( std::same_as<Mode, SlerpMode<Precise>> || std::same_as<Mode, SlerpMode<Fast>> )
+  {
+    // With cos( theta ) = d: sin( t theta ) / sin( theta ) weighs b, and sin( ( 1 - t ) theta ) / sin( theta ) =
+    // cos( t theta ) - d * sin( t theta ) / sin( theta ) weighs a. Nearly equal inputs fall back to lerp as in slerp.
+    constexpr bool precise = std::same_as<Mode, SlerpMode<Precise>>;
+    using P                = std::conditional_t<precise, Precise, Fast>;
+    const auto theta       = acos_lanes<P>( L{}, d );
+    typename L::pack sin_t_theta;
+    typename L::pack cos_t_theta;
+    sincos_lanes<P>( L{}, L::mul( t, theta ), sin_t_theta, cos_t_theta );
+    const auto sin_theta = L::sqrt( L::mul( L::sub( one, d ), L::add( one, d ) ) );
+    const auto ratio     = L::div( sin_t_theta, sin_theta );
+    const auto lerp      = L::splat( 1.0F - std::numeric_limits<float>::epsilon() );
+    const auto wb        = L::select_less( lerp, d, t, ratio );
+    const auto wa        = L::select_less( lerp, d, L::sub( one, t ), L::sub( cos_t_theta, L::mul( d, ratio ) ) );
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      out[c] = L::fmadd( wa, a[c], L::mul( wb, b[c] ) );
+    }
+  } else
+  {
+    if constexpr ( std::same_as<Mode, CorrectedNlerpMode> )
+    {
+      // Moves t along the cubic t + t ( t - 1/2 )( t - 1 ) k( d, t ), fitted so that the normalized lerp tracks the
+      // constant angular velocity of slerp (A. Kapoulkine, "Approximating slerp").
+      static constexpr float a_coefficients[] = { -1.43519F, 3.55645F, -3.2452F, 1.0904F };
+      static constexpr float b_coefficients[] = { 0.215638F, -1.06021F, 0.848013F };
+      const auto             centered         = L::sub( t, L::splat( 0.5F ) );
+      const auto             k                = L::fmadd( polynomial<L>( d, a_coefficients ),
+        L::mul( centered, centered ),
+        polynomial<L>( d, b_coefficients ) );
+      t = L::fmadd( L::mul( L::mul( t, centered ), L::sub( t, one ) ), k, t );
+    }
+    typename L::pack length_squared = L::splat( 0.0F );
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      out[c]         = L::fmadd( t, L::sub( b[c], a[c] ), a[c] );
+      length_squared = L::fmadd( out[c], out[c], length_squared );
+    }
+    const auto inverse_length = L::template rsqrt<Refined>( length_squared );
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      out[c] = L::mul( out[c], inverse_length );
+    }
+  }
+}
+
+static_assert( sizeof( Quaternion ) == 4 * sizeof( float ) );
+
+// Transposes up to one register of interleaved quaternions into component registers; missing ones are the identity.
+template<typename L>
+void load_quaternions( std::span<const Quaternion> quats, typename L::pack ( &out )[4] )
+{
+  if ( quats.size() == L::width )
+  {
+    L::load_deinterleave4( quats.front().data(), out );
+    return;
+  }
+  std::array<Quaternion, L::width> padded;
+  padded.fill( Quaternion{ 0.0F, 0.0F, 0.0F, 1.0F } );
+  std::copy( quats.begin(), quats.end(), padded.begin() );
+  L::load_deinterleave4( padded.front().data(), out );
+}
+
+template<typename L>
+void store_quaternions( const typename L::pack ( &in )[4], std::span<Quaternion> quats )
+{
+  if ( quats.size() == L::width )
+  {
+    L::store_interleave4( quats.front().data(), in );
+    return;
+  }
+  std::array<Quaternion, L::width> padded;
+  L::store_interleave4( padded.front().data(), in );
+  std::copy_n( padded.begin(), quats.size(), quats.begin() );
+}
+
+// Blends a register of quaternions at a time; time( i, count ) returns the parameters of elements [i, i + count). The
+// tail goes through identity-padded registers, so results do not depend on the position of an element.
+template<typename Mode, typename Time>
+void blend( std::span<const Quaternion> a, std::span<const Quaternion> b, Time time, std::span<Quaternion> out )
+{
+  using L = MathLanes;
+  assert( a.size() == out.size() && b.size() == out.size() );
+  typename L::pack qa[4];
+  typename L::pack qb[4];
+  typename L::pack result[4];
+  for ( size_t i = 0; i < out.size(); i += L::width )
+  {
+    const size_t count = std::min( L::width, out.size() - i );
+    load_quaternions<L>( a.subspan( i, count ), qa );
+    load_quaternions<L>( b.subspan( i, count ), qb );
+    blend_lanes<Mode, L>( qa, qb, time( i, count ), result );
+    store_quaternions<L>( result, out.subspan( i, count ) );
+  }
+}
+
+template<typename Mode>
+void blend( std::span<const Quaternion> a, std::span<const Quaternion> b, float t, std::span<Quaternion> out )
+{
+  blend<Mode>( a, b, [t]( size_t, size_t ) { return MathLanes::splat( t ); }, out );
+}
+
+template<typename Mode>
+void blend( std::span<const Quaternion> a,
+  std::span<const Quaternion>           b,
+  std::span<const float>                t,
+  std::span<Quaternion>                 out )
+{
+  assert( t.size() == out.size() );
+  blend<Mode>(
+    a,
+    b,
+    [t]( size_t i, size_t count ) {
+      std::array<float, MathLanes::width> buffer{};
+      std::copy_n( t.data() + i, count, buffer.data() );
+      return MathLanes::load( buffer.data() );
+    },
+    out );
+}
+
+// Runs over every lane including the padding, which VecBatch keeps a whole number of registers long.
+template<typename Mode>
+void blend( const QuaternionBatch& a, const QuaternionBatch& b, float t, QuaternionBatch& out )
+{
+  using L = MathLanes;
+  assert( a.size() == b.size() );
+  out.resize( a.size() );
+  const ConstLanes<float, 4>   l( a );
+  const ConstLanes<float, 4>   r( b );
+  const MutableLanes<float, 4> o( out );
+  typename L::pack             qa[4];
+  typename L::pack             qb[4];
+  typename L::pack             result[4];
+  for ( size_t i = 0; i < out.padded_size(); i += L::width )
+  {
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      qa[c] = L::load( l.ptr[c] + i );
+      qb[c] = L::load( r.ptr[c] + i );
+    }
+    blend_lanes<Mode, L>( qa, qb, L::splat( t ), result );
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      L::store( o.ptr[c] + i, result[c] );
+    }
+  }
+}
+
+// The rotation matrices of a register of unit quaternions, columns[c][r] holding row r of column c. The same products
+// as QuaternionT::get_rotation_matrix.
+template<typename L>
+void rotation_matrix_lanes( const typename L::pack ( &q )[4], typename L::pack ( &columns )[3][3] )
+{
+  const auto one = L::splat( 1.0F );
+  const auto x2  = L::add( q[0], q[0] );
+  const auto y2  = L::add( q[1], q[1] );
+  const auto z2  = L::add( q[2], q[2] );
+  const auto xx  = L::mul( q[0], x2 );
+  const auto yy  = L::mul( q[1], y2 );
+  const auto zz  = L::mul( q[2], z2 );
+  const auto xy  = L::mul( q[0], y2 );
+  const auto xz  = L::mul( q[0], z2 );
+  const auto yz  = L::mul( q[1], z2 );
+  const auto wx  = L::mul( q[3], x2 );
+  const auto wy  = L::mul( q[3], y2 );
+  const auto wz  = L::mul( q[3], z2 );
+  columns[0][0]  = L::sub( one, L::add( yy, zz ) );
+  columns[0][1]  = L::add( xy, wz );
+  columns[0][2]  = L::sub( xz, wy );
+  columns[1][0]  = L::sub( xy, wz );
+  columns[1][1]  = L::sub( one, L::add( xx, zz ) );
+  columns[1][2]  = L::add( yz, wx );
+  columns[2][0]  = L::add( xz, wy );
+  columns[2][1]  = L::sub( yz, wx );
+  columns[2][2]  = L::sub( one, L::add( xx, yy ) );
+}
+
+// The unit quaternions of a register of rotation matrices. Every lane evaluates the four paths of
+// QuaternionT::set_rotation_from_matrix, each of which divides by the component it takes from the diagonal, and keeps
+// the one the scalar code would branch to: w while the trace is positive, otherwise the component of the largest
+// diagonal element. The results therefore have the same sign as the scalar ones.
+template<typename L>
+void quaternion_from_matrix_lanes( const typename L::pack ( &columns )[3][3], typename L::pack ( &q )[4] )
+{
+  const auto one   = L::splat( 1.0F );
+  const auto m00   = columns[0][0];
+  const auto m11   = columns[1][1];
+  const auto m22   = columns[2][2];
+  const auto trace = L::add( L::add( m00, m11 ), m22 );
+  // Four times w x, w y, w z, x y, x z and y z.
+  const auto wx = L::sub( columns[1][2], columns[2][1] );
+  const auto wy = L::sub( columns[2][0], columns[0][2] );
+  const auto wz = L::sub( columns[0][1], columns[1][0] );
+  const auto xy = L::add( columns[0][1], columns[1][0] );
+  const auto xz = L::add( columns[2][0], columns[0][2] );
+  const auto yz = L::add( columns[1][2], columns[2][1] );
+  // Each path is ( x, y, z, w ) times 4 c for the component c it takes from the diagonal, which is then 4 c^2.
+  const typename L::pack z_path[4] = { xz, yz, L::sub( L::add( one, m22 ), L::add( m00, m11 ) ), wz };
+  const typename L::pack y_path[4] = { xy, L::sub( L::add( one, m11 ), L::add( m00, m22 ) ), yz, wy };
+  const typename L::pack x_path[4] = { L::sub( L::add( one, m00 ), L::add( m11, m22 ) ), xy, xz, wx };
+  const typename L::pack w_path[4] = { wx, wy, wz, L::add( one, trace ) };
+  const auto             use_y     = [&]( auto y, auto z ) { return L::select_less( m22, m11, y, z ); };
+  const auto             use_x     = [&, max_yz = L::max( m11, m22 )]( auto x, auto other ) {
+    return L::select_less( max_yz, m00, x, other );
+  };
+  const auto use_w = [&]( auto w, auto other ) { return L::select_less( L::splat( 0.0F ), trace, w, other ); };
+  typename L::pack selected[4];
+  for ( size_t c = 0; c != 4; ++c )
+  {
+    selected[c] = use_w( w_path[c], use_x( x_path[c], use_y( y_path[c], z_path[c] ) ) );
+  }
+  const auto diagonal = use_w( w_path[3], use_x( x_path[0], use_y( y_path[1], z_path[2] ) ) );
+  // 4 c^2 = diagonal gives c = diagonal / ( 2 sqrt( diagonal ) ) and the others 4 c k / ( 4 c ).
+  const auto scale = L::mul( L::splat( 0.5F ), L::template rsqrt<Refined>( diagonal ) );
+  for ( size_t c = 0; c != 4; ++c )
+  {
+    q[c] = L::mul( selected[c], scale );
+  }
+}
+
+// The dimension of Mat3, Mat4 and Transform4, which store their columns as dimension^2 consecutive floats.
+template<typename Matrix>
+inline constexpr size_t dimension_of = std::derived_from<Matrix, Mat4> ? 4 : 3;
+
+// Matrices are moved as four-float groups starting at these floats: all four columns of a 4x4 matrix, and for a 3x3
+// matrix two groups plus one overlapping the second to reach the last float.
+template<typename Matrix>
+inline constexpr std::array<size_t, dimension_of<Matrix>> group_offsets = [] {
+  if constexpr ( dimension_of<Matrix> == 4 )
+  {
+    return std::array<size_t, 4>{ 0, 4, 8, 12 };
+  } else
+  {
+    return std::array<size_t, 3>{ 0, 4, 5 };
+  }
+}();
+
+// Writes the rotation matrices of the first matrices.size() lanes, 4x4 ones with the zero translation of to_mat4.
+// The groups are interleaved with SIMD and copied whole, which avoids scattering single floats.
+template<typename L, typename Matrix>
+void store_matrices( const typename L::pack ( &columns )[3][3], std::span<Matrix> matrices )
+{
+  constexpr size_t n       = dimension_of<Matrix>;
+  constexpr auto   offsets = group_offsets<Matrix>;
+  static_assert( sizeof( Matrix ) == n * n * sizeof( float ) );
+  alignas( 64 ) std::array<float, offsets.size() * 4 * L::width> staged;
+  for ( size_t g = 0; g != offsets.size(); ++g )
+  {
+    typename L::pack group[4];
+    for ( size_t lane = 0; lane != 4; ++lane )
+    {
+      const size_t c = ( offsets[g] + lane ) / n;
+      const size_t r = ( offsets[g] + lane ) % n;
+      group[lane]    = c < 3 && r < 3 ? columns[c][r] : L::splat( c == r ? 1.0F : 0.0F );
+    }
+    L::store_interleave4( staged.data() + g * 4 * L::width, group );
+  }
+  for ( size_t i = 0; i != matrices.size(); ++i )
+  {
+    auto* flat = reinterpret_cast<float*>( &matrices[i] );
+    for ( size_t g = 0; g != offsets.size(); ++g )
+    {
+      std::memcpy( flat + offsets[g], staged.data() + ( g * L::width + i ) * 4, 4 * sizeof( float ) );
+    }
+  }
+}
+
+// The group and lane holding row r of column c of the rotation block at [c][r], following group_offsets.
+template<typename Matrix>
+inline constexpr auto group_lanes = [] {
+  constexpr size_t n       = dimension_of<Matrix>;
+  constexpr auto   offsets = group_offsets<Matrix>;
+
+  std::array<std::array<std::pair<size_t, size_t>, 3>, 3> result{};
+  for ( size_t c = 0; c != 3; ++c )
+  {
+    for ( size_t r = 0; r != 3; ++r )
+    {
+      size_t g = 0;
+      while ( offsets[g] + 4 <= c * n + r )
+      {
+        ++g;
+      }
+      result[c][r] = { g, c * n + r - offsets[g] };
+    }
+  }
+  return result;
+}();
+
+// Reads the rotation blocks of up to one register of matrices; missing ones are the identity.
+template<typename L, typename Matrix>
+void load_matrices( std::span<const Matrix> matrices, typename L::pack ( &columns )[3][3] )
+{
+  if ( matrices.size() != L::width )
+  {
+    std::array<Matrix, L::width> padded{};
+    std::copy( matrices.begin(), matrices.end(), padded.begin() );
+    for ( size_t i = matrices.size(); i != L::width; ++i )
+    {
+      for ( size_t k = 0; k != 3; ++k )
+      {
+        padded[i]( k, k ) = 1.0F;
+      }
+    }
+    load_matrices<L>( std::span<const Matrix>{ padded }, columns );
+    return;
+  }
+  constexpr size_t n       = dimension_of<Matrix>;
+  constexpr auto   offsets = group_offsets<Matrix>;
+  static_assert( sizeof( Matrix ) == n * n * sizeof( float ) );
+  alignas( 64 ) std::array<float, offsets.size() * 4 * L::width> staged;
+  for ( size_t i = 0; i != L::width; ++i )
+  {
+    const auto* flat = reinterpret_cast<const float*>( &matrices[i] );
+    for ( size_t g = 0; g != offsets.size(); ++g )
+    {
+      std::memcpy( staged.data() + ( g * L::width + i ) * 4, flat + offsets[g], 4 * sizeof( float ) );
+    }
+  }
+  typename L::pack groups[offsets.size()][4];
+  for ( size_t g = 0; g != offsets.size(); ++g )
+  {
+    L::load_deinterleave4( staged.data() + g * 4 * L::width, groups[g] );
+  }
+  for ( size_t c = 0; c != 3; ++c )
+  {
+    for ( size_t r = 0; r != 3; ++r )
+    {
+      const auto [g, lane] = group_lanes<Matrix>[c][r];
+      columns[c][r]        = groups[g][lane];
+    }
+  }
+}
+
+template<typename Matrix>
+void to_matrices( std::span<const Quaternion> quats, std::span<Matrix> out )
+{
+  using L = MathLanes;
+  assert( quats.size() == out.size() );
+  typename L::pack q[4];
+  typename L::pack columns[3][3];
+  for ( size_t i = 0; i < out.size(); i += L::width )
+  {
+    const size_t count = std::min( L::width, out.size() - i );
+    load_quaternions<L>( quats.subspan( i, count ), q );
+    rotation_matrix_lanes<L>( q, columns );
+    store_matrices<L>( columns, out.subspan( i, count ) );
+  }
+}
+
+template<typename Matrix>
+void to_matrices( const QuaternionBatch& quats, std::span<Matrix> out )
+{
+  using L = MathLanes;
+  assert( quats.size() == out.size() );
+  const ConstLanes<float, 4> lanes( quats );
+  typename L::pack           q[4];
+  typename L::pack           columns[3][3];
+  for ( size_t i = 0; i < out.size(); i += L::width )
+  {
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      q[c] = L::load( lanes.ptr[c] + i );
+    }
+    rotation_matrix_lanes<L>( q, columns );
+    store_matrices<L>( columns, out.subspan( i, std::min( L::width, out.size() - i ) ) );
+  }
+}
+
+template<typename Matrix>
+void quats_from_matrices( std::span<const Matrix> matrices, std::span<Quaternion> out )
+{
+  using L = MathLanes;
+  assert( matrices.size() == out.size() );
+  typename L::pack columns[3][3];
+  typename L::pack q[4];
+  for ( size_t i = 0; i < out.size(); i += L::width )
+  {
+    const size_t count = std::min( L::width, out.size() - i );
+    load_matrices<L>( matrices.subspan( i, count ), columns );
+    quaternion_from_matrix_lanes<L>( columns, q );
+    store_quaternions<L>( q, out.subspan( i, count ) );
+  }
+}
+
+// Fills the padding lanes too, from identity matrices.
+template<typename Matrix>
+void quats_from_matrices( std::span<const Matrix> matrices, QuaternionBatch& out )
+{
+  using L = MathLanes;
+  out.resize( matrices.size() );
+  const MutableLanes<float, 4> lanes( out );
+  typename L::pack             columns[3][3];
+  typename L::pack             q[4];
+  for ( size_t i = 0; i < out.padded_size(); i += L::width )
+  {
+    const size_t begin = std::min( i, matrices.size() );
+    load_matrices<L>( matrices.subspan( begin, std::min( L::width, matrices.size() - begin ) ), columns );
+    quaternion_from_matrix_lanes<L>( columns, q );
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      L::store( lanes.ptr[c] + i, q[c] );
+    }
+  }
+}
+
+// The axes of an EulerOrder in the order they are applied, and +1 if e_first x e_second = e_third, else -1.
+struct EulerAxes
+{
+  size_t first;
+  size_t second;
+  size_t third;
+  float  parity;
+};
+
+[[nodiscard]] constexpr EulerAxes euler_axes( EulerOrder order )
+{
+  switch ( order )
+  {
+  case EulerOrder::XYZ: return { 0, 1, 2, 1.0F };
+  case EulerOrder::XZY: return { 0, 2, 1, -1.0F };
+  case EulerOrder::YXZ: return { 1, 0, 2, -1.0F };
+  case EulerOrder::YZX: return { 1, 2, 0, 1.0F };
+  case EulerOrder::ZXY: return { 2, 0, 1, 1.0F };
+  case EulerOrder::ZYX: return { 2, 1, 0, -1.0F };
+  }
+  return { 0, 1, 2, 1.0F };
+}
+
+// q = q3 * q2 * q1 for the rotations q1, q2 and q3 about the first, second and third axes, written out with the
+// half-angle sines and cosines. For XYZ these are the products of quat_from_euler.
+template<MathPrecision P, typename L>
+void quaternion_from_euler_lanes(
+  const typename L::pack ( &angles )[3], const EulerAxes& axes, typename L::pack ( &q )[4] )
+{
+  typename L::pack s[3];
+  typename L::pack c[3];
+  for ( size_t k = 0; k != 3; ++k )
+  {
+    sincos_lanes<P>( L{}, L::mul( angles[k], L::splat( 0.5F ) ), s[k], c[k] );
+  }
+  const size_t i      = axes.first;
+  const size_t j      = axes.second;
+  const size_t k      = axes.third;
+  const auto   parity = L::splat( axes.parity );
+  const auto   sk     = L::mul( parity, s[k] );
+  const auto   cc     = L::mul( c[k], c[j] );
+  const auto   cs     = L::mul( c[k], s[j] );
+  const auto   sc     = L::mul( sk, c[j] );
+  const auto   ss     = L::mul( sk, s[j] );
+  q[i]                = L::sub( L::mul( cc, s[i] ), L::mul( ss, c[i] ) );
+  q[j]                = L::fmadd( cs, c[i], L::mul( sc, s[i] ) );
+  q[k]                = L::mul( parity, L::sub( L::mul( sc, c[i] ), L::mul( cs, s[i] ) ) );
+  q[3]                = L::fmadd( cc, c[i], L::mul( ss, s[i] ) );
+}
+
+// The inverse, as in euler_angles: the second angle is an asin and the outer ones atan2s of matrix elements. At the
+// poles the sine of the second angle is clamped to +-1 rather than branched on, which gives the same +-pi/2.
+template<MathPrecision P, typename L>
+void euler_from_quaternion_lanes(
+  const typename L::pack ( &q )[4], const EulerAxes& axes, typename L::pack ( &angles )[3] )
+{
+  const size_t i      = axes.first;
+  const size_t j      = axes.second;
+  const size_t k      = axes.third;
+  const auto   parity = L::splat( axes.parity );
+  const auto   one    = L::splat( 1.0F );
+  const auto   two    = L::splat( 2.0F );
+  const auto   w      = q[3];
+
+  const auto sin_second = L::mul( two, L::sub( L::mul( w, q[j] ), L::mul( parity, L::mul( q[i], q[k] ) ) ) );
+  angles[j]             = asin_lanes<P>( L{}, L::min( L::max( sin_second, L::splat( -1.0F ) ), one ) );
+  angles[i]             = atan2_lanes<P>( L{},
+    L::mul( two, L::fmadd( w, q[i], L::mul( parity, L::mul( q[j], q[k] ) ) ) ),
+    L::sub( one, L::mul( two, L::fmadd( q[i], q[i], L::mul( q[j], q[j] ) ) ) ) );
+  angles[k]             = atan2_lanes<P>( L{},
+    L::mul( two, L::fmadd( w, q[k], L::mul( parity, L::mul( q[i], q[j] ) ) ) ),
+    L::sub( one, L::mul( two, L::fmadd( q[j], q[j], L::mul( q[k], q[k] ) ) ) ) );
+}
+
+// Both conversions run over every lane including the padding.
+template<MathPrecision P>
+void quats_from_euler( const Vec3Batch& euler, QuaternionBatch& out, EulerOrder order )
+{
+  using L = MathLanes;
+  out.resize( euler.size() );
+  const EulerAxes              axes = euler_axes( order );
+  const ConstLanes<float, 3>   e( euler );
+  const MutableLanes<float, 4> o( out );
+  typename L::pack             angles[3];
+  typename L::pack             q[4];
+  for ( size_t i = 0; i < out.padded_size(); i += L::width )
+  {
+    for ( size_t c = 0; c != 3; ++c )
+    {
+      angles[c] = L::load( e.ptr[c] + i );
+    }
+    quaternion_from_euler_lanes<P, L>( angles, axes, q );
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      L::store( o.ptr[c] + i, q[c] );
+    }
+  }
+}
+
+template<MathPrecision P>
+void euler_angles( const QuaternionBatch& quats, Vec3Batch& out, EulerOrder order )
+{
+  using L = MathLanes;
+  out.resize( quats.size() );
+  const EulerAxes              axes = euler_axes( order );
+  const ConstLanes<float, 4>   r( quats );
+  const MutableLanes<float, 3> o( out );
+  typename L::pack             q[4];
+  typename L::pack             angles[3];
+  for ( size_t i = 0; i < out.padded_size(); i += L::width )
+  {
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      q[c] = L::load( r.ptr[c] + i );
+    }
+    euler_from_quaternion_lanes<P, L>( q, axes, angles );
+    for ( size_t c = 0; c != 3; ++c )
+    {
+      L::store( o.ptr[c] + i, angles[c] );
+    }
+  }
+}
+
+// out = v + 2 r x ( r x v + w v ) for the unit quaternion ( r, w ), the rotation of transform( Vec3, Quaternion ).
+template<typename L>
+void rotate_lanes( const typename L::pack ( &q )[4], const typename L::pack ( &v )[3], typename L::pack ( &out )[3] )
+{
+  typename L::pack c[3];
+  for ( size_t k = 0; k != 3; ++k )
+  {
+    const size_t a = ( k + 1 ) % 3;
+    const size_t b = ( k + 2 ) % 3;
+    c[k]           = L::fmadd( q[3], v[k], L::sub( L::mul( q[a], v[b] ), L::mul( q[b], v[a] ) ) );
+  }
+  for ( size_t k = 0; k != 3; ++k )
+  {
+    const size_t a = ( k + 1 ) % 3;
+    const size_t b = ( k + 2 ) % 3;
+    const auto   d = L::sub( L::mul( q[a], c[b] ), L::mul( q[b], c[a] ) );
+    out[k]         = L::fmadd( L::splat( 2.0F ), d, v[k] );
+  }
+}
+
+// Both rotations run over every lane including the padding. A single quaternion is applied as its rotation matrix,
+// splat once: nine multiply-adds per register against the 18 operations of rotate_lanes.
+inline void rotate( Quaternion q, const Vec3Batch& in, Vec3Batch& out )
+{
+  using L = MathLanes;
+  out.resize( in.size() );
+  const Mat3       r = q.get_rotation_matrix();
+  typename L::pack m[3][3];
+  for ( size_t row = 0; row != 3; ++row )
+  {
+    for ( size_t col = 0; col != 3; ++col )
+    {
+      m[row][col] = L::splat( r( row, col ) );
+    }
+  }
+  const ConstLanes<float, 3>   v( in );
+  const MutableLanes<float, 3> o( out );
+  for ( size_t i = 0; i < out.padded_size(); i += L::width )
+  {
+    const auto x = L::load( v.ptr[0] + i );
+    const auto y = L::load( v.ptr[1] + i );
+    const auto z = L::load( v.ptr[2] + i );
+    for ( size_t row = 0; row != 3; ++row )
+    {
+      L::store( o.ptr[row] + i, L::fmadd( m[row][2], z, L::fmadd( m[row][1], y, L::mul( m[row][0], x ) ) ) );
+    }
+  }
+}
+
+inline void rotate( const QuaternionBatch& quats, const Vec3Batch& in, Vec3Batch& out )
+{
+  using L = MathLanes;
+  assert( quats.size() == in.size() );
+  out.resize( in.size() );
+  const ConstLanes<float, 4>   r( quats );
+  const ConstLanes<float, 3>   v( in );
+  const MutableLanes<float, 3> o( out );
+  typename L::pack             q[4];
+  typename L::pack             vec[3];
+  typename L::pack             result[3];
+  for ( size_t i = 0; i < out.padded_size(); i += L::width )
+  {
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      q[c] = L::load( r.ptr[c] + i );
+    }
+    for ( size_t c = 0; c != 3; ++c )
+    {
+      vec[c] = L::load( v.ptr[c] + i );
+    }
+    rotate_lanes<L>( q, vec, result );
+    for ( size_t c = 0; c != 3; ++c )
+    {
+      L::store( o.ptr[c] + i, result[c] );
+    }
+  }
+}
+
+} // namespace detail
+
+// Batched slerp of unit quaternions: out[i] = slerp( a[i], b[i], t ) or slerp( a[i], b[i], t[i] ), taking the shorter
+// arc. Branch-free, with acos and sincos from vmath.hpp; for 0 <= t <= 1 both precisions stay within 6e-7 rad of
+// exact slerp, like the scalar slerp. Outputs may alias the inputs.
+template<MathPrecision P = Precise>
+void slerp( std::span<const Quaternion> a, std::span<const Quaternion> b, float t, std::span<Quaternion> out )
+{
+  detail::blend<detail::SlerpMode<P>>( a, b, t, out );
+}
+
+template<MathPrecision P = Precise>
+void slerp( std::span<const Quaternion> a,
+  std::span<const Quaternion>           b,
+  std::span<const float>                t,
+  std::span<Quaternion>                 out )
+{
+  detail::blend<detail::SlerpMode<P>>( a, b, t, out );
+}
+
+template<MathPrecision P = Precise>
+void slerp( const QuaternionBatch& a, const QuaternionBatch& b, float t, QuaternionBatch& out )
+{
+  detail::blend<detail::SlerpMode<P>>( a, b, t, out );
+}
+
+// Normalized lerp along the shorter arc. The path is exact but the angular velocity is not: the error against slerp
+// grows with the angle between the inputs, to 0.14 rad for a half turn.
+inline void nlerp( std::span<const Quaternion> a, std::span<const Quaternion> b, float t, std::span<Quaternion> out )
+{
+  detail::blend<detail::NlerpMode>( a, b, t, out );
+}
+
+inline void nlerp( std::span<const Quaternion> a,
+  std::span<const Quaternion>                  b,
+  std::span<const float>                       t,
+  std::span<Quaternion>                        out )
+{
+  detail::blend<detail::NlerpMode>( a, b, t, out );
+}
+
+inline void nlerp( const QuaternionBatch& a, const QuaternionBatch& b, float t, QuaternionBatch& out )
+{
+  detail::blend<detail::NlerpMode>( a, b, t, out );
+}
+
+// Normalized lerp with t corrected by a cubic, so that it follows slerp to within 8e-4 rad for 0 <= t <= 1 at
+// roughly the cost of nlerp. Cheaper than slerp where that error is invisible, as when blending animation poses.
+inline void corrected_nlerp( std::span<const Quaternion> a,
+  std::span<const Quaternion>                            b,
+  float                                                  t,
+  std::span<Quaternion>                                  out )
+{
+  detail::blend<detail::CorrectedNlerpMode>( a, b, t, out );
+}
+
+inline void corrected_nlerp( std::span<const Quaternion> a,
+  std::span<const Quaternion>                            b,
+  std::span<const float>                                 t,
+  std::span<Quaternion>                                  out )
+{
+  detail::blend<detail::CorrectedNlerpMode>( a, b, t, out );
+}
+
+inline void corrected_nlerp( const QuaternionBatch& a, const QuaternionBatch& b, float t, QuaternionBatch& out )
+{
+  detail::blend<detail::CorrectedNlerpMode>( a, b, t, out );
+}
+
+// Batched get_rotation_matrix and to_mat4: out[i] is the rotation matrix of the unit quaternion quats[i], a register
+// of quaternions at a time. Transform4 and Mat4 outputs have no translation.
+inline void to_matrices( std::span<const Quaternion> quats, std::span<Mat3> out )
+{
+  detail::to_matrices( quats, out );
+}
+
+inline void to_matrices( std::span<const Quaternion> quats, std::span<Mat4> out )
+{
+  detail::to_matrices( quats, out );
+}
+
+inline void to_matrices( std::span<const Quaternion> quats, std::span<Transform4> out )
+{
+  detail::to_matrices( quats, out );
+}
+
+inline void to_matrices( const QuaternionBatch& quats, std::span<Mat3> out )
+{
+  detail::to_matrices( quats, out );
+}
+
+inline void to_matrices( const QuaternionBatch& quats, std::span<Mat4> out )
+{
+  detail::to_matrices( quats, out );
+}
+
+inline void to_matrices( const QuaternionBatch& quats, std::span<Transform4> out )
+{
+  detail::to_matrices( quats, out );
+}
+
+// Batched set_rotation_from_matrix: out[i] is the unit quaternion of the rotation in the upper 3x3 block of
+// matrices[i]. The four paths of the scalar version are selected per lane without branches, so mixed rotations cost
+// the same as uniform ones, and the results match the scalar ones including their sign.
+inline void quats_from_matrices( std::span<const Mat3> matrices, std::span<Quaternion> out )
+{
+  detail::quats_from_matrices( matrices, out );
+}
+
+inline void quats_from_matrices( std::span<const Mat4> matrices, std::span<Quaternion> out )
+{
+  detail::quats_from_matrices( matrices, out );
+}
+
+inline void quats_from_matrices( std::span<const Transform4> matrices, std::span<Quaternion> out )
+{
+  detail::quats_from_matrices( matrices, out );
+}
+
+inline void quats_from_matrices( std::span<const Mat3> matrices, QuaternionBatch& out )
+{
+  detail::quats_from_matrices( matrices, out );
+}
+
+inline void quats_from_matrices( std::span<const Mat4> matrices, QuaternionBatch& out )
+{
+  detail::quats_from_matrices( matrices, out );
+}
+
+inline void quats_from_matrices( std::span<const Transform4> matrices, QuaternionBatch& out )
+{
+  detail::quats_from_matrices( matrices, out );
+}
+
+// Structure-of-arrays counterparts of the span overloads in batch.hpp: out[i] = transform( in[i], q ) or
+// transform( in[i], quats[i] ) for unit quaternions. Outputs may alias the inputs.
+inline void transform_vectors( const Quaternion& q, const Vec3Batch& in, Vec3Batch& out )
+{
+  detail::rotate( q, in, out );
+}
+
+inline void transform_points( const Quaternion& q, const Point3Batch& in, Point3Batch& out )
+{
+  detail::rotate( q, in, out );
+}
+
+inline void transform_vectors( const QuaternionBatch& quats, const Vec3Batch& in, Vec3Batch& out )
+{
+  detail::rotate( quats, in, out );
+}
+
+inline void transform_points( const QuaternionBatch& quats, const Point3Batch& in, Point3Batch& out )
+{
+  detail::rotate( quats, in, out );
+}
+
+// Batched quat_from_euler: out[i] is the unit quaternion rotating by euler[i].x(), .y() and .z() radians about the
+// fixed x, y and z axes in the given order. sin and cos of the half angles come from sincos in vmath.hpp, so the cost
+// does not depend on the angles.
+template<MathPrecision P = Precise>
+void quats_from_euler( const Vec3Batch& euler, QuaternionBatch& out, EulerOrder order = EulerOrder::XYZ )
+{
+  detail::quats_from_euler<P>( euler, out, order );
+}
+
+// Batched euler_angles: the inverse of quats_from_euler for unit quaternions, with the second angle of the order in
+// [-pi/2, pi/2] and the others in [-pi, pi]. Branch-free, with asin and atan2 from vmath.hpp.
+template<MathPrecision P = Precise>
+void euler_angles( const QuaternionBatch& quats, Vec3Batch& out, EulerOrder order = EulerOrder::XYZ )
+{
+  detail::euler_angles<P>( quats, out, order );
+}
+
+} // namespace linalg
@@ -0,0 +1,306 @@
+#pragma once
+
+#include "quaternion.hpp"
+#include "quaternion_batch.hpp"
+#include "vec_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numbers>
+#include <span>
+
+namespace linalg {
+
+// Compact "smallest three" encodings of unit quaternions. The largest component by magnitude is dropped and rebuilt
+// from the unit length on decoding; the sign of the whole quaternion is chosen to make it positive, which names the
+// same rotation. The other three lie in [-1/sqrt( 2 ), 1/sqrt( 2 )] and are stored in order as snorm values scaled to
+// that range. A two-bit field holds 3 - i for the dropped component i, so zero bits decode to the identity. The
+// angular error bounds hold for every unit input: each stored component is off by at most half a step, and the rebuilt
+// one, being at least 1/2, by at most three times that.
+//
+// Quat32 keeps the field in bits 30-31 and 10-bit components in bits 0-9, 10-19 and 20-29. Quat48 keeps 15-bit
+// components in the low bits of its three words, and the low and high bit of the field in the top bit of the first
+// and second word.
+//
+//   Quat32  4 bytes  max error 0.29 degrees (5e-3 rad)
+//   Quat48  6 bytes  max error 0.009 degrees (1.6e-4 rad)
+struct Quat32
+{
+  std::uint32_t bits = 0;
+
+  [[nodiscard]] friend constexpr bool operator==( Quat32 left, Quat32 right ) = default;
+};
+
+struct Quat48
+{
+  std::array<std::uint16_t, 3> bits{};
+
+  [[nodiscard]] friend constexpr bool operator==( const Quat48& left, const Quat48& right ) = default;
+};
+
+namespace detail {
+
+// The largest representable component, snorm_scale<Bits> / sqrt( 2 ) after scaling, maps to the top snorm code.
+template<int Bits>
+inline constexpr float snorm_scale = static_cast<float>( ( 1 << ( Bits - 1 ) ) - 1 );
+
+// One register of quaternions as the field 3 - i and the three remaining components quantized to Bits-bit snorm
+// values, sign-extended. Ties go to the lower index.
+template<int Bits, typename L>
+void encode_smallest_three( const typename L::pack ( &q )[4],
+  typename L::int_lanes::pack&                      field,
+  typename L::int_lanes::pack ( &values )[3] )
+{
+  const typename L::pack a[4] = { L::abs( q[0] ), L::abs( q[1] ), L::abs( q[2] ), L::abs( q[3] ) };
+  const auto low_max          = L::max( a[0], a[1] );
+  const auto high_max         = L::max( a[2], a[3] );
+  const auto low_index        = L::select_less( a[0], a[1], L::splat( 1.0F ), L::splat( 0.0F ) );
+  const auto high_index       = L::select_less( a[2], a[3], L::splat( 3.0F ), L::splat( 2.0F ) );
+  const auto low_value        = L::select_less( a[0], a[1], q[1], q[0] );
+  const auto high_value       = L::select_less( a[2], a[3], q[3], q[2] );
+  const auto index            = L::select_less( low_max, high_max, high_index, low_index );
+  const auto largest          = L::select_less( low_max, high_max, high_value, low_value );
+  const auto sign             = L::bit_and( largest, L::splat( -0.0F ) );
+  const auto scale            = L::splat( snorm_scale<Bits> * std::numbers::sqrt2_v<float> );
+  for ( size_t j = 0; j != 3; ++j )
+  {
+    // Components after the dropped one move down a slot.
+    const auto kept = L::select_less( index, L::splat( static_cast<float>( j ) + 0.5F ), q[j + 1], q[j] );
+    values[j]       = L::round_to_int( L::mul( L::bit_xor( kept, sign ), scale ) );
+  }
+  field = L::round_to_int( L::sub( L::splat( 3.0F ), index ) );
+}
+
+template<int Bits, typename L>
+void decode_smallest_three( typename L::int_lanes::pack field,
+  const typename L::int_lanes::pack ( &values )[3],
+  typename L::pack ( &q )[4] )
+{
+  const auto       index = L::sub( L::splat( 3.0F ), L::to_float( field ) );
+  const auto       scale = L::splat( 1.0F / ( snorm_scale<Bits> * std::numbers::sqrt2_v<float> ) );
+  typename L::pack kept[3];
+  auto             length_squared = L::splat( 0.0F );
+  for ( size_t j = 0; j != 3; ++j )
+  {
+    kept[j]        = L::mul( L::to_float( values[j] ), scale );
+    length_squared = L::fmadd( kept[j], kept[j], length_squared );
+  }
+  const auto largest = L::sqrt( L::max( L::sub( L::splat( 1.0F ), length_squared ), L::splat( 0.0F ) ) );
+  // Component k is kept[k] before the dropped one and kept[k - 1] after it.
+  q[0] = L::select_less( L::splat( 0.0F ), index, kept[0], largest );
+  for ( size_t k = 1; k != 3; ++k )
+  {
+    const auto slot = L::splat( static_cast<float>( k ) );
+    q[k]            = L::select_less( index, slot, kept[k - 1], L::select_less( slot, index, kept[k], largest ) );
+  }
+  q[3] = L::select_less( index, L::splat( 3.0F ), kept[2], largest );
+}
+
+template<typename L>
+void pack_quat32( const typename L::pack ( &q )[4], typename L::int_lanes::pack& bits )
+{
+  using I = typename L::int_lanes;
+  typename I::pack field;
+  typename I::pack values[3];
+  encode_smallest_three<10, L>( q, field, values );
+  const auto mask = I::splat( 0x3FF );
+  bits            = I::bit_or( I::shift_left( field, 30 ), I::bit_and( values[0], mask ) );
+  bits            = I::bit_or( bits, I::shift_left( I::bit_and( values[1], mask ), 10 ) );
+  bits            = I::bit_or( bits, I::shift_left( I::bit_and( values[2], mask ), 20 ) );
+}
+
+template<typename L>
+void unpack_quat32( typename L::int_lanes::pack bits, typename L::pack ( &q )[4] )
+{
+  using I = typename L::int_lanes;
+  typename I::pack values[3];
+  for ( int j = 0; j != 3; ++j )
+  {
+    values[j] = I::shift_right( I::shift_left( bits, 22 - 10 * j ), 22 );
+  }
+  decode_smallest_three<10, L>( I::bit_and( I::shift_right( bits, 30 ), I::splat( 3 ) ), values, q );
+}
+
+// Quat48 words widened to one int per word, words[k] holding word k of every quaternion.
+template<typename L>
+void pack_quat48( const typename L::pack ( &q )[4], typename L::int_lanes::pack ( &words )[3] )
+{
+  using I = typename L::int_lanes;
+  typename I::pack field;
+  typename I::pack values[3];
+  encode_smallest_three<15, L>( q, field, values );
+  const auto mask = I::splat( 0x7FFF );
+  words[0]        = I::bit_or( I::bit_and( values[0], mask ), I::shift_left( I::bit_and( field, I::splat( 1 ) ), 15 ) );
+  words[1]        = I::bit_or( I::bit_and( values[1], mask ), I::shift_left( I::shift_right( field, 1 ), 15 ) );
+  words[2]        = I::bit_and( values[2], mask );
+}
+
+template<typename L>
+void unpack_quat48( const typename L::int_lanes::pack ( &words )[3], typename L::pack ( &q )[4] )
+{
+  using I = typename L::int_lanes;
+  typename I::pack values[3];
+  for ( size_t j = 0; j != 3; ++j )
+  {
+    values[j] = I::shift_right( I::shift_left( words[j], 17 ), 17 );
+  }
+  const auto field = I::bit_or( I::shift_right( words[0], 15 ), I::shift_left( I::shift_right( words[1], 15 ), 1 ) );
+  decode_smallest_three<15, L>( field, values, q );
+}
+
+static_assert( sizeof( Quat32 ) == sizeof( int ) );
+static_assert( sizeof( Quat48 ) == 6 );
+
+// Runs a register of quaternions at a time; the tail goes through identity-padded registers like quaternion_batch.hpp.
+template<typename Encoded, typename L>
+void encode_register( std::span<const Quaternion> in, std::span<Encoded> out )
+{
+  using I = typename L::int_lanes;
+  typename L::pack q[4];
+  load_quaternions<L>( in, q );
+  std::array<Encoded, L::width> padded;
+  Encoded*                      dst = out.size() == L::width ? out.data() : padded.data();
+  if constexpr ( std::same_as<Encoded, Quat32> )
+  {
+    typename I::pack bits;
+    pack_quat32<L>( q, bits );
+    I::store( reinterpret_cast<int*>( dst ), bits );
+  } else
+  {
+    // No SIMD store writes six-byte records; the words are narrowed one quaternion at a time.
+    typename I::pack          words[3];
+    std::array<int, L::width> lanes[3];
+    pack_quat48<L>( q, words );
+    for ( size_t k = 0; k != 3; ++k )
+    {
+      I::store( lanes[k].data(), words[k] );
+    }
+    for ( size_t i = 0; i != L::width; ++i )
+    {
+      for ( size_t k = 0; k != 3; ++k )
+      {
+        dst[i].bits[k] = static_cast<std::uint16_t>( lanes[k][i] );
+      }
+    }
+  }
+  if ( dst == padded.data() )
+  {
+    std::copy_n( padded.begin(), out.size(), out.begin() );
+  }
+}
+
+template<typename Encoded, typename L>
+void decode_register( std::span<const Encoded> in, std::span<Quaternion> out )
+{
+  using I = typename L::int_lanes;
+  std::array<Encoded, L::width> padded{};
+  const Encoded*                src = in.data();
+  if ( in.size() != L::width )
+  {
+    std::copy( in.begin(), in.end(), padded.begin() );
+    src = padded.data();
+  }
+  typename L::pack q[4];
+  if constexpr ( std::same_as<Encoded, Quat32> )
+  {
+    unpack_quat32<L>( I::load( reinterpret_cast<const int*>( src ) ), q );
+  } else
+  {
+    typename I::pack          words[3];
+    std::array<int, L::width> lanes[3];
+    for ( size_t i = 0; i != L::width; ++i )
+    {
+      for ( size_t k = 0; k != 3; ++k )
+      {
+        lanes[k][i] = src[i].bits[k];
+      }
+    }
+    for ( size_t k = 0; k != 3; ++k )
+    {
+      words[k] = I::load( lanes[k].data() );
+    }
+    unpack_quat48<L>( words, q );
+  }
+  store_quaternions<L>( q, out );
+}
+
+template<typename Encoded>
+void encode_quaternions( std::span<const Quaternion> in, std::span<Encoded> out )
+{
+  using L = MathLanes;
+  assert( in.size() == out.size() );
+  for ( size_t i = 0; i < out.size(); i += L::width )
+  {
+    const size_t count = std::min( L::width, out.size() - i );
+    encode_register<Encoded, L>( in.subspan( i, count ), out.subspan( i, count ) );
+  }
+}
+
+template<typename Encoded>
+void decode_quaternions( std::span<const Encoded> in, std::span<Quaternion> out )
+{
+  using L = MathLanes;
+  assert( in.size() == out.size() );
+  for ( size_t i = 0; i < out.size(); i += L::width )
+  {
+    const size_t count = std::min( L::width, out.size() - i );
+    decode_register<Encoded, L>( in.subspan( i, count ), out.subspan( i, count ) );
+  }
+}
+
+} // namespace detail
+
+// The input must be a unit quaternion.
+[[nodiscard]] inline Quat32 encode_quat32( const Quaternion& q )
+{
+  Quat32 encoded;
+  detail::encode_register<Quat32, detail::ScalarLanes<float>>( { &q, 1 }, { &encoded, 1 } );
+  return encoded;
+}
+
+[[nodiscard]] inline Quat48 encode_quat48( const Quaternion& q )
+{
+  Quat48 encoded;
+  detail::encode_register<Quat48, detail::ScalarLanes<float>>( { &q, 1 }, { &encoded, 1 } );
+  return encoded;
+}
+
+[[nodiscard]] inline Quaternion decode( Quat32 encoded )
+{
+  Quaternion q;
+  detail::decode_register<Quat32, detail::ScalarLanes<float>>( { &encoded, 1 }, { &q, 1 } );
+  return q;
+}
+
+[[nodiscard]] inline Quaternion decode( const Quat48& encoded )
+{
+  Quaternion q;
+  detail::decode_register<Quat48, detail::ScalarLanes<float>>( { &encoded, 1 }, { &q, 1 } );
+  return q;
+}
+
+// Batched codecs a SIMD register at a time, sharing their kernels with the single-quaternion functions above: the
+// results are the same bits on every ISA.
+inline void encode_quat32( std::span<const Quaternion> in, std::span<Quat32> out )
+{
+  detail::encode_quaternions( in, out );
+}
+
+inline void encode_quat48( std::span<const Quaternion> in, std::span<Quat48> out )
+{
+  detail::encode_quaternions( in, out );
+}
+
+inline void decode( std::span<const Quat32> in, std::span<Quaternion> out )
+{
+  detail::decode_quaternions( in, out );
+}
+
+inline void decode( std::span<const Quat48> in, std::span<Quaternion> out )
+{
+  detail::decode_quaternions( in, out );
+}
+
+} // namespace linalg
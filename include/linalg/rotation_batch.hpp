@@ -0,0 +1,68 @@
+#pragma once
+
+#include "mat3.hpp"
+#include "vmath.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+namespace linalg {
+
+namespace detail {
+
+// Angles per sincos call; the sines and cosines of a chunk stay in L1 until the matrices are written.
+inline constexpr size_t rotation_chunk = 256;
+
+template<MathPrecision P, typename Build>
+void make_rotations( std::span<const float> angles, std::span<Rotation3> out, Build build )
+{
+  assert( angles.size() == out.size() );
+  std::array<float, rotation_chunk> sines;
+  std::array<float, rotation_chunk> cosines;
+  for ( size_t begin = 0; begin < angles.size(); begin += rotation_chunk )
+  {
+    const size_t count = std::min( rotation_chunk, angles.size() - begin );
+    detail::sincos<P>( angles.subspan( begin, count ),
+      std::span<float>{ sines.data(), count },
+      std::span<float>{ cosines.data(), count } );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      out[begin + i] = Rotation3{ build( begin + i, cosines[i], sines[i] ) };
+    }
+  }
+}
+
+} // namespace detail
+
+// Batched make_rotation_x, _y and _z: out[i] is the rotation by angles[i]. The sines and cosines come from the
+// vectorized sincos in vmath.hpp, so the matrices match the scalar factories to within its precision.
+template<MathPrecision P = Precise>
+void make_rotations_x( std::span<const float> angles, std::span<Rotation3> out )
+{
+  detail::make_rotations<P>( angles, out, []( size_t, float c, float s ) { return detail::rotation_x( c, s ); } );
+}
+
+template<MathPrecision P = Precise>
+void make_rotations_y( std::span<const float> angles, std::span<Rotation3> out )
+{
+  detail::make_rotations<P>( angles, out, []( size_t, float c, float s ) { return detail::rotation_y( c, s ); } );
+}
+
+template<MathPrecision P = Precise>
+void make_rotations_z( std::span<const float> angles, std::span<Rotation3> out )
+{
+  detail::make_rotations<P>( angles, out, []( size_t, float c, float s ) { return detail::rotation_z( c, s ); } );
+}
+
+// Batched make_rotation: out[i] rotates by angles[i] about the unit vector axes[i].
+template<MathPrecision P = Precise>
+void make_rotations( std::span<const float> angles, std::span<const Vec3> axes, std::span<Rotation3> out )
+{
+  assert( axes.size() == angles.size() );
+  detail::make_rotations<P>(
+    angles, out, [axes]( size_t i, float c, float s ) { return detail::rotation_about( c, s, axes[i] ); } );
+}
+
+} // namespace linalg
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "simd.hpp"
+#include <cmath>
+#include <concepts>
+
+namespace linalg {
+
+// Accuracy modes for reciprocal square roots and normalization. Bounds are relative errors of 1 / sqrt( x ) for
+// normal positive floats:
+//
+//   Exact     1 / std::sqrt( x ); normalization divides by the magnitude   1 ulp
+//   Refined   hardware estimate plus Newton-Raphson                         3e-7 (about 2^-22)
+//   Estimate  hardware estimate only                                       3.7e-4 on x86 (6.1e-5 for AVX-512
+//                                                                          batches), 4e-3 on NEON
+//
+// Without a LINALG_SIMD_* target, and for double, Refined and Estimate fall back to Exact.
+struct Exact
+{};
+
+struct Refined
+{};
+
+struct Estimate
+{};
+
+template<typename P>
+concept RsqrtPolicy = std::same_as<P, Exact> || std::same_as<P, Refined> || std::same_as<P, Estimate>;
+
+template<RsqrtPolicy Policy = Exact, std::floating_point T>
+[[nodiscard]] inline T rsqrt( T x )
+{
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( std::same_as<T, float> && std::same_as<Policy, Refined> )
+  {
+    return simd::first( simd::rsqrt_refined( simd::splat( x ) ) );
+  } else if constexpr ( std::same_as<T, float> && std::same_as<Policy, Estimate> )
+  {
+    return simd::first( simd::rsqrt_estimate( simd::splat( x ) ) );
+  }
+#endif
+  return T{ 1 } / std::sqrt( x );
+}
+
+} // namespace linalg
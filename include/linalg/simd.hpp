@@ -0,0 +1,773 @@
+#pragma once
+
+#include "fma.hpp"
+#include <array>
+#include <concepts>
+#include <cstddef>
+
+#if defined( LINALG_SIMD_AVX512 ) || defined( LINALG_SIMD_AVX2 ) || defined( LINALG_SIMD_SSE4 )
+#include <immintrin.h>
+#define LINALG_SIMD_F32X4
+#if defined( LINALG_SIMD_AVX512 ) || defined( LINALG_SIMD_AVX2 )
+#define LINALG_SIMD_F64X4
+#endif
+#elif defined( LINALG_SIMD_NEON )
+#include <arm_neon.h>
+#define LINALG_SIMD_F32X4
+#endif
+
+namespace linalg::simd {
+
+#ifdef LINALG_SIMD_F32X4
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+// Vec<float, 4> and the columns of Mat<float, 4, 4> map onto a single 128-bit register.
+template<typename T, size_t N>
+inline constexpr bool is_f32x4 = enabled && std::same_as<T, float> && N == 4;
+
+#ifdef LINALG_SIMD_F64X4
+inline constexpr bool enabled_f64x4 = true;
+#else
+inline constexpr bool enabled_f64x4 = false;
+#endif
+
+// Vec<double, 4> and the columns of Mat<double, 4, 4> map onto a single 256-bit register on AVX2.
+template<typename T, size_t N>
+inline constexpr bool is_f64x4 = enabled_f64x4 && std::same_as<T, double> && N == 4;
+
+// Either four-lane pack; kernels written against the overloaded load/store/mul/madd/broadcast serve both.
+template<typename T, size_t N>
+inline constexpr bool is_packed4 = is_f32x4<T, N> || is_f64x4<T, N>;
+
+template<typename T, size_t N>
+inline constexpr size_t alignment = is_f32x4<T, N> ? 16 : is_f64x4<T, N> ? 32 : alignof( std::array<T, N> );
+
+#if defined( LINALG_SIMD_NEON )
+
+using f32x4 = float32x4_t;
+
+[[nodiscard]] inline f32x4 load( const float* ptr ) { return vld1q_f32( ptr ); }
+inline void                store( float* ptr, f32x4 v ) { vst1q_f32( ptr, v ); }
+[[nodiscard]] inline f32x4 splat( float s ) { return vdupq_n_f32( s ); }
+
+[[nodiscard]] inline f32x4 add( f32x4 a, f32x4 b ) { return vaddq_f32( a, b ); }
+[[nodiscard]] inline f32x4 sub( f32x4 a, f32x4 b ) { return vsubq_f32( a, b ); }
+[[nodiscard]] inline f32x4 mul( f32x4 a, f32x4 b ) { return vmulq_f32( a, b ); }
+[[nodiscard]] inline f32x4 div( f32x4 a, f32x4 b ) { return vdivq_f32( a, b ); }
+[[nodiscard]] inline f32x4 neg( f32x4 a ) { return vnegq_f32( a ); }
+[[nodiscard]] inline f32x4 madd( f32x4 a, f32x4 b, f32x4 c ) { return vmlaq_f32( c, a, b ); }
+[[nodiscard]] inline f32x4 min( f32x4 a, f32x4 b ) { return vminq_f32( a, b ); }
+[[nodiscard]] inline f32x4 max( f32x4 a, f32x4 b ) { return vmaxq_f32( a, b ); }
+[[nodiscard]] inline f32x4 sqrt( f32x4 a ) { return vsqrtq_f32( a ); }
+[[nodiscard]] inline float first( f32x4 a ) { return vgetq_lane_f32( a, 0 ); }
+
+// The hardware reciprocal square root estimate (about 8 bits here), and the estimate after enough Newton-Raphson
+// steps to reach the Refined bound in rsqrt.hpp.
+[[nodiscard]] inline f32x4 rsqrt_estimate( f32x4 a ) { return vrsqrteq_f32( a ); }
+
+[[nodiscard]] inline f32x4 rsqrt_refined( f32x4 a )
+{
+  f32x4 y = vrsqrteq_f32( a );
+  y       = vmulq_f32( y, vrsqrtsq_f32( vmulq_f32( a, y ), y ) );
+  return vmulq_f32( y, vrsqrtsq_f32( vmulq_f32( a, y ), y ) );
+}
+
+[[nodiscard]] inline f32x4 fmadd( f32x4 a, f32x4 b, f32x4 c ) { return vfmaq_f32( c, a, b ); }
+
+// Bitwise operations and the lane selection used by the polynomial kernels in vmath.hpp.
+[[nodiscard]] inline f32x4 abs( f32x4 a ) { return vabsq_f32( a ); }
+[[nodiscard]] inline f32x4 select_less( f32x4 a, f32x4 b, f32x4 x, f32x4 y )
+{
+  return vbslq_f32( vcltq_f32( a, b ), x, y );
+}
+
+[[nodiscard]] inline f32x4 bit_and( f32x4 a, f32x4 b )
+{
+  return vreinterpretq_f32_u32( vandq_u32( vreinterpretq_u32_f32( a ), vreinterpretq_u32_f32( b ) ) );
+}
+
+[[nodiscard]] inline f32x4 bit_or( f32x4 a, f32x4 b )
+{
+  return vreinterpretq_f32_u32( vorrq_u32( vreinterpretq_u32_f32( a ), vreinterpretq_u32_f32( b ) ) );
+}
+
+[[nodiscard]] inline f32x4 bit_xor( f32x4 a, f32x4 b )
+{
+  return vreinterpretq_f32_u32( veorq_u32( vreinterpretq_u32_f32( a ), vreinterpretq_u32_f32( b ) ) );
+}
+
+[[nodiscard]] inline float hsum( f32x4 a ) { return vaddvq_f32( a ); }
+[[nodiscard]] inline float dot( f32x4 a, f32x4 b ) { return hsum( vmulq_f32( a, b ) ); }
+
+// ( a0 * b0 + a2 * b2 ) + ( a1 * b1 + a3 * b3 ), each pair fused.
+[[nodiscard]] inline float fused_dot( f32x4 a, f32x4 b )
+{
+  const float32x2_t low   = vmul_f32( vget_low_f32( a ), vget_low_f32( b ) );
+  const float32x2_t pairs = vfma_f32( low, vget_high_f32( a ), vget_high_f32( b ) );
+  return vaddv_f32( pairs );
+}
+
+template<int I>
+[[nodiscard]] inline f32x4 broadcast( f32x4 a )
+{
+  return vdupq_laneq_f32( a, I );
+}
+
+#elif defined( LINALG_SIMD_F32X4 )
+
+using f32x4 = __m128;
+
+[[nodiscard]] inline f32x4 load( const float* ptr ) { return _mm_loadu_ps( ptr ); }
+inline void                store( float* ptr, f32x4 v ) { _mm_storeu_ps( ptr, v ); }
+[[nodiscard]] inline f32x4 splat( float s ) { return _mm_set1_ps( s ); }
+
+[[nodiscard]] inline f32x4 add( f32x4 a, f32x4 b ) { return _mm_add_ps( a, b ); }
+[[nodiscard]] inline f32x4 sub( f32x4 a, f32x4 b ) { return _mm_sub_ps( a, b ); }
+[[nodiscard]] inline f32x4 mul( f32x4 a, f32x4 b ) { return _mm_mul_ps( a, b ); }
+[[nodiscard]] inline f32x4 div( f32x4 a, f32x4 b ) { return _mm_div_ps( a, b ); }
+[[nodiscard]] inline f32x4 neg( f32x4 a ) { return _mm_xor_ps( a, _mm_set1_ps( -0.0F ) ); }
+[[nodiscard]] inline f32x4 madd( f32x4 a, f32x4 b, f32x4 c ) { return _mm_add_ps( _mm_mul_ps( a, b ), c ); }
+[[nodiscard]] inline f32x4 min( f32x4 a, f32x4 b ) { return _mm_min_ps( a, b ); }
+[[nodiscard]] inline f32x4 max( f32x4 a, f32x4 b ) { return _mm_max_ps( a, b ); }
+[[nodiscard]] inline f32x4 sqrt( f32x4 a ) { return _mm_sqrt_ps( a ); }
+[[nodiscard]] inline float first( f32x4 a ) { return _mm_cvtss_f32( a ); }
+
+// One Newton-Raphson step for 1 / sqrt( a ) from the estimate y: y * ( 1.5 - 0.5 * a * y * y ).
+[[nodiscard]] inline f32x4 rsqrt_step( f32x4 a, f32x4 y )
+{
+  const f32x4 half_a_yy = _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 0.5F ), a ), _mm_mul_ps( y, y ) );
+  return _mm_mul_ps( y, _mm_sub_ps( _mm_set1_ps( 1.5F ), half_a_yy ) );
+}
+
+// The hardware reciprocal square root estimate (12 bits), and the estimate after one Newton-Raphson step.
+[[nodiscard]] inline f32x4 rsqrt_estimate( f32x4 a ) { return _mm_rsqrt_ps( a ); }
+[[nodiscard]] inline f32x4 rsqrt_refined( f32x4 a ) { return rsqrt_step( a, _mm_rsqrt_ps( a ) ); }
+
+// Bitwise operations and the lane selection used by the polynomial kernels in vmath.hpp. select_less( a, b, x, y ) is
+// a < b ? x : y per lane, and picks y when either comparand is NaN.
+[[nodiscard]] inline f32x4 abs( f32x4 a ) { return _mm_andnot_ps( _mm_set1_ps( -0.0F ), a ); }
+[[nodiscard]] inline f32x4 select_less( f32x4 a, f32x4 b, f32x4 x, f32x4 y )
+{
+  return _mm_blendv_ps( y, x, _mm_cmplt_ps( a, b ) );
+}
+[[nodiscard]] inline f32x4 bit_and( f32x4 a, f32x4 b ) { return _mm_and_ps( a, b ); }
+[[nodiscard]] inline f32x4 bit_or( f32x4 a, f32x4 b ) { return _mm_or_ps( a, b ); }
+[[nodiscard]] inline f32x4 bit_xor( f32x4 a, f32x4 b ) { return _mm_xor_ps( a, b ); }
+
+[[nodiscard]] inline float hsum( f32x4 a )
+{
+  const f32x4 shuf = _mm_movehdup_ps( a );
+  const f32x4 sums = _mm_add_ps( a, shuf );
+  return _mm_cvtss_f32( _mm_add_ss( sums, _mm_movehl_ps( shuf, sums ) ) );
+}
+
+[[nodiscard]] inline float dot( f32x4 a, f32x4 b ) { return _mm_cvtss_f32( _mm_dp_ps( a, b, 0xF1 ) ); }
+
+#ifdef __FMA__
+[[nodiscard]] inline f32x4 fmadd( f32x4 a, f32x4 b, f32x4 c ) { return _mm_fmadd_ps( a, b, c ); }
+#else
+// Correctly rounded but slow without the instruction; only reached when Fused is requested explicitly.
+[[nodiscard]] inline f32x4 fmadd( f32x4 a, f32x4 b, f32x4 c )
+{
+  alignas( 16 ) float fa[4];
+  alignas( 16 ) float fb[4];
+  alignas( 16 ) float fc[4];
+  _mm_store_ps( fa, a );
+  _mm_store_ps( fb, b );
+  _mm_store_ps( fc, c );
+  for ( int i = 0; i != 4; ++i )
+  {
+    fc[i] = std::fma( fa[i], fb[i], fc[i] );
+  }
+  return _mm_load_ps( fc );
+}
+#endif
+
+// ( a0 * b0 + a2 * b2 ) + ( a1 * b1 + a3 * b3 ), each pair fused.
+[[nodiscard]] inline float fused_dot( f32x4 a, f32x4 b )
+{
+  const f32x4 pairs = fmadd( _mm_movehl_ps( a, a ), _mm_movehl_ps( b, b ), _mm_mul_ps( a, b ) );
+  return _mm_cvtss_f32( _mm_add_ss( pairs, _mm_movehdup_ps( pairs ) ) );
+}
+
+template<int I>
+[[nodiscard]] inline f32x4 broadcast( f32x4 a )
+{
+  return _mm_shuffle_ps( a, a, _MM_SHUFFLE( I, I, I, I ) );
+}
+
+#endif
+
+#ifdef LINALG_SIMD_F32X4
+
+struct Columns4
+{
+  f32x4 col[4];
+};
+
+inline void transpose( Columns4& m )
+{
+#ifdef LINALG_SIMD_NEON
+  const float32x4x2_t t01 = vtrnq_f32( m.col[0], m.col[1] );
+  const float32x4x2_t t23 = vtrnq_f32( m.col[2], m.col[3] );
+
+  m.col[0] = vcombine_f32( vget_low_f32( t01.val[0] ), vget_low_f32( t23.val[0] ) );
+  m.col[1] = vcombine_f32( vget_low_f32( t01.val[1] ), vget_low_f32( t23.val[1] ) );
+  m.col[2] = vcombine_f32( vget_high_f32( t01.val[0] ), vget_high_f32( t23.val[0] ) );
+  m.col[3] = vcombine_f32( vget_high_f32( t01.val[1] ), vget_high_f32( t23.val[1] ) );
+#else
+  _MM_TRANSPOSE4_PS( m.col[0], m.col[1], m.col[2], m.col[3] );
+#endif
+}
+
+template<FmaPolicy Policy>
+[[nodiscard]] inline f32x4 madd( f32x4 a, f32x4 b, f32x4 c )
+{
+  if constexpr ( std::same_as<Policy, Fused> )
+  {
+    return fmadd( a, b, c );
+  } else
+  {
+    return madd( a, b, c );
+  }
+}
+
+template<FmaPolicy Policy>
+[[nodiscard]] inline float dot( f32x4 a, f32x4 b )
+{
+  if constexpr ( std::same_as<Policy, Fused> )
+  {
+    return fused_dot( a, b );
+  } else
+  {
+    return dot( a, b );
+  }
+}
+
+// Linear combination of the columns of a 4x4 matrix weighted by the lanes of v, i.e. M * v.
+template<FmaPolicy Policy = DefaultFma>
+[[nodiscard]] inline f32x4 combine_columns( const Columns4& cols, f32x4 v )
+{
+  f32x4 result = mul( cols.col[0], broadcast<0>( v ) );
+  result       = madd<Policy>( cols.col[1], broadcast<1>( v ), result );
+  result       = madd<Policy>( cols.col[2], broadcast<2>( v ), result );
+  return madd<Policy>( cols.col[3], broadcast<3>( v ), result );
+}
+
+// Overloads taking the vector in memory, so the wider double kernels below can broadcast lanes straight from it.
+template<int I>
+[[nodiscard]] inline f32x4 broadcast( const float* ptr )
+{
+  return broadcast<I>( load( ptr ) );
+}
+
+template<FmaPolicy Policy = DefaultFma>
+[[nodiscard]] inline f32x4 combine_columns( const Columns4& cols, const float* v )
+{
+  return combine_columns<Policy>( cols, load( v ) );
+}
+
+#endif
+
+#ifdef LINALG_SIMD_F64X4
+
+using f64x4 = __m256d;
+
+[[nodiscard]] inline f64x4 load( const double* ptr ) { return _mm256_loadu_pd( ptr ); }
+inline void                store( double* ptr, f64x4 v ) { _mm256_storeu_pd( ptr, v ); }
+[[nodiscard]] inline f64x4 splat( double s ) { return _mm256_set1_pd( s ); }
+
+[[nodiscard]] inline f64x4 add( f64x4 a, f64x4 b ) { return _mm256_add_pd( a, b ); }
+[[nodiscard]] inline f64x4 sub( f64x4 a, f64x4 b ) { return _mm256_sub_pd( a, b ); }
+[[nodiscard]] inline f64x4 mul( f64x4 a, f64x4 b ) { return _mm256_mul_pd( a, b ); }
+[[nodiscard]] inline f64x4 div( f64x4 a, f64x4 b ) { return _mm256_div_pd( a, b ); }
+[[nodiscard]] inline f64x4 madd( f64x4 a, f64x4 b, f64x4 c ) { return _mm256_add_pd( _mm256_mul_pd( a, b ), c ); }
+
+#ifdef __FMA__
+[[nodiscard]] inline f64x4 fmadd( f64x4 a, f64x4 b, f64x4 c ) { return _mm256_fmadd_pd( a, b, c ); }
+#else
+[[nodiscard]] inline f64x4 fmadd( f64x4 a, f64x4 b, f64x4 c )
+{
+  alignas( 32 ) double da[4];
+  alignas( 32 ) double db[4];
+  alignas( 32 ) double dc[4];
+  _mm256_store_pd( da, a );
+  _mm256_store_pd( db, b );
+  _mm256_store_pd( dc, c );
+  for ( int i = 0; i != 4; ++i )
+  {
+    dc[i] = std::fma( da[i], db[i], dc[i] );
+  }
+  return _mm256_load_pd( dc );
+}
+#endif
+
+template<FmaPolicy Policy>
+[[nodiscard]] inline f64x4 madd( f64x4 a, f64x4 b, f64x4 c )
+{
+  if constexpr ( std::same_as<Policy, Fused> )
+  {
+    return fmadd( a, b, c );
+  } else
+  {
+    return madd( a, b, c );
+  }
+}
+
+template<int I>
+[[nodiscard]] inline f64x4 broadcast( f64x4 a )
+{
+  return _mm256_permute4x64_pd( a, _MM_SHUFFLE( I, I, I, I ) );
+}
+
+// A broadcast load, which unlike the cross-lane permute above does not compete for the shuffle port.
+template<int I>
+[[nodiscard]] inline f64x4 broadcast( const double* ptr )
+{
+  return _mm256_broadcast_sd( ptr + I );
+}
+
+// Sets lane 3, which holds w or a translation entry when the lower three lanes are a Vec3.
+[[nodiscard]] inline f64x4 with_w( f64x4 a, double w ) { return _mm256_blend_pd( a, _mm256_set1_pd( w ), 0b1000 ); }
+
+// cross and dot of the lower three lanes. cross leaves lane 3 at zero for finite input.
+[[nodiscard]] inline f64x4 cross3( f64x4 a, f64x4 b )
+{
+  const f64x4 a_yzx = _mm256_permute4x64_pd( a, _MM_SHUFFLE( 3, 0, 2, 1 ) );
+  const f64x4 b_yzx = _mm256_permute4x64_pd( b, _MM_SHUFFLE( 3, 0, 2, 1 ) );
+  const f64x4 a_zxy = _mm256_permute4x64_pd( a, _MM_SHUFFLE( 3, 1, 0, 2 ) );
+  const f64x4 b_zxy = _mm256_permute4x64_pd( b, _MM_SHUFFLE( 3, 1, 0, 2 ) );
+  return _mm256_sub_pd( _mm256_mul_pd( a_yzx, b_zxy ), _mm256_mul_pd( a_zxy, b_yzx ) );
+}
+
+[[nodiscard]] inline double dot3( f64x4 a, f64x4 b )
+{
+  const f64x4   p    = _mm256_mul_pd( a, b );
+  const __m128d low  = _mm256_castpd256_pd128( p );
+  const __m128d high = _mm256_extractf128_pd( p, 1 );
+  return _mm_cvtsd_f64( _mm_add_sd( _mm_add_sd( low, _mm_unpackhi_pd( low, low ) ), high ) );
+}
+
+struct Columns4d
+{
+  f64x4 col[4];
+};
+
+inline void transpose( Columns4d& m )
+{
+  const f64x4 t0 = _mm256_unpacklo_pd( m.col[0], m.col[1] );
+  const f64x4 t1 = _mm256_unpackhi_pd( m.col[0], m.col[1] );
+  const f64x4 t2 = _mm256_unpacklo_pd( m.col[2], m.col[3] );
+  const f64x4 t3 = _mm256_unpackhi_pd( m.col[2], m.col[3] );
+
+  m.col[0] = _mm256_permute2f128_pd( t0, t2, 0x20 );
+  m.col[1] = _mm256_permute2f128_pd( t1, t3, 0x20 );
+  m.col[2] = _mm256_permute2f128_pd( t0, t2, 0x31 );
+  m.col[3] = _mm256_permute2f128_pd( t1, t3, 0x31 );
+}
+
+template<FmaPolicy Policy = DefaultFma>
+[[nodiscard]] inline f64x4 combine_columns( const Columns4d& cols, const double* v )
+{
+  f64x4 result = mul( cols.col[0], broadcast<0>( v ) );
+  result       = madd<Policy>( cols.col[1], broadcast<1>( v ), result );
+  result       = madd<Policy>( cols.col[2], broadcast<2>( v ), result );
+  return madd<Policy>( cols.col[3], broadcast<3>( v ), result );
+}
+
+#endif
+
+// Widest float register enabled at compile time. Structure-of-arrays kernels stream whole registers of one component.
+#if defined( LINALG_SIMD_AVX512 )
+
+using f32xw                        = __m512;
+inline constexpr size_t wide_lanes = 16;
+
+[[nodiscard]] inline f32xw load_wide( const float* ptr ) { return _mm512_loadu_ps( ptr ); }
+inline void                store_wide( float* ptr, f32xw v ) { _mm512_storeu_ps( ptr, v ); }
+[[nodiscard]] inline f32xw splat_wide( float s ) { return _mm512_set1_ps( s ); }
+
+[[nodiscard]] inline f32xw add( f32xw a, f32xw b ) { return _mm512_add_ps( a, b ); }
+[[nodiscard]] inline f32xw sub( f32xw a, f32xw b ) { return _mm512_sub_ps( a, b ); }
+[[nodiscard]] inline f32xw mul( f32xw a, f32xw b ) { return _mm512_mul_ps( a, b ); }
+[[nodiscard]] inline f32xw div( f32xw a, f32xw b ) { return _mm512_div_ps( a, b ); }
+[[nodiscard]] inline f32xw madd( f32xw a, f32xw b, f32xw c ) { return _mm512_add_ps( _mm512_mul_ps( a, b ), c ); }
+[[nodiscard]] inline f32xw min( f32xw a, f32xw b ) { return _mm512_min_ps( a, b ); }
+[[nodiscard]] inline f32xw max( f32xw a, f32xw b ) { return _mm512_max_ps( a, b ); }
+[[nodiscard]] inline f32xw sqrt( f32xw a ) { return _mm512_sqrt_ps( a ); }
+
+[[nodiscard]] inline f32xw rsqrt_step( f32xw a, f32xw y )
+{
+  const f32xw half_a_yy = _mm512_mul_ps( _mm512_mul_ps( _mm512_set1_ps( 0.5F ), a ), _mm512_mul_ps( y, y ) );
+  return _mm512_mul_ps( y, _mm512_sub_ps( _mm512_set1_ps( 1.5F ), half_a_yy ) );
+}
+
+// AVX-512 estimates to 14 bits.
+[[nodiscard]] inline f32xw rsqrt_estimate( f32xw a ) { return _mm512_rsqrt14_ps( a ); }
+[[nodiscard]] inline f32xw rsqrt_refined( f32xw a ) { return rsqrt_step( a, _mm512_rsqrt14_ps( a ) ); }
+
+[[nodiscard]] inline f32xw fmadd( f32xw a, f32xw b, f32xw c ) { return _mm512_fmadd_ps( a, b, c ); }
+[[nodiscard]] inline f32xw abs( f32xw a ) { return _mm512_abs_ps( a ); }
+[[nodiscard]] inline f32xw select_less( f32xw a, f32xw b, f32xw x, f32xw y )
+{
+  return _mm512_mask_blend_ps( _mm512_cmp_ps_mask( a, b, _CMP_LT_OQ ), y, x );
+}
+
+// The float forms of these need AVX512DQ; the integer ones are in AVX512F.
+[[nodiscard]] inline f32xw bit_and( f32xw a, f32xw b )
+{
+  return _mm512_castsi512_ps( _mm512_and_si512( _mm512_castps_si512( a ), _mm512_castps_si512( b ) ) );
+}
+
+[[nodiscard]] inline f32xw bit_or( f32xw a, f32xw b )
+{
+  return _mm512_castsi512_ps( _mm512_or_si512( _mm512_castps_si512( a ), _mm512_castps_si512( b ) ) );
+}
+
+[[nodiscard]] inline f32xw bit_xor( f32xw a, f32xw b )
+{
+  return _mm512_castsi512_ps( _mm512_xor_si512( _mm512_castps_si512( a ), _mm512_castps_si512( b ) ) );
+}
+
+#elif defined( LINALG_SIMD_AVX2 )
+
+using f32xw                        = __m256;
+inline constexpr size_t wide_lanes = 8;
+
+[[nodiscard]] inline f32xw load_wide( const float* ptr ) { return _mm256_loadu_ps( ptr ); }
+inline void                store_wide( float* ptr, f32xw v ) { _mm256_storeu_ps( ptr, v ); }
+[[nodiscard]] inline f32xw splat_wide( float s ) { return _mm256_set1_ps( s ); }
+
+[[nodiscard]] inline f32xw add( f32xw a, f32xw b ) { return _mm256_add_ps( a, b ); }
+[[nodiscard]] inline f32xw sub( f32xw a, f32xw b ) { return _mm256_sub_ps( a, b ); }
+[[nodiscard]] inline f32xw mul( f32xw a, f32xw b ) { return _mm256_mul_ps( a, b ); }
+[[nodiscard]] inline f32xw div( f32xw a, f32xw b ) { return _mm256_div_ps( a, b ); }
+[[nodiscard]] inline f32xw madd( f32xw a, f32xw b, f32xw c ) { return _mm256_add_ps( _mm256_mul_ps( a, b ), c ); }
+[[nodiscard]] inline f32xw min( f32xw a, f32xw b ) { return _mm256_min_ps( a, b ); }
+[[nodiscard]] inline f32xw max( f32xw a, f32xw b ) { return _mm256_max_ps( a, b ); }
+[[nodiscard]] inline f32xw sqrt( f32xw a ) { return _mm256_sqrt_ps( a ); }
+
+[[nodiscard]] inline f32xw rsqrt_step( f32xw a, f32xw y )
+{
+  const f32xw half_a_yy = _mm256_mul_ps( _mm256_mul_ps( _mm256_set1_ps( 0.5F ), a ), _mm256_mul_ps( y, y ) );
+  return _mm256_mul_ps( y, _mm256_sub_ps( _mm256_set1_ps( 1.5F ), half_a_yy ) );
+}
+
+[[nodiscard]] inline f32xw rsqrt_estimate( f32xw a ) { return _mm256_rsqrt_ps( a ); }
+[[nodiscard]] inline f32xw rsqrt_refined( f32xw a ) { return rsqrt_step( a, _mm256_rsqrt_ps( a ) ); }
+
+#ifdef __FMA__
+[[nodiscard]] inline f32xw fmadd( f32xw a, f32xw b, f32xw c ) { return _mm256_fmadd_ps( a, b, c ); }
+#endif
+
+[[nodiscard]] inline f32xw abs( f32xw a ) { return _mm256_andnot_ps( _mm256_set1_ps( -0.0F ), a ); }
+[[nodiscard]] inline f32xw select_less( f32xw a, f32xw b, f32xw x, f32xw y )
+{
+  return _mm256_blendv_ps( y, x, _mm256_cmp_ps( a, b, _CMP_LT_OQ ) );
+}
+[[nodiscard]] inline f32xw bit_and( f32xw a, f32xw b ) { return _mm256_and_ps( a, b ); }
+[[nodiscard]] inline f32xw bit_or( f32xw a, f32xw b ) { return _mm256_or_ps( a, b ); }
+[[nodiscard]] inline f32xw bit_xor( f32xw a, f32xw b ) { return _mm256_xor_ps( a, b ); }
+
+#elif defined( LINALG_SIMD_F32X4 )
+
+using f32xw                        = f32x4;
+inline constexpr size_t wide_lanes = 4;
+
+[[nodiscard]] inline f32xw load_wide( const float* ptr ) { return load( ptr ); }
+inline void                store_wide( float* ptr, f32xw v ) { store( ptr, v ); }
+[[nodiscard]] inline f32xw splat_wide( float s ) { return splat( s ); }
+
+#endif
+
+// The int32 register with as many lanes as f32xw, for integer vectors and grid cells. Shift counts must be below 32.
+// round_to_int rounds to nearest even under the default rounding mode.
+#if defined( LINALG_SIMD_AVX512 )
+
+using i32xw = __m512i;
+
+[[nodiscard]] inline i32xw load_wide( const int* ptr ) { return _mm512_loadu_si512( ptr ); }
+inline void                store_wide( int* ptr, i32xw v ) { _mm512_storeu_si512( ptr, v ); }
+[[nodiscard]] inline i32xw splat_wide( int s ) { return _mm512_set1_epi32( s ); }
+
+[[nodiscard]] inline i32xw add( i32xw a, i32xw b ) { return _mm512_add_epi32( a, b ); }
+[[nodiscard]] inline i32xw sub( i32xw a, i32xw b ) { return _mm512_sub_epi32( a, b ); }
+[[nodiscard]] inline i32xw mul( i32xw a, i32xw b ) { return _mm512_mullo_epi32( a, b ); }
+[[nodiscard]] inline i32xw min( i32xw a, i32xw b ) { return _mm512_min_epi32( a, b ); }
+[[nodiscard]] inline i32xw max( i32xw a, i32xw b ) { return _mm512_max_epi32( a, b ); }
+[[nodiscard]] inline i32xw shift_left( i32xw a, int n ) { return _mm512_sll_epi32( a, _mm_cvtsi32_si128( n ) ); }
+[[nodiscard]] inline i32xw shift_right( i32xw a, int n ) { return _mm512_sra_epi32( a, _mm_cvtsi32_si128( n ) ); }
+
+[[nodiscard]] inline i32xw bit_and( i32xw a, i32xw b ) { return _mm512_and_si512( a, b ); }
+[[nodiscard]] inline i32xw bit_or( i32xw a, i32xw b ) { return _mm512_or_si512( a, b ); }
+
+[[nodiscard]] inline i32xw floor_to_int( f32xw a )
+{
+  return _mm512_cvt_roundps_epi32( a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC );
+}
+
+[[nodiscard]] inline i32xw round_to_int( f32xw a ) { return _mm512_cvtps_epi32( a ); }
+[[nodiscard]] inline f32xw to_float( i32xw a ) { return _mm512_cvtepi32_ps( a ); }
+[[nodiscard]] inline i32xw as_int( f32xw a ) { return _mm512_castps_si512( a ); }
+[[nodiscard]] inline f32xw as_float( i32xw a ) { return _mm512_castsi512_ps( a ); }
+
+#elif defined( LINALG_SIMD_AVX2 )
+
+using i32xw = __m256i;
+
+[[nodiscard]] inline i32xw load_wide( const int* ptr )
+{
+  return _mm256_loadu_si256( reinterpret_cast<const i32xw*>( ptr ) );
+}
+
+inline void store_wide( int* ptr, i32xw v ) { _mm256_storeu_si256( reinterpret_cast<i32xw*>( ptr ), v ); }
+
+[[nodiscard]] inline i32xw splat_wide( int s ) { return _mm256_set1_epi32( s ); }
+
+[[nodiscard]] inline i32xw add( i32xw a, i32xw b ) { return _mm256_add_epi32( a, b ); }
+[[nodiscard]] inline i32xw sub( i32xw a, i32xw b ) { return _mm256_sub_epi32( a, b ); }
+[[nodiscard]] inline i32xw mul( i32xw a, i32xw b ) { return _mm256_mullo_epi32( a, b ); }
+[[nodiscard]] inline i32xw min( i32xw a, i32xw b ) { return _mm256_min_epi32( a, b ); }
+[[nodiscard]] inline i32xw max( i32xw a, i32xw b ) { return _mm256_max_epi32( a, b ); }
+[[nodiscard]] inline i32xw shift_left( i32xw a, int n ) { return _mm256_sll_epi32( a, _mm_cvtsi32_si128( n ) ); }
+[[nodiscard]] inline i32xw shift_right( i32xw a, int n ) { return _mm256_sra_epi32( a, _mm_cvtsi32_si128( n ) ); }
+[[nodiscard]] inline i32xw bit_and( i32xw a, i32xw b ) { return _mm256_and_si256( a, b ); }
+[[nodiscard]] inline i32xw bit_or( i32xw a, i32xw b ) { return _mm256_or_si256( a, b ); }
+[[nodiscard]] inline i32xw floor_to_int( f32xw a ) { return _mm256_cvttps_epi32( _mm256_floor_ps( a ) ); }
+[[nodiscard]] inline i32xw round_to_int( f32xw a ) { return _mm256_cvtps_epi32( a ); }
+[[nodiscard]] inline f32xw to_float( i32xw a ) { return _mm256_cvtepi32_ps( a ); }
+[[nodiscard]] inline i32xw as_int( f32xw a ) { return _mm256_castps_si256( a ); }
+[[nodiscard]] inline f32xw as_float( i32xw a ) { return _mm256_castsi256_ps( a ); }
+
+#elif defined( LINALG_SIMD_SSE4 )
+
+using i32xw = __m128i;
+
+[[nodiscard]] inline i32xw load_wide( const int* ptr )
+{
+  return _mm_loadu_si128( reinterpret_cast<const i32xw*>( ptr ) );
+}
+
+inline void store_wide( int* ptr, i32xw v ) { _mm_storeu_si128( reinterpret_cast<i32xw*>( ptr ), v ); }
+
+[[nodiscard]] inline i32xw splat_wide( int s ) { return _mm_set1_epi32( s ); }
+
+[[nodiscard]] inline i32xw add( i32xw a, i32xw b ) { return _mm_add_epi32( a, b ); }
+[[nodiscard]] inline i32xw sub( i32xw a, i32xw b ) { return _mm_sub_epi32( a, b ); }
+[[nodiscard]] inline i32xw mul( i32xw a, i32xw b ) { return _mm_mullo_epi32( a, b ); }
+[[nodiscard]] inline i32xw min( i32xw a, i32xw b ) { return _mm_min_epi32( a, b ); }
+[[nodiscard]] inline i32xw max( i32xw a, i32xw b ) { return _mm_max_epi32( a, b ); }
+[[nodiscard]] inline i32xw shift_left( i32xw a, int n ) { return _mm_sll_epi32( a, _mm_cvtsi32_si128( n ) ); }
+[[nodiscard]] inline i32xw shift_right( i32xw a, int n ) { return _mm_sra_epi32( a, _mm_cvtsi32_si128( n ) ); }
+[[nodiscard]] inline i32xw bit_and( i32xw a, i32xw b ) { return _mm_and_si128( a, b ); }
+[[nodiscard]] inline i32xw bit_or( i32xw a, i32xw b ) { return _mm_or_si128( a, b ); }
+[[nodiscard]] inline i32xw floor_to_int( f32xw a ) { return _mm_cvttps_epi32( _mm_floor_ps( a ) ); }
+[[nodiscard]] inline i32xw round_to_int( f32xw a ) { return _mm_cvtps_epi32( a ); }
+[[nodiscard]] inline f32xw to_float( i32xw a ) { return _mm_cvtepi32_ps( a ); }
+[[nodiscard]] inline i32xw as_int( f32xw a ) { return _mm_castps_si128( a ); }
+[[nodiscard]] inline f32xw as_float( i32xw a ) { return _mm_castsi128_ps( a ); }
+
+#elif defined( LINALG_SIMD_NEON )
+
+using i32xw = int32x4_t;
+
+[[nodiscard]] inline i32xw load_wide( const int* ptr ) { return vld1q_s32( ptr ); }
+inline void                store_wide( int* ptr, i32xw v ) { vst1q_s32( ptr, v ); }
+[[nodiscard]] inline i32xw splat_wide( int s ) { return vdupq_n_s32( s ); }
+
+[[nodiscard]] inline i32xw add( i32xw a, i32xw b ) { return vaddq_s32( a, b ); }
+[[nodiscard]] inline i32xw sub( i32xw a, i32xw b ) { return vsubq_s32( a, b ); }
+[[nodiscard]] inline i32xw mul( i32xw a, i32xw b ) { return vmulq_s32( a, b ); }
+[[nodiscard]] inline i32xw min( i32xw a, i32xw b ) { return vminq_s32( a, b ); }
+[[nodiscard]] inline i32xw max( i32xw a, i32xw b ) { return vmaxq_s32( a, b ); }
+[[nodiscard]] inline i32xw shift_left( i32xw a, int n ) { return vshlq_s32( a, vdupq_n_s32( n ) ); }
+[[nodiscard]] inline i32xw shift_right( i32xw a, int n ) { return vshlq_s32( a, vdupq_n_s32( -n ) ); }
+[[nodiscard]] inline i32xw bit_and( i32xw a, i32xw b ) { return vandq_s32( a, b ); }
+[[nodiscard]] inline i32xw bit_or( i32xw a, i32xw b ) { return vorrq_s32( a, b ); }
+[[nodiscard]] inline i32xw floor_to_int( f32xw a ) { return vcvtmq_s32_f32( a ); }
+[[nodiscard]] inline i32xw round_to_int( f32xw a ) { return vcvtnq_s32_f32( a ); }
+[[nodiscard]] inline f32xw to_float( i32xw a ) { return vcvtq_f32_s32( a ); }
+[[nodiscard]] inline i32xw as_int( f32xw a ) { return vreinterpretq_s32_f32( a ); }
+[[nodiscard]] inline f32xw as_float( i32xw a ) { return vreinterpretq_f32_s32( a ); }
+
+#endif
+
+// Moves wide_lanes consecutive groups of four floats, such as quaternions or Vec4s, between memory and one register per
+// member: out[c] holds member c of every group. store_interleave4 is the inverse.
+#if defined( LINALG_SIMD_AVX512 ) || defined( LINALG_SIMD_AVX2 )
+
+// The 4x4 transpose of _MM_TRANSPOSE4_PS within every 128-bit lane.
+template<typename F, typename UnpackLo, typename UnpackHi, typename PairLo, typename PairHi>
+inline void transpose_lanes4( F ( &r )[4], UnpackLo unpack_lo, UnpackHi unpack_hi, PairLo pair_lo, PairHi pair_hi )
+{
+  const F t0 = unpack_lo( r[0], r[1] );
+  const F t1 = unpack_hi( r[0], r[1] );
+  const F t2 = unpack_lo( r[2], r[3] );
+  const F t3 = unpack_hi( r[2], r[3] );
+  r[0]       = pair_lo( t0, t2 );
+  r[1]       = pair_hi( t0, t2 );
+  r[2]       = pair_lo( t1, t3 );
+  r[3]       = pair_hi( t1, t3 );
+}
+
+#endif
+
+#if defined( LINALG_SIMD_AVX512 )
+
+// Register k holds groups 4k to 4k + 3, so after the in-lane transpose element 4j + k of out[c] belongs to group
+// 4k + j; the permutation that swaps j and k is its own inverse.
+inline void transpose_groups4( f32xw ( &r )[4] )
+{
+  transpose_lanes4(
+    r,
+    []( f32xw a, f32xw b ) { return _mm512_unpacklo_ps( a, b ); },
+    []( f32xw a, f32xw b ) { return _mm512_unpackhi_ps( a, b ); },
+    []( f32xw a, f32xw b ) {
+      return _mm512_castpd_ps( _mm512_unpacklo_pd( _mm512_castps_pd( a ), _mm512_castps_pd( b ) ) );
+    },
+    []( f32xw a, f32xw b ) {
+      return _mm512_castpd_ps( _mm512_unpackhi_pd( _mm512_castps_pd( a ), _mm512_castps_pd( b ) ) );
+    } );
+}
+
+inline void load_deinterleave4( const float* ptr, f32xw ( &out )[4] )
+{
+  const __m512i order = _mm512_setr_epi32( 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15 );
+  for ( int c = 0; c != 4; ++c )
+  {
+    out[c] = _mm512_loadu_ps( ptr + 16 * c );
+  }
+  transpose_groups4( out );
+  for ( int c = 0; c != 4; ++c )
+  {
+    out[c] = _mm512_permutexvar_ps( order, out[c] );
+  }
+}
+
+inline void store_interleave4( float* ptr, const f32xw ( &in )[4] )
+{
+  const __m512i order = _mm512_setr_epi32( 0, 4, 8, 12, 1, 5, 9, 13, 2, 6, 10, 14, 3, 7, 11, 15 );
+  f32xw         r[4];
+  for ( int c = 0; c != 4; ++c )
+  {
+    r[c] = _mm512_permutexvar_ps( order, in[c] );
+  }
+  transpose_groups4( r );
+  for ( int c = 0; c != 4; ++c )
+  {
+    _mm512_storeu_ps( ptr + 16 * c, r[c] );
+  }
+}
+
+#elif defined( LINALG_SIMD_AVX2 )
+
+// Register k holds groups k and k + 4, so the in-lane transpose leaves the groups in order.
+inline void transpose_groups4( f32xw ( &r )[4] )
+{
+  transpose_lanes4(
+    r,
+    []( f32xw a, f32xw b ) { return _mm256_unpacklo_ps( a, b ); },
+    []( f32xw a, f32xw b ) { return _mm256_unpackhi_ps( a, b ); },
+    []( f32xw a, f32xw b ) {
+      return _mm256_castpd_ps( _mm256_unpacklo_pd( _mm256_castps_pd( a ), _mm256_castps_pd( b ) ) );
+    },
+    []( f32xw a, f32xw b ) {
+      return _mm256_castpd_ps( _mm256_unpackhi_pd( _mm256_castps_pd( a ), _mm256_castps_pd( b ) ) );
+    } );
+}
+
+inline void load_deinterleave4( const float* ptr, f32xw ( &out )[4] )
+{
+  for ( int k = 0; k != 4; ++k )
+  {
+    out[k] = _mm256_insertf128_ps(
+      _mm256_castps128_ps256( _mm_loadu_ps( ptr + 4 * k ) ), _mm_loadu_ps( ptr + 4 * k + 16 ), 1 );
+  }
+  transpose_groups4( out );
+}
+
+inline void store_interleave4( float* ptr, const f32xw ( &in )[4] )
+{
+  f32xw r[4] = { in[0], in[1], in[2], in[3] };
+  transpose_groups4( r );
+  for ( int k = 0; k != 4; ++k )
+  {
+    _mm_storeu_ps( ptr + 4 * k, _mm256_castps256_ps128( r[k] ) );
+    _mm_storeu_ps( ptr + 4 * k + 16, _mm256_extractf128_ps( r[k], 1 ) );
+  }
+}
+
+#elif defined( LINALG_SIMD_NEON )
+
+inline void load_deinterleave4( const float* ptr, f32xw ( &out )[4] )
+{
+  const float32x4x4_t groups = vld4q_f32( ptr );
+  for ( int c = 0; c != 4; ++c )
+  {
+    out[c] = groups.val[c];
+  }
+}
+
+inline void store_interleave4( float* ptr, const f32xw ( &in )[4] )
+{
+  vst4q_f32( ptr, float32x4x4_t{ { in[0], in[1], in[2], in[3] } } );
+}
+
+#elif defined( LINALG_SIMD_F32X4 )
+
+inline void load_deinterleave4( const float* ptr, f32xw ( &out )[4] )
+{
+  for ( int c = 0; c != 4; ++c )
+  {
+    out[c] = _mm_loadu_ps( ptr + 4 * c );
+  }
+  _MM_TRANSPOSE4_PS( out[0], out[1], out[2], out[3] );
+}
+
+inline void store_interleave4( float* ptr, const f32xw ( &in )[4] )
+{
+  f32xw r[4] = { in[0], in[1], in[2], in[3] };
+  _MM_TRANSPOSE4_PS( r[0], r[1], r[2], r[3] );
+  for ( int c = 0; c != 4; ++c )
+  {
+    _mm_storeu_ps( ptr + 4 * c, r[c] );
+  }
+}
+
+#endif
+
+// out[i] = base[index[i]]. SSE and NEON have no gather instruction and go through memory.
+#if defined( LINALG_SIMD_AVX512 )
+
+[[nodiscard]] inline f32xw gather_wide( const float* base, i32xw index )
+{
+  return _mm512_i32gather_ps( index, base, sizeof( float ) );
+}
+
+#elif defined( LINALG_SIMD_AVX2 )
+
+[[nodiscard]] inline f32xw gather_wide( const float* base, i32xw index )
+{
+  return _mm256_i32gather_ps( base, index, sizeof( float ) );
+}
+
+#elif defined( LINALG_SIMD_F32X4 )
+
+[[nodiscard]] inline f32xw gather_wide( const float* base, i32xw index )
+{
+  alignas( 16 ) int   offsets[4];
+  alignas( 16 ) float values[4];
+  store_wide( offsets, index );
+  for ( int i = 0; i != 4; ++i )
+  {
+    values[i] = base[offsets[i]];
+  }
+  return load_wide( values );
+}
+
+#endif
+
+} // namespace linalg::simd
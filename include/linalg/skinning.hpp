@@ -0,0 +1,187 @@
+#pragma once
+
+#include "dual_quaternion.hpp"
+#include "parallel.hpp"
+#include "quaternion_batch.hpp"
+#include "vec_batch.hpp"
+#include "vmath.hpp"
+#include <cassert>
+#include <cstddef>
+#include <span>
+
+namespace linalg {
+
+namespace detail {
+
+static_assert( sizeof( DualQuaternion ) == 8 * sizeof( float ) );
+
+// Skins one register of vertices. The influences are gathered from the palette and summed with their weights, after
+// negating those whose real part lies in the other hemisphere from the first influence, so that all of them take the
+// shorter arc (L. Kavan et al., "Geometric Skinning with Approximate Dual Quaternion Blending"). Dividing the sum by
+// the length of its real part gives a rigid transform.
+template<typename L, bool Normals>
+void skin_lanes( const float*   palette,
+  const ConstLanes<int, 4>&     bones,
+  const ConstLanes<float, 4>&   weights,
+  const ConstLanes<float, 3>&   positions,
+  const ConstLanes<float, 3>&   normals,
+  const MutableLanes<float, 3>& out_positions,
+  const MutableLanes<float, 3>& out_normals,
+  size_t                        i )
+{
+  using I = typename L::int_lanes;
+  typename L::pack real[4];
+  typename L::pack dual[4];
+  typename L::pack pivot[4];
+  for ( size_t k = 0; k != 4; ++k )
+  {
+    const auto       offset = I::shift_left( I::load( bones.ptr[k] + i ), 3 );
+    typename L::pack q[8];
+    for ( size_t c = 0; c != 8; ++c )
+    {
+      q[c] = L::gather( palette + c, offset );
+    }
+    auto weight = L::load( weights.ptr[k] + i );
+    if ( k == 0 )
+    {
+      for ( size_t c = 0; c != 4; ++c )
+      {
+        pivot[c] = q[c];
+        real[c]  = L::mul( weight, q[c] );
+        dual[c]  = L::mul( weight, q[c + 4] );
+      }
+      continue;
+    }
+    auto d = L::mul( pivot[0], q[0] );
+    for ( size_t c = 1; c != 4; ++c )
+    {
+      d = L::fmadd( pivot[c], q[c], d );
+    }
+    weight = L::bit_xor( weight, L::bit_and( d, L::splat( -0.0F ) ) );
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      real[c] = L::fmadd( weight, q[c], real[c] );
+      dual[c] = L::fmadd( weight, q[c + 4], dual[c] );
+    }
+  }
+
+  auto length_squared = L::mul( real[0], real[0] );
+  for ( size_t c = 1; c != 4; ++c )
+  {
+    length_squared = L::fmadd( real[c], real[c], length_squared );
+  }
+  const auto inverse_length = L::template rsqrt<Refined>( length_squared );
+  for ( size_t c = 0; c != 4; ++c )
+  {
+    real[c] = L::mul( real[c], inverse_length );
+    dual[c] = L::mul( dual[c], inverse_length );
+  }
+
+  // The translation 2 ( w_r v_d - w_d v_r + v_r x v_d ) of DualQuaternion::get_translation.
+  typename L::pack p[3];
+  typename L::pack rotated[3];
+  for ( size_t k = 0; k != 3; ++k )
+  {
+    p[k] = L::load( positions.ptr[k] + i );
+  }
+  rotate_lanes<L>( real, p, rotated );
+  for ( size_t k = 0; k != 3; ++k )
+  {
+    const size_t a           = ( k + 1 ) % 3;
+    const size_t b           = ( k + 2 ) % 3;
+    const auto   cross       = L::sub( L::mul( real[a], dual[b] ), L::mul( real[b], dual[a] ) );
+    const auto   translation = L::fmadd( real[3], dual[k], L::sub( cross, L::mul( dual[3], real[k] ) ) );
+    L::store( out_positions.ptr[k] + i, L::fmadd( L::splat( 2.0F ), translation, rotated[k] ) );
+  }
+
+  if constexpr ( Normals )
+  {
+    typename L::pack n[3];
+    for ( size_t k = 0; k != 3; ++k )
+    {
+      n[k] = L::load( normals.ptr[k] + i );
+    }
+    rotate_lanes<L>( real, n, rotated );
+    for ( size_t k = 0; k != 3; ++k )
+    {
+      L::store( out_normals.ptr[k] + i, rotated[k] );
+    }
+  }
+}
+
+// Runs over whole registers: chunk bounds are rounded up to the register width, which padded_size() allows. The last,
+// partial register goes one vertex at a time, since the bone indices in the padding are unspecified and must not be
+// gathered through.
+template<bool Normals>
+void skin( std::span<const DualQuaternion> palette,
+  const IVec4Batch&                        bones,
+  const Vec4Batch&                         weights,
+  const Point3Batch&                       positions,
+  const Vec3Batch*                         normals,
+  Point3Batch&                             out_positions,
+  Vec3Batch*                               out_normals,
+  Threads                                  threads )
+{
+  using L = MathLanes;
+  assert( bones.size() == positions.size() && weights.size() == positions.size() );
+  out_positions.resize( positions.size() );
+  const ConstLanes<int, 4>     b( bones );
+  const ConstLanes<float, 4>   w( weights );
+  const ConstLanes<float, 3>   p( positions );
+  const MutableLanes<float, 3> op( out_positions );
+  if constexpr ( Normals )
+  {
+    assert( normals->size() == positions.size() );
+    out_normals->resize( positions.size() );
+  }
+  // Without normals these lanes are never touched; they alias the positions to stay valid.
+  const ConstLanes<float, 3>   n( Normals ? *normals : positions );
+  const MutableLanes<float, 3> on( Normals ? *out_normals : out_positions );
+  const auto* base = reinterpret_cast<const float*>( palette.data() );
+  parallel_for( positions.size(), threads, [&]( size_t begin, size_t end ) {
+    const auto round_up = []( size_t i ) { return ( i + L::width - 1 ) / L::width * L::width; };
+    for ( size_t i = round_up( begin ); i < round_up( end ); i += L::width )
+    {
+      if ( i + L::width <= positions.size() )
+      {
+        skin_lanes<L, Normals>( base, b, w, p, n, op, on, i );
+        continue;
+      }
+      for ( size_t j = i; j != positions.size(); ++j )
+      {
+        skin_lanes<ScalarLanes<float>, Normals>( base, b, w, p, n, op, on, j );
+      }
+    }
+  } );
+}
+
+} // namespace detail
+
+// Dual quaternion skinning: out_positions[i] is positions[i] transformed by the blend of palette[bones[i][k]] with
+// weights[i][k] for the four influences k. Weights should sum to one; unused influences take weight zero and any
+// valid bone index. Unlike blending matrices, the blend stays rigid, so joints keep their volume under twist.
+// Outputs may alias the inputs.
+inline void skin( std::span<const DualQuaternion> palette,
+  const IVec4Batch&                               bones,
+  const Vec4Batch&                                weights,
+  const Point3Batch&                              positions,
+  Point3Batch&                                    out_positions,
+  Threads                                         threads = {} )
+{
+  detail::skin<false>( palette, bones, weights, positions, nullptr, out_positions, nullptr, threads );
+}
+
+// Also rotates normals[i] by the same blended rotation.
+inline void skin( std::span<const DualQuaternion> palette,
+  const IVec4Batch&                               bones,
+  const Vec4Batch&                                weights,
+  const Point3Batch&                              positions,
+  const Vec3Batch&                                normals,
+  Point3Batch&                                    out_positions,
+  Vec3Batch&                                      out_normals,
+  Threads                                         threads = {} )
+{
+  detail::skin<true>( palette, bones, weights, positions, &normals, out_positions, &out_normals, threads );
+}
+
+} // namespace linalg
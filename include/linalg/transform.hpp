@@ -6,46 +6,36 @@
 
 namespace linalg {
 
-class Transform4 : public Mat4
+template<typename T>
+class Transform4T : public Mat4T<T>
 {
 public:
-  constexpr Transform4() = default;
-
-  constexpr Transform4( float t00,
-    float                     t01,
-    float                     t02,
-    float                     t03,
-    float                     t10,
-    float                     t11,
-    float                     t12,
-    float                     t13,
-    float                     t20,
-    float                     t21,
-    float                     t22,
-    float                     t23 )
-    : Mat4( t00, t01, t02, t03, t10, t11, t12, t13, t20, t21, t22, t23, 0.0F, 0.0F, 0.0F, 1.0F )
+  constexpr Transform4T() = default;
+
+  constexpr Transform4T( T t00, T t01, T t02, T t03, T t10, T t11, T t12, T t13, T t20, T t21, T t22, T t23 )
+    : Mat4T<T>( t00, t01, t02, t03, t10, t11, t12, t13, t20, t21, t22, t23, T{ 0 }, T{ 0 }, T{ 0 }, T{ 1 } )
   {}
 
-  constexpr Transform4( const Vec3& v00, const Vec3& v01, const Vec3& v02, const Point3& p03 )
-    : Mat4( Vec4( v00, 0.0F ), Vec4( v01, 0.0F ), Vec4( v02, 0.0F ), Vec4( p03, 1.0F ) )
+  constexpr Transform4T( const Vec<T, 3>& v00, const Vec<T, 3>& v01, const Vec<T, 3>& v02, const Point3T<T>& p03 )
+    : Mat4T<T>( Vec<T, 4>( v00, T{ 0 } ), Vec<T, 4>( v01, T{ 0 } ), Vec<T, 4>( v02, T{ 0 } ), Vec<T, 4>( p03, T{ 1 } ) )
   {}
 
-  constexpr Transform4( const Mat4& mat ) : Mat4( mat ) {}
+  constexpr Transform4T( const Mat4T<T>& mat ) : Mat4T<T>( mat ) {}
 
-  [[nodiscard]] constexpr Vec3 get_column3( size_t i ) const
+  [[nodiscard]] constexpr Vec<T, 3> get_column3( size_t i ) const
   {
-    const Vec4& vec4 = Mat4::operator[]( i );
-    return vec4.to_sub_vec<3>();
+    const Vec<T, 4>& vec4 = Mat4T<T>::operator[]( i );
+    return vec4.template to_sub_vec<3>();
   }
 
-  [[nodiscard]] constexpr Vec3 operator[]( size_t i ) const { return get_column3( i ); }
+  [[nodiscard]] constexpr Vec<T, 3> operator[]( size_t i ) const { return get_column3( i ); }
 
-  [[nodiscard]] constexpr Point3 get_translation() const
+  [[nodiscard]] constexpr Point3T<T> get_translation() const
   {
-    return Point3{ ( *this )( 0, 3 ), ( *this )( 1, 3 ), ( *this )( 2, 3 ) };
+    return Point3T<T>{ ( *this )( 0, 3 ), ( *this )( 1, 3 ), ( *this )( 2, 3 ) };
   }
 
-  constexpr void set_translation( const Point3& point )
+  constexpr void set_translation( const Point3T<T>& point )
   {
     ( *this )( 0, 3 ) = point.x();
     ( *this )( 1, 3 ) = point.y();
@@ -53,25 +43,61 @@ public:
   }
 };
 
-[[nodiscard]] constexpr Transform4 inverse( const Transform4& mat )
+using Transform4  = Transform4T<float>;
+using DTransform4 = Transform4T<double>;
+
+template<typename T>
+[[nodiscard]] constexpr Transform4T<T> inverse( const Transform4T<T>& mat )
 {
-  const Vec3& a = mat[0];
-  const Vec3& b = mat[1];
-  const Vec3& c = mat[2];
-  const Vec3& d = mat[3];
+#ifdef LINALG_SIMD_F64X4
+  if constexpr ( simd::is_f64x4<T, 4> )
+  {
+    if !consteval
+    {
+      const simd::Columns4d m = simd::load_columns( mat );
+
+      simd::f64x4 s = simd::cross3( m.col[0], m.col[1] );
+      simd::f64x4 t = simd::cross3( m.col[2], m.col[3] );
+
+      const simd::f64x4 inv_det = simd::splat( 1.0 / simd::dot3( s, m.col[2] ) );
+      s                         = simd::mul( s, inv_det );
+      t                         = simd::mul( t, inv_det );
+
+      const simd::f64x4 v = simd::mul( m.col[2], inv_det );
+      simd::Columns4d   rows{ {
+        simd::with_w( simd::cross3( m.col[1], v ), -simd::dot3( m.col[1], t ) ),
+        simd::with_w( simd::cross3( v, m.col[0] ), simd::dot3( m.col[0], t ) ),
+        simd::with_w( s, -simd::dot3( m.col[3], s ) ),
+        simd::with_w( simd::splat( 0.0 ), 1.0 ),
+      } };
+      simd::transpose( rows );
 
-  Vec3 s = cross( a, b );
-  Vec3 t = cross( c, d );
+      Transform4T<T> result;
+      for ( size_t j = 0; j != 4; ++j )
+      {
+        simd::store( result.Mat4T<T>::operator[]( j ).data(), rows.col[j] );
+      }
+      return result;
+    }
+  }
+#endif
+  const Vec<T, 3>& a = mat[0];
+  const Vec<T, 3>& b = mat[1];
+  const Vec<T, 3>& c = mat[2];
+  const Vec<T, 3>& d = mat[3];
+
+  Vec<T, 3> s = cross( a, b );
+  Vec<T, 3> t = cross( c, d );
 
-  const float inv_det = 1.0F / dot( s, c );
+  const T inv_det = T{ 1 } / dot( s, c );
   s *= inv_det;
   t *= inv_det;
 
-  const Vec3 v  = c * inv_det;
-  const Vec3 r0 = cross( b, v );
-  const Vec3 r1 = cross( v, a );
+  const Vec<T, 3> v  = c * inv_det;
+  const Vec<T, 3> r0 = cross( b, v );
+  const Vec<T, 3> r1 = cross( v, a );
 
-  return Transform4{
+  return Transform4T<T>{
     r0.x(),
     r0.y(),
     r0.z(),
@@ -87,65 +113,272 @@ public:
   };
 }
 
-[[nodiscard]] constexpr Vec3 operator*( const Transform4& t, const Vec3& vec )
+// Both bottom rows are ( 0, 0, 0, 1 ), so only the upper 3x4 block is computed: 36 multiplies against the 64 of the
+// general 4x4 product, and the result stays a Transform4.
+template<FmaPolicy Policy, typename T>
+[[nodiscard]] constexpr Transform4T<T> multiply( const Transform4T<T>& left, const Transform4T<T>& right )
 {
-  return Vec3{
-    t( 0, 0 ) * vec.x() + t( 0, 1 ) * vec.y() + t( 0, 2 ) * vec.z(),
-    t( 1, 0 ) * vec.x() + t( 1, 1 ) * vec.y() + t( 1, 2 ) * vec.z(),
-    t( 2, 0 ) * vec.x() + t( 2, 1 ) * vec.y() + t( 2, 2 ) * vec.z(),
-  };
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_packed4<T, 4> )
+  {
+    if !consteval
+    {
+      const auto cols    = simd::load_columns( left );
+      auto       product = cols;
+      for ( size_t j = 0; j != 4; ++j )
+      {
+        const T* col   = right.Mat4T<T>::operator[]( j ).data();
+        auto     sum   = simd::mul( cols.col[0], simd::broadcast<0>( col ) );
+        sum            = simd::madd<Policy>( cols.col[1], simd::broadcast<1>( col ), sum );
+        product.col[j] = simd::madd<Policy>( cols.col[2], simd::broadcast<2>( col ), sum );
+      }
+      product.col[3] = simd::add( product.col[3], cols.col[3] );
+
+      Transform4T<T> result;
+      for ( size_t j = 0; j != 4; ++j )
+      {
+        simd::store( result.Mat4T<T>::operator[]( j ).data(), product.col[j] );
+      }
+      return result;
+    }
+  }
+#endif
+  Transform4T<T> result;
+  for ( size_t i = 0; i != 3; ++i )
+  {
+    for ( size_t j = 0; j != 4; ++j )
+    {
+      T sum          = left( i, 0 ) * right( 0, j );
+      sum            = madd<Policy>( left( i, 1 ), right( 1, j ), sum );
+      result( i, j ) = madd<Policy>( left( i, 2 ), right( 2, j ), sum );
+    }
+    result( i, 3 ) += left( i, 3 );
+  }
+  result( 3, 3 ) = T{ 1 };
+  return result;
 }
 
-[[nodiscard]] constexpr Point3 operator*( const Transform4& t, const Point3& point )
+template<FmaPolicy Policy, typename T>
+[[nodiscard]] constexpr Vec<T, 3> multiply( const Transform4T<T>& t, const Vec<T, 3>& vec )
 {
-  return Point3{
-    t( 0, 0 ) * point.x() + t( 0, 1 ) * point.y() + t( 0, 2 ) * point.z() + t( 0, 3 ),
-    t( 1, 0 ) * point.x() + t( 1, 1 ) * point.y() + t( 1, 2 ) * point.z() + t( 1, 3 ),
-    t( 2, 0 ) * point.x() + t( 2, 1 ) * point.y() + t( 2, 2 ) * point.z() + t( 2, 3 ),
-  };
+  Vec<T, 3> result;
+  for ( size_t i = 0; i != 3; ++i )
+  {
+    const T sum = madd<Policy>( t( i, 1 ), vec.y(), t( i, 0 ) * vec.x() );
+    result[i]   = madd<Policy>( t( i, 2 ), vec.z(), sum );
+  }
+  return result;
+}
+
+template<FmaPolicy Policy, typename T>
+[[nodiscard]] constexpr Point3T<T> multiply( const Transform4T<T>& t, const Point3T<T>& point )
+{
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_packed4<T, 4> )
+  {
+    if !consteval
+    {
+      const Vec<T, 4> p{ point, T{ 1 } };
+      Vec<T, 4>       result;
+      simd::store( result.data(), simd::combine_columns<Policy>( simd::load_columns( t ), p.data() ) );
+      return Point3T<T>{ result.x(), result.y(), result.z() };
+    }
+  }
+#endif
+  Point3T<T> result;
+  for ( size_t i = 0; i != 3; ++i )
+  {
+    const T sum = madd<Policy>( t( i, 1 ), point.y(), t( i, 0 ) * point.x() );
+    result[i]   = madd<Policy>( t( i, 2 ), point.z(), sum ) + t( i, 3 );
+  }
+  return result;
 }
 
-[[nodiscard]] constexpr Vec3 transform_normal( const Vec3& normal, const Transform4& t )
+template<typename T>
+[[nodiscard]] constexpr Transform4T<T> operator*( const Transform4T<T>& left, const Transform4T<T>& right )
 {
-  return Vec3{
+  return multiply<DefaultFma>( left, right );
+}
+
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> operator*( const Transform4T<T>& t, const Vec<T, 3>& vec )
+{
+  return multiply<DefaultFma>( t, vec );
+}
+
+template<typename T>
+[[nodiscard]] constexpr Point3T<T> operator*( const Transform4T<T>& t, const Point3T<T>& point )
+{
+  return multiply<DefaultFma>( t, point );
+}
+
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> transform_normal( const Vec<T, 3>& normal, const Transform4T<T>& t )
+{
+  return Vec<T, 3>{
     normal.x() * t( 0, 0 ) + normal.y() * t( 1, 0 ) + normal.z() * t( 2, 0 ),
     normal.x() * t( 0, 1 ) + normal.y() * t( 1, 1 ) + normal.z() * t( 2, 1 ),
     normal.x() * t( 0, 2 ) + normal.y() * t( 1, 2 ) + normal.z() * t( 2, 2 ),
   };
 }
 
-[[nodiscard]] constexpr Vec3 operator*( const Vec3& normal_vec, const Transform4& t )
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> operator*( const Vec<T, 3>& normal_vec, const Transform4T<T>& t )
 {
   return transform_normal( normal_vec, t );
 }
 
-[[nodiscard]] constexpr Transform4 make_translation( const Vec3& offset )
+namespace detail {
+
+// Base of the Transform4 kinds below. Their inverses and products rely on the structure of the matrix, so the
+// mutators of Transform4 are deleted and elements are read-only; modify a Transform4 copy instead, which then takes
+// the general inverse.
+template<typename T>
+class TransformKind : public Transform4T<T>
+{
+public:
+  using Transform4T<T>::Transform4T;
+  [[nodiscard]] constexpr const T& operator()( size_t i, size_t j ) const { return Transform4T<T>::operator()( i, j ); }
+
+  TransformKind& operator+=( const Mat<T, 4, 4>& other ) = delete;
+  TransformKind& operator-=( const Mat<T, 4, 4>& other ) = delete;
+  template<typename U>
+  TransformKind& operator*=( U mul ) = delete;
+  template<typename U>
+  TransformKind& operator/=( U div ) = delete;
+  void           set_translation( const Point3T<T>& point ) = delete;
+};
+
+} // namespace detail
+
+// Transform4 kinds whose structure gives cheap inverses and products. Each is still a Transform4, so mixed products
+// and anything expecting a general transform take them unchanged.
+template<typename T>
+class Translation4T : public detail::TransformKind<T>
+{
+public:
+  constexpr Translation4T() : detail::TransformKind<T>( Mat4T<T>::identity() ) {}
+
+  explicit constexpr Translation4T( const Vec<T, 3>& offset )
+    : detail::TransformKind<T>(
+        T{ 1 }, T{ 0 }, T{ 0 }, offset.x(), T{ 0 }, T{ 1 }, T{ 0 }, offset.y(), T{ 0 }, T{ 0 }, T{ 1 }, offset.z() )
+  {}
+};
+
+template<typename T>
+class Rotation4T : public detail::TransformKind<T>
+{
+public:
+  constexpr Rotation4T() : detail::TransformKind<T>( Mat4T<T>::identity() ) {}
+
+  explicit constexpr Rotation4T( const Rotation3T<T>& rot )
+    : detail::TransformKind<T>( rot[0], rot[1], rot[2], Point3T<T>{ T{ 0 }, T{ 0 }, T{ 0 } } )
+  {}
+
+  [[nodiscard]] constexpr Rotation3T<T> get_rotation3() const
+  {
+    return Rotation3T<T>{ Mat3T<T>{ this->get_column3( 0 ), this->get_column3( 1 ), this->get_column3( 2 ) } };
+  }
+};
+
+// Axis-aligned scale.
+template<typename T>
+class Scale4T : public detail::TransformKind<T>
+{
+public:
+  constexpr Scale4T() : detail::TransformKind<T>( Mat4T<T>::identity() ) {}
+
+  explicit constexpr Scale4T( const Vec<T, 3>& s )
+    : detail::TransformKind<T>(
+        s.x(), T{ 0 }, T{ 0 }, T{ 0 }, T{ 0 }, s.y(), T{ 0 }, T{ 0 }, T{ 0 }, T{ 0 }, s.z(), T{ 0 } )
+  {}
+
+  [[nodiscard]] constexpr Vec<T, 3> get_scale() const
+  {
+    return Vec<T, 3>{ ( *this )( 0, 0 ), ( *this )( 1, 1 ), ( *this )( 2, 2 ) };
+  }
+};
+
+using Translation4 = Translation4T<float>;
+using Rotation4    = Rotation4T<float>;
+using Scale4       = Scale4T<float>;
+
+template<typename T>
+[[nodiscard]] constexpr Translation4T<T> make_translation( const Vec<T, 3>& offset )
+{
+  return Translation4T<T>{ offset };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Rotation4T<T> make_rotation4( std::type_identity_t<T> angle, const Vec<T, 3>& axis )
 {
-  return Transform4{ 1.0F, 0.0F, 0.0F, offset.x(), 0.0F, 1.0F, 0.0F, offset.y(), 0.0F, 0.0F, 1.0F, offset.z() };
+  return Rotation4T<T>{ make_rotation( angle, axis ) };
 }
 
-[[nodiscard]] inline Transform4 make_rotation4( float angle, const Vec3& axis )
+template<typename T>
+[[nodiscard]] constexpr Scale4T<T> make_scale( const Vec<T, 3>& s )
 {
-  Mat3 rot = make_rotation( angle, axis );
-  return Transform4{
-    rot( 0, 0 ),
-    rot( 0, 1 ),
-    rot( 0, 2 ),
-    0.0F,
-    rot( 1, 0 ),
-    rot( 1, 1 ),
-    rot( 1, 2 ),
-    0.0F,
-    rot( 2, 0 ),
-    rot( 2, 1 ),
-    rot( 2, 2 ),
-    0.0F,
-  };
+  return Scale4T<T>{ s };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Translation4T<T> inverse( const Translation4T<T>& t )
+{
+  return Translation4T<T>{ -t.get_translation() };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Rotation4T<T> inverse( const Rotation4T<T>& r )
+{
+  return Rotation4T<T>{ inverse( r.get_rotation3() ) };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Scale4T<T> inverse( const Scale4T<T>& s )
+{
+  return Scale4T<T>{ T{ 1 } / s.get_scale() };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Translation4T<T> operator*( const Translation4T<T>& left, const Translation4T<T>& right )
+{
+  return Translation4T<T>{ left.get_translation() + right.get_translation() };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Rotation4T<T> operator*( const Rotation4T<T>& left, const Rotation4T<T>& right )
+{
+  return Rotation4T<T>{ left.get_rotation3() * right.get_rotation3() };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Scale4T<T> operator*( const Scale4T<T>& left, const Scale4T<T>& right )
+{
+  return Scale4T<T>{ left.get_scale() * right.get_scale() };
+}
+
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> operator*( const Translation4T<T>& /*t*/, const Vec<T, 3>& vec )
+{
+  return vec;
+}
+
+template<typename T>
+[[nodiscard]] constexpr Point3T<T> operator*( const Translation4T<T>& t, const Point3T<T>& point )
+{
+  return point + t.get_translation();
+}
+
+template<typename T>
+[[nodiscard]] constexpr Vec<T, 3> operator*( const Scale4T<T>& s, const Vec<T, 3>& vec )
+{
+  return s.get_scale() * vec;
 }
 
-[[nodiscard]] constexpr Transform4 make_scale( const Vec3& s )
+template<typename T>
+[[nodiscard]] constexpr Point3T<T> operator*( const Scale4T<T>& s, const Point3T<T>& point )
 {
-  return Transform4{ s.x(), 0.0F, 0.0F, 0.0F, 0.0F, s.y(), 0.0F, 0.0F, 0.0F, 0.0F, s.z(), 0.0F };
+  return Point3T<T>{ s.get_scale() * point };
 }
 
 } // namespace linalg
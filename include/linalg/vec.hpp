@@ -1,13 +1,20 @@
 #pragma once
 
 #include "constants.hpp"
+#include "half.hpp"
+#include "math.hpp"
+#include "rsqrt.hpp"
+#include "simd.hpp"
 #include <array>
 #include <cassert>
 #include <cmath>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <format>
+#include <functional>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 namespace linalg {
@@ -15,8 +22,10 @@ namespace linalg {
 template<typename T>
 concept Arithmetic = std::integral<T> || std::floating_point<T>;
 
+// Vec also holds the 16-bit storage types from half.hpp, for compact containers; convert them with vec_cast to do
+// arithmetic.
 template<typename T, size_t N>
-  requires Arithmetic<T>
+  requires Arithmetic<T> || StorageFloat<T>
 class Vec
 {
 public:
@@ -24,7 +33,7 @@ public:
   static constexpr size_t length = N;
 
 private:
-  std::array<T, N> m_data{};
+  alignas( simd::alignment<T, N> ) std::array<T, N> m_data{};
 
   template<typename U>
   static constexpr bool is_compatible_scalar = std::same_as<U, T>;
@@ -94,6 +103,9 @@ public:
     return m_data[i];
   }
 
+  [[nodiscard]] constexpr T*       data() { return m_data.data(); }
+  [[nodiscard]] constexpr const T* data() const { return m_data.data(); }
+
   constexpr T& x() { return m_data[0]; }
   constexpr T& y() { return m_data[1]; }
   constexpr T& z()
@@ -146,6 +158,16 @@ public:
   constexpr Vec& operator*=( U val )
     requires std::same_as<T, U>
   {
+#ifdef LINALG_SIMD_F32X4
+    if constexpr ( simd::is_f32x4<T, N> )
+    {
+      if !consteval
+      {
+        simd::store( data(), simd::mul( simd::load( data() ), simd::splat( val ) ) );
+        return *this;
+      }
+    }
+#endif
     for ( auto& data : m_data )
     {
       data *= val;
@@ -167,6 +189,16 @@ public:
 
   constexpr Vec& operator+=( const Vec& other )
   {
+#ifdef LINALG_SIMD_F32X4
+    if constexpr ( simd::is_f32x4<T, N> )
+    {
+      if !consteval
+      {
+        simd::store( data(), simd::add( simd::load( data() ), simd::load( other.data() ) ) );
+        return *this;
+      }
+    }
+#endif
     for ( size_t i = 0; i != N; ++i )
     {
       m_data[i] += other.m_data[i];
@@ -176,6 +208,16 @@ public:
 
   constexpr Vec& operator-=( const Vec& other )
   {
+#ifdef LINALG_SIMD_F32X4
+    if constexpr ( simd::is_f32x4<T, N> )
+    {
+      if !consteval
+      {
+        simd::store( data(), simd::sub( simd::load( data() ), simd::load( other.data() ) ) );
+        return *this;
+      }
+    }
+#endif
     for ( size_t i = 0; i != N; ++i )
     {
       m_data[i] -= other.m_data[i];
@@ -185,6 +227,16 @@ public:
 
   constexpr Vec& operator*=( const Vec& other )
   {
+#ifdef LINALG_SIMD_F32X4
+    if constexpr ( simd::is_f32x4<T, N> )
+    {
+      if !consteval
+      {
+        simd::store( data(), simd::mul( simd::load( data() ), simd::load( other.data() ) ) );
+        return *this;
+      }
+    }
+#endif
     for ( size_t i = 0; i != N; ++i )
     {
       m_data[i] *= other.m_data[i];
@@ -214,14 +266,21 @@ public:
     }
   }
 
-  void normalize_in_place() { *this /= magnitude( *this ); }
+  template<RsqrtPolicy Policy = Exact>
+  constexpr void normalize_in_place()
+  {
+    *this = normalized<Policy>( *this );
+  }
 
   explicit operator std::string() const
   {
     std::string result = "Vec" + std::to_string( N ) + "(";
     for ( size_t i = 0; i < N; i++ )
     {
-      if constexpr ( std::floating_point<T> )
+      if constexpr ( StorageFloat<T> )
+      {
+        result += std::format( "{:.1f}", static_cast<float>( m_data[i] ) );
+      } else if constexpr ( std::floating_point<T> )
       {
         result += std::format( "{:.1f}", m_data[i] );
       } else
@@ -245,6 +304,17 @@ Vec( T, Ts... ) -> Vec<T, 1 + sizeof...( Ts )>;
 template<typename T, size_t N>
 [[nodiscard]] constexpr Vec<T, N> operator+( const Vec<T, N>& left, const Vec<T, N>& right )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_f32x4<T, N> )
+  {
+    if !consteval
+    {
+      Vec<T, N> vec;
+      simd::store( vec.data(), simd::add( simd::load( left.data() ), simd::load( right.data() ) ) );
+      return vec;
+    }
+  }
+#endif
   Vec<T, N> vec{};
   for ( size_t i = 0; i != N; ++i )
   {
@@ -256,6 +326,17 @@ template<typename T, size_t N>
 template<typename T, size_t N>
 [[nodiscard]] constexpr Vec<T, N> operator-( const Vec<T, N>& left, const Vec<T, N>& right )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_f32x4<T, N> )
+  {
+    if !consteval
+    {
+      Vec<T, N> vec;
+      simd::store( vec.data(), simd::sub( simd::load( left.data() ), simd::load( right.data() ) ) );
+      return vec;
+    }
+  }
+#endif
   Vec<T, N> vec{};
   for ( size_t i = 0; i != N; ++i )
   {
@@ -267,6 +348,17 @@ template<typename T, size_t N>
 template<typename T, size_t N>
 [[nodiscard]] constexpr Vec<T, N> operator-( const Vec<T, N>& left )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_f32x4<T, N> )
+  {
+    if !consteval
+    {
+      Vec<T, N> vec;
+      simd::store( vec.data(), simd::neg( simd::load( left.data() ) ) );
+      return vec;
+    }
+  }
+#endif
   Vec<T, N> vec{};
   for ( size_t i = 0; i != N; ++i )
   {
@@ -278,6 +370,17 @@ template<typename T, size_t N>
 template<typename T, size_t N>
 [[nodiscard]] constexpr Vec<T, N> operator*( const Vec<T, N>& vec, T mul )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_f32x4<T, N> )
+  {
+    if !consteval
+    {
+      Vec<T, N> result;
+      simd::store( result.data(), simd::mul( simd::load( vec.data() ), simd::splat( mul ) ) );
+      return result;
+    }
+  }
+#endif
   Vec<T, N> result{};
   for ( size_t i = 0; i != N; ++i )
   {
@@ -296,6 +399,17 @@ template<typename T, size_t N>
 [[nodiscard]] constexpr Vec<T, N> operator/( const Vec<T, N>& left, T div )
 {
   assert( div != 0.0F );
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_f32x4<T, N> )
+  {
+    if !consteval
+    {
+      Vec<T, N> vec;
+      simd::store( vec.data(), simd::div( simd::load( left.data() ), simd::splat( div ) ) );
+      return vec;
+    }
+  }
+#endif
   Vec<T, N> vec{};
   for ( size_t i = 0; i != N; ++i )
   {
@@ -320,6 +434,17 @@ template<typename T, size_t N>
 template<typename T, size_t N>
 [[nodiscard]] constexpr Vec<T, N> operator*( const Vec<T, N>& left, const Vec<T, N>& right )
 {
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_f32x4<T, N> )
+  {
+    if !consteval
+    {
+      Vec<T, N> result;
+      simd::store( result.data(), simd::mul( simd::load( left.data() ), simd::load( right.data() ) ) );
+      return result;
+    }
+  }
+#endif
   Vec<T, N> result{};
   for ( size_t i = 0; i != N; ++i )
   {
@@ -339,38 +464,50 @@ template<typename T, size_t N>
   return result;
 }
 
-template<typename T, size_t N>
-[[nodiscard]] constexpr T magnitude_squared( const Vec<T, N>& vec )
+template<FmaPolicy Policy = DefaultFma, typename T, size_t N>
+[[nodiscard]] constexpr T dot( const Vec<T, N>& left, const Vec<T, N>& right )
 {
-  T result{};
-  for ( size_t i = 0; i != N; ++i )
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( simd::is_f32x4<T, N> )
+  {
+    if !consteval
+    {
+      return simd::dot<Policy>( simd::load( left.data() ), simd::load( right.data() ) );
+    }
+  }
+#endif
+  T result = left[0] * right[0];
+  for ( size_t i = 1; i != N; ++i )
   {
-    result += vec[i] * vec[i];
+    result = madd<Policy>( left[i], right[i], result );
   }
   return result;
 }
 
-template<typename T, size_t N>
-[[nodiscard]] inline T magnitude( const Vec<T, N>& vec )
+template<FmaPolicy Policy = DefaultFma, typename T, size_t N>
+[[nodiscard]] constexpr T magnitude_squared( const Vec<T, N>& vec )
 {
-  return std::sqrt( magnitude_squared( vec ) );
+  return dot<Policy>( vec, vec );
 }
 
 template<typename T, size_t N>
-[[nodiscard]] inline Vec<T, N> normalized( const Vec<T, N>& vec )
+[[nodiscard]] constexpr T magnitude( const Vec<T, N>& vec )
 {
-  return vec / magnitude( vec );
+  return sqrt( magnitude_squared( vec ) );
 }
 
-template<typename T, size_t N>
-[[nodiscard]] constexpr T dot( const Vec<T, N>& left, const Vec<T, N>& right )
+// Exact divides by the magnitude and is constexpr; Refined and Estimate multiply by rsqrt<Policy>( magnitude_squared ),
+// trading the square root and divides for the error bounds listed in rsqrt.hpp.
+template<RsqrtPolicy Policy = Exact, typename T, size_t N>
+[[nodiscard]] constexpr Vec<T, N> normalized( const Vec<T, N>& vec )
 {
-  T result{};
-  for ( size_t i = 0; i != N; ++i )
+  if constexpr ( std::same_as<Policy, Exact> )
+  {
+    return vec / magnitude( vec );
+  } else
   {
-    result += left[i] * right[i];
+    return vec * rsqrt<Policy>( magnitude_squared( vec ) );
   }
-  return result;
 }
 
 template<typename T, size_t N>
@@ -395,15 +532,55 @@ template<typename T, size_t N>
 }
 
 template<typename T, size_t N>
-[[nodiscard]] inline bool is_unit_vector( const Vec<T, N>& vec, const T eps = epsilon )
+[[nodiscard]] constexpr bool is_unit_vector( const Vec<T, N>& vec, const T eps = epsilon )
 {
   return std::abs( dot( vec, vec ) - unit ) < eps;
 }
 
-using Vec2  = Vec<float, 2>;
-using Vec3  = Vec<float, 3>;
-using Vec4  = Vec<float, 4>;
-using IVec3 = Vec<int, 3>;
-using IVec4 = Vec<int, 4>;
+// Converts each component with static_cast, e.g. vec_cast<Half>( normal ) for storage and vec_cast<float>( back ).
+template<typename U, typename T, size_t N>
+[[nodiscard]] constexpr Vec<U, N> vec_cast( const Vec<T, N>& vec )
+{
+  Vec<U, N> result{};
+  for ( size_t i = 0; i != N; ++i )
+  {
+    result[i] = static_cast<U>( vec[i] );
+  }
+  return result;
+}
+
+using Vec2     = Vec<float, 2>;
+using Vec3     = Vec<float, 3>;
+using Vec4     = Vec<float, 4>;
+using DVec3    = Vec<double, 3>;
+using DVec4    = Vec<double, 4>;
+using IVec3    = Vec<int, 3>;
+using IVec4    = Vec<int, 4>;
+using HVec2    = Vec<Half, 2>;
+using HVec3    = Vec<Half, 3>;
+using HVec4    = Vec<Half, 4>;
+using BF16Vec3 = Vec<BFloat16, 3>;
+using BF16Vec4 = Vec<BFloat16, 4>;
 
 } // namespace linalg
+
+// Hashes integer vectors such as grid cells for unordered containers. Each component is folded in with a 64-bit
+// multiply and the murmur3 finalizer spreads the result over all bits, so neighbouring cells land far apart.
+template<std::integral T, size_t N>
+struct std::hash<linalg::Vec<T, N>>
+{
+  [[nodiscard]] size_t operator()( const linalg::Vec<T, N>& vec ) const noexcept
+  {
+    std::uint64_t h = 0;
+    for ( size_t i = 0; i != N; ++i )
+    {
+      h = ( h ^ static_cast<std::make_unsigned_t<T>>( vec[i] ) ) * 0x9e37'79b9'7f4a'7c15ULL;
+    }
+    h ^= h >> 33;
+    h *= 0xff51'afd7'ed55'8ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ce'b9fe'1a85'ec53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>( h );
+  }
+};
@@ -0,0 +1,799 @@
+#pragma once
+
+#include "grid.hpp"
+#include "point.hpp"
+#include "simd.hpp"
+#include "vec.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace linalg {
+
+namespace detail {
+
+template<typename T, size_t Alignment>
+struct AlignedAllocator
+{
+  using value_type = T;
+
+  template<typename U>
+  struct rebind
+  {
+    using other = AlignedAllocator<U, Alignment>;
+  };
+
+  constexpr AlignedAllocator() = default;
+  template<typename U>
+  constexpr AlignedAllocator( const AlignedAllocator<U, Alignment>& /*unused*/ ) noexcept
+  {}
+
+  [[nodiscard]] T* allocate( size_t count )
+  {
+    return static_cast<T*>( ::operator new( count * sizeof( T ), std::align_val_t{ Alignment } ) );
+  }
+  void deallocate( T* ptr, size_t count ) noexcept
+  {
+    ::operator delete( ptr, count * sizeof( T ), std::align_val_t{ Alignment } );
+  }
+
+  friend constexpr bool operator==( const AlignedAllocator& /*unused*/, const AlignedAllocator& /*unused*/ )
+  {
+    return true;
+  }
+};
+
+} // namespace detail
+
+// Structure-of-arrays storage for `size()` vectors: component c of every vector is contiguous in lane(c). Each lane
+// starts on a 64-byte boundary and is padded to a multiple of 64 bytes, so kernels can run whole registers over
+// padded_size() elements without a tail. The padding contents are unspecified (kernels may leave NaN there), so
+// nothing may reduce over it or convert it to integers.
+template<typename T, size_t N>
+  requires Arithmetic<T>
+class VecBatch
+{
+public:
+  using value_type                       = T;
+  static constexpr size_t length         = N;
+  static constexpr size_t lane_alignment = 64;
+  static constexpr size_t lane_multiple  = lane_alignment / sizeof( T );
+
+  VecBatch() = default;
+  explicit VecBatch( size_t size ) { resize( size ); }
+  explicit VecBatch( std::span<const Vec<T, N>> vecs ) : VecBatch( vecs.size() )
+  {
+    for ( size_t i = 0; i != vecs.size(); ++i )
+    {
+      set( i, vecs[i] );
+    }
+  }
+
+  [[nodiscard]] size_t size() const { return m_size; }
+  [[nodiscard]] size_t padded_size() const { return m_padded_size; }
+  [[nodiscard]] bool   empty() const { return m_size == 0; }
+
+  // Keeps the first min( size(), new_size ) vectors; new vectors are zero.
+  void resize( size_t size )
+  {
+    const size_t padded_size = ( size + lane_multiple - 1 ) / lane_multiple * lane_multiple;
+    if ( padded_size != m_padded_size )
+    {
+      Storage      storage( N * padded_size );
+      const size_t kept = std::min( m_size, size );
+      for ( size_t c = 0; c != N; ++c )
+      {
+        std::copy_n( m_storage.data() + c * m_padded_size, kept, storage.data() + c * padded_size );
+      }
+      m_storage     = std::move( storage );
+      m_padded_size = padded_size;
+    }
+    for ( size_t c = 0; c != N && size > m_size; ++c )
+    {
+      std::fill( m_storage.data() + c * m_padded_size + m_size, m_storage.data() + c * m_padded_size + size, T{} );
+    }
+    m_size = size;
+  }
+
+  void clear() { resize( 0 ); }
+
+  [[nodiscard]] std::span<T> lane( size_t component )
+  {
+    assert( component < N );
+    return { m_storage.data() + component * m_padded_size, m_size };
+  }
+  [[nodiscard]] std::span<const T> lane( size_t component ) const
+  {
+    assert( component < N );
+    return { m_storage.data() + component * m_padded_size, m_size };
+  }
+
+  [[nodiscard]] std::span<T> x() { return lane( 0 ); }
+  [[nodiscard]] std::span<T> y() { return lane( 1 ); }
+  [[nodiscard]] std::span<T> z()
+    requires( N >= 3 )
+  {
+    return lane( 2 );
+  }
+  [[nodiscard]] std::span<T> w()
+    requires( N >= 4 )
+  {
+    return lane( 3 );
+  }
+
+  [[nodiscard]] std::span<const T> x() const { return lane( 0 ); }
+  [[nodiscard]] std::span<const T> y() const { return lane( 1 ); }
+  [[nodiscard]] std::span<const T> z() const
+    requires( N >= 3 )
+  {
+    return lane( 2 );
+  }
+  [[nodiscard]] std::span<const T> w() const
+    requires( N >= 4 )
+  {
+    return lane( 3 );
+  }
+
+  [[nodiscard]] Vec<T, N> operator[]( size_t i ) const
+  {
+    assert( i < m_size );
+    Vec<T, N> vec{};
+    for ( size_t c = 0; c != N; ++c )
+    {
+      vec[c] = m_storage[c * m_padded_size + i];
+    }
+    return vec;
+  }
+
+  void set( size_t i, const Vec<T, N>& vec )
+  {
+    assert( i < m_size );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      m_storage[c * m_padded_size + i] = vec[c];
+    }
+  }
+
+  // Interleaves the batch back into array-of-structs layout.
+  void copy_to( std::span<Vec<T, N>> out ) const
+  {
+    assert( out.size() == m_size );
+    for ( size_t i = 0; i != m_size; ++i )
+    {
+      out[i] = ( *this )[i];
+    }
+  }
+
+private:
+  using Storage = std::vector<T, detail::AlignedAllocator<T, lane_alignment>>;
+
+  size_t  m_size{};
+  size_t  m_padded_size{};
+  Storage m_storage;
+};
+
+using Vec3Batch  = VecBatch<float, 3>;
+using Vec4Batch  = VecBatch<float, 4>;
+using IVec3Batch = VecBatch<int, 3>;
+using IVec4Batch = VecBatch<int, 4>;
+
+class Point3Batch : public Vec3Batch
+{
+public:
+  Point3Batch() = default;
+  explicit Point3Batch( size_t size ) : Vec3Batch( size ) {}
+  explicit Point3Batch( std::span<const Point3> points ) : Vec3Batch( points.size() )
+  {
+    for ( size_t i = 0; i != points.size(); ++i )
+    {
+      set( i, points[i] );
+    }
+  }
+
+  [[nodiscard]] Point3 operator[]( size_t i ) const { return Point3{ Vec3Batch::operator[]( i ) }; }
+
+  using Vec3Batch::copy_to;
+  void copy_to( std::span<Point3> out ) const
+  {
+    assert( out.size() == size() );
+    for ( size_t i = 0; i != size(); ++i )
+    {
+      out[i] = ( *this )[i];
+    }
+  }
+};
+
+namespace detail {
+
+// Lane operations on a single element; also the tail path for outputs that are not padded.
+template<typename T>
+struct ScalarLanes
+{
+  using pack                    = T;
+  using int_lanes               = ScalarLanes<int>;
+  static constexpr size_t width = 1;
+
+  static T    load( const T* ptr ) { return *ptr; }
+  static void store( T* ptr, T v ) { *ptr = v; }
+  static T    splat( T s ) { return s; }
+  // Integers wrap around as in the SIMD lanes, also on the unspecified values in the padding.
+  static T    add( T a, T b ) { return wrapping( a, b, []( auto l, auto r ) { return l + r; } ); }
+  static T    sub( T a, T b ) { return wrapping( a, b, []( auto l, auto r ) { return l - r; } ); }
+  static T    mul( T a, T b ) { return wrapping( a, b, []( auto l, auto r ) { return l * r; } ); }
+  static T    div( T a, T b ) { return a / b; }
+  static T    madd( T a, T b, T c ) { return add( mul( a, b ), c ); }
+  static T    min( T a, T b ) { return std::min( a, b ); }
+  static T    max( T a, T b ) { return std::max( a, b ); }
+  static T    sqrt( T a ) { return std::sqrt( a ); }
+  static T    shift_left( T a, int n ) { return a << n; }
+  static T    shift_right( T a, int n ) { return a >> n; }
+  static int  floor_to_int( T a ) { return static_cast<int>( std::floor( a ) ); }
+
+  template<RsqrtPolicy Policy>
+  static T rsqrt( T a )
+  {
+    return linalg::rsqrt<Policy>( a );
+  }
+
+  // The building blocks of the polynomial kernels in vmath.hpp. fmadd is fused when LINALG_FMA is defined.
+  static T    fmadd( T a, T b, T c ) { return linalg::madd<DefaultFma>( a, b, c ); }
+  static T    abs( T a ) { return std::abs( a ); }
+  static T    select_less( T a, T b, T x, T y ) { return a < b ? x : y; }
+  static T    bit_and( T a, T b ) { return bitwise( a, b, []( auto l, auto r ) { return l & r; } ); }
+  static T    bit_or( T a, T b ) { return bitwise( a, b, []( auto l, auto r ) { return l | r; } ); }
+  static T    bit_xor( T a, T b ) { return bitwise( a, b, []( auto l, auto r ) { return l ^ r; } ); }
+  static int  round_to_int( T a ) { return static_cast<int>( std::lrint( a ) ); }
+  static T    to_float( int a ) { return static_cast<T>( a ); }
+  static int  as_int( T a ) { return std::bit_cast<int>( a ); }
+  static T    as_float( int a ) { return std::bit_cast<T>( a ); }
+
+  // One group of four consecutive values; see simd::load_deinterleave4.
+  static void load_deinterleave4( const T* ptr, T ( &out )[4] ) { std::copy_n( ptr, 4, out ); }
+  static void store_interleave4( T* ptr, const T ( &in )[4] ) { std::copy_n( in, 4, ptr ); }
+  static T    gather( const T* base, int index ) { return base[index]; }
+
+private:
+  // At least as wide as int, so that narrow types are not promoted back to signed int.
+  template<typename Op>
+  static T wrapping( T a, T b, Op op )
+  {
+    if constexpr ( std::integral<T> )
+    {
+      using U = std::make_unsigned_t<std::common_type_t<T, int>>;
+      return static_cast<T>( op( static_cast<U>( a ), static_cast<U>( b ) ) );
+    } else
+    {
+      return op( a, b );
+    }
+  }
+
+  template<typename Op>
+  static T bitwise( T a, T b, Op op )
+  {
+    if constexpr ( std::integral<T> )
+    {
+      return op( a, b );
+    } else
+    {
+      return std::bit_cast<T>( op( std::bit_cast<std::uint32_t>( a ), std::bit_cast<std::uint32_t>( b ) ) );
+    }
+  }
+};
+
+#ifdef LINALG_SIMD_F32X4
+struct WideIntLanes
+{
+  using pack                    = simd::i32xw;
+  static constexpr size_t width = simd::wide_lanes;
+
+  static pack load( const int* ptr ) { return simd::load_wide( ptr ); }
+  static void store( int* ptr, pack v ) { simd::store_wide( ptr, v ); }
+  static pack splat( int s ) { return simd::splat_wide( s ); }
+  static pack add( pack a, pack b ) { return simd::add( a, b ); }
+  static pack sub( pack a, pack b ) { return simd::sub( a, b ); }
+  static pack mul( pack a, pack b ) { return simd::mul( a, b ); }
+  static pack madd( pack a, pack b, pack c ) { return simd::add( simd::mul( a, b ), c ); }
+  static pack min( pack a, pack b ) { return simd::min( a, b ); }
+  static pack max( pack a, pack b ) { return simd::max( a, b ); }
+  static pack shift_left( pack a, int n ) { return simd::shift_left( a, n ); }
+  static pack shift_right( pack a, int n ) { return simd::shift_right( a, n ); }
+  static pack bit_and( pack a, pack b ) { return simd::bit_and( a, b ); }
+  static pack bit_or( pack a, pack b ) { return simd::bit_or( a, b ); }
+};
+
+struct WideLanes
+{
+  using pack                    = simd::f32xw;
+  using int_lanes               = WideIntLanes;
+  static constexpr size_t width = simd::wide_lanes;
+
+  static pack load( const float* ptr ) { return simd::load_wide( ptr ); }
+  static void store( float* ptr, pack v ) { simd::store_wide( ptr, v ); }
+  static pack splat( float s ) { return simd::splat_wide( s ); }
+  static pack add( pack a, pack b ) { return simd::add( a, b ); }
+  static pack sub( pack a, pack b ) { return simd::sub( a, b ); }
+  static pack mul( pack a, pack b ) { return simd::mul( a, b ); }
+  static pack div( pack a, pack b ) { return simd::div( a, b ); }
+  static pack madd( pack a, pack b, pack c ) { return simd::madd( a, b, c ); }
+  static pack min( pack a, pack b ) { return simd::min( a, b ); }
+  static pack max( pack a, pack b ) { return simd::max( a, b ); }
+  static pack sqrt( pack a ) { return simd::sqrt( a ); }
+
+  template<RsqrtPolicy Policy>
+  static pack rsqrt( pack a )
+  {
+    if constexpr ( std::same_as<Policy, Refined> )
+    {
+      return simd::rsqrt_refined( a );
+    } else if constexpr ( std::same_as<Policy, Estimate> )
+    {
+      return simd::rsqrt_estimate( a );
+    } else
+    {
+      return simd::div( simd::splat_wide( 1.0F ), simd::sqrt( a ) );
+    }
+  }
+
+  static simd::i32xw floor_to_int( pack a ) { return simd::floor_to_int( a ); }
+
+  static pack fmadd( pack a, pack b, pack c )
+  {
+#ifdef LINALG_FMA
+    return simd::fmadd( a, b, c );
+#else
+    return simd::madd( a, b, c );
+#endif
+  }
+
+  static pack        abs( pack a ) { return simd::abs( a ); }
+  static pack        select_less( pack a, pack b, pack x, pack y ) { return simd::select_less( a, b, x, y ); }
+  static pack        bit_and( pack a, pack b ) { return simd::bit_and( a, b ); }
+  static pack        bit_or( pack a, pack b ) { return simd::bit_or( a, b ); }
+  static pack        bit_xor( pack a, pack b ) { return simd::bit_xor( a, b ); }
+  static simd::i32xw round_to_int( pack a ) { return simd::round_to_int( a ); }
+  static pack        to_float( simd::i32xw a ) { return simd::to_float( a ); }
+  static simd::i32xw as_int( pack a ) { return simd::as_int( a ); }
+  static pack        as_float( simd::i32xw a ) { return simd::as_float( a ); }
+
+  static void load_deinterleave4( const float* ptr, pack ( &out )[4] ) { simd::load_deinterleave4( ptr, out ); }
+  static void store_interleave4( float* ptr, const pack ( &in )[4] ) { simd::store_interleave4( ptr, in ); }
+  static pack gather( const float* base, simd::i32xw index ) { return simd::gather_wide( base, index ); }
+};
+#endif
+
+// Calls kernel( lanes, i ) for consecutive element offsets covering [0, count): a full SIMD register at a time where
+// possible, single elements for whatever is left. VecBatch outputs pass padded_size() and never reach the tail.
+template<typename T, typename Kernel>
+void for_each_lanes( size_t count, Kernel&& kernel )
+{
+  size_t i = 0;
+#ifdef LINALG_SIMD_F32X4
+  if constexpr ( std::same_as<T, float> )
+  {
+    for ( ; i + WideLanes::width <= count; i += WideLanes::width )
+    {
+      kernel( WideLanes{}, i );
+    }
+  } else if constexpr ( std::same_as<T, int> )
+  {
+    for ( ; i + WideIntLanes::width <= count; i += WideIntLanes::width )
+    {
+      kernel( WideIntLanes{}, i );
+    }
+  }
+#endif
+  for ( ; i < count; ++i )
+  {
+    kernel( ScalarLanes<T>{}, i );
+  }
+}
+
+template<typename L, typename T, size_t N>
+[[nodiscard]] typename L::pack lane_dot( const T* const ( &left )[N], const T* const ( &right )[N], size_t i )
+{
+  auto result = L::mul( L::load( left[0] + i ), L::load( right[0] + i ) );
+  for ( size_t c = 1; c != N; ++c )
+  {
+    result = L::madd( L::load( left[c] + i ), L::load( right[c] + i ), result );
+  }
+  return result;
+}
+
+template<typename T, size_t N>
+struct ConstLanes
+{
+  const T* ptr[N];
+
+  explicit ConstLanes( const VecBatch<T, N>& batch )
+  {
+    for ( size_t c = 0; c != N; ++c )
+    {
+      ptr[c] = batch.lane( c ).data();
+    }
+  }
+};
+
+template<typename T, size_t N>
+struct MutableLanes
+{
+  T* ptr[N];
+
+  explicit MutableLanes( VecBatch<T, N>& batch )
+  {
+    for ( size_t c = 0; c != N; ++c )
+    {
+      ptr[c] = batch.lane( c ).data();
+    }
+  }
+};
+
+} // namespace detail
+
+// out[i] = dot( left[i], right[i] ).
+template<typename T, size_t N>
+void dot( const VecBatch<T, N>& left, const VecBatch<T, N>& right, std::span<T> out )
+{
+  assert( left.size() == out.size() && right.size() == out.size() );
+  const detail::ConstLanes<T, N> l( left );
+  const detail::ConstLanes<T, N> r( right );
+  detail::for_each_lanes<T>( out.size(), [&]( auto lanes, size_t i ) {
+    using L = decltype( lanes );
+    L::store( out.data() + i, detail::lane_dot<L>( l.ptr, r.ptr, i ) );
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] std::vector<T> dot( const VecBatch<T, N>& left, const VecBatch<T, N>& right )
+{
+  std::vector<T> result( left.size() );
+  dot( left, right, std::span<T>{ result } );
+  return result;
+}
+
+// out[i] = magnitude( vecs[i] ).
+template<typename T, size_t N>
+void magnitude( const VecBatch<T, N>& vecs, std::span<T> out )
+{
+  assert( vecs.size() == out.size() );
+  const detail::ConstLanes<T, N> v( vecs );
+  detail::for_each_lanes<T>( out.size(), [&]( auto lanes, size_t i ) {
+    using L = decltype( lanes );
+    L::store( out.data() + i, L::sqrt( detail::lane_dot<L>( v.ptr, v.ptr, i ) ) );
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] std::vector<T> magnitude( const VecBatch<T, N>& vecs )
+{
+  std::vector<T> result( vecs.size() );
+  magnitude( vecs, std::span<T>{ result } );
+  return result;
+}
+
+// out[i] = cross( left[i], right[i] ). The output is resized and may alias either input.
+template<typename T, size_t N>
+void cross( const VecBatch<T, N>& left, const VecBatch<T, N>& right, VecBatch<T, N>& out )
+  requires( N == 3 )
+{
+  assert( left.size() == right.size() );
+  out.resize( left.size() );
+  const detail::ConstLanes<T, N>   l( left );
+  const detail::ConstLanes<T, N>   r( right );
+  const detail::MutableLanes<T, N> o( out );
+  detail::for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L       = decltype( lanes );
+    const auto lx = L::load( l.ptr[0] + i );
+    const auto ly = L::load( l.ptr[1] + i );
+    const auto lz = L::load( l.ptr[2] + i );
+    const auto rx = L::load( r.ptr[0] + i );
+    const auto ry = L::load( r.ptr[1] + i );
+    const auto rz = L::load( r.ptr[2] + i );
+    L::store( o.ptr[0] + i, L::sub( L::mul( ly, rz ), L::mul( lz, ry ) ) );
+    L::store( o.ptr[1] + i, L::sub( L::mul( lz, rx ), L::mul( lx, rz ) ) );
+    L::store( o.ptr[2] + i, L::sub( L::mul( lx, ry ), L::mul( ly, rx ) ) );
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] VecBatch<T, N> cross( const VecBatch<T, N>& left, const VecBatch<T, N>& right )
+  requires( N == 3 )
+{
+  VecBatch<T, N> result;
+  cross( left, right, result );
+  return result;
+}
+
+// out[i] = normalized<Policy>( vecs[i] ). The output is resized and may alias the input.
+template<RsqrtPolicy Policy = Exact, typename T, size_t N>
+void normalized( const VecBatch<T, N>& vecs, VecBatch<T, N>& out )
+{
+  out.resize( vecs.size() );
+  const detail::ConstLanes<T, N>   v( vecs );
+  const detail::MutableLanes<T, N> o( out );
+  detail::for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L = decltype( lanes );
+    if constexpr ( std::same_as<Policy, Exact> )
+    {
+      const auto length = L::sqrt( detail::lane_dot<L>( v.ptr, v.ptr, i ) );
+      for ( size_t c = 0; c != N; ++c )
+      {
+        L::store( o.ptr[c] + i, L::div( L::load( v.ptr[c] + i ), length ) );
+      }
+    } else
+    {
+      const auto inverse_length = L::template rsqrt<Policy>( detail::lane_dot<L>( v.ptr, v.ptr, i ) );
+      for ( size_t c = 0; c != N; ++c )
+      {
+        L::store( o.ptr[c] + i, L::mul( L::load( v.ptr[c] + i ), inverse_length ) );
+      }
+    }
+  } );
+}
+
+template<RsqrtPolicy Policy = Exact, typename T, size_t N>
+[[nodiscard]] VecBatch<T, N> normalized( const VecBatch<T, N>& vecs )
+{
+  VecBatch<T, N> result;
+  normalized<Policy>( vecs, result );
+  return result;
+}
+
+// out[i] = project( source[i], target[i] ). The output is resized and may alias either input.
+template<typename T, size_t N>
+void project( const VecBatch<T, N>& source, const VecBatch<T, N>& target, VecBatch<T, N>& out )
+{
+  assert( source.size() == target.size() );
+  out.resize( source.size() );
+  const detail::ConstLanes<T, N>   s( source );
+  const detail::ConstLanes<T, N>   t( target );
+  const detail::MutableLanes<T, N> o( out );
+  detail::for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L       = decltype( lanes );
+    const auto st = detail::lane_dot<L>( s.ptr, t.ptr, i );
+    const auto tt = detail::lane_dot<L>( t.ptr, t.ptr, i );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      L::store( o.ptr[c] + i, L::div( L::mul( L::load( t.ptr[c] + i ), st ), tt ) );
+    }
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] VecBatch<T, N> project( const VecBatch<T, N>& source, const VecBatch<T, N>& target )
+{
+  VecBatch<T, N> result;
+  project( source, target, result );
+  return result;
+}
+
+// out[i] = reject( source[i], target[i] ). The output is resized and may alias either input.
+template<typename T, size_t N>
+void reject( const VecBatch<T, N>& source, const VecBatch<T, N>& target, VecBatch<T, N>& out )
+{
+  assert( source.size() == target.size() );
+  out.resize( source.size() );
+  const detail::ConstLanes<T, N>   s( source );
+  const detail::ConstLanes<T, N>   t( target );
+  const detail::MutableLanes<T, N> o( out );
+  detail::for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L       = decltype( lanes );
+    const auto st = detail::lane_dot<L>( s.ptr, t.ptr, i );
+    const auto tt = detail::lane_dot<L>( t.ptr, t.ptr, i );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      const auto projected = L::div( L::mul( L::load( t.ptr[c] + i ), st ), tt );
+      L::store( o.ptr[c] + i, L::sub( L::load( s.ptr[c] + i ), projected ) );
+    }
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] VecBatch<T, N> reject( const VecBatch<T, N>& source, const VecBatch<T, N>& target )
+{
+  VecBatch<T, N> result;
+  reject( source, target, result );
+  return result;
+}
+
+// out[i] = mix( a[i], b[i], t ). The output is resized and may alias either input.
+template<typename T, size_t N>
+void mix( const VecBatch<T, N>& a, const VecBatch<T, N>& b, T t, VecBatch<T, N>& out )
+{
+  assert( a.size() == b.size() );
+  out.resize( a.size() );
+  const detail::ConstLanes<T, N>   l( a );
+  const detail::ConstLanes<T, N>   r( b );
+  const detail::MutableLanes<T, N> o( out );
+  detail::for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L         = decltype( lanes );
+    const auto step = L::splat( t );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      const auto from = L::load( l.ptr[c] + i );
+      L::store( o.ptr[c] + i, L::add( from, L::mul( step, L::sub( L::load( r.ptr[c] + i ), from ) ) ) );
+    }
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] VecBatch<T, N> mix( const VecBatch<T, N>& a, const VecBatch<T, N>& b, T t )
+{
+  VecBatch<T, N> result;
+  mix( a, b, t, result );
+  return result;
+}
+
+// out[i] = min( a[i], b[i] ) component-wise. The output is resized and may alias either input.
+template<typename T, size_t N>
+void min( const VecBatch<T, N>& a, const VecBatch<T, N>& b, VecBatch<T, N>& out )
+{
+  assert( a.size() == b.size() );
+  out.resize( a.size() );
+  const detail::ConstLanes<T, N>   l( a );
+  const detail::ConstLanes<T, N>   r( b );
+  const detail::MutableLanes<T, N> o( out );
+  detail::for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L = decltype( lanes );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      L::store( o.ptr[c] + i, L::min( L::load( l.ptr[c] + i ), L::load( r.ptr[c] + i ) ) );
+    }
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] VecBatch<T, N> min( const VecBatch<T, N>& a, const VecBatch<T, N>& b )
+{
+  VecBatch<T, N> result;
+  min( a, b, result );
+  return result;
+}
+
+// out[i] = max( a[i], b[i] ) component-wise. The output is resized and may alias either input.
+template<typename T, size_t N>
+void max( const VecBatch<T, N>& a, const VecBatch<T, N>& b, VecBatch<T, N>& out )
+{
+  assert( a.size() == b.size() );
+  out.resize( a.size() );
+  const detail::ConstLanes<T, N>   l( a );
+  const detail::ConstLanes<T, N>   r( b );
+  const detail::MutableLanes<T, N> o( out );
+  detail::for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L = decltype( lanes );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      L::store( o.ptr[c] + i, L::max( L::load( l.ptr[c] + i ), L::load( r.ptr[c] + i ) ) );
+    }
+  } );
+}
+
+template<typename T, size_t N>
+[[nodiscard]] VecBatch<T, N> max( const VecBatch<T, N>& a, const VecBatch<T, N>& b )
+{
+  VecBatch<T, N> result;
+  max( a, b, result );
+  return result;
+}
+
+namespace detail {
+
+// Component-wise out[i] = a[i] op b[i]. The output is resized and may alias either input.
+template<typename T, size_t N, typename Op>
+void elementwise( const VecBatch<T, N>& a, const VecBatch<T, N>& b, VecBatch<T, N>& out, Op op )
+{
+  assert( a.size() == b.size() );
+  out.resize( a.size() );
+  const ConstLanes<T, N>   l( a );
+  const ConstLanes<T, N>   r( b );
+  const MutableLanes<T, N> o( out );
+  for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L = decltype( lanes );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      L::store( o.ptr[c] + i, op( lanes, L::load( l.ptr[c] + i ), L::load( r.ptr[c] + i ) ) );
+    }
+  } );
+}
+
+template<typename T, size_t N, typename Op>
+void shift( const VecBatch<T, N>& vecs, int n, VecBatch<T, N>& out, Op op )
+{
+  assert( n >= 0 && n < 32 );
+  out.resize( vecs.size() );
+  const ConstLanes<T, N>   v( vecs );
+  const MutableLanes<T, N> o( out );
+  for_each_lanes<T>( out.padded_size(), [&]( auto lanes, size_t i ) {
+    using L = decltype( lanes );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      L::store( o.ptr[c] + i, op( lanes, L::load( v.ptr[c] + i ), n ) );
+    }
+  } );
+}
+
+} // namespace detail
+
+// out[i] = a[i] + b[i]. The output is resized and may alias either input.
+template<typename T, size_t N>
+void add( const VecBatch<T, N>& a, const VecBatch<T, N>& b, VecBatch<T, N>& out )
+{
+  detail::elementwise( a, b, out, []( auto lanes, auto l, auto r ) { return lanes.add( l, r ); } );
+}
+
+// out[i] = a[i] - b[i]. The output is resized and may alias either input.
+template<typename T, size_t N>
+void subtract( const VecBatch<T, N>& a, const VecBatch<T, N>& b, VecBatch<T, N>& out )
+{
+  detail::elementwise( a, b, out, []( auto lanes, auto l, auto r ) { return lanes.sub( l, r ); } );
+}
+
+// out[i] = a[i] * b[i] component-wise. The output is resized and may alias either input.
+template<typename T, size_t N>
+void multiply( const VecBatch<T, N>& a, const VecBatch<T, N>& b, VecBatch<T, N>& out )
+{
+  detail::elementwise( a, b, out, []( auto lanes, auto l, auto r ) { return lanes.mul( l, r ); } );
+}
+
+// out[i] = vecs[i] << n component-wise, for 0 <= n < 32. The output is resized and may alias the input.
+template<std::integral T, size_t N>
+void shift_left( const VecBatch<T, N>& vecs, int n, VecBatch<T, N>& out )
+{
+  detail::shift( vecs, n, out, []( auto lanes, auto v, int bits ) { return lanes.shift_left( v, bits ); } );
+}
+
+// out[i] = vecs[i] >> n component-wise, an arithmetic shift that rounds towards negative infinity.
+template<std::integral T, size_t N>
+void shift_right( const VecBatch<T, N>& vecs, int n, VecBatch<T, N>& out )
+{
+  detail::shift( vecs, n, out, []( auto lanes, auto v, int bits ) { return lanes.shift_right( v, bits ); } );
+}
+
+// cells[i] = to_cell( points[i], cell_size ). The output is resized.
+template<size_t N>
+void to_cells( const VecBatch<float, N>& points, float cell_size, VecBatch<int, N>& cells )
+{
+  assert( cell_size > 0.0F );
+  cells.resize( points.size() );
+  const detail::ConstLanes<float, N> p( points );
+  const detail::MutableLanes<int, N> o( cells );
+  // Stops at size(): converting NaN padding to int would be undefined for single elements.
+  detail::for_each_lanes<float>( cells.size(), [&]( auto lanes, size_t i ) {
+    using L         = decltype( lanes );
+    const auto size = L::splat( cell_size );
+    for ( size_t c = 0; c != N; ++c )
+    {
+      L::int_lanes::store( o.ptr[c] + i, L::floor_to_int( L::div( L::load( p.ptr[c] + i ), size ) ) );
+    }
+  } );
+}
+
+template<size_t N>
+[[nodiscard]] VecBatch<int, N> to_cells( const VecBatch<float, N>& points, float cell_size )
+{
+  VecBatch<int, N> result;
+  to_cells( points, cell_size, result );
+  return result;
+}
+
+// out[i] = morton_encode( cells[i] ).
+inline void morton_encode( const IVec3Batch& cells, std::span<std::uint64_t> out )
+{
+  assert( cells.size() == out.size() );
+  const auto x = cells.x();
+  const auto y = cells.y();
+  const auto z = cells.z();
+  for ( size_t i = 0; i != out.size(); ++i )
+  {
+    out[i] = morton_encode( IVec3{ x[i], y[i], z[i] } );
+  }
+}
+
+} // namespace linalg
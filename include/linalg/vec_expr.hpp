@@ -0,0 +1,255 @@
+#pragma once
+
+#include "vec.hpp"
+#include <concepts>
+#include <cstddef>
+
+namespace linalg {
+
+// Lazily evaluated Vec arithmetic. lazy( v ) wraps a vector so that +, -, * and / build an expression tree instead of a
+// temporary Vec per operator; the tree is evaluated component by component, in a single pass, when it is converted to
+// a Vec. A product feeding a sum or difference is contracted into one multiply-add under DefaultFma.
+//
+// Expressions refer to their vector operands, so they must be converted within the full-expression that built them:
+//   Vec3 r = ( c * c - b2 ) * lazy( v ) + 2.0F * dot( v, b ) * lazy( b );
+namespace detail {
+
+struct VecExprTag
+{};
+
+template<typename E>
+concept VecExpression = std::derived_from<E, VecExprTag>;
+
+template<typename V>
+concept VecValue = requires {
+  typename V::value_type;
+  { V::length } -> std::convertible_to<std::size_t>;
+  requires std::derived_from<V, Vec<typename V::value_type, V::length>>;
+};
+
+template<typename T, size_t N>
+class VecRef : public VecExprTag
+{
+  const Vec<T, N>& m_vec;
+
+public:
+  using value_type               = T;
+  static constexpr size_t length = N;
+
+  constexpr explicit VecRef( const Vec<T, N>& vec ) : m_vec( vec ) {}
+
+  [[nodiscard]] constexpr T operator[]( size_t i ) const { return m_vec[i]; }
+};
+
+template<typename T, size_t N>
+class VecScalar : public VecExprTag
+{
+  T m_value;
+
+public:
+  using value_type               = T;
+  static constexpr size_t length = N;
+
+  constexpr explicit VecScalar( T value ) : m_value( value ) {}
+
+  [[nodiscard]] constexpr T operator[]( size_t /*i*/ ) const { return m_value; }
+};
+
+struct AddOp;
+struct SubOp;
+struct MulOp;
+struct DivOp;
+
+template<typename L, typename R, typename Op>
+class VecBinary : public VecExprTag
+{
+  static_assert( L::length == R::length, "Vec expression operands must have the same length" );
+  static_assert( std::same_as<typename L::value_type, typename R::value_type>,
+    "Vec expression operands must have the same value type" );
+
+public:
+  using value_type               = typename L::value_type;
+  static constexpr size_t length = L::length;
+
+  L left;
+  R right;
+
+  constexpr VecBinary( const L& l, const R& r ) : left( l ), right( r ) {}
+
+  [[nodiscard]] constexpr value_type operator[]( size_t i ) const { return Op::apply( left, right, i ); }
+};
+
+template<typename E>
+inline constexpr bool is_product = false;
+
+template<typename L, typename R>
+inline constexpr bool is_product<VecBinary<L, R, MulOp>> = true;
+
+struct AddOp
+{
+  template<typename L, typename R>
+  [[nodiscard]] static constexpr auto apply( const L& l, const R& r, size_t i )
+  {
+    if constexpr ( is_product<L> )
+    {
+      return madd<DefaultFma>( l.left[i], l.right[i], r[i] );
+    } else if constexpr ( is_product<R> )
+    {
+      return madd<DefaultFma>( r.left[i], r.right[i], l[i] );
+    } else
+    {
+      return l[i] + r[i];
+    }
+  }
+};
+
+struct SubOp
+{
+  template<typename L, typename R>
+  [[nodiscard]] static constexpr auto apply( const L& l, const R& r, size_t i )
+  {
+    if constexpr ( is_product<R> )
+    {
+      return madd<DefaultFma>( -r.left[i], r.right[i], l[i] );
+    } else if constexpr ( is_product<L> )
+    {
+      return madd<DefaultFma>( l.left[i], l.right[i], -r[i] );
+    } else
+    {
+      return l[i] - r[i];
+    }
+  }
+};
+
+struct MulOp
+{
+  template<typename L, typename R>
+  [[nodiscard]] static constexpr auto apply( const L& l, const R& r, size_t i )
+  {
+    return l[i] * r[i];
+  }
+};
+
+struct DivOp
+{
+  template<typename L, typename R>
+  [[nodiscard]] static constexpr auto apply( const L& l, const R& r, size_t i )
+  {
+    return l[i] / r[i];
+  }
+};
+
+template<typename E>
+class VecNegate : public VecExprTag
+{
+  E m_expr;
+
+public:
+  using value_type               = typename E::value_type;
+  static constexpr size_t length = E::length;
+
+  constexpr explicit VecNegate( const E& expr ) : m_expr( expr ) {}
+
+  [[nodiscard]] constexpr value_type operator[]( size_t i ) const { return -m_expr[i]; }
+};
+
+template<typename V>
+[[nodiscard]] constexpr auto as_expr( const V& operand )
+{
+  if constexpr ( VecExpression<V> )
+  {
+    return operand;
+  } else
+  {
+    return VecRef<typename V::value_type, V::length>{ operand };
+  }
+}
+
+// At least one side must already be an expression; Vec op Vec stays eager.
+template<typename L, typename R>
+concept VecExprOperands = ( VecExpression<L> || VecValue<L> ) && ( VecExpression<R> || VecValue<R> )
+                          && ( VecExpression<L> || VecExpression<R> );
+
+template<typename Op, typename L, typename R>
+[[nodiscard]] constexpr auto make_binary( const L& l, const R& r )
+{
+  using LE = decltype( as_expr( l ) );
+  using RE = decltype( as_expr( r ) );
+  return VecBinary<LE, RE, Op>{ as_expr( l ), as_expr( r ) };
+}
+
+template<typename Op, typename E>
+[[nodiscard]] constexpr auto make_scalar_binary( const E& e, typename E::value_type s )
+{
+  return VecBinary<E, VecScalar<typename E::value_type, E::length>, Op>{ e,
+    VecScalar<typename E::value_type, E::length>{ s } };
+}
+
+} // namespace detail
+
+template<typename T, size_t N>
+[[nodiscard]] constexpr detail::VecRef<T, N> lazy( const Vec<T, N>& vec )
+{
+  return detail::VecRef<T, N>{ vec };
+}
+
+// Evaluates an expression into a Vec, for use where the target type is not spelled out.
+template<detail::VecExpression E>
+[[nodiscard]] constexpr Vec<typename E::value_type, E::length> eval( const E& expr )
+{
+  return Vec<typename E::value_type, E::length>{ expr };
+}
+
+template<typename L, typename R>
+  requires detail::VecExprOperands<L, R>
+[[nodiscard]] constexpr auto operator+( const L& left, const R& right )
+{
+  return detail::make_binary<detail::AddOp>( left, right );
+}
+
+template<typename L, typename R>
+  requires detail::VecExprOperands<L, R>
+[[nodiscard]] constexpr auto operator-( const L& left, const R& right )
+{
+  return detail::make_binary<detail::SubOp>( left, right );
+}
+
+template<typename L, typename R>
+  requires detail::VecExprOperands<L, R>
+[[nodiscard]] constexpr auto operator*( const L& left, const R& right )
+{
+  return detail::make_binary<detail::MulOp>( left, right );
+}
+
+template<typename L, typename R>
+  requires detail::VecExprOperands<L, R>
+[[nodiscard]] constexpr auto operator/( const L& left, const R& right )
+{
+  return detail::make_binary<detail::DivOp>( left, right );
+}
+
+template<detail::VecExpression E>
+[[nodiscard]] constexpr auto operator-( const E& expr )
+{
+  return detail::VecNegate<E>{ expr };
+}
+
+template<detail::VecExpression E>
+[[nodiscard]] constexpr auto operator*( const E& expr, typename E::value_type mul )
+{
+  return detail::make_scalar_binary<detail::MulOp>( expr, mul );
+}
+
+template<detail::VecExpression E>
+[[nodiscard]] constexpr auto operator*( typename E::value_type mul, const E& expr )
+{
+  return detail::make_scalar_binary<detail::MulOp>( expr, mul );
+}
+
+template<detail::VecExpression E>
+[[nodiscard]] constexpr auto operator/( const E& expr, typename E::value_type div )
+{
+  return detail::make_scalar_binary<detail::DivOp>( expr, div );
+}
+
+} // namespace linalg
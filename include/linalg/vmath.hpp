@@ -0,0 +1,636 @@
+#pragma once
+
+#include "vec.hpp"
+#include "vec_batch.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numbers>
+#include <span>
+
+namespace linalg {
+
+// Precision modes for the vectorized float functions below, which work on Vec<float, N>, on float spans and on SoA
+// batches, a whole SIMD register at a time. Bounds are the worst errors in ulp measured against double precision,
+// with and without FMA; inside the listed domains, and for any input where no domain is given.
+//
+//                  Precise                   Fast
+//   sin, cos       2.5 ulp, |x| < 40000      2.5 ulp, |x| < 120
+//   tan            3.5 ulp, |x| < 40000      3.5 ulp, |x| < 120
+//   asin           2 ulp                     2 ulp
+//   acos           1.5 ulp                   1.5 ulp
+//   atan           1.5 ulp                   2.5 ulp
+//   atan2          2 ulp                     3.5 ulp
+//   exp            1.1 ulp                   2.5 ulp
+//   log            1 ulp                     1.5 ulp
+//
+// For |x| < 4, Precise sin and cos stay within 1.5 ulp and tan within 2.5 ulp. Outside its domain Fast loses accuracy
+// quickly. Precise reduces trigonometric arguments in four steps and Fast in three; atan, exp and log use shorter
+// polynomials in Fast mode, and asin and acos are the same in both. Infinities and NaNs give the IEEE results except
+// for atan2( inf, inf ); subnormal results of exp are flushed to zero only where the hardware flushes them.
+struct Precise
+{};
+
+struct Fast
+{};
+
+template<typename P>
+concept MathPrecision = std::same_as<P, Precise> || std::same_as<P, Fast>;
+
+namespace detail {
+
+#ifdef LINALG_SIMD_F32X4
+using MathLanes = WideLanes;
+#else
+using MathLanes = ScalarLanes<float>;
+#endif
+
+// Horner's scheme with the coefficients from the highest degree down.
+template<typename L, size_t K>
+[[nodiscard]] typename L::pack polynomial( typename L::pack x, const float ( &coefficients )[K] )
+{
+  auto result = L::splat( coefficients[0] );
+  for ( size_t k = 1; k != K; ++k )
+  {
+    result = L::fmadd( result, x, L::splat( coefficients[k] ) );
+  }
+  return result;
+}
+
+// hi - x + lo, for constants split into a float and the float nearest the remainder.
+template<typename L>
+[[nodiscard]] typename L::pack subtract_from( float hi, float lo, typename L::pack x )
+{
+  return L::add( L::sub( L::splat( hi ), x ), L::splat( lo ) );
+}
+
+// x with the sign bit of sign flipped into it.
+template<typename L>
+[[nodiscard]] typename L::pack xor_sign( typename L::pack x, typename L::pack sign )
+{
+  return L::bit_xor( x, L::bit_and( sign, L::splat( -0.0F ) ) );
+}
+
+constexpr float half_pi_hi = 1.57079637F;
+constexpr float half_pi_lo = -4.37113883e-8F;
+constexpr float pi_hi      = 3.14159274F;
+constexpr float pi_lo      = -8.74227766e-8F;
+
+// Splits x into quadrant * pi / 2 + r with |r| <= pi / 4 (Cody-Waite). The constants carry few enough bits that the
+// products with the quadrant are exact.
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack reduce_half_pi( typename L::pack x, typename L::int_lanes::pack& quadrant )
+{
+  quadrant     = L::round_to_int( L::mul( x, L::splat( std::numbers::inv_pi_v<float> * 2.0F ) ) );
+  const auto j = L::to_float( quadrant );
+  if constexpr ( std::same_as<P, Precise> )
+  {
+    auto r = L::fmadd( j, L::splat( -1.5703125F ), x );
+    r      = L::fmadd( j, L::splat( -4.83512878e-4F ), r );
+    r      = L::fmadd( j, L::splat( -3.13855708e-7F ), r );
+    return L::fmadd( j, L::splat( -6.07710063e-11F ), r );
+  } else
+  {
+    auto r = L::fmadd( j, L::splat( -1.57073975F ), x );
+    r      = L::fmadd( j, L::splat( -5.65797091e-5F ), r );
+    return L::fmadd( j, L::splat( -9.92093629e-10F ), r );
+  }
+}
+
+// r + r^3 p( r^2 ) with the sign of r, which the sum loses for r = -0.
+template<typename L>
+[[nodiscard]] typename L::pack odd_series( typename L::pack r, typename L::pack z, typename L::pack p )
+{
+  return L::bit_or( L::fmadd( L::mul( r, z ), p, r ), L::bit_and( r, L::splat( -0.0F ) ) );
+}
+
+// sin( r ) and cos( r ) for |r| <= pi / 4.
+template<typename L>
+[[nodiscard]] typename L::pack sin_reduced( typename L::pack r )
+{
+  static constexpr float coefficients[] = { -1.9515295891e-4F, 8.3321608736e-3F, -1.6666654611e-1F };
+  const auto             z              = L::mul( r, r );
+  return odd_series<L>( r, z, polynomial<L>( z, coefficients ) );
+}
+
+template<typename L>
+[[nodiscard]] typename L::pack cos_reduced( typename L::pack r )
+{
+  static constexpr float coefficients[] = { 2.443315711809948e-5F, -1.388731625493765e-3F, 4.166664568298827e-2F };
+  const auto             z              = L::mul( r, r );
+  return L::add( L::fmadd( z, L::splat( -0.5F ), L::mul( L::mul( z, z ), polynomial<L>( z, coefficients ) ) ),
+    L::splat( 1.0F ) );
+}
+
+// sin( quadrant * pi / 2 + r ) from sin( r ) and cos( r ).
+template<typename L>
+[[nodiscard]] typename L::pack apply_quadrant( typename L::int_lanes::pack quadrant,
+  typename L::pack                                                         sin_r,
+  typename L::pack                                                         cos_r )
+{
+  using I          = typename L::int_lanes;
+  const auto odd   = L::to_float( I::bit_and( quadrant, I::splat( 1 ) ) );
+  const auto value = L::select_less( odd, L::splat( 0.5F ), sin_r, cos_r );
+  return L::bit_xor( value, L::as_float( I::shift_left( I::bit_and( quadrant, I::splat( 2 ) ), 30 ) ) );
+}
+
+template<MathPrecision P, typename L>
+void sincos_lanes( L /*lanes*/, typename L::pack x, typename L::pack& sines, typename L::pack& cosines )
+{
+  using I = typename L::int_lanes;
+  typename I::pack quadrant;
+  const auto       r     = reduce_half_pi<P, L>( x, quadrant );
+  const auto       sin_r = sin_reduced<L>( r );
+  const auto       cos_r = cos_reduced<L>( r );
+  sines                  = apply_quadrant<L>( quadrant, sin_r, cos_r );
+  cosines                = apply_quadrant<L>( I::add( quadrant, I::splat( 1 ) ), sin_r, cos_r );
+}
+
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack sin_lanes( L /*lanes*/, typename L::pack x )
+{
+  typename L::int_lanes::pack quadrant;
+  const auto                  r = reduce_half_pi<P, L>( x, quadrant );
+  return apply_quadrant<L>( quadrant, sin_reduced<L>( r ), cos_reduced<L>( r ) );
+}
+
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack cos_lanes( L /*lanes*/, typename L::pack x )
+{
+  using I = typename L::int_lanes;
+  typename I::pack quadrant;
+  const auto       r = reduce_half_pi<P, L>( x, quadrant );
+  return apply_quadrant<L>( I::add( quadrant, I::splat( 1 ) ), sin_reduced<L>( r ), cos_reduced<L>( r ) );
+}
+
+// tan( r ) on the reduced argument, and -1 / tan( r ) = tan( r + pi / 2 ) in odd quadrants.
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack tan_lanes( L /*lanes*/, typename L::pack x )
+{
+  using I                               = typename L::int_lanes;
+  static constexpr float coefficients[] = {
+    9.38540185543e-3F, 3.11992232697e-3F, 2.44301354525e-2F, 5.34112807005e-2F, 1.33387994085e-1F, 3.33331568548e-1F
+  };
+  typename I::pack quadrant;
+  const auto       r   = reduce_half_pi<P, L>( x, quadrant );
+  const auto       z   = L::mul( r, r );
+  const auto       t   = odd_series<L>( r, z, polynomial<L>( z, coefficients ) );
+  const auto       odd = L::to_float( I::bit_and( quadrant, I::splat( 1 ) ) );
+  return L::select_less( odd, L::splat( 0.5F ), t, L::div( L::splat( -1.0F ), t ) );
+}
+
+// atan( a ) for 0 <= a <= 1, as a + a^3 q( a^2 ).
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack atan_unit( typename L::pack a )
+{
+  const auto z = L::mul( a, a );
+  if constexpr ( std::same_as<P, Precise> )
+  {
+    static constexpr float coefficients[] = { 0.00282363896F,
+      -0.0159569029F,
+      0.0425049886F,
+      -0.0748900920F,
+      0.106347933F,
+      -0.142027363F,
+      0.199926957F,
+      -0.333331019F };
+    return L::fmadd( L::mul( a, z ), polynomial<L>( z, coefficients ), a );
+  } else
+  {
+    static constexpr float coefficients[] = {
+      -0.00482233940F, 0.0247333813F, -0.0602021925F, 0.0996840969F, -0.140413061F, 0.199742109F, -0.333323926F
+    };
+    return L::fmadd( L::mul( a, z ), polynomial<L>( z, coefficients ), a );
+  }
+}
+
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack atan_lanes( L /*lanes*/, typename L::pack x )
+{
+  const auto one    = L::splat( 1.0F );
+  const auto ax     = L::abs( x );
+  const auto atan_a = atan_unit<P, L>( L::div( L::min( ax, one ), L::max( ax, one ) ) );
+  return xor_sign<L>( L::select_less( one, ax, subtract_from<L>( half_pi_hi, half_pi_lo, atan_a ), atan_a ), x );
+}
+
+// Reduces to atan( min / max ) on |y| and |x| and unfolds the octant; the signs of zeros are honoured.
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack atan2_lanes( L /*lanes*/, typename L::pack y, typename L::pack x )
+{
+  const auto zero   = L::splat( 0.0F );
+  const auto ax     = L::abs( x );
+  const auto ay     = L::abs( y );
+  const auto larger = L::max( ax, ay );
+  const auto ratio  = L::select_less( zero, larger, L::div( L::min( ax, ay ), larger ), zero );
+  auto       angle  = atan_unit<P, L>( ratio );
+  angle             = L::select_less( ax, ay, subtract_from<L>( half_pi_hi, half_pi_lo, angle ), angle );
+  const auto x_sign = L::bit_or( L::bit_and( x, L::splat( -0.0F ) ), L::splat( 1.0F ) );
+  angle             = L::select_less( x_sign, zero, subtract_from<L>( pi_hi, pi_lo, angle ), angle );
+  return xor_sign<L>( angle, y );
+}
+
+// asin( t ) for the reduced argument of asin_lanes and acos_lanes, with z = t * t.
+template<typename L>
+[[nodiscard]] typename L::pack asin_reduced( typename L::pack t, typename L::pack z )
+{
+  static constexpr float coefficients[] = {
+    4.2163199048e-2F, 2.4181311049e-2F, 4.5470025998e-2F, 7.4953002686e-2F, 1.6666752422e-1F
+  };
+  return L::fmadd( L::mul( t, z ), polynomial<L>( z, coefficients ), t );
+}
+
+// For |x| > 1/2, asin( |x| ) = pi / 2 - 2 asin( sqrt( ( 1 - |x| ) / 2 ) ).
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack asin_lanes( L /*lanes*/, typename L::pack x )
+{
+  const auto half   = L::splat( 0.5F );
+  const auto a      = L::abs( x );
+  const auto z      = L::select_less( half, a, L::mul( half, L::sub( L::splat( 1.0F ), a ) ), L::mul( a, a ) );
+  const auto t      = L::select_less( half, a, L::sqrt( z ), a );
+  const auto asin_t = asin_reduced<L>( t, z );
+  const auto large  = subtract_from<L>( half_pi_hi, half_pi_lo, L::add( asin_t, asin_t ) );
+  return xor_sign<L>( L::select_less( half, a, large, asin_t ), x );
+}
+
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack acos_lanes( L /*lanes*/, typename L::pack x )
+{
+  const auto half      = L::splat( 0.5F );
+  const auto a         = L::abs( x );
+  const auto z         = L::select_less( half, a, L::mul( half, L::sub( L::splat( 1.0F ), a ) ), L::mul( a, a ) );
+  const auto t         = L::select_less( half, a, L::sqrt( z ), a );
+  const auto asin_t    = asin_reduced<L>( t, z );
+  const auto twice     = L::add( asin_t, asin_t );
+  const auto large     = L::select_less( x, L::splat( 0.0F ), subtract_from<L>( pi_hi, pi_lo, twice ), twice );
+  const auto small     = subtract_from<L>( half_pi_hi, half_pi_lo, xor_sign<L>( asin_t, x ) );
+  return L::select_less( half, a, large, small );
+}
+
+// 2^n for -126 <= n <= 127.
+template<typename L>
+[[nodiscard]] typename L::pack exp2_int( typename L::int_lanes::pack n )
+{
+  using I = typename L::int_lanes;
+  return L::as_float( I::shift_left( I::add( n, I::splat( 127 ) ), 23 ) );
+}
+
+// exp( x ) = 2^n * exp( r ) with |r| <= ln( 2 ) / 2. The scale is applied in two halves so that results near overflow
+// and in the subnormal range are rounded once.
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack exp_lanes( L /*lanes*/, typename L::pack x )
+{
+  using I             = typename L::int_lanes;
+  const auto clamped  = L::min( L::max( x, L::splat( -104.0F ) ), L::splat( 89.0F ) );
+  const auto n        = L::round_to_int( L::mul( clamped, L::splat( std::numbers::log2e_v<float> ) ) );
+  const auto nf       = L::to_float( n );
+  auto       r        = L::fmadd( nf, L::splat( -0.693359375F ), clamped );
+  r                   = L::fmadd( nf, L::splat( 2.12194442e-4F ), r );
+  typename L::pack p;
+  if constexpr ( std::same_as<P, Precise> )
+  {
+    static constexpr float coefficients[] = {
+      0.00138146104F, 0.00836871006F, 0.0416683890F, 0.166665211F, 0.499999940F
+    };
+    p = polynomial<L>( r, coefficients );
+  } else
+  {
+    static constexpr float coefficients[] = { 0.00831252709F, 0.0418901145F, 0.166671142F, 0.499992311F };
+    p                                     = polynomial<L>( r, coefficients );
+  }
+  const auto exp_r  = L::add( L::fmadd( L::mul( r, r ), p, r ), L::splat( 1.0F ) );
+  const auto n_half = I::shift_right( n, 1 );
+  const auto result = L::mul( L::mul( exp_r, exp2_int<L>( n_half ) ), exp2_int<L>( I::sub( n, n_half ) ) );
+  return L::select_less( x, L::splat( std::numeric_limits<float>::infinity() ), result, x );
+}
+
+// log( x ) = e * ln( 2 ) + log( 1 + f ) with sqrt( 1/2 ) - 1 <= f < sqrt( 2 ) - 1. Subnormals are scaled up first.
+template<MathPrecision P, typename L>
+[[nodiscard]] typename L::pack log_lanes( L /*lanes*/, typename L::pack x )
+{
+  using I                  = typename L::int_lanes;
+  const auto smallest      = L::splat( std::numeric_limits<float>::min() );
+  const auto scaled        = L::select_less( x, smallest, L::mul( x, L::splat( 0x1p25F ) ), x );
+  const auto exponent      = I::sub( I::shift_right( L::as_int( scaled ), 23 ), I::splat( 126 ) );
+  const auto bias          = L::select_less( x, smallest, L::splat( 25.0F ), L::splat( 0.0F ) );
+  auto       e             = L::sub( L::to_float( exponent ), bias );
+  const auto mantissa_bits = L::as_float( I::splat( 0x007f'ffff ) );
+  auto       m             = L::bit_or( L::bit_and( scaled, mantissa_bits ), L::splat( 0.5F ) );
+  const auto sqrt_half     = L::splat( std::numbers::sqrt2_v<float> / 2.0F );
+  e                        = L::select_less( m, sqrt_half, L::sub( e, L::splat( 1.0F ) ), e );
+  const auto f             = L::sub( L::select_less( m, sqrt_half, L::add( m, m ), m ), L::splat( 1.0F ) );
+  const auto z             = L::mul( f, f );
+  typename L::pack q;
+  if constexpr ( std::same_as<P, Precise> )
+  {
+    static constexpr float coefficients[] = { 7.0376836292e-2F,
+      -1.1514610310e-1F,
+      1.1676998740e-1F,
+      -1.2420140846e-1F,
+      1.4249322787e-1F,
+      -1.6668057665e-1F,
+      2.0000714765e-1F,
+      -2.4999993993e-1F,
+      3.3333331174e-1F };
+    q                                     = polynomial<L>( f, coefficients );
+  } else
+  {
+    static constexpr float coefficients[] = {
+      0.0870035961F, -0.142674759F, 0.149147868F, -0.165775865F, 0.199630618F, -0.250013381F, 0.333339095F
+    };
+    q = polynomial<L>( f, coefficients );
+  }
+  auto result = L::fmadd( e, L::splat( -2.12194442e-4F ), L::mul( L::mul( f, z ), q ) );
+  result      = L::add( f, L::fmadd( z, L::splat( -0.5F ), result ) );
+  result      = L::fmadd( e, L::splat( 0.693359375F ), result );
+
+  const auto zero = L::splat( 0.0F );
+  result          = L::select_less( zero, x, result, L::splat( -std::numeric_limits<float>::infinity() ) );
+  result          = L::select_less( x, zero, L::splat( std::numeric_limits<float>::quiet_NaN() ), result );
+  return L::select_less( x, L::splat( std::numeric_limits<float>::infinity() ), result, x );
+}
+
+// Runs op( lanes, x... ) over whole registers of the inputs and writes one register of out per call. The tail goes
+// through a zero-padded register so that every element takes the same path.
+template<typename Op, typename... Inputs>
+void map_lanes( std::span<float> out, Op op, Inputs... in )
+{
+  using L = MathLanes;
+  assert( ( ( in.size() == out.size() ) && ... ) );
+  size_t i = 0;
+  for ( ; i + L::width <= out.size(); i += L::width )
+  {
+    L::store( out.data() + i, op( L{}, L::load( in.data() + i )... ) );
+  }
+  if ( i != out.size() )
+  {
+    const size_t rest    = out.size() - i;
+    const auto   padded  = [&]( std::span<const float> values ) {
+      std::array<float, L::width> buffer{};
+      std::copy_n( values.data() + i, rest, buffer.data() );
+      return buffer;
+    };
+    std::array<float, L::width> result{};
+    L::store( result.data(), op( L{}, L::load( padded( in ).data() )... ) );
+    std::copy_n( result.data(), rest, out.data() + i );
+  }
+}
+
+template<typename Op, size_t N>
+[[nodiscard]] Vec<float, N> map_lanes( const Vec<float, N>& v, Op op )
+{
+  Vec<float, N> result;
+  map_lanes( std::span<float>{ result.data(), N }, op, std::span<const float>{ v.data(), N } );
+  return result;
+}
+
+// Maps every component lane including the padding, which VecBatch keeps a whole number of registers long.
+template<typename Op, size_t N>
+void map_lanes( const VecBatch<float, N>& in, VecBatch<float, N>& out, Op op )
+{
+  out.resize( in.size() );
+  for ( size_t c = 0; c != N; ++c )
+  {
+    map_lanes( std::span<float>{ out.lane( c ).data(), out.padded_size() },
+      op,
+      std::span<const float>{ in.lane( c ).data(), in.padded_size() } );
+  }
+}
+
+template<MathPrecision P>
+void sincos( std::span<const float> in, std::span<float> sines, std::span<float> cosines )
+{
+  using L = MathLanes;
+  assert( in.size() == sines.size() && in.size() == cosines.size() );
+  size_t           i = 0;
+  typename L::pack s;
+  typename L::pack c;
+  for ( ; i + L::width <= in.size(); i += L::width )
+  {
+    sincos_lanes<P>( L{}, L::load( in.data() + i ), s, c );
+    L::store( sines.data() + i, s );
+    L::store( cosines.data() + i, c );
+  }
+  if ( i != in.size() )
+  {
+    const size_t                rest = in.size() - i;
+    std::array<float, L::width> buffer{};
+    std::copy_n( in.data() + i, rest, buffer.data() );
+    sincos_lanes<P>( L{}, L::load( buffer.data() ), s, c );
+    L::store( buffer.data(), s );
+    std::copy_n( buffer.data(), rest, sines.data() + i );
+    L::store( buffer.data(), c );
+    std::copy_n( buffer.data(), rest, cosines.data() + i );
+  }
+}
+
+} // namespace detail
+
+// Component-wise functions of Vec<float, N>.
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> sin( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::sin_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> cos( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::cos_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> tan( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::tan_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> asin( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::asin_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> acos( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::acos_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> atan( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::atan_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> exp( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::exp_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> log( const Vec<float, N>& v )
+{
+  return detail::map_lanes( v, []( auto lanes, auto x ) { return detail::log_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+[[nodiscard]] Vec<float, N> atan2( const Vec<float, N>& y, const Vec<float, N>& x )
+{
+  Vec<float, N> result;
+  detail::map_lanes( std::span<float>{ result.data(), N },
+    []( auto lanes, auto a, auto b ) { return detail::atan2_lanes<P>( lanes, a, b ); },
+    std::span<const float>{ y.data(), N },
+    std::span<const float>{ x.data(), N } );
+  return result;
+}
+
+template<MathPrecision P = Precise, size_t N>
+void sincos( const Vec<float, N>& v, Vec<float, N>& sines, Vec<float, N>& cosines )
+{
+  detail::sincos<P>( std::span<const float>{ v.data(), N },
+    std::span<float>{ sines.data(), N },
+    std::span<float>{ cosines.data(), N } );
+}
+
+// out[i] = f( in[i] ) over float arrays. The output may alias the input.
+template<MathPrecision P = Precise>
+void sin( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::sin_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void cos( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::cos_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void tan( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::tan_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void asin( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::asin_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void acos( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::acos_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void atan( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::atan_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void exp( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::exp_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void log( std::span<const float> in, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto x ) { return detail::log_lanes<P>( lanes, x ); }, in );
+}
+
+template<MathPrecision P = Precise>
+void atan2( std::span<const float> y, std::span<const float> x, std::span<float> out )
+{
+  detail::map_lanes( out, []( auto lanes, auto a, auto b ) { return detail::atan2_lanes<P>( lanes, a, b ); }, y, x );
+}
+
+template<MathPrecision P = Precise>
+void sincos( std::span<const float> in, std::span<float> sines, std::span<float> cosines )
+{
+  detail::sincos<P>( in, sines, cosines );
+}
+
+// Component-wise functions of SoA batches. The outputs are resized and may alias the input.
+template<MathPrecision P = Precise, size_t N>
+void sin( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::sin_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void cos( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::cos_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void tan( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::tan_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void asin( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::asin_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void acos( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::acos_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void atan( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::atan_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void exp( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::exp_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void log( const VecBatch<float, N>& in, VecBatch<float, N>& out )
+{
+  detail::map_lanes( in, out, []( auto lanes, auto x ) { return detail::log_lanes<P>( lanes, x ); } );
+}
+
+template<MathPrecision P = Precise, size_t N>
+void atan2( const VecBatch<float, N>& y, const VecBatch<float, N>& x, VecBatch<float, N>& out )
+{
+  assert( y.size() == x.size() );
+  out.resize( y.size() );
+  for ( size_t c = 0; c != N; ++c )
+  {
+    detail::map_lanes( std::span<float>{ out.lane( c ).data(), out.padded_size() },
+      []( auto lanes, auto a, auto b ) { return detail::atan2_lanes<P>( lanes, a, b ); },
+      std::span<const float>{ y.lane( c ).data(), y.padded_size() },
+      std::span<const float>{ x.lane( c ).data(), x.padded_size() } );
+  }
+}
+
+template<MathPrecision P = Precise, size_t N>
+void sincos( const VecBatch<float, N>& in, VecBatch<float, N>& sines, VecBatch<float, N>& cosines )
+{
+  sines.resize( in.size() );
+  cosines.resize( in.size() );
+  for ( size_t c = 0; c != N; ++c )
+  {
+    detail::sincos<P>( std::span<const float>{ in.lane( c ).data(), in.padded_size() },
+      std::span<float>{ sines.lane( c ).data(), sines.padded_size() },
+      std::span<float>{ cosines.lane( c ).data(), cosines.padded_size() } );
+  }
+}
+
+} // namespace linalg
@@ -0,0 +1,94 @@
+#include "linalg/affine.hpp"
+#include "linalg/transform.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest-death-test.h>
+#include <gtest/gtest.h>
+
+using namespace linalg;
+
+class Affine3x4Test : public ::testing::Test
+{
+protected:
+  Transform4 transform{ 0.0F, -2.0F, 0.0F, 5.0F, 1.0F, 0.0F, 0.0F, -3.0F, 0.0F, 0.0F, 0.5F, 1.5F };
+  Affine3x4  affine{ transform };
+};
+
+TEST_F( Affine3x4Test, Layout )
+{
+  EXPECT_EQ( sizeof( Affine3x4 ), 12 * sizeof( float ) );
+  EXPECT_EQ( alignof( Affine3x4 ), 16U );
+}
+
+TEST_F( Affine3x4Test, IndexOperators )
+{
+  EXPECT_FLOAT_EQ( affine( 0, 1 ), -2.0F );
+  EXPECT_FLOAT_EQ( affine( 1, 3 ), -3.0F );
+  EXPECT_FLOAT_EQ( affine( 2, 2 ), 0.5F );
+  EXPECT_EQ( affine.row( 1 ), ( Vec4{ 1.0F, 0.0F, 0.0F, -3.0F } ) );
+  EXPECT_EQ( affine.get_column3( 0 ), ( Vec3{ 0.0F, 1.0F, 0.0F } ) );
+
+  EXPECT_DEATH( { (void)affine( 3, 0 ); }, "" );
+}
+
+TEST_F( Affine3x4Test, Translation )
+{
+  EXPECT_EQ( affine.get_translation(), ( Point3{ 5.0F, -3.0F, 1.5F } ) );
+  affine.set_translation( Point3{ 4.0F, 5.0F, 6.0F } );
+  EXPECT_EQ( affine.get_translation(), ( Point3{ 4.0F, 5.0F, 6.0F } ) );
+}
+
+TEST_F( Affine3x4Test, ConstructFromColumns )
+{
+  const Vec3   x{ 1.0F, 2.0F, 3.0F };
+  const Vec3   y{ 4.0F, 5.0F, 6.0F };
+  const Vec3   z{ 7.0F, 8.0F, 9.0F };
+  const Point3 origin{ 10.0F, 11.0F, 12.0F };
+  EXPECT_EQ( ( Affine3x4{ x, y, z, origin } ), ( Affine3x4{ Transform4{ x, y, z, origin } } ) );
+}
+
+TEST_F( Affine3x4Test, Transform4RoundTrip )
+{
+  const Transform4 back = affine.to_transform4();
+  EXPECT_TRUE( are_matrices_equal( back, transform, 0.0F ) );
+  EXPECT_EQ( Affine3x4{ back }, affine );
+  EXPECT_EQ( Affine3x4::identity(), Affine3x4{ Transform4{ Transform4::identity() } } );
+}
+
+TEST_F( Affine3x4Test, Multiply )
+{
+  const Transform4 other   = make_translation( Vec3{ 1.0F, 2.0F, 3.0F } ) * make_scale( Vec3{ 2.0F, 3.0F, 4.0F } );
+  const Affine3x4  product = affine * Affine3x4{ other };
+  EXPECT_TRUE( are_matrices_equal( product.to_transform4(), transform * other, 1e-6F ) );
+
+  constexpr Affine3x4 a{ 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F, 8.0F, 9.0F, 10.0F, 11.0F, 12.0F };
+  constexpr Affine3x4 squared = a * a;
+  static_assert( squared( 0, 0 ) == 1.0F + 10.0F + 27.0F );
+  static_assert( squared( 0, 3 ) == 4.0F + 16.0F + 36.0F + 4.0F );
+  EXPECT_EQ( a * a, squared );
+}
+
+TEST_F( Affine3x4Test, TransformPointVectorNormal )
+{
+  const Point3 point{ 1.0F, 2.0F, 3.0F };
+  const Vec3   vec{ -1.0F, 0.5F, 2.0F };
+
+  EXPECT_TRUE( are_vectors_equal( affine * point, transform * point ) );
+  EXPECT_TRUE( are_vectors_equal( affine * vec, transform * vec ) );
+  EXPECT_TRUE( are_vectors_equal( transform_normal( vec, affine ), transform_normal( vec, transform ) ) );
+  EXPECT_TRUE( are_vectors_equal( vec * affine, vec * transform ) );
+
+  constexpr Affine3x4 shift{ 1.0F, 0.0F, 0.0F, 1.0F, 0.0F, 1.0F, 0.0F, 2.0F, 0.0F, 0.0F, 1.0F, 3.0F };
+  static_assert( shift * Point3{ 1.0F, 1.0F, 1.0F } == Point3{ 2.0F, 3.0F, 4.0F } );
+}
+
+TEST_F( Affine3x4Test, InverseMatchesTransform4 )
+{
+  const Affine3x4 inv = inverse( affine );
+  EXPECT_TRUE( are_matrices_equal( inv.to_transform4(), inverse( transform ), 1e-6F ) );
+
+  const Affine3x4 round_trip = affine * inv;
+  for ( size_t i = 0; i != 3; ++i )
+  {
+    EXPECT_TRUE( are_vectors_equal( round_trip.row( i ), Affine3x4::identity().row( i ), 1e-6F ) );
+  }
+}
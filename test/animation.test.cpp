@@ -0,0 +1,150 @@
+#include "linalg/animation.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace linalg;
+
+class AnimationTest : public ::testing::Test
+{
+protected:
+  static Quaternion rotation_about_z( float angle )
+  {
+    return Quaternion{ 0.0F, 0.0F, std::sin( angle / 2.0F ), std::cos( angle / 2.0F ) };
+  }
+
+  // Keys at 0, 1, 2 and 4 turning about z by a quarter turn per key, moving along x and growing in y.
+  static Track make_track()
+  {
+    std::vector<float>      times{ 0.0F, 1.0F, 2.0F, 4.0F };
+    std::vector<Vec3>       translations;
+    std::vector<Quaternion> rotations;
+    std::vector<Vec3>       scales;
+    for ( size_t k = 0; k != times.size(); ++k )
+    {
+      const float f = static_cast<float>( k );
+      translations.emplace_back( f, 0.0F, 0.0F );
+      rotations.push_back( rotation_about_z( f * 0.5F * pi ) );
+      scales.emplace_back( 1.0F, 1.0F + f, 1.0F );
+    }
+    return Track{ times, translations, rotations, scales };
+  }
+
+  const Track track = make_track();
+};
+
+TEST_F( AnimationTest, SamplesKeysExactly )
+{
+  TrackCursor cursor;
+  for ( size_t k = 0; k != track.size(); ++k )
+  {
+    const float      f        = static_cast<float>( k );
+    const Transform4 expected = make_translation( track.translations()[k] )
+                                * make_rotation4( f * 0.5F * pi, Vec3{ 0.0F, 0.0F, 1.0F } )
+                                * make_scale( track.scales()[k] );
+    EXPECT_TRUE( are_matrices_equal( sample( track, track.times()[k], cursor ), expected, 1e-5F ) ) << k;
+    EXPECT_EQ( cursor.key, k );
+  }
+}
+
+TEST_F( AnimationTest, InterpolatesBetweenKeys )
+{
+  TrackCursor      cursor;
+  const Transform4 pose     = sample( track, 3.0F, cursor );
+  const Transform4 expected = make_translation( Vec3{ 2.5F, 0.0F, 0.0F } )
+                              * make_rotation4( 1.25F * pi, Vec3{ 0.0F, 0.0F, 1.0F } )
+                              * make_scale( Vec3{ 1.0F, 3.5F, 1.0F } );
+  EXPECT_TRUE( are_matrices_equal( pose, expected, 1e-5F ) );
+  EXPECT_EQ( cursor.key, 2U );
+}
+
+TEST_F( AnimationTest, ClampsOutsideTheTrack )
+{
+  TrackCursor cursor;
+  EXPECT_TRUE( are_matrices_equal( sample( track, -1.0F, cursor ), sample( track, 0.0F, cursor ), 0.0F ) );
+  EXPECT_EQ( cursor.key, 0U );
+  EXPECT_TRUE( are_matrices_equal( sample( track, 9.0F, cursor ), sample( track, 4.0F, cursor ), 0.0F ) );
+  EXPECT_EQ( cursor.key, 3U );
+
+  const Track single{
+    { 1.0F }, { Vec3{ 1.0F, 2.0F, 3.0F } }, { rotation_about_z( 0.3F ) }, { Vec3{ 2.0F, 2.0F, 2.0F } } };
+  TrackCursor single_cursor;
+  EXPECT_TRUE(
+    are_matrices_equal( sample( single, 0.0F, single_cursor ), sample( single, 5.0F, single_cursor ), 0.0F ) );
+}
+
+TEST_F( AnimationTest, EmptyTrackCannotBeSampled )
+{
+  const Track empty;
+  TrackCursor cursor;
+  EXPECT_DEATH( { (void)sample( empty, 0.0F, cursor ); }, "" );
+}
+
+TEST_F( AnimationTest, CursorFollowsPlaybackAndSeeks )
+{
+  TrackCursor cursor;
+  for ( const float time : { 0.5F, 1.5F, 3.9F, 0.2F, 2.0F, 1.99F, 8.0F, 0.0F } )
+  {
+    TrackCursor fresh;
+    EXPECT_TRUE( are_matrices_equal( sample( track, time, cursor ), sample( track, time, fresh ), 0.0F ) ) << time;
+    EXPECT_EQ( cursor.key, fresh.key ) << time;
+  }
+
+  // A cursor left over from a longer track is clamped.
+  cursor.key = 100;
+  TrackCursor fresh;
+  EXPECT_TRUE( are_matrices_equal( sample( track, 1.5F, cursor ), sample( track, 1.5F, fresh ), 0.0F ) );
+}
+
+TEST_F( AnimationTest, BatchMatchesSingleTrack )
+{
+  std::mt19937                          engine( 9 );
+  std::normal_distribution<float>       normal;
+  std::uniform_real_distribution<float> uniform( 0.0F, 1.0F );
+  std::vector<Track>                    tracks;
+  for ( size_t i = 0; i != 611; ++i )
+  {
+    std::vector<float>      times;
+    std::vector<Vec3>       translations;
+    std::vector<Quaternion> rotations;
+    std::vector<Vec3>       scales;
+    float                   time = uniform( engine );
+    for ( size_t k = 0; k != 1 + i % 9; ++k )
+    {
+      times.push_back( time );
+      time += 0.1F + uniform( engine );
+      translations.emplace_back( normal( engine ), normal( engine ), normal( engine ) );
+      const Vec4 q{ normal( engine ), normal( engine ), normal( engine ), normal( engine ) };
+      rotations.emplace_back( normalized( q ) );
+      scales.emplace_back( 1.0F + uniform( engine ), 1.0F + uniform( engine ), 1.0F + uniform( engine ) );
+    }
+    tracks.emplace_back( times, translations, rotations, scales );
+  }
+
+  std::vector<TrackCursor> cursors( tracks.size() );
+  std::vector<TrackCursor> reference_cursors( tracks.size() );
+  std::vector<float>       times( tracks.size() );
+  std::vector<Transform4>  poses( tracks.size() );
+  for ( float frame = -0.5F; frame < 8.0F; frame += 0.37F )
+  {
+    for ( size_t i = 0; i != tracks.size(); ++i )
+    {
+      times[i] = frame * ( 0.5F + uniform( engine ) );
+    }
+    sample( tracks, times, cursors, poses );
+    for ( size_t i = 0; i != tracks.size(); ++i )
+    {
+      ASSERT_TRUE( are_matrices_equal( poses[i], sample( tracks[i], times[i], reference_cursors[i] ), 2e-5F ) ) << i;
+      ASSERT_EQ( cursors[i].key, reference_cursors[i].key );
+    }
+
+    sample( tracks, frame, cursors, poses );
+    for ( size_t i = 0; i != tracks.size(); ++i )
+    {
+      ASSERT_TRUE( are_matrices_equal( poses[i], sample( tracks[i], frame, reference_cursors[i] ), 2e-5F ) ) << i;
+    }
+  }
+}
@@ -0,0 +1,594 @@
+#include "linalg/batch.hpp"
+#include "linalg/dispatch.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+using namespace linalg;
+
+class BatchTest : public ::testing::TestWithParam<Isa>
+{
+protected:
+  Isa previous = active_isa();
+
+  void SetUp() override
+  {
+    if ( GetParam() > supported_isa() )
+    {
+      GTEST_SKIP() << "CPU does not support " << to_string( GetParam() );
+    }
+    set_isa( GetParam() );
+  }
+
+  void TearDown() override { set_isa( previous ); }
+
+  static float value( size_t i, size_t k ) { return static_cast<float>( ( i * 7 + k * 3 ) % 11 ) - 4.5F; }
+
+  static std::vector<Vec3> make_vec3( size_t count, size_t seed )
+  {
+    std::vector<Vec3> result( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      result[i] = Vec3{ value( i, seed ), value( i, seed + 1 ), value( i, seed + 2 ) };
+    }
+    return result;
+  }
+
+  static std::vector<Vec4> make_vec4( size_t count, size_t seed )
+  {
+    std::vector<Vec4> result( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      result[i] = Vec4{ value( i, seed ), value( i, seed + 1 ), value( i, seed + 2 ), value( i, seed + 3 ) };
+    }
+    return result;
+  }
+
+  static std::vector<Mat4> make_mat4( size_t count, size_t seed )
+  {
+    std::vector<Mat4> result( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      for ( size_t j = 0; j != 4; ++j )
+      {
+        result[i][j] = Vec4{ value( i, seed + j ), value( i, seed + j + 4 ), value( i, seed + j + 8 ), 1.0F };
+      }
+    }
+    return result;
+  }
+};
+
+// Sizes that cover empty input, pure tails and full vector blocks of every width.
+static constexpr std::array<size_t, 6> sizes{ 0, 1, 5, 16, 37, 100 };
+
+TEST_P( BatchTest, Mat4Multiply )
+{
+  for ( size_t count : sizes )
+  {
+    const auto        left  = make_mat4( count, 0 );
+    const auto        right = make_mat4( count, 5 );
+    std::vector<Mat4> out( count );
+    multiply( left, right, out );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_matrices_equal( out[i], left[i] * right[i], 1e-4F ) );
+    }
+  }
+}
+
+TEST_P( BatchTest, Mat4MultiplyInPlace )
+{
+  auto       left  = make_mat4( 9, 0 );
+  const auto right = make_mat4( 9, 5 );
+  const auto copy  = left;
+  multiply( left, right, left );
+  for ( size_t i = 0; i != left.size(); ++i )
+  {
+    EXPECT_TRUE( are_matrices_equal( left[i], copy[i] * right[i], 1e-4F ) );
+  }
+}
+
+TEST_P( BatchTest, Mat4MultiplyBroadcast )
+{
+  const Mat4 parent = make_mat4( 1, 7 )[0];
+  for ( size_t count : sizes )
+  {
+    const auto        locals = make_mat4( count, 2 );
+    std::vector<Mat4> world( count );
+    std::vector<Mat4> local_to_parent( count );
+    multiply( parent, locals, world );
+    multiply( locals, parent, local_to_parent );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_matrices_equal( world[i], parent * locals[i], 1e-4F ) ) << "index " << i;
+      EXPECT_TRUE( are_matrices_equal( local_to_parent[i], locals[i] * parent, 1e-4F ) ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, Transform4Multiply )
+{
+  const Transform4              parent{ 0.0F, -1.0F, 0.0F, 5.0F, 1.0F, 0.0F, 0.0F, -2.0F, 0.0F, 0.0F, 2.0F, 0.5F };
+  const std::vector<Transform4> locals{ make_translation( Vec3{ 1.0F, 2.0F, 3.0F } ),
+    make_scale( Vec3{ 2.0F, 0.5F, 1.0F } ),
+    parent };
+  std::vector<Transform4>       pairs( locals.size() );
+  std::vector<Transform4>       world( locals.size() );
+  multiply( locals, locals, pairs );
+  multiply( parent, locals, world );
+  for ( size_t i = 0; i != locals.size(); ++i )
+  {
+    EXPECT_TRUE( are_matrices_equal( pairs[i], locals[i] * locals[i], 1e-5F ) );
+    EXPECT_TRUE( are_matrices_equal( world[i], parent * locals[i], 1e-5F ) );
+    EXPECT_EQ( world[i]( 3, 3 ), 1.0F );
+  }
+}
+
+TEST_P( BatchTest, Mat4MultiplyThreaded )
+{
+  const size_t      count = 4 * detail::min_items_per_thread + 3;
+  const auto        left  = make_mat4( count, 0 );
+  const auto        right = make_mat4( count, 5 );
+  const Mat4        mat   = right[1];
+  std::vector<Mat4> serial( count );
+  std::vector<Mat4> threaded( count );
+
+  const auto same = [&] {
+    return std::ranges::all_of( std::views::iota( size_t{ 0 }, count ),
+      [&]( size_t i ) { return are_matrices_equal( serial[i], threaded[i], 0.0F ); } );
+  };
+
+  multiply( left, right, serial );
+  multiply( left, right, threaded, Threads{ 4 } );
+  EXPECT_TRUE( same() );
+
+  multiply( mat, left, serial );
+  multiply( mat, left, threaded, Threads{ 0 } );
+  EXPECT_TRUE( same() );
+
+  multiply( left, mat, serial );
+  multiply( left, mat, threaded, Threads{ 3 } );
+  EXPECT_TRUE( same() );
+}
+
+TEST_P( BatchTest, Mat4TimesVec4 )
+{
+  const Mat4 mat = make_mat4( 1, 3 )[0];
+  for ( size_t count : sizes )
+  {
+    const auto        in = make_vec4( count, 2 );
+    std::vector<Vec4> out( count );
+    multiply( mat, in, out );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( out[i], mat * in[i], 1e-4F ) ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, TransformPoints )
+{
+  const Transform4 t{ 0.0F, -1.0F, 0.0F, 5.0F, 1.0F, 0.0F, 0.0F, -2.0F, 0.0F, 0.0F, 2.0F, 0.5F };
+  for ( size_t count : sizes )
+  {
+    const auto          vecs = make_vec3( count, 1 );
+    std::vector<Point3> in( vecs.begin(), vecs.end() );
+    std::vector<Point3> out( count );
+    transform_points( t, in, out );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( out[i], t * in[i], 1e-5F ) ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, TransformVectorsAndNormals )
+{
+  const Transform4 t{ 0.0F, -1.0F, 0.0F, 5.0F, 1.0F, 0.0F, 0.0F, -2.0F, 0.0F, 0.0F, 2.0F, 0.5F };
+  for ( size_t count : sizes )
+  {
+    const auto        in = make_vec3( count, 2 );
+    std::vector<Vec3> vectors( count );
+    std::vector<Vec3> normals( count );
+    transform_vectors( t, in, vectors );
+    transform_normals( t, in, normals );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( vectors[i], t * in[i], 1e-5F ) ) << "index " << i;
+      EXPECT_TRUE( are_vectors_equal( normals[i], transform_normal( in[i], t ), 1e-5F ) ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, TransformAffine3x4 )
+{
+  const Transform4 t{ 0.0F, -1.0F, 0.0F, 5.0F, 1.0F, 0.0F, 0.0F, -2.0F, 0.0F, 0.0F, 2.0F, 0.5F };
+  const Affine3x4  a{ t };
+  const auto       in = make_vec3( 37, 3 );
+
+  std::vector<Point3> points( in.begin(), in.end() );
+  std::vector<Vec3>   vectors( in.size() );
+  std::vector<Vec3>   normals( in.size() );
+  transform_points( a, points, points );
+  transform_vectors( a, in, vectors );
+  transform_normals( a, in, normals );
+  for ( size_t i = 0; i != in.size(); ++i )
+  {
+    EXPECT_TRUE( are_vectors_equal( points[i], a * Point3{ in[i] }, 1e-5F ) ) << "index " << i;
+    EXPECT_TRUE( are_vectors_equal( vectors[i], a * in[i], 1e-5F ) ) << "index " << i;
+    EXPECT_TRUE( are_vectors_equal( normals[i], transform_normal( in[i], a ), 1e-5F ) ) << "index " << i;
+  }
+}
+
+// Large enough for non-temporal stores, with an output offset so the kernels need an unaligned head.
+TEST_P( BatchTest, TransformPointsStreaming )
+{
+  const Transform4 t{ 2.0F, 0.0F, 1.0F, 5.0F, 0.0F, 1.0F, 0.0F, -2.0F, -1.0F, 0.0F, 3.0F, 0.5F };
+  const size_t     count = streaming_store_threshold / sizeof( Point3 ) + 37;
+  const auto       vecs  = make_vec3( count, 1 );
+
+  std::vector<Point3> in( vecs.begin(), vecs.end() );
+  std::vector<Point3> out( count + 2, Point3{ 7.0F, 7.0F, 7.0F } );
+  transform_points( t, in, std::span{ out }.subspan( 1, count ) );
+
+  EXPECT_EQ( out.front(), ( Point3{ 7.0F, 7.0F, 7.0F } ) );
+  EXPECT_EQ( out.back(), ( Point3{ 7.0F, 7.0F, 7.0F } ) );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    ASSERT_TRUE( are_vectors_equal( out[i + 1], t * in[i], 1e-5F ) ) << "index " << i;
+  }
+}
+
+TEST_P( BatchTest, Dot )
+{
+  for ( size_t count : sizes )
+  {
+    const auto         a3 = make_vec3( count, 0 );
+    const auto         b3 = make_vec3( count, 4 );
+    const auto         a4 = make_vec4( count, 2 );
+    const auto         b4 = make_vec4( count, 9 );
+    std::vector<float> out3( count );
+    std::vector<float> out4( count );
+    dot( a3, b3, out3 );
+    dot( a4, b4, out4 );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_NEAR( out3[i], dot( a3[i], b3[i] ), 1e-4F ) << "index " << i;
+      EXPECT_NEAR( out4[i], dot( a4[i], b4[i] ), 1e-4F ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, Cross )
+{
+  for ( size_t count : sizes )
+  {
+    const auto        a = make_vec3( count, 0 );
+    const auto        b = make_vec3( count, 5 );
+    std::vector<Vec3> out( count );
+    cross( a, b, out );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( out[i], cross( a[i], b[i] ), 1e-4F ) ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, RotateByQuaternion )
+{
+  const Quaternion q = normalized( Quaternion{ 0.3F, -0.5F, 0.1F, 0.8F } );
+  for ( size_t count : sizes )
+  {
+    const auto              in = make_vec3( count, 2 );
+    std::vector<Quaternion> quats( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      quats[i] = normalized( Quaternion{ value( i, 0 ), value( i, 1 ), value( i, 2 ), value( i, 3 ) + 0.25F } );
+    }
+    std::vector<Vec3>   vectors( count );
+    std::vector<Vec3>   rotated( count );
+    std::vector<Point3> points( in.begin(), in.end() );
+    std::vector<Point3> rotated_points( in.begin(), in.end() );
+    transform_vectors( q, in, vectors );
+    transform_vectors( quats, in, rotated );
+    transform_points( q, points, points );
+    transform_points( quats, rotated_points, rotated_points );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( vectors[i], transform( in[i], q ), 1e-5F ) ) << "index " << i;
+      EXPECT_TRUE( are_vectors_equal( rotated[i], transform( in[i], quats[i] ), 1e-5F ) ) << "index " << i;
+      EXPECT_TRUE( are_vectors_equal( points[i], transform( in[i], q ), 1e-5F ) ) << "index " << i;
+      EXPECT_TRUE( are_vectors_equal( rotated_points[i], rotated[i], 0.0F ) ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, TailDoesNotWritePastEnd )
+{
+  constexpr size_t   count = 21;
+  const auto         in    = make_vec3( count + 1, 1 );
+  std::vector<Vec3>  out( count + 1, Vec3{ 7.0F, 7.0F, 7.0F } );
+  std::vector<float> dots( count + 1, 7.0F );
+
+  normalize( std::span{ in }.first( count ), std::span{ out }.first( count ) );
+  dot( std::span{ in }.first( count ), std::span{ in }.first( count ), std::span{ dots }.first( count ) );
+  EXPECT_EQ( out[count], ( Vec3{ 7.0F, 7.0F, 7.0F } ) );
+  EXPECT_FLOAT_EQ( dots[count], 7.0F );
+}
+
+TEST_P( BatchTest, Normalize )
+{
+  for ( size_t count : sizes )
+  {
+    auto in3 = make_vec3( count, 3 );
+    auto in4 = make_vec4( count, 1 );
+    for ( auto& v : in3 )
+    {
+      v.x() += 10.0F;
+    }
+    for ( auto& v : in4 )
+    {
+      v.w() += 10.0F;
+    }
+    std::vector<Vec3> out3( count );
+    std::vector<Vec4> out4( count );
+    normalize( in3, out3 );
+    normalize( in4, out4 );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( out3[i], normalized( in3[i] ), 1e-6F ) ) << "index " << i;
+      EXPECT_TRUE( are_vectors_equal( out4[i], normalized( in4[i] ), 1e-6F ) ) << "index " << i;
+    }
+
+    normalize( in3, in3 );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( in3[i], out3[i], 0.0F ) );
+    }
+  }
+}
+
+TEST_P( BatchTest, NormalizeAccuracyModes )
+{
+  constexpr size_t count = 37;
+  auto             in3   = make_vec3( count, 3 );
+  auto             in4   = make_vec4( count, 1 );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    in3[i].x() += 10.0F;
+    in4[i].w() += 10.0F;
+  }
+  std::vector<Vec3> refined3( count );
+  std::vector<Vec3> estimate3( count );
+  std::vector<Vec4> refined4( count );
+  std::vector<Vec4> estimate4( count );
+  normalize<Refined>( in3, refined3 );
+  normalize<Estimate>( in3, estimate3 );
+  normalize<Refined>( in4, refined4 );
+  normalize<Estimate>( in4, estimate4 );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    EXPECT_NEAR( magnitude( refined3[i] ), 1.0F, 1e-6F ) << "index " << i;
+    EXPECT_NEAR( magnitude( refined4[i] ), 1.0F, 1e-6F ) << "index " << i;
+    EXPECT_NEAR( magnitude( estimate3[i] ), 1.0F, 4e-4F ) << "index " << i;
+    EXPECT_NEAR( magnitude( estimate4[i] ), 1.0F, 4e-4F ) << "index " << i;
+    EXPECT_TRUE( are_vectors_equal( refined3[i], normalized( in3[i] ), 1e-6F ) ) << "index " << i;
+  }
+}
+
+// Without FMA every kernel rounds each product and sum on its own, in the order of the scalar kernels, so all ISAs
+// agree with them bit for bit. Refined and Estimate normalization start from the hardware's rsqrt estimate, whose
+// precision differs between instruction sets, and are left out.
+TEST_P( BatchTest, MatchesScalarWithoutFma )
+{
+#ifdef LINALG_NO_FMA
+  constexpr size_t count = 37;
+  const auto       noisy = []( size_t i ) { return 7.0F * std::sin( 0.37F * static_cast<float>( i ) + 0.1F ); };
+
+  std::vector<Vec3>       a3( count );
+  std::vector<Vec3>       b3( count );
+  std::vector<Vec4>       a4( count );
+  std::vector<Vec4>       b4( count );
+  std::vector<Mat4>       mats( count );
+  std::vector<Quaternion> quats( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    a3[i] = Vec3{ noisy( 8 * i ), noisy( 8 * i + 1 ), noisy( 8 * i + 2 ) };
+    b3[i] = Vec3{ noisy( 8 * i + 3 ), noisy( 8 * i + 4 ), noisy( 8 * i + 5 ) };
+    a4[i] = Vec4{ noisy( 8 * i ), noisy( 8 * i + 2 ), noisy( 8 * i + 4 ), noisy( 8 * i + 6 ) };
+    b4[i] = Vec4{ noisy( 8 * i + 1 ), noisy( 8 * i + 3 ), noisy( 8 * i + 5 ), noisy( 8 * i + 7 ) };
+    for ( size_t j = 0; j != 4; ++j )
+    {
+      const size_t k = 16 * i + j;
+      mats[i][j]     = Vec4{ noisy( k ), noisy( k + 4 ), noisy( k + 8 ), noisy( k + 12 ) };
+    }
+    quats[i] = normalized( Quaternion{ a4[i].x(), a4[i].y(), a4[i].z(), a4[i].w() } );
+  }
+  const Transform4 t{ noisy( 1 ), noisy( 2 ), noisy( 3 ), noisy( 4 ), noisy( 5 ), noisy( 6 ), noisy( 7 ), noisy( 8 ),
+    noisy( 9 ), noisy( 10 ), noisy( 11 ), noisy( 12 ) };
+  const std::vector<Point3> points( a3.begin(), a3.end() );
+
+  const auto run = [&] {
+    std::vector<float> result;
+    const auto         append = [&]( const auto& values ) {
+      const auto* first = reinterpret_cast<const float*>( values.data() );
+      result.insert( result.end(), first, first + values.size() * sizeof( values[0] ) / sizeof( float ) );
+    };
+    std::vector<Mat4>   m( count );
+    std::vector<Vec4>   v4( count );
+    std::vector<Vec3>   v3( count );
+    std::vector<Point3> p3( count );
+    std::vector<float>  dots( count );
+    multiply( mats, mats, m );
+    append( m );
+    multiply( mats, mats[3], m );
+    append( m );
+    multiply( mats[5], a4, v4 );
+    append( v4 );
+    transform_points( t, points, p3 );
+    append( p3 );
+    transform_vectors( t, a3, v3 );
+    append( v3 );
+    dot( a3, b3, dots );
+    append( dots );
+    dot( a4, b4, dots );
+    append( dots );
+    cross( a3, b3, v3 );
+    append( v3 );
+    transform_vectors( quats, a3, v3 );
+    append( v3 );
+    normalize( a3, v3 );
+    append( v3 );
+    normalize( a4, v4 );
+    append( v4 );
+    return result;
+  };
+
+  const std::vector<float> dispatched = run();
+  set_isa( Isa::scalar );
+  const std::vector<float> reference = run();
+  set_isa( GetParam() );
+  ASSERT_EQ( dispatched.size(), reference.size() );
+  for ( size_t i = 0; i != dispatched.size(); ++i )
+  {
+    EXPECT_EQ( std::bit_cast<std::uint32_t>( dispatched[i] ), std::bit_cast<std::uint32_t>( reference[i] ) )
+      << "value " << i;
+  }
+#else
+  GTEST_SKIP() << "kernels fuse multiply-adds unless LINALG_NO_FMA is defined";
+#endif
+}
+
+// Scattered bit patterns reach subnormals, rounding ties, overflow, infinities and NaNs. The bulk kernels must match
+// the scalar conversion bit for bit, except that NaN payloads may differ.
+static float scattered_float( size_t i )
+{
+  return std::bit_cast<float>( static_cast<std::uint32_t>( i * 0x9e37'79b1U ) );
+}
+
+static std::uint16_t scattered_bits( size_t i )
+{
+  return static_cast<std::uint16_t>( i * 40'503U );
+}
+
+template<typename Storage, size_t N>
+static void expect_storage_conversion()
+{
+  for ( size_t count : { size_t{ 0 }, size_t{ 1 }, size_t{ 5 }, size_t{ 16 }, size_t{ 37 }, size_t{ 1000 } } )
+  {
+    std::vector<Vec<float, N>>   in( count );
+    std::vector<Vec<Storage, N>> packed( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      for ( size_t k = 0; k != N; ++k )
+      {
+        in[i][k]     = scattered_float( i * N + k );
+        packed[i][k] = Storage::from_bits( scattered_bits( i * N + k ) );
+      }
+    }
+
+    std::vector<Vec<Storage, N>> narrowed( count );
+    std::vector<Vec<float, N>>   widened( count );
+    convert( in, narrowed );
+    convert( packed, widened );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      for ( size_t k = 0; k != N; ++k )
+      {
+        const Storage expected = Storage( in[i][k] );
+        if ( std::isnan( in[i][k] ) )
+        {
+          EXPECT_TRUE( std::isnan( static_cast<float>( narrowed[i][k] ) ) );
+        } else
+        {
+          EXPECT_EQ( narrowed[i][k].bits(), expected.bits() ) << "value " << in[i][k];
+        }
+
+        const float wide = static_cast<float>( packed[i][k] );
+        if ( std::isnan( wide ) )
+        {
+          EXPECT_TRUE( std::isnan( widened[i][k] ) );
+        } else
+        {
+          EXPECT_EQ( std::bit_cast<std::uint32_t>( widened[i][k] ), std::bit_cast<std::uint32_t>( wide ) );
+        }
+      }
+    }
+  }
+}
+
+TEST_P( BatchTest, HalfConversion )
+{
+  expect_storage_conversion<Half, 3>();
+  expect_storage_conversion<Half, 4>();
+}
+
+TEST_P( BatchTest, BFloat16Conversion )
+{
+  expect_storage_conversion<BFloat16, 3>();
+  expect_storage_conversion<BFloat16, 4>();
+}
+
+template<typename Encoded>
+static void expect_normal_encoding( Encoded ( *encode_one )( const Vec3& ),
+  void ( *encode_many )( std::span<const Vec3>, std::span<Encoded> ) )
+{
+  for ( size_t count : sizes )
+  {
+    std::vector<Vec3> normals( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      normals[i] = normalized( Vec3{ scattered_float( i ) > 0 ? 1.0F : -1.0F,
+        static_cast<float>( i % 13 ) - 6.0F,
+        static_cast<float>( i % 7 ) - 3.5F } );
+    }
+    std::vector<Encoded> encoded( count );
+    std::vector<Vec3>    decoded( count );
+    encode_many( normals, encoded );
+    decode( std::span<const Encoded>{ encoded }, std::span<Vec3>{ decoded } );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      EXPECT_EQ( encoded[i], encode_one( normals[i] ) ) << "index " << i;
+      EXPECT_TRUE( are_vectors_equal( decoded[i], decode( encoded[i] ), 1e-6F ) ) << "index " << i;
+    }
+  }
+}
+
+TEST_P( BatchTest, NormalEncoding )
+{
+  expect_normal_encoding<Oct32>( encode_oct32, encode_oct32 );
+  expect_normal_encoding<Oct16>( encode_oct16, encode_oct16 );
+  expect_normal_encoding<Snorm10x3>( encode_snorm10x3, encode_snorm10x3 );
+}
+
+INSTANTIATE_TEST_SUITE_P( AllIsas,
+  BatchTest,
+  ::testing::Values( Isa::scalar, Isa::sse4, Isa::avx2, Isa::avx512 ),
+  []( const ::testing::TestParamInfo<Isa>& info ) { return std::string( to_string( info.param ) ); } );
+
+TEST( DispatchTest, SetIsaClampsToSupported )
+{
+  const Isa previous = active_isa();
+  EXPECT_EQ( set_isa( Isa::avx512 ), supported_isa() );
+  EXPECT_EQ( active_isa(), supported_isa() );
+  EXPECT_EQ( set_isa( Isa::scalar ), Isa::scalar );
+  EXPECT_EQ( active_isa(), Isa::scalar );
+  set_isa( previous );
+}
+
+TEST( DispatchTest, IsaNames )
+{
+  for ( size_t i = 0; i != isa_count; ++i )
+  {
+    const auto isa = static_cast<Isa>( i );
+    EXPECT_EQ( isa_from_string( to_string( isa ), Isa::scalar ), isa );
+  }
+  EXPECT_EQ( isa_from_string( "neon", Isa::sse4 ), Isa::sse4 );
+}
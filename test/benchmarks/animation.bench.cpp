@@ -0,0 +1,107 @@
+#include "linalg/animation.hpp"
+#include "linalg/utility.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+// Each track a second of keys at 30 Hz; the argument is the number of tracks, 60 bones for one character.
+constexpr size_t key_count = 31;
+
+std::vector<Track> make_tracks( size_t track_count )
+{
+  std::vector<Track> tracks;
+  for ( size_t i = 0; i != track_count; ++i )
+  {
+    std::vector<float>      times;
+    std::vector<Vec3>       translations;
+    std::vector<Quaternion> rotations;
+    std::vector<Vec3>       scales;
+    for ( size_t k = 0; k != key_count; ++k )
+    {
+      const float angle = static_cast<float>( i + k ) * 0.37F;
+      const Vec3  axis  = normalized( Vec3{ std::sin( angle ), std::cos( 2.0F * angle ), 0.5F } );
+      times.push_back( static_cast<float>( k ) / 30.0F );
+      translations.emplace_back( angle, 1.0F, -angle );
+      rotations.emplace_back( axis * std::sin( angle / 2.0F ), std::cos( angle / 2.0F ) );
+      scales.emplace_back( 1.0F, 1.0F, 1.0F );
+    }
+    tracks.emplace_back( times, translations, rotations, scales );
+  }
+  return tracks;
+}
+
+// Frames at 60 Hz wrapping around the one-second clip.
+float frame_time( size_t frame )
+{
+  return static_cast<float>( frame % 60 ) / 60.0F;
+}
+
+} // namespace
+
+// Binary search and slerp per track: the baseline the cursor replaces.
+static void bm_sample_search( benchmark::State& state )
+{
+  const auto              tracks = make_tracks( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Transform4> out( tracks.size() );
+  size_t                  frame = 0;
+  for ( auto _ : state )
+  {
+    const float time = frame_time( frame++ );
+    for ( size_t i = 0; i != tracks.size(); ++i )
+    {
+      const Track& track = tracks[i];
+      const auto   times = track.times();
+      const size_t key =
+        std::min( static_cast<size_t>( std::upper_bound( times.begin(), times.end(), time ) - times.begin() ),
+          times.size() - 1 );
+      const size_t from    = key - 1;
+      const float  t       = ( time - times[from] ) / ( times[key] - times[from] );
+      const Mat3   r       = slerp( track.rotations()[from], track.rotations()[key], t ).get_rotation_matrix();
+      const Vec3   s       = mix( track.scales()[from], track.scales()[key], t );
+      const Vec3   offset  = mix( track.translations()[from], track.translations()[key], t );
+      out[i]               = Transform4{ r[0] * s.x(), r[1] * s.y(), r[2] * s.z(), Point3{ offset } };
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( tracks.size() ) );
+}
+BENCHMARK( bm_sample_search )->Arg( 60 )->Arg( 200 * 60 );
+
+static void bm_sample_cursor( benchmark::State& state )
+{
+  const auto               tracks = make_tracks( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<TrackCursor> cursors( tracks.size() );
+  std::vector<Transform4>  out( tracks.size() );
+  size_t                   frame = 0;
+  for ( auto _ : state )
+  {
+    const float time = frame_time( frame++ );
+    for ( size_t i = 0; i != tracks.size(); ++i )
+    {
+      out[i] = sample( tracks[i], time, cursors[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( tracks.size() ) );
+}
+BENCHMARK( bm_sample_cursor )->Arg( 60 )->Arg( 200 * 60 );
+
+static void bm_sample_batch( benchmark::State& state )
+{
+  const auto               tracks = make_tracks( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<TrackCursor> cursors( tracks.size() );
+  std::vector<Transform4>  out( tracks.size() );
+  size_t                   frame = 0;
+  for ( auto _ : state )
+  {
+    sample( tracks, frame_time( frame++ ), cursors, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( tracks.size() ) );
+}
+BENCHMARK( bm_sample_batch )->Arg( 60 )->Arg( 200 * 60 );
@@ -0,0 +1,429 @@
+#include "linalg/batch.hpp"
+#include "linalg/dispatch.hpp"
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+// First argument selects the ISA, second the number of elements.
+const std::vector<std::int64_t> isa_args{ 0, 1, 2, 3 };
+const std::vector<std::int64_t> size_args{ 1 << 10, 1 << 16, 1 << 20 };
+
+bool select_isa( benchmark::State& state )
+{
+  const auto isa = static_cast<Isa>( state.range( 0 ) );
+  if ( isa > supported_isa() )
+  {
+    state.SkipWithError( "ISA not supported by this CPU" );
+    return false;
+  }
+  set_isa( isa );
+  state.SetLabel( std::string( to_string( isa ) ) );
+  return true;
+}
+
+template<typename T>
+std::vector<T> make_input( size_t count )
+{
+  std::vector<T> result( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    for ( size_t j = 0; j != T::length; ++j )
+    {
+      result[i][j] = static_cast<float>( ( i + j ) % 17 ) + 1.0F;
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+static void bm_batch_transform_points( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto          count = static_cast<size_t>( state.range( 1 ) );
+  const auto          vecs  = make_input<Vec3>( count );
+  std::vector<Point3> in( vecs.begin(), vecs.end() );
+  std::vector<Point3> out( count );
+  const Transform4    t{ 0.0F, -1.0F, 0.0F, 5.0F, 1.0F, 0.0F, 0.0F, -2.0F, 0.0F, 0.0F, 2.0F, 0.5F };
+  for ( auto _ : state )
+  {
+    transform_points( t, in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_transform_points )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_dot3( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto         count = static_cast<size_t>( state.range( 1 ) );
+  const auto         a     = make_input<Vec3>( count );
+  const auto         b     = make_input<Vec3>( count );
+  std::vector<float> out( count );
+  for ( auto _ : state )
+  {
+    dot( a, b, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_dot3 )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_dot4( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto         count = static_cast<size_t>( state.range( 1 ) );
+  const auto         a     = make_input<Vec4>( count );
+  const auto         b     = make_input<Vec4>( count );
+  std::vector<float> out( count );
+  for ( auto _ : state )
+  {
+    dot( a, b, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_dot4 )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_cross3( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto        count = static_cast<size_t>( state.range( 1 ) );
+  const auto        a     = make_input<Vec3>( count );
+  const auto        b     = make_input<Vec3>( count );
+  std::vector<Vec3> out( count );
+  for ( auto _ : state )
+  {
+    cross( a, b, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_cross3 )->ArgsProduct( { isa_args, size_args } );
+
+// The per-vector loop the quaternion overloads replace.
+static void bm_scalar_rotate( benchmark::State& state )
+{
+  const auto        count = static_cast<size_t>( state.range( 0 ) );
+  const auto        in    = make_input<Vec3>( count );
+  std::vector<Vec3> out( count );
+  const Quaternion  q = normalized( Quaternion{ 0.3F, -0.5F, 0.1F, 0.8F } );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != count; ++i )
+    {
+      out[i] = transform( in[i], q );
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_rotate )->ArgsProduct( { size_args } );
+
+static void bm_batch_rotate( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto        count = static_cast<size_t>( state.range( 1 ) );
+  const auto        in    = make_input<Vec3>( count );
+  std::vector<Vec3> out( count );
+  const Quaternion  q = normalized( Quaternion{ 0.3F, -0.5F, 0.1F, 0.8F } );
+  for ( auto _ : state )
+  {
+    transform_vectors( q, in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_rotate )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_rotate_each( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto              count = static_cast<size_t>( state.range( 1 ) );
+  const auto              in    = make_input<Vec3>( count );
+  std::vector<Quaternion> quats( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    quats[i] = normalized( Quaternion{ in[i].x(), -1.0F, in[i].z(), 2.0F } );
+  }
+  std::vector<Vec3> out( count );
+  for ( auto _ : state )
+  {
+    transform_vectors( quats, in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_rotate_each )->ArgsProduct( { isa_args, size_args } );
+
+template<typename Policy>
+static void bm_batch_normalize3( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto        count = static_cast<size_t>( state.range( 1 ) );
+  const auto        in    = make_input<Vec3>( count );
+  std::vector<Vec3> out( count );
+  for ( auto _ : state )
+  {
+    normalize<Policy>( in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK_TEMPLATE( bm_batch_normalize3, Exact )->ArgsProduct( { isa_args, size_args } );
+BENCHMARK_TEMPLATE( bm_batch_normalize3, Refined )->ArgsProduct( { isa_args, size_args } );
+BENCHMARK_TEMPLATE( bm_batch_normalize3, Estimate )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_mat4_times_vec4( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto        count = static_cast<size_t>( state.range( 1 ) );
+  const auto        in    = make_input<Vec4>( count );
+  std::vector<Vec4> out( count );
+  const Mat4        m{ 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F, 8.0F, 9.0F, 1.0F, 2.0F, 3.0F, 0.0F, 0.0F, 0.0F, 1.0F };
+  for ( auto _ : state )
+  {
+    multiply( m, in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_mat4_times_vec4 )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_mat4_multiply( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto        count = static_cast<size_t>( state.range( 1 ) );
+  std::vector<Mat4> left( count, Mat4::identity() );
+  std::vector<Mat4> right( count, Mat4::identity() );
+  std::vector<Mat4> out( count );
+  for ( auto _ : state )
+  {
+    multiply( left, right, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_mat4_multiply )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_vec4_to_half( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto         count = static_cast<size_t>( state.range( 1 ) );
+  const auto         in    = make_input<Vec4>( count );
+  std::vector<HVec4> out( count );
+  for ( auto _ : state )
+  {
+    convert( in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_vec4_to_half )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_half_to_vec4( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto         count = static_cast<size_t>( state.range( 1 ) );
+  std::vector<HVec4> in( count );
+  convert( make_input<Vec4>( count ), in );
+  std::vector<Vec4> out( count );
+  for ( auto _ : state )
+  {
+    convert( in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_half_to_vec4 )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_vec4_to_bfloat16( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto            count = static_cast<size_t>( state.range( 1 ) );
+  const auto            in    = make_input<Vec4>( count );
+  std::vector<BF16Vec4> out( count );
+  for ( auto _ : state )
+  {
+    convert( in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_vec4_to_bfloat16 )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_encode_oct32( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto         count = static_cast<size_t>( state.range( 1 ) );
+  const auto         in    = make_input<Vec3>( count );
+  std::vector<Oct32> out( count );
+  for ( auto _ : state )
+  {
+    encode_oct32( in, out );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_encode_oct32 )->ArgsProduct( { isa_args, size_args } );
+
+static void bm_batch_decode_oct32( benchmark::State& state )
+{
+  if ( !select_isa( state ) )
+  {
+    return;
+  }
+  const auto         count = static_cast<size_t>( state.range( 1 ) );
+  std::vector<Oct32> in( count );
+  encode_oct32( make_input<Vec3>( count ), in );
+  std::vector<Vec3> out( count );
+  for ( auto _ : state )
+  {
+    decode( std::span<const Oct32>{ in }, std::span<Vec3>{ out } );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 1 ) );
+}
+BENCHMARK( bm_batch_decode_oct32 )->ArgsProduct( { isa_args, size_args } );
+
+namespace {
+
+// Concatenation benchmarks run on the widest supported ISA. First argument is the number of matrices, second the
+// number of threads (0 = hardware concurrency).
+const std::vector<std::int64_t> concat_size_args{ 10'000, 100'000, 1'000'000 };
+const std::vector<std::int64_t> thread_args{ 1, 0 };
+
+std::vector<Transform4> make_transforms( size_t count )
+{
+  std::vector<Transform4> result( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const auto f = static_cast<float>( i % 64 );
+    result[i]    = Transform4{ make_rotation4( 0.01F * f, Vec3{ 0.0F, 1.0F, 0.0F } ) };
+    result[i].set_translation( Point3{ f, 2.0F * f, -f } );
+  }
+  return result;
+}
+
+Threads select_threads( benchmark::State& state )
+{
+  set_isa( supported_isa() );
+  const Threads threads{ static_cast<size_t>( state.range( 1 ) ) };
+  state.SetLabel( std::string( to_string( active_isa() ) ) + " threads=" + std::to_string( threads.count ) );
+  return threads;
+}
+
+} // namespace
+
+static void bm_batch_concat_pairs( benchmark::State& state )
+{
+  const Threads           threads = select_threads( state );
+  const auto              count   = static_cast<size_t>( state.range( 0 ) );
+  const auto              parents = make_transforms( count );
+  const auto              locals  = make_transforms( count );
+  std::vector<Transform4> world( count );
+  for ( auto _ : state )
+  {
+    multiply( parents, locals, world, threads );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_batch_concat_pairs )->ArgsProduct( { concat_size_args, thread_args } )->UseRealTime();
+
+static void bm_batch_concat_parent( benchmark::State& state )
+{
+  const Threads           threads = select_threads( state );
+  const auto              count   = static_cast<size_t>( state.range( 0 ) );
+  const Transform4        parent  = make_transforms( 2 )[1];
+  const auto              locals  = make_transforms( count );
+  std::vector<Transform4> world( count );
+  for ( auto _ : state )
+  {
+    multiply( parent, locals, world, threads );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_batch_concat_parent )->ArgsProduct( { concat_size_args, thread_args } )->UseRealTime();
+
+static void bm_batch_concat_local( benchmark::State& state )
+{
+  const Threads           threads = select_threads( state );
+  const auto              count   = static_cast<size_t>( state.range( 0 ) );
+  const auto              parents = make_transforms( count );
+  const Transform4        local   = make_transforms( 2 )[1];
+  std::vector<Transform4> world( count );
+  for ( auto _ : state )
+  {
+    multiply( parents, local, world, threads );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_batch_concat_local )->ArgsProduct( { concat_size_args, thread_args } )->UseRealTime();
+
+// Reference point: one operator* per matrix.
+static void bm_concat_scalar_loop( benchmark::State& state )
+{
+  const auto              count   = static_cast<size_t>( state.range( 0 ) );
+  const auto              parents = make_transforms( count );
+  const auto              locals  = make_transforms( count );
+  std::vector<Transform4> world( count );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != count; ++i )
+    {
+      world[i] = parents[i] * locals[i];
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_concat_scalar_loop )->ArgsProduct( { concat_size_args } );
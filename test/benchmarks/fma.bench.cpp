@@ -0,0 +1,157 @@
+#include "linalg/fma.hpp"
+#include "linalg/mat4.hpp"
+#include "linalg/transform.hpp"
+#include "linalg/vec.hpp"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace linalg;
+
+// Latency benchmarks feed each result into the next call; throughput benchmarks run independent calls over an array.
+namespace {
+
+constexpr size_t throughput_count = 1024;
+
+std::vector<Vec4> make_vec4s()
+{
+  std::vector<Vec4> vecs( throughput_count );
+  for ( size_t i = 0; i != vecs.size(); ++i )
+  {
+    const auto f = static_cast<float>( i );
+    vecs[i]      = Vec4{ 0.5F + f * 0.001F, -0.25F, 0.125F * f, 1.0F };
+  }
+  return vecs;
+}
+
+const Mat4 rotation_like{
+  0.8F, -0.6F, 0.0F, 0.1F, 0.6F, 0.8F, 0.0F, -0.2F, 0.0F, 0.0F, 1.0F, 0.3F, 0.0F, 0.0F, 0.0F, 1.0F
+};
+
+const Transform4 transform_like{ 0.8F, -0.6F, 0.0F, 0.1F, 0.6F, 0.8F, 0.0F, -0.2F, 0.0F, 0.0F, 1.0F, 0.3F };
+
+} // namespace
+
+template<typename Policy>
+static void bm_dot_vec4_latency( benchmark::State& state )
+{
+  Vec4  v{ 0.5F, -0.25F, 0.125F, 1.0F };
+  float acc = 0.0F;
+  for ( auto _ : state )
+  {
+    acc = dot<Policy>( v, Vec4{ acc, 0.5F, 0.25F, 0.125F } );
+  }
+  benchmark::DoNotOptimize( acc );
+}
+BENCHMARK_TEMPLATE( bm_dot_vec4_latency, Fused );
+BENCHMARK_TEMPLATE( bm_dot_vec4_latency, Separate );
+
+template<typename Policy>
+static void bm_dot_vec4_throughput( benchmark::State& state )
+{
+  const auto         vecs = make_vec4s();
+  std::vector<float> out( vecs.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != vecs.size(); ++i )
+    {
+      out[i] = dot<Policy>( vecs[i], vecs[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( vecs.size() ) );
+}
+BENCHMARK_TEMPLATE( bm_dot_vec4_throughput, Fused );
+BENCHMARK_TEMPLATE( bm_dot_vec4_throughput, Separate );
+
+template<typename Policy>
+static void bm_mat4_times_vec4_latency( benchmark::State& state )
+{
+  Vec4 v{ 0.5F, -0.25F, 0.125F, 1.0F };
+  for ( auto _ : state )
+  {
+    v = multiply<Policy>( rotation_like, v );
+  }
+  benchmark::DoNotOptimize( v );
+}
+BENCHMARK_TEMPLATE( bm_mat4_times_vec4_latency, Fused );
+BENCHMARK_TEMPLATE( bm_mat4_times_vec4_latency, Separate );
+
+template<typename Policy>
+static void bm_mat4_times_vec4_throughput( benchmark::State& state )
+{
+  const auto        vecs = make_vec4s();
+  std::vector<Vec4> out( vecs.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != vecs.size(); ++i )
+    {
+      out[i] = multiply<Policy>( rotation_like, vecs[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( vecs.size() ) );
+}
+BENCHMARK_TEMPLATE( bm_mat4_times_vec4_throughput, Fused );
+BENCHMARK_TEMPLATE( bm_mat4_times_vec4_throughput, Separate );
+
+template<typename Policy>
+static void bm_mat4_multiply_latency( benchmark::State& state )
+{
+  Mat4 m = rotation_like;
+  for ( auto _ : state )
+  {
+    m = multiply<Policy>( m, rotation_like );
+  }
+  benchmark::DoNotOptimize( m );
+}
+BENCHMARK_TEMPLATE( bm_mat4_multiply_latency, Fused );
+BENCHMARK_TEMPLATE( bm_mat4_multiply_latency, Separate );
+
+template<typename Policy>
+static void bm_mat4_multiply_throughput( benchmark::State& state )
+{
+  std::vector<Mat4> mats( throughput_count, rotation_like );
+  std::vector<Mat4> out( mats.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != mats.size(); ++i )
+    {
+      out[i] = multiply<Policy>( mats[i], rotation_like );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( mats.size() ) );
+}
+BENCHMARK_TEMPLATE( bm_mat4_multiply_throughput, Fused );
+BENCHMARK_TEMPLATE( bm_mat4_multiply_throughput, Separate );
+
+template<typename Policy>
+static void bm_transform4_times_point3_latency( benchmark::State& state )
+{
+  Point3 p{ 1.0F, 2.0F, 3.0F };
+  for ( auto _ : state )
+  {
+    p = multiply<Policy>( transform_like, p );
+  }
+  benchmark::DoNotOptimize( p );
+}
+BENCHMARK_TEMPLATE( bm_transform4_times_point3_latency, Fused );
+BENCHMARK_TEMPLATE( bm_transform4_times_point3_latency, Separate );
+
+template<typename Policy>
+static void bm_transform4_times_point3_throughput( benchmark::State& state )
+{
+  std::vector<Point3> points( throughput_count, Point3{ 1.0F, 2.0F, 3.0F } );
+  std::vector<Point3> out( points.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != points.size(); ++i )
+    {
+      out[i] = multiply<Policy>( transform_like, points[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * static_cast<int64_t>( points.size() ) );
+}
+BENCHMARK_TEMPLATE( bm_transform4_times_point3_throughput, Fused );
+BENCHMARK_TEMPLATE( bm_transform4_times_point3_throughput, Separate );
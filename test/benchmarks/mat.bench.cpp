@@ -121,6 +121,17 @@ static void bm_transform4_times_vec3( benchmark::State& state )
 }
 BENCHMARK( bm_transform4_times_vec3 );
 
+static void bm_transform4_multiply( benchmark::State& state )
+{
+  Transform4 a{ 1.0F, 0.0F, 0.0F, 5.0F, 0.0F, 1.0F, 0.0F, 6.0F, 0.0F, 0.0F, 1.0F, 7.0F };
+  Transform4 b{ 0.0F, -1.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F, 2.0F, 0.0F, 0.0F, 2.0F, 3.0F };
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( a * b );
+  }
+}
+BENCHMARK( bm_transform4_multiply );
+
 static void bm_transform4_inverse( benchmark::State& state )
 {
   Transform4 t{ 1.0F, 0.0F, 0.0F, 5.0F, 0.0F, 1.0F, 0.0F, 6.0F, 0.0F, 0.0F, 1.0F, 7.0F };
@@ -130,3 +141,67 @@ static void bm_transform4_inverse( benchmark::State& state )
   }
 }
 BENCHMARK( bm_transform4_inverse );
+
+static void bm_dmat4_multiply( benchmark::State& state )
+{
+  DMat4 a{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 13.0, 14.0, 15.0, 16.0 };
+  DMat4 b{ 16.0, 15.0, 14.0, 13.0, 12.0, 11.0, 10.0, 9.0, 8.0, 7.0, 6.0, 5.0, 4.0, 3.0, 2.0, 1.0 };
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( a * b );
+  }
+}
+BENCHMARK( bm_dmat4_multiply );
+
+static void bm_dmat4_inverse( benchmark::State& state )
+{
+  DMat4 a{ 1.0, 0.0, 2.0, 1.0, 0.0, 1.0, 0.0, 1.0, 2.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0 };
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( inverse( a ) );
+  }
+}
+BENCHMARK( bm_dmat4_inverse );
+
+static void bm_dmat4_times_vec4( benchmark::State& state )
+{
+  DMat4 m{ 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0, 13.0, 14.0, 15.0, 16.0 };
+  DVec4 v{ 1.0, 2.0, 3.0, 4.0 };
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( m * v );
+  }
+}
+BENCHMARK( bm_dmat4_times_vec4 );
+
+static void bm_dtransform4_times_point3( benchmark::State& state )
+{
+  DTransform4 t{ 1.0, 0.0, 0.0, 5.0, 0.0, 1.0, 0.0, 6.0, 0.0, 0.0, 1.0, 7.0 };
+  DPoint3     p{ 1.0, 2.0, 3.0 };
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( t * p );
+  }
+}
+BENCHMARK( bm_dtransform4_times_point3 );
+
+static void bm_dtransform4_multiply( benchmark::State& state )
+{
+  DTransform4 a{ 1.0, 0.0, 0.0, 5.0, 0.0, 1.0, 0.0, 6.0, 0.0, 0.0, 1.0, 7.0 };
+  DTransform4 b{ 0.0, -1.0, 0.0, 1.0, 1.0, 0.0, 0.0, 2.0, 0.0, 0.0, 2.0, 3.0 };
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( a * b );
+  }
+}
+BENCHMARK( bm_dtransform4_multiply );
+
+static void bm_dtransform4_inverse( benchmark::State& state )
+{
+  DTransform4 t{ 1.0, 0.0, 0.0, 5.0, 0.0, 1.0, 0.0, 6.0, 0.0, 0.0, 1.0, 7.0 };
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( inverse( t ) );
+  }
+}
+BENCHMARK( bm_dtransform4_inverse );
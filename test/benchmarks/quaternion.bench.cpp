@@ -0,0 +1,314 @@
+#include "linalg/quaternion.hpp"
+#include "linalg/quaternion_batch.hpp"
+#include "linalg/quaternion_encoding.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+// A skeleton's worth of bones by default; the argument is the number of quaternions.
+std::vector<Quaternion> make_pose( size_t count, float phase )
+{
+  std::vector<Quaternion> pose( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const float angle = static_cast<float>( i ) * 0.37F + phase;
+    const Vec3  axis  = normalized( Vec3{ std::sin( angle ), std::cos( 2.0F * angle ), 0.5F } );
+    pose[i]           = Quaternion{ axis * std::sin( angle / 2.0F ), std::cos( angle / 2.0F ) };
+  }
+  return pose;
+}
+
+// Rotations by every angle in random order, so that the scalar conversion takes its four branches unpredictably.
+std::vector<Mat3> make_rotation_matrices( size_t count )
+{
+  std::vector<Mat3> matrices;
+  for ( Quaternion q : make_pose( count, 0.0F ) )
+  {
+    matrices.push_back( q.get_rotation_matrix() );
+  }
+  std::shuffle( matrices.begin(), matrices.end(), std::mt19937{ 7 } );
+  return matrices;
+}
+
+// Log-like Euler triplets in [-pi, pi) x [-pi/2, pi/2) x [-pi, pi).
+std::vector<Vec3> make_euler( size_t count )
+{
+  std::vector<Vec3>                     euler( count );
+  std::mt19937                          engine( 5 );
+  std::uniform_real_distribution<float> uniform( -1.0F, 1.0F );
+  for ( Vec3& e : euler )
+  {
+    e = Vec3{ 3.14159F * uniform( engine ), 1.5707F * uniform( engine ), 3.14159F * uniform( engine ) };
+  }
+  return euler;
+}
+
+// One million conversions per iteration, the scale of a telemetry import.
+constexpr int64_t euler_count = 1 << 20;
+
+} // namespace
+
+static void bm_scalar_slerp( benchmark::State& state )
+{
+  const auto              a = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  const auto              b = make_pose( a.size(), 1.3F );
+  std::vector<Quaternion> out( a.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != a.size(); ++i )
+    {
+      out[i] = slerp( a[i], b[i], 0.3F );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_slerp )->Arg( 256 )->Arg( 16384 );
+
+template<typename P>
+static void bm_slerp( benchmark::State& state )
+{
+  const auto              a = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  const auto              b = make_pose( a.size(), 1.3F );
+  std::vector<Quaternion> out( a.size() );
+  for ( auto _ : state )
+  {
+    slerp<P>( a, b, 0.3F, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_slerp, Precise )->Arg( 256 )->Arg( 16384 );
+BENCHMARK_TEMPLATE( bm_slerp, Fast )->Arg( 256 )->Arg( 16384 );
+
+static void bm_nlerp( benchmark::State& state )
+{
+  const auto              a = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  const auto              b = make_pose( a.size(), 1.3F );
+  std::vector<Quaternion> out( a.size() );
+  for ( auto _ : state )
+  {
+    nlerp( a, b, 0.3F, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_nlerp )->Arg( 256 )->Arg( 16384 );
+
+static void bm_corrected_nlerp( benchmark::State& state )
+{
+  const auto              a = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  const auto              b = make_pose( a.size(), 1.3F );
+  std::vector<Quaternion> out( a.size() );
+  for ( auto _ : state )
+  {
+    corrected_nlerp( a, b, 0.3F, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_corrected_nlerp )->Arg( 256 )->Arg( 16384 );
+
+static void bm_slerp_soa( benchmark::State& state )
+{
+  const QuaternionBatch a{ make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F ) };
+  const QuaternionBatch b{ make_pose( a.size(), 1.3F ) };
+  QuaternionBatch       out( a.size() );
+  for ( auto _ : state )
+  {
+    slerp( a, b, 0.3F, out );
+    benchmark::DoNotOptimize( out.lane( 0 ).data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_slerp_soa )->Arg( 256 )->Arg( 16384 );
+
+static void bm_encode_quat32( benchmark::State& state )
+{
+  const auto          pose = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  std::vector<Quat32> out( pose.size() );
+  for ( auto _ : state )
+  {
+    encode_quat32( pose, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_encode_quat32 )->Arg( 16384 );
+
+template<typename Encoded>
+static void bm_decode( benchmark::State& state )
+{
+  const auto           pose = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  std::vector<Encoded> packed( pose.size() );
+  if constexpr ( std::same_as<Encoded, Quat32> )
+  {
+    encode_quat32( pose, packed );
+  } else
+  {
+    encode_quat48( pose, packed );
+  }
+  std::vector<Quaternion> out( pose.size() );
+  for ( auto _ : state )
+  {
+    decode( std::span<const Encoded>{ packed }, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_decode, Quat32 )->Arg( 16384 );
+BENCHMARK_TEMPLATE( bm_decode, Quat48 )->Arg( 16384 );
+
+static void bm_scalar_decode_quat32( benchmark::State& state )
+{
+  const auto          pose = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  std::vector<Quat32> packed( pose.size() );
+  encode_quat32( pose, packed );
+  std::vector<Quaternion> out( pose.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != packed.size(); ++i )
+    {
+      out[i] = decode( packed[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_decode_quat32 )->Arg( 16384 );
+
+static void bm_scalar_to_mat4( benchmark::State& state )
+{
+  auto              pose = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  std::vector<Mat4> out( pose.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != pose.size(); ++i )
+    {
+      out[i] = pose[i].to_mat4();
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_to_mat4 )->Arg( 256 )->Arg( 16384 );
+
+template<typename Matrix>
+static void bm_to_matrices( benchmark::State& state )
+{
+  const auto          pose = make_pose( static_cast<size_t>( state.range( 0 ) ), 0.0F );
+  std::vector<Matrix> out( pose.size() );
+  for ( auto _ : state )
+  {
+    to_matrices( pose, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_to_matrices, Mat3 )->Arg( 256 )->Arg( 16384 );
+BENCHMARK_TEMPLATE( bm_to_matrices, Mat4 )->Arg( 256 )->Arg( 16384 );
+
+static void bm_scalar_from_matrices( benchmark::State& state )
+{
+  const auto              matrices = make_rotation_matrices( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Quaternion> out( matrices.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != matrices.size(); ++i )
+    {
+      out[i].set_rotation_from_matrix( matrices[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_from_matrices )->Arg( 256 )->Arg( 16384 );
+
+static void bm_quats_from_matrices( benchmark::State& state )
+{
+  const auto              matrices = make_rotation_matrices( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Quaternion> out( matrices.size() );
+  for ( auto _ : state )
+  {
+    quats_from_matrices( matrices, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_quats_from_matrices )->Arg( 256 )->Arg( 16384 );
+
+static void bm_scalar_quat_from_euler( benchmark::State& state )
+{
+  const auto              euler = make_euler( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Quaternion> out( euler.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != euler.size(); ++i )
+    {
+      out[i] = quat_from_euler( euler[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_quat_from_euler )->Arg( euler_count );
+
+template<typename P>
+static void bm_quats_from_euler( benchmark::State& state )
+{
+  const auto      values = make_euler( static_cast<size_t>( state.range( 0 ) ) );
+  const Vec3Batch euler( values );
+  QuaternionBatch out( values.size() );
+  for ( auto _ : state )
+  {
+    quats_from_euler<P>( euler, out );
+    benchmark::DoNotOptimize( out.lane( 0 ).data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_quats_from_euler, Precise )->Arg( euler_count );
+BENCHMARK_TEMPLATE( bm_quats_from_euler, Fast )->Arg( euler_count );
+
+static void bm_scalar_euler_angles( benchmark::State& state )
+{
+  std::vector<Quaternion> quats;
+  for ( const Vec3& e : make_euler( static_cast<size_t>( state.range( 0 ) ) ) )
+  {
+    quats.push_back( quat_from_euler( e ) );
+  }
+  std::vector<Vec3> out( quats.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != quats.size(); ++i )
+    {
+      out[i] = euler_angles( quats[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_euler_angles )->Arg( euler_count );
+
+template<typename P>
+static void bm_euler_angles( benchmark::State& state )
+{
+  const Vec3Batch euler( make_euler( static_cast<size_t>( state.range( 0 ) ) ) );
+  QuaternionBatch quats;
+  quats_from_euler( euler, quats );
+  Vec3Batch out( euler.size() );
+  for ( auto _ : state )
+  {
+    euler_angles<P>( quats, out );
+    benchmark::DoNotOptimize( out.lane( 0 ).data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_euler_angles, Precise )->Arg( euler_count );
+BENCHMARK_TEMPLATE( bm_euler_angles, Fast )->Arg( euler_count );
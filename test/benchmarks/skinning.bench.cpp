@@ -0,0 +1,129 @@
+#include "linalg/skinning.hpp"
+#include "linalg/transform.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+constexpr int bone_count = 64;
+
+std::vector<DualQuaternion> make_palette()
+{
+  std::vector<DualQuaternion> palette;
+  for ( int b = 0; b != bone_count; ++b )
+  {
+    const float angle = static_cast<float>( b ) * 0.37F;
+    const Vec3  axis  = normalized( Vec3{ std::sin( angle ), std::cos( 2.0F * angle ), 0.5F } );
+    palette.emplace_back(
+      Quaternion{ axis * std::sin( angle / 2.0F ), std::cos( angle / 2.0F ) }, Vec3{ angle, 1.0F, -angle } );
+  }
+  return palette;
+}
+
+// Four influences per vertex; the argument is the number of vertices.
+struct Mesh
+{
+  explicit Mesh( size_t count ) : bones( count ), weights( count ), positions( count ), normals( count )
+  {
+    for ( size_t i = 0; i != count; ++i )
+    {
+      const int   b = static_cast<int>( i * 7 % bone_count );
+      const float f = static_cast<float>( i );
+      bones.set( i, IVec4{ b, ( b + 1 ) % bone_count, ( b + 9 ) % bone_count, ( b + 30 ) % bone_count } );
+      weights.set( i, Vec4{ 0.4F, 0.3F, 0.2F, 0.1F } );
+      positions.set( i, Vec3{ std::sin( f ), std::cos( f ), 0.001F * f } );
+      normals.set( i, Vec3{ 0.0F, 0.0F, 1.0F } );
+    }
+  }
+
+  IVec4Batch  bones;
+  Vec4Batch   weights;
+  Point3Batch positions;
+  Vec3Batch   normals;
+};
+
+} // namespace
+
+// Linear blend skinning with a Transform4 palette, one vertex at a time: the usual scalar baseline.
+static void bm_scalar_linear_blend( benchmark::State& state )
+{
+  std::vector<Transform4> palette;
+  for ( const DualQuaternion& dq : make_palette() )
+  {
+    palette.push_back( dq.to_transform4() );
+  }
+  const Mesh          mesh( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Point3> out( mesh.positions.size() );
+  std::vector<Vec3>   out_normals( mesh.positions.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != out.size(); ++i )
+    {
+      const IVec4 bones   = mesh.bones[i];
+      const Vec4  weights = mesh.weights[i];
+      Mat4        blend   = palette[bones[0]] * weights[0];
+      for ( size_t k = 1; k != 4; ++k )
+      {
+        blend = blend + palette[bones[k]] * weights[k];
+      }
+      const Transform4 t{ blend };
+      out[i]         = t * mesh.positions[i];
+      out_normals[i] = t * mesh.normals[i];
+    }
+    benchmark::DoNotOptimize( out.data() );
+    benchmark::DoNotOptimize( out_normals.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_linear_blend )->Arg( 16384 )->Arg( 262144 );
+
+static void bm_scalar_dual_quaternion( benchmark::State& state )
+{
+  const auto          palette = make_palette();
+  const Mesh          mesh( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Point3> out( mesh.positions.size() );
+  std::vector<Vec3>   out_normals( mesh.positions.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != out.size(); ++i )
+    {
+      const IVec4    bones   = mesh.bones[i];
+      const Vec4     weights = mesh.weights[i];
+      DualQuaternion blend   = weights[0] * palette[bones[0]];
+      for ( size_t k = 1; k != 4; ++k )
+      {
+        const float sign = dot( static_cast<const Vec4&>( palette[bones[0]].real() ),
+                             static_cast<const Vec4&>( palette[bones[k]].real() ) ) < 0.0F
+                             ? -1.0F
+                             : 1.0F;
+        blend = blend + ( sign * weights[k] ) * palette[bones[k]];
+      }
+      blend          = normalized( blend );
+      out[i]         = transform( mesh.positions[i], blend );
+      out_normals[i] = transform( mesh.normals[i], blend );
+    }
+    benchmark::DoNotOptimize( out.data() );
+    benchmark::DoNotOptimize( out_normals.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_scalar_dual_quaternion )->Arg( 16384 )->Arg( 262144 );
+
+static void bm_skin( benchmark::State& state )
+{
+  const auto  palette = make_palette();
+  const Mesh  mesh( static_cast<size_t>( state.range( 0 ) ) );
+  Point3Batch out;
+  Vec3Batch   out_normals;
+  for ( auto _ : state )
+  {
+    skin( palette, mesh.bones, mesh.weights, mesh.positions, mesh.normals, out, out_normals,
+      Threads{ static_cast<size_t>( state.range( 1 ) ) } );
+    benchmark::DoNotOptimize( out.x().data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_skin )->Args( { 16384, 1 } )->Args( { 262144, 1 } )->Args( { 262144, 4 } )->UseRealTime();
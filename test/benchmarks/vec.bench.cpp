@@ -1,6 +1,12 @@
+#include "linalg/grid.hpp"
 #include "linalg/vec.hpp"
+#include "linalg/vec_batch.hpp"
+#include "linalg/vec_expr.hpp"
 #include <benchmark/benchmark.h>
 
+#include <cstdint>
+#include <vector>
+
 using namespace linalg;
 
 static void bm_vec3_dot( benchmark::State& state )
@@ -76,3 +82,73 @@ static void bm_vec4_normalize( benchmark::State& state )
   }
 }
 BENCHMARK( bm_vec4_normalize );
+
+static void bm_vec3_expression_eager( benchmark::State& state )
+{
+  Vec3  v{ 1.0F, 2.0F, 3.0F };
+  Vec3  b{ 0.5F, -0.25F, 0.75F };
+  float c = 0.8F;
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( v );
+    benchmark::DoNotOptimize( ( c * c - dot( b, b ) ) * v + 2.0F * dot( v, b ) * b + 2.0F * c * cross( b, v ) );
+  }
+}
+BENCHMARK( bm_vec3_expression_eager );
+
+static void bm_vec3_expression_lazy( benchmark::State& state )
+{
+  Vec3  v{ 1.0F, 2.0F, 3.0F };
+  Vec3  b{ 0.5F, -0.25F, 0.75F };
+  float c = 0.8F;
+  for ( auto _ : state )
+  {
+    benchmark::DoNotOptimize( v );
+    benchmark::DoNotOptimize(
+      eval( ( c * c - dot( b, b ) ) * lazy( v ) + 2.0F * dot( v, b ) * lazy( b ) + 2.0F * c * lazy( cross( b, v ) ) ) );
+  }
+}
+BENCHMARK( bm_vec3_expression_lazy );
+
+static std::vector<Vec3> make_point_stream( size_t count )
+{
+  std::vector<Vec3> points( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const auto f = static_cast<float>( i );
+    points[i]    = Vec3{ f * 0.37F - 500.0F, 300.0F - f * 0.11F, f * 0.05F };
+  }
+  return points;
+}
+
+// Point to Morton cell key, one point at a time.
+static void bm_voxel_keys_scalar( benchmark::State& state )
+{
+  const auto                 points = make_point_stream( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<std::uint64_t> keys( points.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != points.size(); ++i )
+    {
+      keys[i] = morton_encode( to_cell( points[i], 0.25F ) );
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_voxel_keys_scalar )->Arg( 1 << 16 );
+
+static void bm_voxel_keys_batch( benchmark::State& state )
+{
+  const Vec3Batch            points( make_point_stream( static_cast<size_t>( state.range( 0 ) ) ) );
+  IVec3Batch                 cells;
+  std::vector<std::uint64_t> keys( points.size() );
+  for ( auto _ : state )
+  {
+    to_cells( points, 0.25F, cells );
+    morton_encode( cells, keys );
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_voxel_keys_batch )->Arg( 1 << 16 );
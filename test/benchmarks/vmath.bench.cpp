@@ -0,0 +1,104 @@
+#include "linalg/mat3.hpp"
+#include "linalg/rotation_batch.hpp"
+#include "linalg/vmath.hpp"
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+std::vector<float> make_angles( size_t count )
+{
+  std::vector<float> angles( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    angles[i] = static_cast<float>( i ) * 0.001F - 50.0F;
+  }
+  return angles;
+}
+
+} // namespace
+
+static void bm_std_sincos( benchmark::State& state )
+{
+  const auto         angles = make_angles( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<float> sines( angles.size() );
+  std::vector<float> cosines( angles.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != angles.size(); ++i )
+    {
+      sines[i]   = std::sin( angles[i] );
+      cosines[i] = std::cos( angles[i] );
+    }
+    benchmark::DoNotOptimize( sines.data() );
+    benchmark::DoNotOptimize( cosines.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_std_sincos )->Arg( 1024 );
+
+template<typename P>
+static void bm_sincos( benchmark::State& state )
+{
+  const auto         angles = make_angles( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<float> sines( angles.size() );
+  std::vector<float> cosines( angles.size() );
+  for ( auto _ : state )
+  {
+    sincos<P>( angles, sines, cosines );
+    benchmark::DoNotOptimize( sines.data() );
+    benchmark::DoNotOptimize( cosines.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_sincos, Precise )->Arg( 1024 );
+BENCHMARK_TEMPLATE( bm_sincos, Fast )->Arg( 1024 );
+
+template<typename P>
+static void bm_exp( benchmark::State& state )
+{
+  const auto         in = make_angles( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<float> out( in.size() );
+  for ( auto _ : state )
+  {
+    exp<P>( in, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_exp, Precise )->Arg( 1024 );
+BENCHMARK_TEMPLATE( bm_exp, Fast )->Arg( 1024 );
+
+static void bm_make_rotation_z( benchmark::State& state )
+{
+  const auto             angles = make_angles( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Rotation3> out( angles.size() );
+  for ( auto _ : state )
+  {
+    for ( size_t i = 0; i != angles.size(); ++i )
+    {
+      out[i] = make_rotation_z( angles[i] );
+    }
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK( bm_make_rotation_z )->Arg( 100'000 );
+
+template<typename P>
+static void bm_make_rotations_z( benchmark::State& state )
+{
+  const auto             angles = make_angles( static_cast<size_t>( state.range( 0 ) ) );
+  std::vector<Rotation3> out( angles.size() );
+  for ( auto _ : state )
+  {
+    make_rotations_z<P>( angles, out );
+    benchmark::DoNotOptimize( out.data() );
+  }
+  state.SetItemsProcessed( state.iterations() * state.range( 0 ) );
+}
+BENCHMARK_TEMPLATE( bm_make_rotations_z, Precise )->Arg( 100'000 );
+BENCHMARK_TEMPLATE( bm_make_rotations_z, Fast )->Arg( 100'000 );
@@ -0,0 +1,73 @@
+#include "linalg/dual_quaternion.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+using namespace linalg;
+
+class DualQuaternionTest : public ::testing::Test
+{
+protected:
+  const Transform4 rigid =
+    make_translation( Vec3{ 1.0F, -2.0F, 3.0F } ) * make_rotation4( 0.7F, normalized( Vec3{ 1.0F, 2.0F, 3.0F } ) );
+  const Transform4 other =
+    make_translation( Vec3{ -0.5F, 0.25F, 4.0F } ) * make_rotation4( -2.1F, normalized( Vec3{ 0.0F, 1.0F, -1.0F } ) );
+};
+
+TEST_F( DualQuaternionTest, DefaultIsIdentity )
+{
+  constexpr DualQuaternion identity;
+  static_assert( identity.real() == Quaternion{ 0.0F, 0.0F, 0.0F, 1.0F } );
+  static_assert( identity.get_translation() == Vec3{ 0.0F, 0.0F, 0.0F } );
+  EXPECT_TRUE( are_matrices_equal( identity.to_transform4(), Transform4{ Mat4::identity() }, 0.0F ) );
+}
+
+TEST_F( DualQuaternionTest, RotationAndTranslation )
+{
+  constexpr DualQuaternion dq{ Quaternion{ 0.0F, 0.0F, 0.0F, 1.0F }, Vec3{ 1.0F, 2.0F, 3.0F } };
+  static_assert( dq.get_translation() == Vec3{ 1.0F, 2.0F, 3.0F } );
+
+  const Quaternion rotation{ 0.0F, 0.0F, std::sin( 0.25F * pi ), std::cos( 0.25F * pi ) };
+  const DualQuaternion turned{ rotation, Vec3{ 1.0F, 2.0F, 3.0F } };
+  EXPECT_TRUE( are_vectors_equal( turned.get_translation(), Vec3{ 1.0F, 2.0F, 3.0F }, 1e-6F ) );
+  EXPECT_TRUE( are_vectors_equal(
+    transform( Point3{ 1.0F, 0.0F, 0.0F }, turned ), Point3{ 1.0F, 3.0F, 3.0F }, 1e-6F ) );
+  EXPECT_TRUE( are_vectors_equal( transform( Vec3{ 1.0F, 0.0F, 0.0F }, turned ), Vec3{ 0.0F, 1.0F, 0.0F }, 1e-6F ) );
+}
+
+TEST_F( DualQuaternionTest, Transform4RoundTrip )
+{
+  const DualQuaternion dq = dual_quat_from_transform( rigid );
+  EXPECT_NEAR( magnitude( static_cast<const Vec4&>( dq.real() ) ), 1.0F, 1e-6F );
+  EXPECT_TRUE( are_matrices_equal( dq.to_transform4(), rigid, 1e-5F ) );
+
+  const Point3 p{ 0.3F, 4.0F, -1.0F };
+  EXPECT_TRUE( are_vectors_equal( transform( p, dq ), rigid * p, 1e-5F ) );
+  const Vec3 v{ -2.0F, 0.5F, 1.0F };
+  EXPECT_TRUE( are_vectors_equal( transform( v, dq ), rigid * v, 1e-5F ) );
+}
+
+TEST_F( DualQuaternionTest, CompositionMatchesMatrices )
+{
+  const DualQuaternion a = dual_quat_from_transform( rigid );
+  const DualQuaternion b = dual_quat_from_transform( other );
+  EXPECT_TRUE( are_matrices_equal( ( a * b ).to_transform4(), rigid * other, 1e-5F ) );
+  EXPECT_TRUE( are_matrices_equal( ( b * a ).to_transform4(), other * rigid, 1e-5F ) );
+
+  const DualQuaternion round_trip = a * inverse( a );
+  EXPECT_TRUE( are_matrices_equal( round_trip.to_transform4(), Transform4{ Mat4::identity() }, 1e-6F ) );
+}
+
+TEST_F( DualQuaternionTest, NormalizedBlendStaysRigid )
+{
+  const DualQuaternion a     = dual_quat_from_transform( rigid );
+  const DualQuaternion b     = dual_quat_from_transform( other );
+  const DualQuaternion blend = normalized( 0.3F * a + 0.7F * b );
+  EXPECT_NEAR( magnitude( static_cast<const Vec4&>( blend.real() ) ), 1.0F, 1e-6F );
+  const Point3 p{ 0.3F, 4.0F, -1.0F };
+  const Point3 q{ -2.0F, 1.0F, 0.5F };
+  EXPECT_NEAR( magnitude( transform( p, blend ) - transform( q, blend ) ), magnitude( p - q ), 1e-5F );
+
+  EXPECT_TRUE( are_matrices_equal( normalized( 2.0F * a ).to_transform4(), rigid, 1e-5F ) );
+}
@@ -0,0 +1,126 @@
+#include "linalg/fma.hpp"
+#include "linalg/mat4.hpp"
+#include "linalg/transform.hpp"
+#include "linalg/vec.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+using namespace linalg;
+
+// x * x = 1 + 2^-11 + 2^-24 needs 25 significant bits. Fused keeps the 2^-24 when the rest cancels; Separate rounds it
+// away first.
+class FmaTest : public ::testing::Test
+{
+protected:
+  static constexpr float x        = 1.0F + 0x1p-12F;
+  static constexpr float rounded  = 1.0F + 0x1p-11F;
+  static constexpr float residual = 0x1p-24F;
+
+  // { a, b, c, madd<Fused>( a, b, c ) } for scattered a and b, with c close to -a * b so that the sum cancels.
+  template<typename T>
+  static constexpr std::array<std::array<T, 4>, 64> fused_cases()
+  {
+    const auto operand = []( size_t i, size_t k ) {
+      return 1.0 + static_cast<double>( ( i * 2'654'435'761U + k * 40'503U ) % 1'000'003U ) / 1'000'003.0;
+    };
+    std::array<std::array<T, 4>, 64> cases{};
+    for ( size_t i = 0; i != cases.size(); ++i )
+    {
+      const T a = static_cast<T>( operand( i, 0 ) );
+      const T b = static_cast<T>( -operand( i, 1 ) );
+      const T c = static_cast<T>( operand( i, 0 ) * operand( i, 1 ) );
+      cases[i]  = { a, b, c, madd<Fused>( a, b, c ) };
+    }
+    return cases;
+  }
+};
+
+TEST_F( FmaTest, ScalarMadd )
+{
+  EXPECT_EQ( madd<Fused>( x, x, -rounded ), residual );
+  EXPECT_EQ( madd<Separate>( x, x, -rounded ), 0.0F );
+  EXPECT_EQ( madd<Fused>( 3, 4, 5 ), 17 );
+
+  static_assert( madd<Fused>( x, x, -rounded ) == residual );
+  static_assert( madd<Separate>( x, x, -rounded ) == 0.0F );
+}
+
+TEST_F( FmaTest, ConstantEvaluationRoundsOnce )
+{
+  // 1 + 2^-23 + 2^-24 - 2^-70 lies just below a float midpoint. Summed in double it would round onto the midpoint and
+  // then to the even neighbour.
+  constexpr float a = 0x1p-12F + 0x1p-35F;
+  constexpr float b = 0x1p-12F - 0x1p-35F;
+  constexpr float c = 1.0F + 0x1p-23F;
+  static_assert( madd<Fused>( a, b, c ) == c );
+  EXPECT_EQ( std::fma( a, b, c ), c );
+
+  constexpr double y = 1.0 + 0x1p-30;
+  static_assert( madd<Fused>( y, y, -( 1.0 + 0x1p-29 ) ) == 0x1p-60 );
+  static_assert( madd<Separate>( y, y, -( 1.0 + 0x1p-29 ) ) == 0.0 );
+
+  // Folded at compile time, the cases must still equal std::fma bit for bit.
+  constexpr auto floats  = fused_cases<float>();
+  constexpr auto doubles = fused_cases<double>();
+  for ( size_t i = 0; i != floats.size(); ++i )
+  {
+    const auto& [fa, fb, fc, f] = floats[i];
+    const auto& [da, db, dc, d] = doubles[i];
+    EXPECT_EQ( std::bit_cast<std::uint32_t>( f ), std::bit_cast<std::uint32_t>( std::fma( fa, fb, fc ) ) ) << i;
+    EXPECT_EQ( std::bit_cast<std::uint64_t>( d ), std::bit_cast<std::uint64_t>( std::fma( da, db, dc ) ) ) << i;
+  }
+}
+
+TEST_F( FmaTest, Dot )
+{
+  const Vec3 a{ 1.0F, x, 0.0F };
+  const Vec3 b{ -rounded, x, 0.0F };
+  EXPECT_EQ( dot<Fused>( a, b ), residual );
+  EXPECT_EQ( dot<Separate>( a, b ), 0.0F );
+
+  const Vec4 c{ 1.0F, 0.0F, x, 0.0F };
+  const Vec4 d{ -rounded, 0.0F, x, 0.0F };
+  EXPECT_EQ( dot<Fused>( c, d ), residual );
+  EXPECT_EQ( dot<Separate>( c, d ), 0.0F );
+  EXPECT_EQ( magnitude_squared<Separate>( c ), dot<Separate>( c, c ) );
+
+  static_assert( dot<Fused>( Vec3{ 1.0F, x, 0.0F }, Vec3{ -rounded, x, 0.0F } ) == residual );
+}
+
+TEST_F( FmaTest, MatrixVector )
+{
+  Mat4 m;
+  m( 0, 0 ) = -rounded;
+  m( 0, 1 ) = x;
+  const Vec4 v{ 1.0F, x, 0.0F, 0.0F };
+  EXPECT_EQ( multiply<Fused>( m, v ).x(), residual );
+  EXPECT_EQ( multiply<Separate>( m, v ).x(), 0.0F );
+
+  const Mat4 right{ Vec4{ 1.0F, x, 0.0F, 0.0F }, Vec4{}, Vec4{}, Vec4{} };
+  EXPECT_EQ( multiply<Fused>( m, right )( 0, 0 ), residual );
+  EXPECT_EQ( multiply<Separate>( m, right )( 0, 0 ), 0.0F );
+}
+
+TEST_F( FmaTest, TransformPoint )
+{
+  const Transform4 t{ -rounded, x, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 0.0F, 0.0F, 1.0F, 0.0F };
+  const Point3     p{ 1.0F, x, 0.0F };
+  EXPECT_EQ( multiply<Fused>( t, p ).x(), residual );
+  EXPECT_EQ( multiply<Separate>( t, p ).x(), 0.0F );
+  EXPECT_EQ( multiply<Fused>( t, Vec3{ p } ).x(), residual );
+}
+
+TEST_F( FmaTest, OperatorsUseDefaultPolicy )
+{
+  const Mat4 a{ 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F, 8.0F, 9.0F, 10.0F, 11.0F, 12.0F, 13.0F, 14.0F, 15.0F, 16.0F };
+  const Vec4 v{ 0.1F, -0.3F, 0.7F, 1.1F };
+  EXPECT_EQ( a * v, multiply<DefaultFma>( a, v ) );
+  EXPECT_TRUE( are_matrices_equal( a * a, multiply<DefaultFma>( a, a ), 0.0F ) );
+  EXPECT_EQ( dot( v, v ), dot<DefaultFma>( v, v ) );
+}
@@ -0,0 +1,73 @@
+#include "linalg/grid.hpp"
+#include "linalg/vec.hpp"
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <unordered_set>
+
+using namespace linalg;
+
+class GridTest : public ::testing::Test
+{
+};
+
+TEST_F( GridTest, ToCellRoundsTowardsNegativeInfinity )
+{
+  EXPECT_EQ( to_cell( Vec3{ 0.0F, 0.99F, 1.0F }, 1.0F ), ( IVec3{ 0, 0, 1 } ) );
+  EXPECT_EQ( to_cell( Vec3{ -0.01F, -1.0F, -1.5F }, 1.0F ), ( IVec3{ -1, -1, -2 } ) );
+  EXPECT_EQ( to_cell( Vec3{ 2.5F, -2.5F, 7.4F }, 2.5F ), ( IVec3{ 1, -1, 2 } ) );
+  EXPECT_EQ( to_cell( Vec2{ 3.0F, -3.0F }, 2.0F ), ( Vec<int, 2>{ 1, -2 } ) );
+}
+
+TEST_F( GridTest, MortonInterleavesBits )
+{
+  static_assert( morton_encode( IVec3{ 1, 0, 0 } ) == 1 );
+  static_assert( morton_encode( IVec3{ 0, 1, 0 } ) == 2 );
+  static_assert( morton_encode( IVec3{ 0, 0, 1 } ) == 4 );
+  static_assert( morton_encode( IVec3{ 3, 0, 0 } ) == 9 );
+  EXPECT_EQ( morton_encode( IVec3{ 1, 1, 1 } ), 7U );
+  EXPECT_EQ( morton_encode( IVec3{ 5, 0, 2 } ), 0b1'100'001U );
+  EXPECT_EQ( morton_encode( IVec3{ 0x1f'ffff, 0x1f'ffff, 0x1f'ffff } ), ( std::uint64_t{ 1 } << 63 ) - 1 );
+  EXPECT_EQ( morton_encode( IVec3{ 0, 0, -1 } ), 0x4924'9249'2492'4924ULL );
+}
+
+TEST_F( GridTest, MortonRoundTrip )
+{
+  constexpr int limit = 1 << 20;
+  for ( const IVec3& cell : { IVec3{ 0, 0, 0 },
+          IVec3{ 17, -4, 1'000'000 },
+          IVec3{ limit - 1, -limit, 12'345 },
+          IVec3{ -1, -2, -3 } } )
+  {
+    EXPECT_EQ( morton_decode( morton_encode( cell ) ), cell );
+  }
+  static_assert( morton_decode( morton_encode( IVec3{ -7, 8, 9 } ) ) == IVec3{ -7, 8, 9 } );
+}
+
+TEST_F( GridTest, CellHash )
+{
+  const std::hash<IVec3>          hasher;
+  std::unordered_set<std::size_t> hashes;
+  std::unordered_set<std::size_t> low_bits;
+  for ( int x = -8; x != 8; ++x )
+  {
+    for ( int y = -8; y != 8; ++y )
+    {
+      for ( int z = -8; z != 8; ++z )
+      {
+        const std::size_t h = hasher( IVec3{ x, y, z } );
+        hashes.insert( h );
+        low_bits.insert( h & 0xffff );
+      }
+    }
+  }
+  // 4096 neighbouring cells: no full collisions, and the low 16 bits as spread as random values would be.
+  EXPECT_EQ( hashes.size(), 4096U );
+  EXPECT_GT( low_bits.size(), 3900U );
+
+  std::unordered_set<IVec4> cells{ IVec4{ 1, 2, 3, 4 }, IVec4{ 4, 3, 2, 1 } };
+  EXPECT_TRUE( cells.contains( IVec4{ 4, 3, 2, 1 } ) );
+  EXPECT_FALSE( cells.contains( IVec4{ 1, 2, 3, 5 } ) );
+}
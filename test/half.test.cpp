@@ -0,0 +1,89 @@
+#include "linalg/half.hpp"
+#include "linalg/vec.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+using namespace linalg;
+
+class HalfTest : public ::testing::Test
+{
+protected:
+  static constexpr float infinity = std::numeric_limits<float>::infinity();
+};
+
+TEST_F( HalfTest, HalfRoundTrip )
+{
+  EXPECT_EQ( Half( 1.0F ).bits(), 0x3c00 );
+  EXPECT_EQ( Half( -2.0F ).bits(), 0xc000 );
+  EXPECT_EQ( Half( 65504.0F ).bits(), 0x7bff );
+  EXPECT_EQ( Half( -0.0F ).bits(), 0x8000 );
+
+  for ( float value : { 0.0F, 1.0F, -0.5F, 3.140625F, 65504.0F, 0x1p-14F, 0x1p-24F } )
+  {
+    EXPECT_EQ( static_cast<float>( Half( value ) ), value );
+  }
+  static_assert( static_cast<float>( Half( 0.25F ) ) == 0.25F );
+}
+
+TEST_F( HalfTest, HalfRoundsToNearestEven )
+{
+  // The half spacing just above 1 is 2^-10; halfway cases go to the even mantissa.
+  EXPECT_EQ( Half( 1.0F + 0x1p-11F ).bits(), 0x3c00 );
+  EXPECT_EQ( Half( 1.0F + 3 * 0x1p-11F ).bits(), 0x3c02 );
+  EXPECT_EQ( Half( 1.0F + 0x1p-11F + 0x1p-20F ).bits(), 0x3c01 );
+
+  // Subnormals: the smallest is 2^-24 and half of it rounds to zero.
+  EXPECT_EQ( Half( 0x1p-24F ).bits(), 0x0001 );
+  EXPECT_EQ( Half( 0x1p-25F ).bits(), 0x0000 );
+  EXPECT_EQ( Half( 0x1.8p-24F ).bits(), 0x0002 );
+  EXPECT_EQ( Half( 0x1p-15F ).bits(), 0x0200 );
+}
+
+TEST_F( HalfTest, HalfSpecialValues )
+{
+  EXPECT_EQ( Half( 65520.0F ).bits(), 0x7c00 );
+  EXPECT_EQ( Half( 65519.0F ).bits(), 0x7bff );
+  EXPECT_EQ( Half( infinity ).bits(), 0x7c00 );
+  EXPECT_EQ( Half( -infinity ).bits(), 0xfc00 );
+  EXPECT_EQ( static_cast<float>( Half::from_bits( 0x7c00 ) ), infinity );
+  EXPECT_TRUE( std::isnan( static_cast<float>( Half( std::numeric_limits<float>::quiet_NaN() ) ) ) );
+  EXPECT_TRUE( std::isnan( static_cast<float>( Half::from_bits( 0x7c01 ) ) ) );
+}
+
+TEST_F( HalfTest, BFloat16 )
+{
+  EXPECT_EQ( BFloat16( 1.0F ).bits(), 0x3f80 );
+  EXPECT_EQ( static_cast<float>( BFloat16( -3.5F ) ), -3.5F );
+  EXPECT_EQ( BFloat16( 1e30F ).bits(), 0x714a );
+
+  // 1 + 2^-8 is halfway between 1 and 1 + 2^-7.
+  EXPECT_EQ( BFloat16( 1.0F + 0x1p-8F ).bits(), 0x3f80 );
+  EXPECT_EQ( BFloat16( 1.0F + 3 * 0x1p-8F ).bits(), 0x3f82 );
+  EXPECT_EQ( BFloat16( std::numeric_limits<float>::max() ).bits(), 0x7f80 );
+  EXPECT_EQ( BFloat16( infinity ).bits(), 0x7f80 );
+
+  // A NaN whose payload sits in the dropped bits must stay a NaN.
+  EXPECT_TRUE( std::isnan( static_cast<float>( BFloat16( std::bit_cast<float>( 0x7f80'0001U ) ) ) ) );
+}
+
+TEST_F( HalfTest, StorageVectors )
+{
+  static_assert( sizeof( HVec3 ) == 6 && sizeof( HVec4 ) == 8 && sizeof( BF16Vec4 ) == 8 );
+
+  const Vec3  v{ 1.0F, -2.5F, 0.125F };
+  const HVec3 h = vec_cast<Half>( v );
+  EXPECT_EQ( h[1], Half( -2.5F ) );
+  EXPECT_TRUE( are_vectors_equal( vec_cast<float>( h ), v, 0.0F ) );
+  EXPECT_EQ( static_cast<std::string>( h ), static_cast<std::string>( v ) );
+
+  std::vector<BF16Vec4> stored( 3, vec_cast<BFloat16>( Vec4{ 1.0F, 2.0F, 3.0F, 4.0F } ) );
+  stored.push_back( BF16Vec4{} );
+  EXPECT_EQ( stored.size(), 4 );
+  EXPECT_EQ( vec_cast<float>( stored[2] ), ( Vec4{ 1.0F, 2.0F, 3.0F, 4.0F } ) );
+  EXPECT_EQ( vec_cast<float>( stored[3] ), Vec4{} );
+  EXPECT_EQ( stored[0], stored[1] );
+}
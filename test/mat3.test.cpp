@@ -6,6 +6,24 @@
 
 using namespace linalg;
 
+namespace {
+
+template<typename M>
+concept MutableElements = requires( M m ) {
+  m( 0, 0 ) = 2.0F;
+  m[0]      = Vec3{};
+};
+
+template<typename M>
+concept MutableInPlace = requires( M m, const Mat3& other ) {
+  m *= 2.0F;
+  m /= 2.0F;
+  m += other;
+  m -= other;
+};
+
+} // namespace
+
 class Mat3Test : public ::testing::Test
 {
 protected:
@@ -268,6 +286,30 @@ TEST_F( Mat3Test, GeneralRotation )
   EXPECT_TRUE( are_matrices_equal( result, expected ) );
 }
 
+TEST_F( Mat3Test, RotationInverseIsTranspose )
+{
+  const Rotation3 rot = make_rotation( 0.9F, normalized( Vec3{ 1.0F, -2.0F, 0.5F } ) );
+  const Rotation3 inv = inverse( rot );
+  EXPECT_TRUE( are_matrices_equal( inv, inverse( Mat3{ rot } ), 1e-5F ) );
+  EXPECT_TRUE( are_matrices_equal( rot * inv, Mat3::identity(), 1e-6F ) );
+
+  const Rotation3 composed = make_rotation_x( 0.3F ) * make_rotation_z( -1.1F );
+  EXPECT_TRUE( are_matrices_equal( inverse( composed ) * composed, Mat3::identity(), 1e-6F ) );
+  EXPECT_TRUE( are_matrices_equal( Rotation3{}, Mat3::identity() ) );
+}
+
+// A Rotation3 cannot be modified in place, which would make its transpose inverse wrong; a modified copy is a Mat3.
+TEST_F( Mat3Test, RotationIsNotMutable )
+{
+  static_assert( MutableElements<Mat3> && MutableInPlace<Mat3> );
+  static_assert( !MutableElements<Rotation3> && !MutableInPlace<Rotation3> );
+
+  Mat3 scaled = make_rotation( 0.9F, normalized( Vec3{ 1.0F, -2.0F, 0.5F } ) );
+  scaled *= 2.0F;
+  EXPECT_TRUE( are_matrices_equal( scaled * inverse( scaled ), Mat3::identity(), 1e-6F ) );
+  EXPECT_FLOAT_EQ( ( make_rotation_x( 0.3F ) * 2.0F )( 0, 0 ), 2.0F );
+}
+
 TEST_F( Mat3Test, ReflectionMatrix )
 {
   Vec3 inv{ 1.0F, 0.0F, 0.0F };
@@ -352,3 +394,15 @@ TEST_F( Mat3Test, NonZeroAngleSkew )
   EXPECT_FLOAT_EQ( output_vec.y(), tan );
   EXPECT_FLOAT_EQ( output_vec.z(), 0.0F );
 }
+
+TEST_F( Mat3Test, DoublePrecision )
+{
+  const DMat3 m{ 2.0, 0.5, -1.0, 0.25, 1.5, 0.0, 1.0, -0.5, 3.0 };
+  EXPECT_TRUE( are_matrices_equal( m * inverse( m ), DMat3::identity(), 1e-14F ) );
+
+  const double     angle = std::numbers::pi / 3.0;
+  const DRotation3 rot   = make_rotation( angle, DVec3{ 0.0, 0.0, 1.0 } );
+  const DRotation3 rot_z = make_rotation_z<double>( angle );
+  EXPECT_TRUE( are_matrices_equal( rot, rot_z, 1e-15F ) );
+  EXPECT_TRUE( are_matrices_equal( rot * inverse( rot ), DMat3::identity(), 1e-15F ) );
+}
@@ -280,3 +280,36 @@ TEST_F( Mat4Test, ConstructFromMat )
   EXPECT_FLOAT_EQ( mat( 2, 2 ), 3.0F );
   EXPECT_FLOAT_EQ( mat( 3, 3 ), 4.0F );
 }
+
+TEST_F( Mat4Test, DoubleProductMatchesFloat )
+{
+  const DMat4 a{ 1.0, 2.0, 3.0, 4.0, 6.0, 7.0, 8.0, 9.0, 5.0, 5.0, 5.0, 5.0, 0.0, 0.0, 0.0, 0.0 };
+  const DMat4 b{ 0.0, 0.0, 0.0, 0.0, 6.0, 7.0, 8.0, 9.0, 5.0, 5.0, 5.0, 5.0, 1.0, 2.0, 3.0, 4.0 };
+  const Mat4  af{ 1.0F, 2.0F, 3.0F, 4.0F, 6.0F, 7.0F, 8.0F, 9.0F, 5.0F, 5.0F, 5.0F, 5.0F, 0.0F, 0.0F, 0.0F, 0.0F };
+  const Mat4  bf{ 0.0F, 0.0F, 0.0F, 0.0F, 6.0F, 7.0F, 8.0F, 9.0F, 5.0F, 5.0F, 5.0F, 5.0F, 1.0F, 2.0F, 3.0F, 4.0F };
+
+  const DMat4 product  = a * b;
+  const Mat4  expected = af * bf;
+  const DVec4 column   = a * DVec4{ 1.0, 2.0, 3.0, 4.0 };
+  const DMat4 flipped  = transpose( a );
+  for ( size_t i = 0; i != 4; ++i )
+  {
+    for ( size_t j = 0; j != 4; ++j )
+    {
+      EXPECT_DOUBLE_EQ( product( i, j ), static_cast<double>( expected( i, j ) ) );
+      EXPECT_DOUBLE_EQ( flipped( i, j ), a( j, i ) );
+    }
+  }
+  EXPECT_EQ( column, ( DVec4{ 30.0, 80.0, 50.0, 0.0 } ) );
+}
+
+TEST_F( Mat4Test, DoubleInverseMatchesScalarPath )
+{
+  // Constant evaluation always takes the scalar path, so this checks the 256-bit kernel when it is enabled.
+  constexpr DMat4 m{ 2.0, 0.5, -1.0, 3.0, 0.25, 1.5, 0.0, -2.0, 1.0, -0.5, 3.0, 0.75, 0.5, 0.25, -0.125, 1.0 };
+  constexpr DMat4 expected = inverse( m );
+
+  const DMat4 inv = inverse( m );
+  EXPECT_TRUE( are_matrices_equal( inv, expected, 1e-14F ) );
+  EXPECT_TRUE( are_matrices_equal( m * inv, DMat4::identity(), 1e-12F ) );
+}
@@ -0,0 +1,198 @@
+#include "linalg/mat3.hpp"
+#include "linalg/math.hpp"
+#include "linalg/projection.hpp"
+#include "linalg/quaternion.hpp"
+#include "linalg/transform.hpp"
+#include "linalg/vec.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+constexpr size_t sample_count = 512;
+
+// Arguments from -20 to 20 with irregular spacing.
+template<typename T>
+constexpr std::array<T, sample_count> arguments()
+{
+  std::array<T, sample_count> result{};
+  for ( size_t i = 0; i != sample_count; ++i )
+  {
+    result[i] = static_cast<T>( -20.0 + 40.0 * static_cast<double>( i * i % 1021 ) / 1021.0 ) + static_cast<T>( 1e-3 );
+  }
+  return result;
+}
+
+// f over the arguments; called from constant expressions, so f runs its compile-time path.
+template<typename T, typename F>
+constexpr std::array<T, sample_count> evaluate( F f )
+{
+  std::array<T, sample_count> result{};
+  for ( size_t i = 0; i != sample_count; ++i )
+  {
+    result[i] = f( arguments<T>()[i] );
+  }
+  return result;
+}
+
+// Distance in representable values between two finite floats of the same sign.
+template<typename T>
+int ulps_apart( T a, T b )
+{
+  int count = 0;
+  for ( T x = std::min( a, b ); x < std::max( a, b ) && count < 100; x = std::nextafter( x, b > a ? b : a ) )
+  {
+    ++count;
+  }
+  return count;
+}
+
+} // namespace
+
+class MathTest : public ::testing::Test
+{
+protected:
+  template<typename T, typename G>
+  static void expect_within_ulps( const std::array<T, sample_count>& values, G reference, int ulps )
+  {
+    const auto args = arguments<T>();
+    for ( size_t i = 0; i != sample_count; ++i )
+    {
+      const T expected = reference( args[i] );
+      if ( std::signbit( expected ) != std::signbit( values[i] ) )
+      {
+        EXPECT_NEAR( values[i], expected, std::numeric_limits<T>::epsilon() ) << args[i];
+      } else
+      {
+        EXPECT_LE( ulps_apart( values[i], expected ), ulps ) << args[i];
+      }
+    }
+  }
+};
+
+TEST_F( MathTest, SqrtIsCorrectlyRounded )
+{
+  constexpr auto roots       = evaluate<double>( []( double x ) { return linalg::sqrt( x * x * 3.7 ); } );
+  constexpr auto float_roots = evaluate<float>( []( float x ) { return linalg::sqrt( std::abs( x ) ); } );
+  const auto     args        = arguments<double>();
+  const auto     float_args  = arguments<float>();
+  for ( size_t i = 0; i != sample_count; ++i )
+  {
+    EXPECT_EQ( roots[i], std::sqrt( args[i] * args[i] * 3.7 ) );
+    EXPECT_EQ( float_roots[i], std::sqrt( std::abs( float_args[i] ) ) );
+  }
+
+  static_assert( linalg::sqrt( 4.0 ) == 2.0 && linalg::sqrt( 0.25F ) == 0.5F && linalg::sqrt( 16 ) == 4.0 );
+  static_assert( linalg::sqrt( 0.0 ) == 0.0 );
+  static_assert( linalg::sqrt( 0x1p-1074 ) == 0x1p-537 );
+  static_assert( linalg::sqrt( -1.0 ) != linalg::sqrt( -1.0 ) );
+}
+
+TEST_F( MathTest, TrigWithinAnUlp )
+{
+  constexpr auto sines   = evaluate<double>( []( double x ) { return linalg::sin( x ); } );
+  constexpr auto cosines = evaluate<double>( []( double x ) { return linalg::cos( x ); } );
+  constexpr auto tangent = evaluate<double>( []( double x ) { return linalg::tan( x ); } );
+  expect_within_ulps( sines, []( double x ) { return std::sin( x ); }, 1 );
+  expect_within_ulps( cosines, []( double x ) { return std::cos( x ); }, 1 );
+  expect_within_ulps( tangent, []( double x ) { return std::tan( x ); }, 3 );
+
+  constexpr auto float_sines   = evaluate<float>( []( float x ) { return linalg::sin( x ); } );
+  constexpr auto float_tangent = evaluate<float>( []( float x ) { return linalg::tan( x ); } );
+  expect_within_ulps( float_sines, []( float x ) { return std::sin( x ); }, 1 );
+  expect_within_ulps( float_tangent, []( float x ) { return std::tan( x ); }, 1 );
+
+  static_assert( linalg::sin( 0.0 ) == 0.0 && linalg::cos( 0.0F ) == 1.0F && linalg::tan( 0.0 ) == 0.0 );
+  static_assert( linalg::cos( std::numbers::pi ) == -1.0 );
+  constexpr double inf = std::numeric_limits<double>::infinity();
+  static_assert( linalg::sin( inf ) != linalg::sin( inf ) && linalg::sqrt( inf ) == inf );
+}
+
+// The bounds in math.hpp, measured against long double. The compile-time kernels are called directly, which runs the
+// same code as constant evaluation.
+TEST_F( MathTest, TrigErrorBounds )
+{
+  if ( std::numeric_limits<long double>::digits < 64 )
+  {
+    GTEST_SKIP() << "long double is not wider than double";
+  }
+  const auto ulp_error = []( double value, long double exact ) {
+    const double rounded = std::abs( static_cast<double>( exact ) );
+    const double ulp     = std::nextafter( rounded, std::numeric_limits<double>::infinity() ) - rounded;
+    return static_cast<double>( std::abs( static_cast<long double>( value ) - exact ) / ulp );
+  };
+
+  // Scattered arguments up to 1e6, plus the worst tangent argument found by a longer search (2.18 ulp).
+  std::vector<double> args{ 0x1.1c974c3eb8024p+18 };
+  for ( size_t i = 1; i != 100'000; ++i )
+  {
+    const double t = static_cast<double>( i * 2'654'435'761U % 1'000'003U ) / 1'000'003.0 - 0.5;
+    args.push_back( i % 2 == 0 ? 8.0 * t : 2e6 * t );
+  }
+  double sin_error = 0.0;
+  double cos_error = 0.0;
+  double tan_error = 0.0;
+  for ( const double x : args )
+  {
+    const auto wide = static_cast<long double>( x );
+    sin_error       = std::max( sin_error, ulp_error( detail::constexpr_sin( x, 0 ), std::sin( wide ) ) );
+    cos_error       = std::max( cos_error, ulp_error( detail::constexpr_sin( x, 1 ), std::cos( wide ) ) );
+    tan_error       = std::max( tan_error, ulp_error( detail::constexpr_tan( x ), std::tan( wide ) ) );
+  }
+  EXPECT_LE( sin_error, 0.8 );
+  EXPECT_LE( cos_error, 0.8 );
+  EXPECT_LE( tan_error, 2.2 );
+}
+
+TEST_F( MathTest, ConstexprFactories )
+{
+  constexpr float     angle = std::numbers::pi_v<float> / 3.0F;
+  constexpr Vec3      axis  = normalized( Vec3{ 1.0F, 2.0F, 2.0F } );
+  constexpr Rotation3 x     = make_rotation_x( angle );
+  constexpr Rotation3 about = make_rotation( angle, axis );
+  constexpr Rotation4 r4    = make_rotation4( angle, axis );
+  constexpr Mat3      skew  = make_skew( angle, Vec3{ 1.0F, 0.0F, 0.0F }, Vec3{ 0.0F, 1.0F, 0.0F } );
+  EXPECT_TRUE( are_matrices_equal( x, make_rotation_x( angle ) ) );
+  EXPECT_TRUE( are_matrices_equal( about, make_rotation( angle, axis ) ) );
+  EXPECT_TRUE( are_matrices_equal( r4, make_rotation4( angle, axis ) ) );
+  EXPECT_TRUE( are_matrices_equal( skew, make_skew( angle, Vec3{ 1.0F, 0.0F, 0.0F }, Vec3{ 0.0F, 1.0F, 0.0F } ) ) );
+  static_assert( magnitude( Vec3{ 3.0F, 4.0F, 12.0F } ) == 13.0F );
+  static_assert( is_unit_vector( axis ) );
+
+  constexpr Vec3  eye{ 1.0F, 2.0F, 5.0F };
+  constexpr Vec3  up{ 0.0F, 1.0F, 0.0F };
+  constexpr float fovy       = std::numbers::pi_v<float> / 4.0F;
+  constexpr Mat4  view       = look_at( eye, Vec3{}, up );
+  constexpr Mat4  projection = perspective( fovy, 16.0F / 9.0F, 0.1F, 100.0F );
+  EXPECT_TRUE( are_matrices_equal( view, look_at( eye, Vec3{}, up ) ) );
+  EXPECT_TRUE( are_matrices_equal( projection, perspective( fovy, 16.0F / 9.0F, 0.1F, 100.0F ) ) );
+
+  constexpr Quaternion q = quat_from_euler( Vec3{ 0.1F, 0.2F, 0.3F } );
+  EXPECT_TRUE( are_vectors_equal( q, quat_from_euler( Vec3{ 0.1F, 0.2F, 0.3F } ) ) );
+}
+
+// A table of canonical orientations built entirely at compile time.
+TEST_F( MathTest, ConstexprRotationTable )
+{
+  constexpr auto table = [] {
+    std::array<Rotation3, 8> rotations{};
+    for ( size_t i = 0; i != rotations.size(); ++i )
+    {
+      rotations[i] = make_rotation_z( static_cast<float>( i ) * std::numbers::pi_v<float> / 4.0F );
+    }
+    return rotations;
+  }();
+  for ( size_t i = 0; i != table.size(); ++i )
+  {
+    EXPECT_TRUE( are_matrices_equal( table[i], make_rotation_z( static_cast<float>( i ) * pi / 4.0F ) ) );
+  }
+}
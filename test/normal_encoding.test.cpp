@@ -0,0 +1,101 @@
+#include "linalg/normal_encoding.hpp"
+#include "linalg/vec.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+using namespace linalg;
+
+class NormalEncodingTest : public ::testing::Test
+{
+protected:
+  // Points of a Fibonacci lattice, which covers the sphere evenly.
+  static std::vector<Vec3> sphere( size_t count )
+  {
+    const double      golden_angle = std::numbers::pi * ( 3.0 - std::sqrt( 5.0 ) );
+    std::vector<Vec3> result( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      const double z = 1.0 - 2.0 * ( static_cast<double>( i ) + 0.5 ) / static_cast<double>( count );
+      const double r = std::sqrt( 1.0 - z * z );
+      const double a = golden_angle * static_cast<double>( i );
+      result[i] = normalized( Vec3{ static_cast<float>( r * std::cos( a ) ),
+        static_cast<float>( r * std::sin( a ) ),
+        static_cast<float>( z ) } );
+    }
+    return result;
+  }
+
+  static double degrees_between( const Vec3& a, const Vec3& b )
+  {
+    const DVec3 da = vec_cast<double>( a );
+    const DVec3 db = vec_cast<double>( b );
+    return std::atan2( magnitude( cross( da, db ) ), dot( da, db ) ) * 180.0 / std::numbers::pi;
+  }
+
+  template<typename Encode>
+  static double max_error( Encode encode )
+  {
+    double worst = 0.0;
+    for ( const Vec3& n : sphere( 50'000 ) )
+    {
+      worst = std::max( worst, degrees_between( n, decode( encode( n ) ) ) );
+    }
+    return worst;
+  }
+};
+
+TEST_F( NormalEncodingTest, Sizes )
+{
+  static_assert( sizeof( Oct32 ) == 4 && sizeof( Oct16 ) == 2 && sizeof( Snorm10x3 ) == 4 );
+}
+
+TEST_F( NormalEncodingTest, AxesRoundTripExactly )
+{
+  const std::array<Vec3, 6> axes{ Vec3{ 1.0F, 0.0F, 0.0F },
+    Vec3{ -1.0F, 0.0F, 0.0F },
+    Vec3{ 0.0F, 1.0F, 0.0F },
+    Vec3{ 0.0F, -1.0F, 0.0F },
+    Vec3{ 0.0F, 0.0F, 1.0F },
+    Vec3{ 0.0F, 0.0F, -1.0F } };
+  for ( const Vec3& axis : axes )
+  {
+    EXPECT_TRUE( are_vectors_equal( decode( encode_oct32( axis ) ), axis, 0.0F ) );
+    EXPECT_TRUE( are_vectors_equal( decode( encode_oct16( axis ) ), axis, 0.0F ) );
+    EXPECT_TRUE( are_vectors_equal( decode( encode_snorm10x3( axis ) ), axis, 0.0F ) );
+  }
+}
+
+TEST_F( NormalEncodingTest, Layout )
+{
+  EXPECT_EQ( encode_oct32( Vec3{ 0.0F, 0.0F, 1.0F } ).bits, 0U );
+  EXPECT_EQ( encode_oct32( Vec3{ 1.0F, 0.0F, 0.0F } ).bits, 0x0000'7fffU );
+  EXPECT_EQ( encode_oct16( Vec3{ 0.0F, -1.0F, 0.0F } ).bits, 0x8100U );
+  EXPECT_EQ( encode_snorm10x3( Vec3{ 0.0F, 0.0F, -1.0F } ).bits, 0x2010'0000U );
+}
+
+TEST_F( NormalEncodingTest, DecodesToUnitVectors )
+{
+  for ( const Vec3& n : sphere( 1'000 ) )
+  {
+    EXPECT_TRUE( is_unit_vector( decode( encode_oct16( n ) ), 1e-6F ) );
+    EXPECT_TRUE( is_unit_vector( decode( encode_snorm10x3( n ) ), 1e-6F ) );
+  }
+}
+
+TEST_F( NormalEncodingTest, OctahedralAcceptsUnnormalizedInput )
+{
+  const Vec3 n{ 0.36F, -0.48F, -0.8F };
+  EXPECT_EQ( encode_oct32( n * 4.0F ), encode_oct32( n ) );
+}
+
+TEST_F( NormalEncodingTest, MaxAngularError )
+{
+  EXPECT_LT( max_error( []( const Vec3& n ) { return encode_oct32( n ); } ), 0.004 );
+  EXPECT_LT( max_error( []( const Vec3& n ) { return encode_oct16( n ); } ), 1.0 );
+  EXPECT_LT( max_error( []( const Vec3& n ) { return encode_snorm10x3( n ); } ), 0.1 );
+}
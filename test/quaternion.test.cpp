@@ -234,3 +234,18 @@ TEST_F( QuaternionTest, SlerpMidpoint )
   EXPECT_NEAR( mid.z(), std::sin( expected_half_angle ), 1e-5F );
   EXPECT_NEAR( mid.w(), std::cos( expected_half_angle ), 1e-5F );
 }
+
+TEST_F( QuaternionTest, DoublePrecision )
+{
+  const double half = 1.0 / std::numbers::sqrt2;
+  DQuaternion  q{ 0.0, 0.0, half, half };
+  EXPECT_TRUE( are_vectors_equal( transform( DVec3{ 1.0, 0.0, 0.0 }, q ), DVec3{ 0.0, 1.0, 0.0 }, 1e-15F ) );
+
+  DQuaternion from_matrix;
+  from_matrix.set_rotation_from_matrix( q.get_rotation_matrix() );
+  EXPECT_TRUE( are_vectors_equal( from_matrix, q, 1e-15F ) );
+
+  const DQuaternion mid = slerp( DQuaternion{ 0.0, 0.0, 0.0, 1.0 }, q, 0.5 );
+  EXPECT_NEAR( mid.z(), std::sin( std::numbers::pi / 8.0 ), 1e-15 );
+  EXPECT_NEAR( mid.w(), std::cos( std::numbers::pi / 8.0 ), 1e-15 );
+}
@@ -0,0 +1,378 @@
+#include "linalg/quaternion_batch.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace linalg;
+
+class QuaternionBatchTest : public ::testing::Test
+{
+protected:
+  static constexpr size_t count = 20'000;
+
+  // Random unit pairs with parameters in [0, 1]. Every fourth pair is nearly equal, every seventh has a negative dot
+  // product and the first ones hit the ends of the interval; the count is not a multiple of any register width.
+  void SetUp() override
+  {
+    std::mt19937                          engine( 11 );
+    std::normal_distribution<float>       normal;
+    std::uniform_real_distribution<float> uniform( 0.0F, 1.0F );
+    const auto random_unit = [&] { return Vec4{ normal( engine ), normal( engine ), normal( engine ), normal( engine ) }; };
+    for ( size_t i = 0; i != count + 3; ++i )
+    {
+      const Vec4 from = normalized( random_unit() );
+      Vec4       to   = i % 4 == 0 ? normalized( from + random_unit() * 1e-3F ) : normalized( random_unit() );
+      if ( i % 7 == 0 )
+      {
+        to = -to;
+      }
+      a.emplace_back( from );
+      b.emplace_back( to );
+      t.push_back( uniform( engine ) );
+    }
+    t[0] = 0.0F;
+    t[1] = 1.0F;
+  }
+
+  // The rotation angle between q and slerp( a[i], b[i], t[i] ) evaluated in double.
+  [[nodiscard]] double angle_to_slerp( size_t i, const Quaternion& q ) const
+  {
+    std::array<double, 4> from{};
+    std::array<double, 4> to{};
+    double                cos_theta = 0.0;
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      from[c] = a[i][c];
+      to[c]   = b[i][c];
+      cos_theta += from[c] * to[c];
+    }
+    const double sign  = cos_theta < 0.0 ? -1.0 : 1.0;
+    const double theta = std::acos( std::min( std::abs( cos_theta ), 1.0 ) );
+    const double wa    = theta < 1e-12 ? 1.0 - t[i] : std::sin( ( 1.0 - t[i] ) * theta ) / std::sin( theta );
+    const double wb    = theta < 1e-12 ? t[i] : std::sin( t[i] * theta ) / std::sin( theta );
+
+    std::array<double, 4> expected{};
+    double                length    = 0.0;
+    double                alignment = 0.0;
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      expected[c] = wa * from[c] + sign * wb * to[c];
+      length += expected[c] * expected[c];
+      alignment += expected[c] * q[c];
+    }
+    const double scale = ( alignment < 0.0 ? -1.0 : 1.0 ) / std::sqrt( length );
+    double       chord = 0.0;
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      const double difference = q[c] - scale * expected[c];
+      chord += difference * difference;
+    }
+    return 4.0 * std::asin( std::min( std::sqrt( chord ) / 2.0, 1.0 ) );
+  }
+
+  template<typename Blend>
+  [[nodiscard]] double max_angle( Blend blend ) const
+  {
+    std::vector<Quaternion> out( a.size() );
+    blend( a, b, t, std::span<Quaternion>{ out } );
+    double worst = 0.0;
+    for ( size_t i = 0; i != out.size(); ++i )
+    {
+      worst = std::max( worst, angle_to_slerp( i, out[i] ) );
+      EXPECT_NEAR( magnitude( static_cast<const Vec4&>( out[i] ) ), 1.0F, 1e-6F );
+    }
+    return worst;
+  }
+
+  std::vector<Quaternion> a;
+  std::vector<Quaternion> b;
+  std::vector<float>      t;
+};
+
+TEST_F( QuaternionBatchTest, SlerpBounds )
+{
+  EXPECT_LT( max_angle( []( auto from, auto to, auto time, auto out ) { slerp<Precise>( from, to, time, out ); } ),
+    6e-7 );
+  EXPECT_LT( max_angle( []( auto from, auto to, auto time, auto out ) { slerp<Fast>( from, to, time, out ); } ), 6e-7 );
+}
+
+TEST_F( QuaternionBatchTest, NlerpBounds )
+{
+  EXPECT_LT( max_angle( []( auto from, auto to, auto time, auto out ) { corrected_nlerp( from, to, time, out ); } ),
+    8e-4 );
+  const double uncorrected
+    = max_angle( []( auto from, auto to, auto time, auto out ) { nlerp( from, to, time, out ); } );
+  EXPECT_LT( uncorrected, 0.15 );
+  EXPECT_GT( uncorrected, 0.1 );
+}
+
+TEST_F( QuaternionBatchTest, MatchesScalarSlerp )
+{
+  std::vector<Quaternion> out( a.size() );
+  slerp( a, b, t, out );
+  for ( size_t i = 0; i != out.size(); ++i )
+  {
+    EXPECT_TRUE( are_vectors_equal( out[i], slerp( a[i], b[i], t[i] ), 1e-6F ) ) << i;
+  }
+}
+
+TEST_F( QuaternionBatchTest, TakesTheShorterArc )
+{
+  std::vector<Quaternion> negated( b.size() );
+  std::transform( b.begin(), b.end(), negated.begin(), []( const Quaternion& q ) { return Quaternion{ -q }; } );
+  std::vector<Quaternion> out( a.size() );
+  std::vector<Quaternion> out_negated( a.size() );
+  slerp( a, b, 0.25F, out );
+  slerp( a, negated, 0.25F, out_negated );
+  EXPECT_EQ( out, out_negated );
+  corrected_nlerp( a, b, 0.25F, out );
+  corrected_nlerp( a, negated, 0.25F, out_negated );
+  EXPECT_EQ( out, out_negated );
+}
+
+// Uniform and per-element parameters, spans and SoA batches, and every tail length give the same results.
+TEST_F( QuaternionBatchTest, OverloadsAgree )
+{
+  const std::vector<float> uniform( a.size(), 0.375F );
+  std::vector<Quaternion>  expected( a.size() );
+  std::vector<Quaternion>  out( a.size() );
+  slerp( a, b, uniform, expected );
+  slerp( a, b, 0.375F, out );
+  EXPECT_EQ( out, expected );
+
+  QuaternionBatch batch_out;
+  slerp( QuaternionBatch{ a }, QuaternionBatch{ b }, 0.375F, batch_out );
+  ASSERT_EQ( batch_out.size(), a.size() );
+  for ( size_t i = 0; i != a.size(); ++i )
+  {
+    EXPECT_EQ( batch_out[i], expected[i] );
+  }
+
+  for ( size_t size = 0; size != 40; ++size )
+  {
+    std::vector<Quaternion> prefix( size );
+    slerp( std::span{ a }.first( size ), std::span{ b }.first( size ), 0.375F, prefix );
+    EXPECT_TRUE( std::equal( prefix.begin(), prefix.end(), expected.begin() ) ) << size;
+  }
+
+  std::vector<Quaternion> nlerped( a.size() );
+  QuaternionBatch         batch_nlerped;
+  corrected_nlerp( a, b, 0.375F, nlerped );
+  corrected_nlerp( QuaternionBatch{ a }, QuaternionBatch{ b }, 0.375F, batch_nlerped );
+  for ( size_t i = 0; i != a.size(); ++i )
+  {
+    EXPECT_EQ( batch_nlerped[i], nlerped[i] );
+  }
+}
+
+TEST_F( QuaternionBatchTest, OutputMayAliasInput )
+{
+  std::vector<Quaternion> expected( a.size() );
+  nlerp( a, b, t, expected );
+  nlerp( a, b, t, a );
+  EXPECT_EQ( a, expected );
+}
+
+TEST_F( QuaternionBatchTest, ToMatricesMatchesScalar )
+{
+  std::vector<Mat3>       mat3s( a.size() );
+  std::vector<Mat4>       mat4s( a.size() );
+  std::vector<Transform4> transforms( a.size() );
+  to_matrices( a, mat3s );
+  to_matrices( a, mat4s );
+  to_matrices( a, transforms );
+  for ( size_t i = 0; i != a.size(); ++i )
+  {
+    Quaternion q = a[i];
+    EXPECT_TRUE( are_matrices_equal( mat3s[i], q.get_rotation_matrix(), 1e-6F ) ) << i;
+    EXPECT_TRUE( are_matrices_equal( mat4s[i], q.to_mat4(), 1e-6F ) ) << i;
+    EXPECT_TRUE( are_matrices_equal( transforms[i], mat4s[i], 0.0F ) ) << i;
+  }
+
+  const auto equal = []( const auto& left, const auto& right ) { return are_matrices_equal( left, right, 0.0F ); };
+  std::vector<Mat3> batch_mat3s( a.size() );
+  to_matrices( QuaternionBatch{ a }, batch_mat3s );
+  EXPECT_TRUE( std::equal( batch_mat3s.begin(), batch_mat3s.end(), mat3s.begin(), equal ) );
+  for ( size_t size = 0; size != 40; ++size )
+  {
+    std::vector<Mat4> prefix( size );
+    to_matrices( std::span{ a }.first( size ), prefix );
+    EXPECT_TRUE( std::equal( prefix.begin(), prefix.end(), mat4s.begin(), equal ) ) << size;
+  }
+}
+
+// Besides random rotations, half turns and rotations close to them, whose traces are near -1, take each of the four
+// paths with their diagonal elements in every order.
+TEST_F( QuaternionBatchTest, QuatsFromMatricesMatchesScalar )
+{
+  std::vector<Mat3> matrices;
+  for ( Quaternion q : a )
+  {
+    matrices.push_back( q.get_rotation_matrix() );
+  }
+  for ( const Vec3& axis : { Vec3{ 1.0F, 0.0F, 0.0F },
+          Vec3{ 0.0F, 1.0F, 0.0F },
+          Vec3{ 0.0F, 0.0F, 1.0F },
+          normalized( Vec3{ 1.0F, 2.0F, -3.0F } ),
+          normalized( Vec3{ -3.0F, 1.0F, 2.0F } ),
+          normalized( Vec3{ 2.0F, -3.0F, 1.0F } ) } )
+  {
+    for ( const float angle : { 0.0F, 1.5F, 3.0F, 3.14F, std::numbers::pi_v<float> } )
+    {
+      Quaternion q{ axis * std::sin( angle / 2.0F ), std::cos( angle / 2.0F ) };
+      matrices.push_back( q.get_rotation_matrix() );
+    }
+  }
+
+  std::vector<Quaternion> out( matrices.size() );
+  quats_from_matrices( matrices, out );
+  for ( size_t i = 0; i != matrices.size(); ++i )
+  {
+    Quaternion expected;
+    expected.set_rotation_from_matrix( matrices[i] );
+    EXPECT_TRUE( are_vectors_equal( out[i], expected, 2e-6F ) ) << i;
+    EXPECT_NEAR( magnitude( static_cast<const Vec4&>( out[i] ) ), 1.0F, 1e-6F ) << i;
+  }
+
+  std::vector<Mat4>       mat4s( matrices.size() );
+  std::vector<Transform4> transforms( matrices.size() );
+  to_matrices( out, mat4s );
+  to_matrices( out, transforms );
+  std::vector<Quaternion> from_mat4s( matrices.size() );
+  std::vector<Quaternion> from_transforms( matrices.size() );
+  QuaternionBatch         batch_out;
+  quats_from_matrices( mat4s, from_mat4s );
+  quats_from_matrices( transforms, from_transforms );
+  quats_from_matrices( std::span<const Mat4>{ mat4s }, batch_out );
+  EXPECT_EQ( from_transforms, from_mat4s );
+  ASSERT_EQ( batch_out.size(), from_mat4s.size() );
+  for ( size_t i = 0; i != from_mat4s.size(); ++i )
+  {
+    EXPECT_EQ( batch_out[i], from_mat4s[i] );
+    // A trace rounded to the other side of zero takes another path, which may flip the sign.
+    const float alignment = dot( static_cast<const Vec4&>( from_mat4s[i] ), static_cast<const Vec4&>( out[i] ) );
+    EXPECT_NEAR( std::abs( alignment ), 1.0F, 4e-6F ) << i;
+  }
+}
+
+TEST_F( QuaternionBatchTest, TransformMatchesScalar )
+{
+  Vec3Batch vecs( a.size() );
+  for ( size_t i = 0; i != a.size(); ++i )
+  {
+    vecs.set( i, Vec3{ b[i].x(), b[i].y(), b[i].z() } * 10.0F );
+  }
+  const QuaternionBatch quats( a );
+  Point3Batch           points( 1 );
+  points.set( 0, Point3{ 1.0F, -2.0F, 3.0F } );
+
+  Vec3Batch   by_one;
+  Vec3Batch   by_each;
+  Point3Batch rotated_points;
+  transform_vectors( a[1], vecs, by_one );
+  transform_vectors( quats, vecs, by_each );
+  transform_points( a[1], points, rotated_points );
+  ASSERT_EQ( by_one.size(), a.size() );
+  ASSERT_EQ( by_each.size(), a.size() );
+  for ( size_t i = 0; i != a.size(); ++i )
+  {
+    ASSERT_TRUE( are_vectors_equal( by_one[i], transform( vecs[i], a[1] ), 1e-5F ) ) << "index " << i;
+    ASSERT_TRUE( are_vectors_equal( by_each[i], transform( vecs[i], a[i] ), 1e-5F ) ) << "index " << i;
+  }
+  EXPECT_TRUE( are_vectors_equal( rotated_points[0], transform( points[0], a[1] ), 1e-5F ) );
+
+  transform_vectors( quats, by_each, by_each );
+  for ( size_t i = 0; i != a.size(); ++i )
+  {
+    ASSERT_TRUE( are_vectors_equal( by_each[i], transform( transform( vecs[i], a[i] ), a[i] ), 2e-5F ) )
+      << "index " << i;
+  }
+}
+
+// Every order against the product of its three axis rotations, with the middle angle in [-1.5, 1.5] so that the
+// conversion is invertible; XYZ also against the scalar functions.
+TEST_F( QuaternionBatchTest, EulerConversionsMatchAxisRotations )
+{
+  constexpr float                            pi = std::numbers::pi_v<float>;
+  const std::array<std::array<size_t, 3>, 6> sequences{
+    { { 0, 1, 2 }, { 0, 2, 1 }, { 1, 0, 2 }, { 1, 2, 0 }, { 2, 0, 1 }, { 2, 1, 0 } }
+  };
+  const std::array<EulerOrder, 6> orders{
+    EulerOrder::XYZ, EulerOrder::XZY, EulerOrder::YXZ, EulerOrder::YZX, EulerOrder::ZXY, EulerOrder::ZYX
+  };
+  // Angles of +-pi may come out as -+pi.
+  const auto same_angles = []( const Vec3& a, const Vec3& b, float tolerance ) {
+    for ( size_t c = 0; c != 3; ++c )
+    {
+      if ( std::abs( std::remainder( a[c] - b[c], 2.0F * pi ) ) > tolerance )
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+  for ( size_t o = 0; o != orders.size(); ++o )
+  {
+    const auto& sequence = sequences[o];
+    Vec3Batch   euler( t.size() );
+    for ( size_t i = 0; i != t.size(); ++i )
+    {
+      Vec3 e;
+      e[sequence[0]] = ( 2.0F * t[i] - 1.0F ) * pi;
+      e[sequence[1]] = 3.0F * t[( i + 1 ) % t.size()] - 1.5F;
+      e[sequence[2]] = a[i].w() * pi;
+      euler.set( i, e );
+    }
+    QuaternionBatch quats;
+    Vec3Batch       angles;
+    quats_from_euler( euler, quats, orders[o] );
+    euler_angles( quats, angles, orders[o] );
+    ASSERT_EQ( quats.size(), t.size() );
+    ASSERT_EQ( angles.size(), t.size() );
+    for ( size_t i = 0; i != t.size(); ++i )
+    {
+      const Vec3 e = euler[i];
+      Quaternion expected{ 0.0F, 0.0F, 0.0F, 1.0F };
+      for ( size_t axis : sequence )
+      {
+        Vec3 half_sine{ 0.0F, 0.0F, 0.0F };
+        half_sine[axis] = std::sin( e[axis] / 2.0F );
+        expected        = Quaternion{ half_sine, std::cos( e[axis] / 2.0F ) } * expected;
+      }
+      ASSERT_TRUE(
+        are_vectors_equal( static_cast<const Vec4&>( quats[i] ), static_cast<const Vec4&>( expected ), 2e-6F ) )
+        << "order " << o << " index " << i;
+      ASSERT_TRUE( same_angles( angles[i], e, 2e-5F ) ) << "order " << o << " index " << i;
+      if ( orders[o] == EulerOrder::XYZ )
+      {
+        ASSERT_TRUE( are_vectors_equal(
+          static_cast<const Vec4&>( quats[i] ), static_cast<const Vec4&>( quat_from_euler( e ) ), 2e-6F ) )
+          << "index " << i;
+        ASSERT_TRUE( same_angles( angles[i], euler_angles( quats[i] ), 1e-5F ) ) << "index " << i;
+      }
+    }
+  }
+}
+
+// Where rounding pushes the sine of the middle angle past +-1, it is clamped to exactly +-pi/2 as in the scalar
+// euler_angles instead of turning into a NaN.
+TEST_F( QuaternionBatchTest, EulerAnglesAtThePoles )
+{
+  constexpr float half_pi = std::numbers::pi_v<float> / 2.0F;
+  const float     c       = std::nextafter( std::sqrt( 0.5F ), 1.0F );
+  QuaternionBatch quats( 2 );
+  quats.set( 0, Vec4{ 0.0F, c, 0.0F, c } );
+  quats.set( 1, Vec4{ 0.0F, -c, 0.0F, c } );
+  Vec3Batch angles;
+  euler_angles( quats, angles );
+  EXPECT_EQ( angles[0].y(), half_pi );
+  EXPECT_EQ( angles[1].y(), -half_pi );
+  EXPECT_EQ( angles[0].y(), euler_angles( quats[0] ).y() );
+  EXPECT_EQ( angles[1].y(), euler_angles( quats[1] ).y() );
+}
@@ -0,0 +1,146 @@
+#include "linalg/quaternion_encoding.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace linalg;
+
+class QuaternionEncodingTest : public ::testing::Test
+{
+protected:
+  // Random unit quaternions, plus the axes, ties between the largest components and both signs of each; the count is
+  // not a multiple of any register width.
+  void SetUp() override
+  {
+    const float half = 0.5F;
+    const float root = std::numbers::sqrt2_v<float> / 2.0F;
+    for ( size_t k = 0; k != 4; ++k )
+    {
+      Vec4 axis{};
+      axis[k] = 1.0F;
+      quats.emplace_back( axis );
+      Vec4 tie{};
+      tie[k]             = root;
+      tie[( k + 1 ) % 4] = -root;
+      quats.emplace_back( tie );
+    }
+    quats.emplace_back( half, -half, half, half );
+
+    std::mt19937                    engine( 3 );
+    std::normal_distribution<float> normal;
+    while ( quats.size() != count )
+    {
+      const Vec4 q{ normal( engine ), normal( engine ), normal( engine ), normal( engine ) };
+      quats.emplace_back( normalized( q ) );
+    }
+    for ( size_t i = 0; i < count; i += 3 )
+    {
+      quats[i] = Quaternion{ -quats[i] };
+    }
+  }
+
+  // The angle of the rotation between a and b, in double and robust to inputs that are unit only to float precision.
+  static double angle_between( const Quaternion& a, const Quaternion& b )
+  {
+    std::array<double, 4> da{};
+    std::array<double, 4> db{};
+    double                dot = 0.0;
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      da[c] = a[c];
+      db[c] = b[c];
+      dot += da[c] * db[c];
+    }
+    double difference = 0.0;
+    double sum        = 0.0;
+    for ( size_t c = 0; c != 4; ++c )
+    {
+      const double other = dot < 0.0 ? -db[c] : db[c];
+      difference += ( da[c] - other ) * ( da[c] - other );
+      sum += ( da[c] + other ) * ( da[c] + other );
+    }
+    return 4.0 * std::atan2( std::sqrt( difference ), std::sqrt( sum ) );
+  }
+
+  static constexpr size_t count = 100'003;
+  std::vector<Quaternion> quats;
+};
+
+TEST_F( QuaternionEncodingTest, Sizes )
+{
+  EXPECT_EQ( sizeof( Quat32 ), 4U );
+  EXPECT_EQ( sizeof( Quat48 ), 6U );
+}
+
+TEST_F( QuaternionEncodingTest, ZeroBitsAreIdentity )
+{
+  const Quaternion identity{ 0.0F, 0.0F, 0.0F, 1.0F };
+  EXPECT_EQ( decode( Quat32{} ), identity );
+  EXPECT_EQ( decode( Quat48{} ), identity );
+  EXPECT_EQ( encode_quat32( identity ), Quat32{} );
+  EXPECT_EQ( encode_quat48( identity ), Quat48{} );
+  EXPECT_EQ( encode_quat32( Quaternion{ -identity } ), Quat32{} );
+}
+
+TEST_F( QuaternionEncodingTest, Layout )
+{
+  // x and z tie for the largest and x is dropped; components of 1/sqrt( 2 ) take the top snorm code.
+  const float      root = std::sqrt( 0.5F );
+  const Quaternion tie{ root, 0.0F, -root, 0.0F };
+  EXPECT_EQ( encode_quat32( tie ).bits, ( 3U << 30 ) | ( ( 1024U - 511U ) << 10 ) );
+  EXPECT_EQ( encode_quat48( tie ).bits, ( std::array<std::uint16_t, 3>{ 0x8000, 0x8000 | ( 32768 - 16383 ), 0 } ) );
+
+  // w is dropped; the sign flip makes it positive.
+  const Quaternion q{ 0.0F, 0.0F, 0.6F, -0.8F };
+  EXPECT_EQ( encode_quat32( q ).bits, ( 1024U - 434U ) << 20 );
+  EXPECT_EQ( encode_quat48( q ).bits, ( std::array<std::uint16_t, 3>{ 0, 0, 32768 - 13901 } ) );
+}
+
+TEST_F( QuaternionEncodingTest, MaxAngularError )
+{
+  double max_error32 = 0.0;
+  double max_error48 = 0.0;
+  for ( const Quaternion& q : quats )
+  {
+    max_error32 = std::max( max_error32, angle_between( q, decode( encode_quat32( q ) ) ) );
+    max_error48 = std::max( max_error48, angle_between( q, decode( encode_quat48( q ) ) ) );
+  }
+  EXPECT_LT( max_error32, 5e-3 );
+  EXPECT_LT( max_error48, 1.6e-4 );
+}
+
+TEST_F( QuaternionEncodingTest, DecodesToUnitQuaternions )
+{
+  for ( const Quaternion& q : quats )
+  {
+    EXPECT_NEAR( magnitude( static_cast<const Vec4&>( decode( encode_quat32( q ) ) ) ), 1.0F, 1e-6F );
+    EXPECT_NEAR( magnitude( static_cast<const Vec4&>( decode( encode_quat48( q ) ) ) ), 1.0F, 1e-6F );
+  }
+}
+
+TEST_F( QuaternionEncodingTest, BatchMatchesScalar )
+{
+  for ( const size_t size : { size_t{ 0 }, size_t{ 1 }, size_t{ 7 }, size_t{ 17 }, count } )
+  {
+    const std::span<const Quaternion> in{ quats.data(), size };
+    std::vector<Quat32>               packed32( size );
+    std::vector<Quat48>               packed48( size );
+    std::vector<Quaternion>           decoded32( size );
+    std::vector<Quaternion>           decoded48( size );
+    encode_quat32( in, packed32 );
+    encode_quat48( in, packed48 );
+    decode( std::span<const Quat32>{ packed32 }, decoded32 );
+    decode( std::span<const Quat48>{ packed48 }, decoded48 );
+    for ( size_t i = 0; i != size; ++i )
+    {
+      ASSERT_EQ( packed32[i], encode_quat32( in[i] ) ) << i;
+      ASSERT_EQ( packed48[i], encode_quat48( in[i] ) ) << i;
+      ASSERT_EQ( decoded32[i], decode( packed32[i] ) ) << i;
+      ASSERT_EQ( decoded48[i], decode( packed48[i] ) ) << i;
+    }
+  }
+}
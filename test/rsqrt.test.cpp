@@ -0,0 +1,66 @@
+#include "linalg/plane.hpp"
+#include "linalg/rsqrt.hpp"
+#include "linalg/vec.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+
+using namespace linalg;
+
+class RsqrtTest : public ::testing::Test
+{
+protected:
+  // Worst relative error of rsqrt<Policy> over values spread across many binades.
+  template<RsqrtPolicy Policy>
+  static double max_relative_error()
+  {
+    double worst = 0.0;
+    for ( float x = 1e-20F; x < 1e20F; x *= 1.0137F )
+    {
+      const double exact = 1.0 / std::sqrt( static_cast<double>( x ) );
+      worst              = std::max( worst, std::abs( rsqrt<Policy>( x ) - exact ) / exact );
+    }
+    return worst;
+  }
+};
+
+TEST_F( RsqrtTest, ErrorBounds )
+{
+  EXPECT_LT( max_relative_error<Exact>(), 1.2e-7 );
+  EXPECT_LT( max_relative_error<Refined>(), 3e-7 );
+  EXPECT_LT( max_relative_error<Estimate>(), 4e-3 );
+}
+
+TEST_F( RsqrtTest, DoubleIsExact )
+{
+  EXPECT_EQ( rsqrt<Estimate>( 4.0 ), 0.5 );
+  EXPECT_EQ( rsqrt<Refined>( 2.0 ), 1.0 / std::sqrt( 2.0 ) );
+}
+
+TEST_F( RsqrtTest, NormalizeModes )
+{
+  const Vec3 v{ 3.0F, -4.0F, 12.0F };
+  EXPECT_EQ( normalized<Exact>( v ), normalized( v ) );
+  EXPECT_TRUE( are_vectors_equal( normalized<Refined>( v ), normalized( v ), 1e-6F ) );
+  EXPECT_NEAR( magnitude( normalized<Estimate>( v ) ), 1.0F, 4e-3F );
+
+  Vec4 w{ 1.0F, 2.0F, 2.0F, 4.0F };
+  w.normalize_in_place<Refined>();
+  EXPECT_TRUE( are_vectors_equal( w, Vec4{ 0.2F, 0.4F, 0.4F, 0.8F }, 1e-6F ) );
+
+  const DVec3 d{ 3.0, 4.0, 0.0 };
+  EXPECT_NEAR( normalized<Estimate>( d ).x(), 0.6, 1e-15 );
+  EXPECT_NEAR( normalized<Estimate>( d ).y(), 0.8, 1e-15 );
+}
+
+TEST_F( RsqrtTest, PlaneNormalizeModes )
+{
+  Plane exact{ Vec3{ 0.0F, 3.0F, 4.0F }, 10.0F };
+  Plane refined = exact;
+  exact.normalize_in_place();
+  refined.normalize_in_place<Refined>();
+  EXPECT_TRUE( are_vectors_equal( refined.get_normal(), exact.get_normal(), 1e-6F ) );
+  EXPECT_NEAR( refined.w(), exact.w(), 1e-5F );
+}
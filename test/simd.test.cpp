@@ -0,0 +1,151 @@
+#include "linalg/mat4.hpp"
+#include "linalg/simd.hpp"
+#include "linalg/vec.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+constexpr Vec4 a{ 1.0F, -2.0F, 3.5F, 4.0F };
+constexpr Vec4 b{ 0.5F, 6.0F, -7.0F, 2.0F };
+
+constexpr Mat4 m{ 1.0F, 2.0F, 3.0F, 4.0F, 5.0F, 6.0F, 7.0F, 8.0F, 9.0F, 10.0F, 11.0F, 12.0F, 13.0F, 14.0F, 15.0F, 16.0F };
+constexpr Mat4 n{ 2.0F, 0.0F, 1.0F, -1.0F, 0.0F, 3.0F, 0.0F, 2.0F, 1.0F, 0.0F, 1.0F, 0.0F, -4.0F, 1.0F, 0.0F, 1.0F };
+
+} // namespace
+
+class SimdTest : public ::testing::Test
+{
+protected:
+  Vec4 va = a;
+  Vec4 vb = b;
+  Mat4 ma = m;
+  Mat4 mb = n;
+};
+
+TEST_F( SimdTest, Alignment )
+{
+  if constexpr ( simd::enabled )
+  {
+    EXPECT_EQ( alignof( Vec4 ), 16U );
+    EXPECT_EQ( alignof( Mat4 ), 16U );
+  }
+  EXPECT_EQ( sizeof( Vec4 ), 4 * sizeof( float ) );
+  EXPECT_EQ( sizeof( Vec3 ), 3 * sizeof( float ) );
+  EXPECT_EQ( sizeof( Mat4 ), 16 * sizeof( float ) );
+}
+
+TEST_F( SimdTest, Vec4ArithmeticMatchesConstexpr )
+{
+  constexpr Vec4 sum        = a + b;
+  constexpr Vec4 difference = a - b;
+  constexpr Vec4 negated    = -a;
+  constexpr Vec4 scaled     = a * 3.0F;
+  constexpr Vec4 divided    = a / 4.0F;
+  constexpr Vec4 product    = a * b;
+
+  EXPECT_EQ( va + vb, sum );
+  EXPECT_EQ( va - vb, difference );
+  EXPECT_EQ( -va, negated );
+  EXPECT_EQ( va * 3.0F, scaled );
+  EXPECT_EQ( va / 4.0F, divided );
+  EXPECT_EQ( va * vb, product );
+}
+
+TEST_F( SimdTest, Vec4CompoundAssignmentMatchesConstexpr )
+{
+  Vec4 vec = va;
+  vec += vb;
+  EXPECT_EQ( vec, a + b );
+  vec -= vb;
+  EXPECT_EQ( vec, a );
+  vec *= vb;
+  EXPECT_EQ( vec, a * b );
+  vec = va;
+  vec *= 2.0F;
+  EXPECT_EQ( vec, a * 2.0F );
+}
+
+TEST_F( SimdTest, Vec4DotMatchesConstexpr )
+{
+  constexpr float dot_ab = dot( a, b );
+  constexpr float mag_sq = magnitude_squared( a );
+  static_assert( dot_ab == 0.5F - 12.0F - 24.5F + 8.0F );
+
+  EXPECT_FLOAT_EQ( dot( va, vb ), dot_ab );
+  EXPECT_FLOAT_EQ( magnitude_squared( va ), mag_sq );
+}
+
+TEST_F( SimdTest, Mat4MultiplyMatchesConstexpr )
+{
+  constexpr Mat4 product = m * n;
+  EXPECT_TRUE( are_matrices_equal( ma * mb, product, 0.0F ) );
+
+  constexpr Vec4 transformed = m * a;
+  EXPECT_EQ( ma * va, transformed );
+}
+
+TEST_F( SimdTest, Mat4TransposeMatchesConstexpr )
+{
+  constexpr Mat4 transposed = transpose( m );
+  static_assert( transposed( 0, 3 ) == 13.0F );
+
+  const Mat4 result = transpose( ma );
+  EXPECT_TRUE( are_matrices_equal( result, transposed, 0.0F ) );
+  EXPECT_FLOAT_EQ( result( 3, 0 ), 4.0F );
+  EXPECT_FLOAT_EQ( result( 1, 2 ), 10.0F );
+}
+
+TEST_F( SimdTest, DeinterleaveGroupsOfFour )
+{
+#ifdef LINALG_SIMD_F32X4
+  constexpr size_t   lanes = simd::wide_lanes;
+  std::vector<float> groups( 4 * lanes );
+  for ( size_t i = 0; i != groups.size(); ++i )
+  {
+    groups[i] = static_cast<float>( i );
+  }
+  simd::f32xw members[4];
+  simd::load_deinterleave4( groups.data(), members );
+  for ( size_t c = 0; c != 4; ++c )
+  {
+    std::vector<float> member( lanes );
+    simd::store_wide( member.data(), members[c] );
+    for ( size_t i = 0; i != lanes; ++i )
+    {
+      EXPECT_EQ( member[i], static_cast<float>( 4 * i + c ) );
+    }
+  }
+
+  std::vector<float> round_trip( groups.size() );
+  simd::store_interleave4( round_trip.data(), members );
+  EXPECT_EQ( round_trip, groups );
+#endif
+}
+
+TEST_F( SimdTest, GatherByIndex )
+{
+#ifdef LINALG_SIMD_F32X4
+  constexpr size_t   lanes = simd::wide_lanes;
+  std::vector<float> table( 8 * lanes );
+  std::vector<int>   indices( lanes );
+  for ( size_t i = 0; i != table.size(); ++i )
+  {
+    table[i] = static_cast<float>( i ) * 0.5F;
+  }
+  for ( size_t i = 0; i != lanes; ++i )
+  {
+    indices[i] = static_cast<int>( ( i * 13 + 5 ) % table.size() );
+  }
+  std::vector<float> gathered( lanes );
+  simd::store_wide( gathered.data(), simd::gather_wide( table.data(), simd::load_wide( indices.data() ) ) );
+  for ( size_t i = 0; i != lanes; ++i )
+  {
+    EXPECT_EQ( gathered[i], table[indices[i]] );
+  }
+#endif
+}
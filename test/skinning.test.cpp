@@ -0,0 +1,147 @@
+#include "linalg/skinning.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+using namespace linalg;
+
+class SkinningTest : public ::testing::Test
+{
+protected:
+  static constexpr size_t count      = 10'003;
+  static constexpr int    bone_count = 24;
+
+  // A random palette and vertices with one to four influences each; the count is not a multiple of any register width.
+  void SetUp() override
+  {
+    std::mt19937                          engine( 5 );
+    std::normal_distribution<float>       normal;
+    std::uniform_real_distribution<float> uniform( 0.0F, 1.0F );
+    std::uniform_int_distribution<int>    bone( 0, bone_count - 1 );
+    for ( int b = 0; b != bone_count; ++b )
+    {
+      const Vec4 axis{ normal( engine ), normal( engine ), normal( engine ), normal( engine ) };
+      Quaternion rotation{ normalized( axis ) };
+      // Both covers of a rotation appear in the palette, as they do after composing bone hierarchies.
+      if ( b % 3 == 0 )
+      {
+        rotation = Quaternion{ -rotation };
+      }
+      palette.emplace_back( rotation, Vec3{ normal( engine ), normal( engine ), normal( engine ) } );
+    }
+
+    bones.resize( count );
+    weights.resize( count );
+    positions.resize( count );
+    normals.resize( count );
+    for ( size_t i = 0; i != count; ++i )
+    {
+      IVec4 influences{ bone( engine ), bone( engine ), bone( engine ), bone( engine ) };
+      Vec4  w{ uniform( engine ), uniform( engine ), uniform( engine ), uniform( engine ) };
+      for ( size_t k = i % 4 + 1; k != 4; ++k )
+      {
+        w[k]          = 0.0F;
+        influences[k] = 0;
+      }
+      bones.set( i, influences );
+      weights.set( i, w / ( w[0] + w[1] + w[2] + w[3] ) );
+      positions.set( i, Vec3{ normal( engine ), normal( engine ), normal( engine ) } * 2.0F );
+      normals.set( i, normalized( Vec3{ normal( engine ), normal( engine ), normal( engine ) } ) );
+    }
+  }
+
+  [[nodiscard]] DualQuaternion blended( size_t i ) const
+  {
+    const IVec4           influences = bones[i];
+    const Vec4            w          = weights[i];
+    const Vec4&           pivot      = palette[influences[0]].real();
+    DualQuaternion        sum        = w[0] * palette[influences[0]];
+    for ( size_t k = 1; k != 4; ++k )
+    {
+      const DualQuaternion& dq   = palette[influences[k]];
+      const float           sign = dot( pivot, static_cast<const Vec4&>( dq.real() ) ) < 0.0F ? -1.0F : 1.0F;
+      sum                        = sum + ( sign * w[k] ) * dq;
+    }
+    return normalized( sum );
+  }
+
+  std::vector<DualQuaternion> palette;
+  IVec4Batch                  bones;
+  Vec4Batch                   weights;
+  Point3Batch                 positions;
+  Vec3Batch                   normals;
+};
+
+TEST_F( SkinningTest, MatchesScalarBlend )
+{
+  Point3Batch out_positions;
+  Vec3Batch   out_normals;
+  skin( palette, bones, weights, positions, normals, out_positions, out_normals );
+  ASSERT_EQ( out_positions.size(), count );
+  ASSERT_EQ( out_normals.size(), count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const DualQuaternion dq = blended( i );
+    ASSERT_TRUE( are_vectors_equal( Vec3{ out_positions[i] }, Vec3{ transform( positions[i], dq ) }, 2e-5F ) ) << i;
+    ASSERT_TRUE( are_vectors_equal( out_normals[i], transform( normals[i], dq ), 2e-6F ) ) << i;
+  }
+}
+
+TEST_F( SkinningTest, SingleInfluenceIsRigid )
+{
+  for ( size_t i = 0; i != count; ++i )
+  {
+    bones.set( i, IVec4{ static_cast<int>( i % bone_count ), 0, 0, 0 } );
+    weights.set( i, Vec4{ 1.0F, 0.0F, 0.0F, 0.0F } );
+  }
+  Point3Batch out;
+  skin( palette, bones, weights, positions, out );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const Transform4 bone = palette[i % bone_count].to_transform4();
+    ASSERT_TRUE( are_vectors_equal( Vec3{ out[i] }, Vec3{ bone * positions[i] }, 2e-5F ) ) << i;
+  }
+}
+
+TEST_F( SkinningTest, ThreadedAndInPlaceMatch )
+{
+  Point3Batch expected_positions;
+  Vec3Batch   expected_normals;
+  skin( palette, bones, weights, positions, normals, expected_positions, expected_normals );
+
+  Point3Batch threaded;
+  skin( palette, bones, weights, positions, threaded, Threads{ 3 } );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    ASSERT_EQ( threaded[i], expected_positions[i] ) << i;
+  }
+
+  skin( palette, bones, weights, positions, normals, positions, normals, Threads{ 0 } );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    ASSERT_EQ( positions[i], expected_positions[i] ) << i;
+    ASSERT_EQ( normals[i], expected_normals[i] ) << i;
+  }
+}
+
+TEST_F( SkinningTest, IgnoresBonesInPadding )
+{
+  // Shrinking leaves the indices behind in the padding, far outside the palette.
+  bones.resize( count + 5 );
+  for ( size_t i = count; i != bones.size(); ++i )
+  {
+    bones.set( i, IVec4{ 1 << 28, -( 1 << 28 ), 1 << 28, -( 1 << 28 ) } );
+  }
+  bones.resize( count );
+  ASSERT_GT( bones.padded_size(), count + 4 );
+
+  Point3Batch out;
+  skin( palette, bones, weights, positions, out );
+  for ( size_t i = count - 20; i != count; ++i )
+  {
+    ASSERT_TRUE( are_vectors_equal( Vec3{ out[i] }, Vec3{ transform( positions[i], blended( i ) ) }, 2e-5F ) ) << i;
+  }
+}
@@ -5,6 +5,24 @@
 
 using namespace linalg;
 
+namespace {
+
+template<typename M>
+concept MutableElements = requires( M m ) { m( 0, 3 ) = 2.5F; };
+
+template<typename M>
+concept MutableInPlace = requires( M m, const Mat4& other ) {
+  m *= 2.0F;
+  m /= 2.0F;
+  m += other;
+  m -= other;
+};
+
+template<typename M>
+concept Translatable = requires( M m ) { m.set_translation( Point3{} ); };
+
+} // namespace
+
 class Transform4Test : public ::testing::Test
 {
 protected:
@@ -153,6 +171,24 @@ TEST_F( Transform4Test, TransformComposition )
   EXPECT_FLOAT_EQ( composed( 2, 3 ), 0.0F );
 }
 
+TEST_F( Transform4Test, CompositionMatchesMat4Product )
+{
+  const Transform4 translate = make_translation( Vec3{ 1.0F, -2.0F, 3.0F } );
+  const Transform4 rotate    = make_rotation4( 0.7F, normalized( Vec3{ 1.0F, 2.0F, -0.5F } ) );
+  const Transform4 scale     = make_scale( Vec3{ 2.0F, 0.5F, 3.0F } );
+
+  const Transform4 composed = translate * rotate * scale;
+  const Mat4       expected = Mat4{ Mat4{ translate } * Mat4{ rotate } } * Mat4{ scale };
+  EXPECT_TRUE( are_matrices_equal( composed, expected, 1e-6F ) );
+  EXPECT_EQ( composed( 3, 0 ), 0.0F );
+  EXPECT_EQ( composed( 3, 1 ), 0.0F );
+  EXPECT_EQ( composed( 3, 2 ), 0.0F );
+  EXPECT_EQ( composed( 3, 3 ), 1.0F );
+
+  constexpr Transform4 shifted = make_translation( Vec3{ 1.0F, 2.0F, 3.0F } ) * make_scale( Vec3{ 2.0F, 2.0F, 2.0F } );
+  static_assert( shifted( 0, 0 ) == 2.0F && shifted( 2, 3 ) == 3.0F && shifted( 3, 3 ) == 1.0F );
+}
+
 TEST_F( Transform4Test, InverseRoundtrip )
 {
   Transform4 t{
@@ -268,3 +304,98 @@ TEST_F( Transform4Test, MakeScaleApply )
   EXPECT_FLOAT_EQ( scaled.y(), 3.0F );
   EXPECT_FLOAT_EQ( scaled.z(), 4.0F );
 }
+
+TEST_F( Transform4Test, TranslationKind )
+{
+  const Translation4 t   = make_translation( Vec3{ 1.0F, -2.0F, 3.0F } );
+  const Translation4 inv = inverse( t );
+  EXPECT_TRUE( are_matrices_equal( inv, inverse( Transform4{ t } ) ) );
+  EXPECT_EQ( inv.get_translation(), ( Point3{ -1.0F, 2.0F, -3.0F } ) );
+
+  const Translation4 both = t * make_translation( Vec3{ 0.5F, 0.5F, 0.5F } );
+  EXPECT_EQ( both.get_translation(), ( Point3{ 1.5F, -1.5F, 3.5F } ) );
+
+  const Point3 point{ 4.0F, 5.0F, 6.0F };
+  const Vec3   vec{ 4.0F, 5.0F, 6.0F };
+  EXPECT_EQ( t * point, Transform4{ t } * point );
+  EXPECT_EQ( t * vec, vec );
+}
+
+TEST_F( Transform4Test, RotationKind )
+{
+  const Rotation4 r   = make_rotation4( 0.8F, normalized( Vec3{ 0.0F, 1.0F, 1.0F } ) );
+  const Rotation4 inv = inverse( r );
+  EXPECT_TRUE( are_matrices_equal( inv, inverse( Transform4{ r } ), 1e-5F ) );
+  EXPECT_TRUE( are_matrices_equal( r * inv, Mat4::identity(), 1e-6F ) );
+  EXPECT_FLOAT_EQ( inv( 3, 3 ), 1.0F );
+
+  const Rotation4 twice = r * r;
+  EXPECT_TRUE( are_matrices_equal( twice, make_rotation4( 1.6F, normalized( Vec3{ 0.0F, 1.0F, 1.0F } ) ), 1e-6F ) );
+}
+
+TEST_F( Transform4Test, ScaleKind )
+{
+  const Scale4 s   = make_scale( Vec3{ 2.0F, 4.0F, 0.5F } );
+  const Scale4 inv = inverse( s );
+  EXPECT_TRUE( are_matrices_equal( inv, inverse( Transform4{ s } ) ) );
+  EXPECT_EQ( inv.get_scale(), ( Vec3{ 0.5F, 0.25F, 2.0F } ) );
+  EXPECT_EQ( ( s * make_scale( Vec3{ 3.0F, 1.0F, 2.0F } ) ).get_scale(), ( Vec3{ 6.0F, 4.0F, 1.0F } ) );
+  EXPECT_EQ( ( s * Point3{ 1.0F, 1.0F, 2.0F } ), ( Point3{ 2.0F, 4.0F, 1.0F } ) );
+
+  static_assert( inverse( make_translation( Vec3{ 1.0F, 0.0F, 0.0F } ) )( 0, 3 ) == -1.0F );
+  static_assert( inverse( make_scale( Vec3{ 2.0F, 2.0F, 2.0F } ) ).get_scale() == Vec3{ 0.5F, 0.5F, 0.5F } );
+}
+
+TEST_F( Transform4Test, MixedKindsComposeToTransform4 )
+{
+  const Translation4 t = make_translation( Vec3{ 1.0F, 2.0F, 3.0F } );
+  const Rotation4    r = make_rotation4( 0.5F, Vec3{ 0.0F, 0.0F, 1.0F } );
+  const Scale4       s = make_scale( Vec3{ 2.0F, 2.0F, 2.0F } );
+
+  const Transform4 world = t * r * s;
+  const Transform4 inv   = inverse( s ) * inverse( r ) * inverse( t );
+  EXPECT_TRUE( are_matrices_equal( inv, inverse( world ), 1e-5F ) );
+}
+
+TEST_F( Transform4Test, DoublePrecision )
+{
+  const DTransform4 t = make_translation( DVec3{ 1.0, -2.0, 3.0 } ) * make_rotation4( 0.7, DVec3{ 0.0, 1.0, 0.0 } )
+                        * make_scale( DVec3{ 2.0, 0.5, 4.0 } );
+  const DTransform4 inv = inverse( t );
+  EXPECT_TRUE( are_matrices_equal( t * inv, DMat4::identity(), 1e-14F ) );
+  EXPECT_TRUE( are_matrices_equal( inv, inverse( DMat4{ t } ), 1e-14F ) );
+
+  const DPoint3 point{ 0.5, -1.5, 2.0 };
+  const DPoint3 round_trip = inv * ( t * point );
+  EXPECT_TRUE( are_vectors_equal( round_trip, point, 1e-14F ) );
+
+  const DVec4 homogeneous = DMat4{ t } * DVec4{ point, 1.0 };
+  EXPECT_TRUE( are_vectors_equal( t * point, DVec3{ homogeneous.x(), homogeneous.y(), homogeneous.z() }, 1e-14F ) );
+}
+
+TEST_F( Transform4Test, DoubleInverseMatchesScalarPath )
+{
+  constexpr DTransform4 t{ 2.0, 0.5, -1.0, 3.0, 0.25, 1.5, 0.0, -2.0, 1.0, -0.5, 3.0, 0.75 };
+  constexpr DTransform4 expected = inverse( t );
+  EXPECT_TRUE( are_matrices_equal( inverse( t ), expected, 1e-14F ) );
+}
+
+// The kinds cannot be modified in place, which would break the structure their inverses rely on. A modified copy is
+// a general Transform4 and takes the general inverse.
+TEST_F( Transform4Test, KindsAreNotMutable )
+{
+  static_assert( MutableElements<Transform4> && MutableInPlace<Transform4> && Translatable<Transform4> );
+  static_assert( !MutableElements<Translation4> && !MutableInPlace<Translation4> && !Translatable<Translation4> );
+  static_assert( !MutableElements<Rotation4> && !MutableInPlace<Rotation4> && !Translatable<Rotation4> );
+  static_assert( !MutableElements<Scale4> && !MutableInPlace<Scale4> && !Translatable<Scale4> );
+
+  Transform4 s = make_scale( Vec3{ 2.0F, 4.0F, 0.5F } );
+  s( 0, 3 )    = 2.5F;
+  EXPECT_FLOAT_EQ( inverse( s )( 0, 3 ), -1.25F );
+  EXPECT_TRUE( are_matrices_equal( s * inverse( s ), Mat4::identity(), 1e-6F ) );
+
+  Transform4 r = make_rotation4( 0.8F, normalized( Vec3{ 0.0F, 1.0F, 1.0F } ) );
+  r *= 2.0F;
+  r( 3, 3 ) = 1.0F;
+  EXPECT_TRUE( are_matrices_equal( r * inverse( r ), Mat4::identity(), 1e-6F ) );
+}
@@ -0,0 +1,331 @@
+#include "linalg/utility.hpp"
+#include "linalg/vec_batch.hpp"
+#include "test_utils.hpp"
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+using namespace linalg;
+
+namespace {
+
+std::vector<Vec3> make_vec3s( size_t count, float seed )
+{
+  std::vector<Vec3> vecs( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const auto f = static_cast<float>( i );
+    vecs[i]      = Vec3{ seed + f * 0.25F, 1.0F - seed * f * 0.125F, 0.5F + f * 0.0625F };
+  }
+  return vecs;
+}
+
+std::vector<IVec3> make_ivec3s( size_t count, int seed )
+{
+  std::vector<IVec3> vecs( count );
+  for ( size_t i = 0; i != count; ++i )
+  {
+    const auto n = static_cast<int>( i );
+    vecs[i]      = IVec3{ seed + n * 3, seed * n - 50, ( n % 7 ) - 3 };
+  }
+  return vecs;
+}
+
+// Sizes around the SIMD width and the 16-float lane padding.
+const std::vector<size_t> sizes{ 0, 1, 7, 16, 17, 100 };
+
+} // namespace
+
+class VecBatchTest : public ::testing::Test
+{
+protected:
+  std::vector<Vec3> v1 = make_vec3s( 37, 1.5F );
+  std::vector<Vec3> v2 = make_vec3s( 37, -0.75F );
+};
+
+TEST_F( VecBatchTest, ConstructFromSpan )
+{
+  const Vec3Batch batch( v1 );
+  ASSERT_EQ( batch.size(), v1.size() );
+  EXPECT_EQ( batch.padded_size(), 48U );
+  for ( size_t i = 0; i != v1.size(); ++i )
+  {
+    EXPECT_EQ( batch[i], v1[i] );
+    EXPECT_EQ( batch.x()[i], v1[i].x() );
+    EXPECT_EQ( batch.y()[i], v1[i].y() );
+    EXPECT_EQ( batch.z()[i], v1[i].z() );
+  }
+
+  std::vector<Vec3> round_trip( v1.size() );
+  batch.copy_to( round_trip );
+  EXPECT_EQ( round_trip, v1 );
+}
+
+TEST_F( VecBatchTest, LanesAreAligned )
+{
+  const Vec4Batch batch( 5 );
+  for ( size_t c = 0; c != 4; ++c )
+  {
+    EXPECT_EQ( reinterpret_cast<std::uintptr_t>( batch.lane( c ).data() ) % Vec4Batch::lane_alignment, 0U );
+    EXPECT_EQ( batch.lane( c ).size(), 5U );
+  }
+}
+
+TEST_F( VecBatchTest, ResizeKeepsValuesAndZeroesNewVectors )
+{
+  Vec3Batch batch( v1 );
+  batch.resize( 3 );
+  batch.resize( 10 );
+  EXPECT_EQ( batch[2], v1[2] );
+  EXPECT_EQ( batch[3], Vec3{} );
+
+  batch.resize( 40 );
+  EXPECT_EQ( batch.padded_size(), 48U );
+  EXPECT_EQ( batch[1], v1[1] );
+  EXPECT_EQ( batch[39], Vec3{} );
+
+  batch.set( 39, v2[0] );
+  EXPECT_EQ( batch[39], v2[0] );
+
+  batch.clear();
+  EXPECT_TRUE( batch.empty() );
+}
+
+TEST_F( VecBatchTest, DotAndMagnitude )
+{
+  for ( size_t size : sizes )
+  {
+    const auto      a = make_vec3s( size, 2.0F );
+    const auto      b = make_vec3s( size, -1.0F );
+    const Vec3Batch left( a );
+    const Vec3Batch right( b );
+
+    const std::vector<float> dots       = dot( left, right );
+    const std::vector<float> magnitudes = magnitude( left );
+    ASSERT_EQ( dots.size(), size );
+    ASSERT_EQ( magnitudes.size(), size );
+    for ( size_t i = 0; i != size; ++i )
+    {
+      EXPECT_NEAR( dots[i], dot( a[i], b[i] ), 1e-4F );
+      EXPECT_NEAR( magnitudes[i], magnitude( a[i] ), 1e-5F );
+    }
+  }
+}
+
+TEST_F( VecBatchTest, CrossAndNormalized )
+{
+  for ( size_t size : sizes )
+  {
+    const auto      a = make_vec3s( size, 2.0F );
+    const auto      b = make_vec3s( size, -1.0F );
+    const Vec3Batch left( a );
+    const Vec3Batch right( b );
+
+    const Vec3Batch crossed = cross( left, right );
+    const Vec3Batch units   = normalized( left );
+    ASSERT_EQ( crossed.size(), size );
+    ASSERT_EQ( units.size(), size );
+    for ( size_t i = 0; i != size; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( crossed[i], cross( a[i], b[i] ), 1e-4F ) );
+      EXPECT_TRUE( are_vectors_equal( units[i], normalized( a[i] ) ) );
+    }
+  }
+}
+
+TEST_F( VecBatchTest, NormalizedAccuracyModes )
+{
+  for ( size_t size : sizes )
+  {
+    const auto      a = make_vec3s( size, 2.0F );
+    const Vec3Batch batch( a );
+    const Vec3Batch refined  = normalized<Refined>( batch );
+    const Vec3Batch estimate = normalized<Estimate>( batch );
+    for ( size_t i = 0; i != size; ++i )
+    {
+      EXPECT_TRUE( are_vectors_equal( refined[i], normalized( a[i] ), 1e-6F ) );
+      EXPECT_NEAR( magnitude( estimate[i] ), 1.0F, 4e-4F );
+    }
+  }
+}
+
+TEST_F( VecBatchTest, ProjectAndReject )
+{
+  const Vec3Batch source( v1 );
+  const Vec3Batch target( v2 );
+
+  const Vec3Batch projected = project( source, target );
+  const Vec3Batch rejected  = reject( source, target );
+  for ( size_t i = 0; i != v1.size(); ++i )
+  {
+    EXPECT_TRUE( are_vectors_equal( projected[i], project( v1[i], v2[i] ), 1e-4F ) );
+    EXPECT_TRUE( are_vectors_equal( rejected[i], reject( v1[i], v2[i] ), 1e-4F ) );
+  }
+}
+
+TEST_F( VecBatchTest, MixMinMax )
+{
+  const Vec3Batch a( v1 );
+  const Vec3Batch b( v2 );
+
+  const Vec3Batch mixed = mix( a, b, 0.3F );
+  const Vec3Batch lower = min( a, b );
+  const Vec3Batch upper = max( a, b );
+  for ( size_t i = 0; i != v1.size(); ++i )
+  {
+    EXPECT_TRUE( are_vectors_equal( mixed[i], mix( v1[i], v2[i], 0.3F ) ) );
+    EXPECT_EQ( lower[i], min( v1[i], v2[i] ) );
+    EXPECT_EQ( upper[i], max( v1[i], v2[i] ) );
+  }
+}
+
+TEST_F( VecBatchTest, OutputMayAliasInput )
+{
+  Vec3Batch       a( v1 );
+  const Vec3Batch b( v2 );
+  cross( a, b, a );
+  for ( size_t i = 0; i != v1.size(); ++i )
+  {
+    EXPECT_TRUE( are_vectors_equal( a[i], cross( v1[i], v2[i] ), 1e-4F ) );
+  }
+
+  normalized( a, a );
+  EXPECT_TRUE( are_vectors_equal( a[0], normalized( cross( v1[0], v2[0] ) ), 1e-6F ) );
+}
+
+TEST_F( VecBatchTest, Point3Batch )
+{
+  const std::vector<Point3> points{ { 1.0F, 2.0F, 3.0F }, { -4.0F, 5.0F, 0.5F }, { 0.0F, 0.0F, 1.0F } };
+  const Point3Batch         batch( points );
+  ASSERT_EQ( batch.size(), points.size() );
+  EXPECT_EQ( batch[1], points[1] );
+
+  std::vector<Point3> out( points.size() );
+  batch.copy_to( out );
+  EXPECT_EQ( out, points );
+
+  const std::vector<float> lengths = magnitude( batch );
+  EXPECT_FLOAT_EQ( lengths[0], magnitude( points[0] ) );
+}
+
+TEST_F( VecBatchTest, IntegerArithmetic )
+{
+  for ( size_t size : sizes )
+  {
+    const auto       a = make_ivec3s( size, 5 );
+    const auto       b = make_ivec3s( size, -9 );
+    const IVec3Batch left( a );
+    const IVec3Batch right( b );
+
+    IVec3Batch sum;
+    IVec3Batch difference;
+    IVec3Batch product;
+    IVec3Batch shifted_left;
+    IVec3Batch shifted_right;
+    add( left, right, sum );
+    subtract( left, right, difference );
+    multiply( left, right, product );
+    shift_left( left, 3, shifted_left );
+    shift_right( right, 2, shifted_right );
+    const IVec3Batch lower = min( left, right );
+    const IVec3Batch upper = max( left, right );
+    ASSERT_EQ( sum.size(), size );
+    for ( size_t i = 0; i != size; ++i )
+    {
+      EXPECT_EQ( sum[i], a[i] + b[i] );
+      EXPECT_EQ( difference[i], a[i] - b[i] );
+      EXPECT_EQ( product[i], ( IVec3{ a[i].x() * b[i].x(), a[i].y() * b[i].y(), a[i].z() * b[i].z() } ) );
+      EXPECT_EQ( shifted_left[i], a[i] * 8 );
+      EXPECT_EQ( shifted_right[i], ( IVec3{ b[i].x() >> 2, b[i].y() >> 2, b[i].z() >> 2 } ) );
+      EXPECT_EQ( lower[i], min( a[i], b[i] ) );
+      EXPECT_EQ( upper[i], max( a[i], b[i] ) );
+    }
+  }
+}
+
+TEST_F( VecBatchTest, IntegerArithmeticAfterShrink )
+{
+  // The shrink leaves INT_MAX in the padding, which the kernels still run over.
+  constexpr int    big = std::numeric_limits<int>::max();
+  const IVec3      value{ big, big, big };
+  IVec3Batch       batch( std::vector<IVec3>( 3, value ) );
+  IVec3Batch       sum;
+  IVec3Batch       product;
+  batch.resize( 2 );
+  add( batch, batch, sum );
+  multiply( batch, batch, product );
+  ASSERT_EQ( sum.size(), 2u );
+  const IVec3 wrapped_sum{ -2, -2, -2 };
+  const IVec3 wrapped_product{ 1, 1, 1 };
+  for ( size_t i = 0; i != sum.size(); ++i )
+  {
+    EXPECT_EQ( sum[i], wrapped_sum );
+    EXPECT_EQ( product[i], wrapped_product );
+  }
+
+  using I64Vec3        = Vec<std::int64_t, 3>;
+  constexpr auto wide = static_cast<std::int64_t>( big );
+  VecBatch<std::int64_t, 3> wide_batch( std::vector<I64Vec3>( 3, I64Vec3{ wide, wide, wide } ) );
+  VecBatch<std::int64_t, 3> wide_sum;
+  wide_batch.resize( 1 );
+  add( wide_batch, wide_batch, wide_sum );
+  EXPECT_EQ( wide_sum[0], ( I64Vec3{ 2 * wide, 2 * wide, 2 * wide } ) );
+}
+
+TEST_F( VecBatchTest, FloatArithmetic )
+{
+  const Vec3Batch left( v1 );
+  const Vec3Batch right( v2 );
+  Vec3Batch       sum;
+  Vec3Batch       product;
+  add( left, right, sum );
+  multiply( left, right, product );
+  subtract( sum, right, sum );
+  for ( size_t i = 0; i != v1.size(); ++i )
+  {
+    EXPECT_TRUE( are_vectors_equal( sum[i], v1[i], 1e-5F ) );
+    EXPECT_TRUE( are_vectors_equal(
+      product[i], Vec3{ v1[i].x() * v2[i].x(), v1[i].y() * v2[i].y(), v1[i].z() * v2[i].z() }, 0.0F ) );
+  }
+}
+
+TEST_F( VecBatchTest, PaddingDoesNotReachResults )
+{
+  // Normalizing computes 0 / 0 in the padding lanes; nothing downstream may depend on it.
+  const Vec3Batch unit = normalized( Vec3Batch( v1 ) );
+  ASSERT_GT( unit.padded_size(), unit.size() );
+
+  const IVec3Batch cells = to_cells( unit, 0.25F );
+  ASSERT_EQ( cells.size(), unit.size() );
+  for ( size_t i = 0; i != cells.size(); ++i )
+  {
+    EXPECT_EQ( cells[i], to_cell( unit[i], 0.25F ) ) << "index " << i;
+  }
+}
+
+TEST_F( VecBatchTest, ToCellsAndMorton )
+{
+  for ( size_t size : sizes )
+  {
+    auto points = make_vec3s( size, -3.0F );
+    if ( size > 1 )
+    {
+      points[1] = Vec3{ -0.5F, 0.5F, 1.0F };
+    }
+    const IVec3Batch cells = to_cells( Vec3Batch( points ), 0.5F );
+    ASSERT_EQ( cells.size(), size );
+
+    std::vector<std::uint64_t> codes( size );
+    morton_encode( cells, codes );
+    for ( size_t i = 0; i != size; ++i )
+    {
+      EXPECT_EQ( cells[i], to_cell( points[i], 0.5F ) ) << "index " << i;
+      EXPECT_EQ( codes[i], morton_encode( cells[i] ) );
+    }
+    if ( size > 1 )
+    {
+      EXPECT_EQ( cells[1], ( IVec3{ -1, 1, 2 } ) );
+    }
+  }
+}
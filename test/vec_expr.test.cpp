@@ -0,0 +1,62 @@
+#include "linalg/point.hpp"
+#include "linalg/vec_expr.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+#include <type_traits>
+
+using namespace linalg;
+
+class VecExprTest : public ::testing::Test
+{
+protected:
+  Vec3 a{ 1.0F, -2.0F, 3.5F };
+  Vec3 b{ 0.25F, 4.0F, -1.0F };
+  Vec3 c{ -3.0F, 0.5F, 2.0F };
+};
+
+TEST_F( VecExprTest, MatchesEagerArithmetic )
+{
+  const Vec3 lazy_result  = 2.0F * lazy( a ) + lazy( b ) * c - lazy( c ) / 4.0F;
+  const Vec3 eager_result = 2.0F * a + b * c - c / 4.0F;
+  EXPECT_TRUE( are_vectors_equal( lazy_result, eager_result, 1e-6F ) );
+
+  const Vec3 negated = -( lazy( a ) - b );
+  EXPECT_EQ( negated, b - a );
+
+  const Vec3 divided = lazy( a ) / c;
+  EXPECT_FLOAT_EQ( divided.x(), a.x() / c.x() );
+}
+
+TEST_F( VecExprTest, BuildsExpressionsNotVectors )
+{
+  const auto expr = lazy( a ) + b;
+  EXPECT_FALSE( ( std::is_same_v<std::remove_cvref_t<decltype( expr )>, Vec3> ) );
+  EXPECT_TRUE( ( std::is_same_v<decltype( eval( expr ) ), Vec3> ) );
+  EXPECT_TRUE( ( std::is_same_v<decltype( a + b ), Vec3> ) );
+}
+
+TEST_F( VecExprTest, AssignsAndMixesWithVecDerivedTypes )
+{
+  Vec3 result;
+  result = lazy( a ) * 3.0F - b;
+  EXPECT_TRUE( are_vectors_equal( result, a * 3.0F - b, 1e-6F ) );
+
+  const Point3 point{ 1.0F, 2.0F, 3.0F };
+  const Vec3   shifted = point + lazy( a ) * 0.5F;
+  EXPECT_TRUE( are_vectors_equal( shifted, point + a * 0.5F, 1e-6F ) );
+
+  const Vec4 widened{ lazy( a ) + b, 1.0F };
+  EXPECT_EQ( widened, ( Vec4{ a + b, 1.0F } ) );
+}
+
+TEST_F( VecExprTest, Constexpr )
+{
+  constexpr Vec3 x{ 1.0F, 2.0F, 3.0F };
+  constexpr Vec3 y{ 4.0F, 5.0F, 6.0F };
+  constexpr Vec3 z = 2.0F * lazy( x ) + lazy( y ) * x - y / 2.0F;
+  static_assert( z == Vec3{ 4.0F, 11.5F, 21.0F } );
+
+  constexpr IVec3 i{ 1, 2, 3 };
+  constexpr IVec3 j = lazy( i ) * i - 2 * lazy( i );
+  static_assert( j == IVec3{ -1, 0, 3 } );
+}
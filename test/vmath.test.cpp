@@ -0,0 +1,254 @@
+#include "linalg/rotation_batch.hpp"
+#include "linalg/vec_batch.hpp"
+#include "linalg/vmath.hpp"
+#include "test_utils.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <vector>
+
+using namespace linalg;
+
+class VMathTest : public ::testing::Test
+{
+protected:
+  static constexpr float inf = std::numeric_limits<float>::infinity();
+  static constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+  // Uniform samples in [low, high] plus a logarithmic sweep of both signs down to tiny magnitudes.
+  static std::vector<float> samples( float low, float high )
+  {
+    std::mt19937                          engine( 17 );
+    std::uniform_real_distribution<float> uniform( low, high );
+    std::vector<float>                    result( 100'000 );
+    std::generate( result.begin(), result.end(), [&] { return uniform( engine ); } );
+    for ( float x = 1e-30F; x < std::max( -low, high ); x *= 1.01F )
+    {
+      if ( x <= high )
+      {
+        result.push_back( x );
+      }
+      if ( -x >= low )
+      {
+        result.push_back( -x );
+      }
+    }
+    return result;
+  }
+
+  // Error of value in float ulp at the exact result.
+  static double ulps( float value, double exact )
+  {
+    int exponent = 0;
+    std::frexp( exact, &exponent );
+    return std::abs( value - exact ) / std::ldexp( 1.0, std::max( exponent, -125 ) - 24 );
+  }
+
+  template<typename Function, typename Reference>
+  static double max_ulps( const std::vector<float>& in, Function function, Reference reference )
+  {
+    std::vector<float> out( in.size() );
+    function( std::span<const float>{ in }, std::span<float>{ out } );
+    double worst = 0.0;
+    for ( size_t i = 0; i != in.size(); ++i )
+    {
+      worst = std::max( worst, ulps( out[i], reference( static_cast<double>( in[i] ) ) ) );
+    }
+    return worst;
+  }
+
+  template<MathPrecision P>
+  static void expect_bounds()
+  {
+    constexpr bool precise = std::same_as<P, Precise>;
+    const auto     trig    = samples( precise ? -40000.0F : -120.0F, precise ? 40000.0F : 120.0F );
+    const auto     unit    = samples( -1.0F, 1.0F );
+    const auto     wide    = samples( -1e30F, 1e30F );
+    const auto     exp_in  = samples( -103.0F, 88.7F );
+    const auto     log_in  = samples( 0.0F, 3e38F );
+
+    const auto sin_p = []( auto in, auto out ) { sin<P>( in, out ); };
+    const auto cos_p = []( auto in, auto out ) { cos<P>( in, out ); };
+    const auto tan_p = []( auto in, auto out ) { tan<P>( in, out ); };
+    const auto sin_d = []( double x ) { return std::sin( x ); };
+    EXPECT_LT( max_ulps( trig, sin_p, sin_d ), 2.5 );
+    EXPECT_LT( max_ulps( samples( -4.0F, 4.0F ), sin_p, sin_d ), precise ? 1.5 : 2.0 );
+    EXPECT_LT( max_ulps( trig, cos_p, []( double x ) { return std::cos( x ); } ), 2.5 );
+    EXPECT_LT( max_ulps( trig, tan_p, []( double x ) { return std::tan( x ); } ), 3.5 );
+
+    const auto asin_p = []( auto in, auto out ) { asin<P>( in, out ); };
+    const auto acos_p = []( auto in, auto out ) { acos<P>( in, out ); };
+    const auto atan_p = []( auto in, auto out ) { atan<P>( in, out ); };
+    EXPECT_LT( max_ulps( unit, asin_p, []( double x ) { return std::asin( x ); } ), 2.0 );
+    EXPECT_LT( max_ulps( unit, acos_p, []( double x ) { return std::acos( x ); } ), 1.5 );
+    EXPECT_LT( max_ulps( wide, atan_p, []( double x ) { return std::atan( x ); } ), precise ? 1.5 : 2.5 );
+
+    const auto exp_p = []( auto in, auto out ) { exp<P>( in, out ); };
+    const auto log_p = []( auto in, auto out ) { log<P>( in, out ); };
+    EXPECT_LT( max_ulps( exp_in, exp_p, []( double x ) { return std::exp( x ); } ), precise ? 1.1 : 2.5 );
+    EXPECT_LT( max_ulps( log_in, log_p, []( double x ) { return std::log( x ); } ), precise ? 1.0 : 1.5 );
+
+    std::vector<float> angles( wide.size() );
+    std::vector<float> x( wide.size() );
+    std::vector<float> y( wide.size() );
+    std::mt19937       engine( 5 );
+    for ( size_t i = 0; i != wide.size(); ++i )
+    {
+      const float scale = std::uniform_real_distribution<float>( -3.0F, 3.0F )( engine );
+      x[i]              = std::pow( 10.0F, scale ) * std::cos( static_cast<float>( i ) );
+      y[i]              = std::pow( 10.0F, -scale ) * std::sin( static_cast<float>( i ) );
+    }
+    atan2<P>( y, x, angles );
+    double worst = 0.0;
+    for ( size_t i = 0; i != x.size(); ++i )
+    {
+      worst = std::max( worst, ulps( angles[i], std::atan2( static_cast<double>( y[i] ), x[i] ) ) );
+    }
+    EXPECT_LT( worst, precise ? 2.0 : 3.5 );
+  }
+};
+
+TEST_F( VMathTest, PreciseBounds )
+{
+  expect_bounds<Precise>();
+}
+
+TEST_F( VMathTest, FastBounds )
+{
+  expect_bounds<Fast>();
+}
+
+TEST_F( VMathTest, SpecialValues )
+{
+  const Vec4 exps = exp( Vec4{ -inf, inf, 100.0F, -200.0F } );
+  EXPECT_EQ( exps, ( Vec4{ 0.0F, inf, inf, 0.0F } ) );
+  EXPECT_TRUE( std::isnan( exp( Vec2{ nan, 0.0F } ).x() ) );
+  EXPECT_EQ( exp( Vec2{ nan, 0.0F } ).y(), 1.0F );
+
+  const Vec4 logs = log( Vec4{ 0.0F, -1.0F, inf, 1.0F } );
+  EXPECT_EQ( logs.x(), -inf );
+  EXPECT_TRUE( std::isnan( logs.y() ) );
+  EXPECT_EQ( logs.z(), inf );
+  EXPECT_EQ( logs.w(), 0.0F );
+  EXPECT_LT( ulps( log( Vec2{ 1e-40F, 0.0F } ).x(), std::log( static_cast<double>( 1e-40F ) ) ), 1.0 );
+
+  const Vec3 sines = sin( Vec3{ -0.0F, inf, nan } );
+  EXPECT_TRUE( sines.x() == 0.0F && std::signbit( sines.x() ) );
+  EXPECT_TRUE( std::isnan( sines.y() ) && std::isnan( sines.z() ) );
+  EXPECT_TRUE( std::isnan( asin( Vec2{ 1.5F, 0.0F } ).x() ) );
+  const float pi = std::numbers::pi_v<float>;
+  EXPECT_EQ( asin( Vec2{ 1.0F, -1.0F } ), ( Vec2{ pi / 2, -pi / 2 } ) );
+  EXPECT_EQ( acos( Vec2{ 1.0F, -1.0F } ), ( Vec2{ 0.0F, pi } ) );
+  EXPECT_EQ( atan( Vec2{ inf, -inf } ), ( Vec2{ pi / 2, -pi / 2 } ) );
+}
+
+TEST_F( VMathTest, Atan2SignedZeros )
+{
+  const float pi = std::numbers::pi_v<float>;
+  const Vec4  y{ 0.0F, -0.0F, 0.0F, -0.0F };
+  const Vec4  x{ 0.0F, 0.0F, -0.0F, -1.0F };
+  const Vec4  angles = atan2( y, x );
+  EXPECT_TRUE( angles.x() == 0.0F && !std::signbit( angles.x() ) );
+  EXPECT_TRUE( angles.y() == 0.0F && std::signbit( angles.y() ) );
+  EXPECT_EQ( angles.z(), pi );
+  EXPECT_EQ( angles.w(), -pi );
+  EXPECT_EQ( atan2( Vec2{ 1.0F, -1.0F }, Vec2{ 0.0F, 0.0F } ), ( Vec2{ pi / 2, -pi / 2 } ) );
+}
+
+// Every element takes the same path, so results depend neither on the size of the call nor on the position.
+TEST_F( VMathTest, TailsAndAliasing )
+{
+  std::vector<float> in( 37 );
+  for ( size_t i = 0; i != in.size(); ++i )
+  {
+    in[i] = static_cast<float>( i ) * 0.37F - 5.0F;
+  }
+  std::vector<float> sines( in.size() );
+  std::vector<float> cosines( in.size() );
+  sincos( in, sines, cosines );
+
+  for ( size_t size = 1; size != in.size(); ++size )
+  {
+    const size_t       offset = in.size() - size;
+    std::vector<float> part( in.begin() + static_cast<std::ptrdiff_t>( offset ), in.end() );
+    std::vector<float> part_cosines( size );
+    cos( part, part_cosines );
+    sin( part, part );
+    for ( size_t i = 0; i != size; ++i )
+    {
+      EXPECT_EQ( part[i], sines[offset + i] );
+      EXPECT_EQ( part_cosines[i], cosines[offset + i] );
+    }
+  }
+
+  const Vec3 v{ in[3], in[10], in[20] };
+  Vec3       vs;
+  Vec3       vc;
+  sincos( v, vs, vc );
+  EXPECT_EQ( vs, sin( v ) );
+  EXPECT_EQ( vc, ( Vec3{ cosines[3], cosines[10], cosines[20] } ) );
+}
+
+TEST_F( VMathTest, Batches )
+{
+  std::vector<Vec3> vecs( 21 );
+  for ( size_t i = 0; i != vecs.size(); ++i )
+  {
+    const auto f = static_cast<float>( i );
+    vecs[i]      = Vec3{ f * 0.3F + 0.1F, 0.05F * f + 0.01F, f * 3.0F + 0.5F };
+  }
+  const Vec3Batch batch( vecs );
+  Vec3Batch       sines;
+  Vec3Batch       cosines;
+  Vec3Batch       logs;
+  Vec3Batch       angles;
+  sincos<Fast>( batch, sines, cosines );
+  log( batch, logs );
+  atan2( sines, cosines, angles );
+  ASSERT_EQ( sines.size(), vecs.size() );
+  for ( size_t i = 0; i != vecs.size(); ++i )
+  {
+    EXPECT_EQ( sines[i], sin<Fast>( vecs[i] ) );
+    EXPECT_EQ( cosines[i], cos<Fast>( vecs[i] ) );
+    EXPECT_EQ( logs[i], log( vecs[i] ) );
+    EXPECT_EQ( angles[i], atan2( sines[i], cosines[i] ) );
+  }
+
+  Vec3Batch in_place = batch;
+  exp( in_place, in_place );
+  for ( size_t i = 0; i != vecs.size(); ++i )
+  {
+    EXPECT_EQ( in_place[i], exp( vecs[i] ) );
+  }
+}
+
+TEST_F( VMathTest, RotationFactories )
+{
+  std::vector<float> angles( 300 );
+  std::vector<Vec3>  axes( angles.size() );
+  for ( size_t i = 0; i != angles.size(); ++i )
+  {
+    const auto f = static_cast<float>( i );
+    angles[i]    = f * 0.05F - 7.0F;
+    axes[i]      = normalized( Vec3{ std::sin( f ), std::cos( f * 0.7F ), 0.5F } );
+  }
+  std::vector<Rotation3> x( angles.size() );
+  std::vector<Rotation3> y( angles.size() );
+  std::vector<Rotation3> z( angles.size() );
+  std::vector<Rotation3> about( angles.size() );
+  make_rotations_x( angles, x );
+  make_rotations_y( angles, y );
+  make_rotations_z<Fast>( angles, z );
+  make_rotations( angles, axes, about );
+  for ( size_t i = 0; i != angles.size(); ++i )
+  {
+    EXPECT_TRUE( are_matrices_equal( x[i], make_rotation_x( angles[i] ), 1e-6F ) );
+    EXPECT_TRUE( are_matrices_equal( y[i], make_rotation_y( angles[i] ), 1e-6F ) );
+    EXPECT_TRUE( are_matrices_equal( z[i], make_rotation_z( angles[i] ), 1e-6F ) );
+    EXPECT_TRUE( are_matrices_equal( about[i], make_rotation( angles[i], axes[i] ), 1e-6F ) );
+  }
+}